@@ -0,0 +1,61 @@
+#include "AdvanceIndex.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+namespace
+{
+	AdvanceIndex CreateIndex(size_t count)
+	{
+		std::mt19937 random(32);
+		std::vector<int> advances(count);
+
+		for (auto& a : advances) a = 5 + random() % 6;
+
+		AdvanceIndex index;
+		index.Assign(advances.data(), advances.size());
+		return index;
+	}
+}
+
+static void AdvanceIndex_GetPosition(benchmark::State& state)
+{
+	const auto index = CreateIndex(static_cast<size_t>(state.range(0)));
+	std::mt19937 random(32);
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(index.GetPosition(random() % index.GetCount()));
+	}
+}
+BENCHMARK(AdvanceIndex_GetPosition)->Arg(1000)->Arg(100000)->Arg(1000000);
+
+static void AdvanceIndex_FindIndex(benchmark::State& state)
+{
+	const auto index = CreateIndex(static_cast<size_t>(state.range(0)));
+	std::mt19937 random(32);
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(index.FindIndex(static_cast<int>(random() % index.GetWidth())));
+	}
+}
+BENCHMARK(AdvanceIndex_FindIndex)->Arg(1000)->Arg(100000)->Arg(1000000);
+
+// Typing a character and moving the caret after it
+static void AdvanceIndex_Keystroke(benchmark::State& state)
+{
+	auto index = CreateIndex(static_cast<size_t>(state.range(0)));
+	std::mt19937 random(32);
+	const int advance = 7;
+
+	for (auto _ : state)
+	{
+		const size_t at = random() % index.GetCount();
+		index.Insert(at, &advance, 1);
+		benchmark::DoNotOptimize(index.GetPosition(at + 1));
+		index.Erase(at, 1);
+	}
+}
+BENCHMARK(AdvanceIndex_Keystroke)->Arg(1000)->Arg(100000)->Arg(1000000);
\ No newline at end of file
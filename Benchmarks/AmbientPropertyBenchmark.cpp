@@ -0,0 +1,103 @@
+#include "AmbientProperty.h"
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+	struct Control
+	{
+		Control* Parent;
+		std::vector<Control*> Children;
+		AmbientProperty<std::string> Local;
+		std::string Value;
+		unsigned long long Version = 0;
+		unsigned long long ResolvedVersion = 0;
+
+		Control(Control* parent)
+			:
+			Parent(parent),
+			Local("Segoe UI, 9pt"),
+			Value(Local.Get())
+		{
+			if (parent != nullptr) parent->Children.push_back(this);
+		}
+
+		void Resolve()
+		{
+			if (ResolvedVersion == AmbientVersion::GetCurrent()) return;
+
+			auto parent = [](const Control* c) { return c->Parent; };
+			AmbientProperty<std::string>::Find(this, &Control::Local, parent).CopyTo(Value, Version);
+			ResolvedVersion = AmbientVersion::GetCurrent();
+		}
+
+		// Former SetFont: the value is copied into every descendant
+		void Propagate(const std::string& value)
+		{
+			Value = value;
+			for (auto c : Children) c->Propagate(value);
+		}
+	};
+
+	// A window with 50 panels of 100 controls each
+	std::vector<std::unique_ptr<Control>> CreateTree()
+	{
+		std::vector<std::unique_ptr<Control>> controls;
+		controls.push_back(std::make_unique<Control>(nullptr));
+
+		for (int i = 0; i < 50; ++i)
+		{
+			auto panel = controls.emplace_back(std::make_unique<Control>(controls[0].get())).get();
+
+			for (int j = 0; j < 100; ++j)
+			{
+				controls.push_back(std::make_unique<Control>(panel));
+			}
+		}
+
+		return controls;
+	}
+}
+
+// Change the window font and resolve every control (what a full repaint does)
+static void AmbientProperty_SetAndResolveAll(benchmark::State& state)
+{
+	auto controls = CreateTree();
+	int i = 0;
+
+	for (auto _ : state)
+	{
+		controls[0]->Local.Set(++i % 2 ? "Consolas, 10pt" : "Segoe UI, 9pt");
+		for (auto& c : controls) c->Resolve();
+	}
+}
+BENCHMARK(AmbientProperty_SetAndResolveAll)->Unit(benchmark::kMicrosecond);
+
+static void AmbientProperty_Propagate(benchmark::State& state)
+{
+	auto controls = CreateTree();
+	int i = 0;
+
+	for (auto _ : state)
+	{
+		controls[0]->Propagate(++i % 2 ? "Consolas, 10pt" : "Segoe UI, 9pt");
+	}
+}
+BENCHMARK(AmbientProperty_Propagate)->Unit(benchmark::kMicrosecond);
+
+// Every control resolved again after an unrelated change (ex: a color set on another window)
+static void AmbientProperty_ResolveUnchanged(benchmark::State& state)
+{
+	auto controls = CreateTree();
+	AmbientProperty<int> other(0);
+
+	for (auto _ : state)
+	{
+		other.Set(1);
+		for (auto& c : controls) c->Resolve();
+	}
+}
+BENCHMARK(AmbientProperty_ResolveUnchanged)->Unit(benchmark::kMicrosecond);
\ No newline at end of file
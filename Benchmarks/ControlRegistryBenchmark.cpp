@@ -0,0 +1,59 @@
+#include "ControlRegistry.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+namespace
+{
+	struct Item
+	{
+		unsigned int Id;
+	};
+
+	const void* GetHandle(size_t i)
+	{
+		return reinterpret_cast<const void*>(0x10000 + i * 8);
+	}
+}
+
+// Hit test of a click in a window of 10000 controls
+static void ControlRegistry_FindByHandle(benchmark::State& state)
+{
+	constexpr size_t Count = 10000;
+	std::vector<Item> items(Count);
+	ControlRegistry<Item> registry;
+
+	for (size_t i = 0; i < Count; ++i)
+	{
+		items[i].Id = static_cast<unsigned int>(i);
+		registry.AddId(items[i].Id, &items[i]);
+		registry.AddHandle(GetHandle(i), &items[i]);
+	}
+
+	std::mt19937 random(49);
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(registry.FindByHandle(GetHandle(random() % Count)));
+	}
+}
+BENCHMARK(ControlRegistry_FindByHandle);
+
+// A control created, given a handle, destroyed and deleted
+static void ControlRegistry_Lifetime(benchmark::State& state)
+{
+	ControlRegistry<Item> registry;
+	Item item{ 1 };
+	size_t handle = 0;
+
+	for (auto _ : state)
+	{
+		registry.AddId(item.Id, &item);
+		registry.AddHandle(GetHandle(handle), &item);
+		registry.RemoveHandle(&item, GetHandle(handle));
+		registry.Remove(&item, item.Id, nullptr);
+		handle = (handle + 1) % 1024;
+	}
+}
+BENCHMARK(ControlRegistry_Lifetime);
\ No newline at end of file
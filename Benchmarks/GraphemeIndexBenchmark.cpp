@@ -0,0 +1,74 @@
+#include "GraphemeIndex.h"
+
+#include <benchmark/benchmark.h>
+#include <string>
+
+namespace
+{
+	// 16 MB of ASCII (Arg 0) or mixed UTF-8 with combining marks, emoji and CR LF (Arg 1)
+	std::string CreateText(bool isMixed)
+	{
+		const char* line = isMixed ? "Ol\xC3\xA1 mundo, \xE4\xBD\xA0\xE5\xA5\xBD \xF0\x9F\x91\x8D\xF0\x9F\x8F\xBD caf\x65\xCC\x81\r\n" : "The quick brown fox jumps over the lazy dog.\n";
+		std::string ret;
+
+		while (ret.size() < (16u << 20)) ret += line;
+
+		return ret;
+	}
+}
+
+static void GraphemeIndex_NextStop(benchmark::State& state)
+{
+	PieceTable document(CreateText(state.range(0)));
+	GraphemeIndex index(document);
+	size_t position = document.GetLength() / 2;
+
+	for (auto _ : state)
+	{
+		position = index.GetNextStop(position);
+		if (position == document.GetLength()) position = 0;
+	}
+}
+BENCHMARK(GraphemeIndex_NextStop)->Arg(0)->Arg(1);
+
+static void GraphemeIndex_PreviousStop(benchmark::State& state)
+{
+	PieceTable document(CreateText(state.range(0)));
+	GraphemeIndex index(document);
+	size_t position = document.GetLength() / 2;
+
+	for (auto _ : state)
+	{
+		position = index.GetPreviousStop(position);
+		if (position == 0) position = document.GetLength();
+	}
+}
+BENCHMARK(GraphemeIndex_PreviousStop)->Arg(0)->Arg(1);
+
+// Typing an accented character and moving the caret after it
+static void GraphemeIndex_Type(benchmark::State& state)
+{
+	PieceTable document(CreateText(state.range(0)));
+	GraphemeIndex index(document);
+	size_t caret = document.GetLength() / 3;
+
+	for (auto _ : state)
+	{
+		document.Insert(caret, "\xC3\xA9");
+		index.OnInsert(caret, 2);
+		caret = index.GetNextStop(caret);
+	}
+}
+BENCHMARK(GraphemeIndex_Type)->Arg(0)->Arg(1);
+
+static void GraphemeIndex_Full(benchmark::State& state)
+{
+	PieceTable document(CreateText(state.range(0)));
+
+	for (auto _ : state)
+	{
+		GraphemeIndex index(document);
+		benchmark::DoNotOptimize(index.GetClusterCount());
+	}
+}
+BENCHMARK(GraphemeIndex_Full)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
\ No newline at end of file
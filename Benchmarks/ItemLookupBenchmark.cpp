@@ -0,0 +1,81 @@
+#include "ItemLookup.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	constexpr size_t Count = 1000000;
+
+	struct Entry
+	{
+		int Id;
+		std::string Value;
+		bool Tabulated = false;
+		bool Visible = true;
+		bool Selected = false;
+	};
+
+	ItemStore CreateItems()
+	{
+		std::vector<Entry> entries(Count);
+		for (size_t i = 0; i < Count; ++i) entries[i] = { static_cast<int>(i), "Item number " + std::to_string(i) };
+
+		ItemStore ret;
+		ret.Assign(entries.begin(), entries.end());
+
+		return ret;
+	}
+}
+
+static void ItemLookup_Find(benchmark::State& state)
+{
+	const auto items = CreateItems();
+	ItemLookup lookup(items);
+	std::mt19937 random(46);
+
+	for (auto _ : state)
+	{
+		const size_t index = random() % Count;
+		benchmark::DoNotOptimize(lookup.Find(items.GetId(index), items.GetValue(index)));
+	}
+}
+BENCHMARK(ItemLookup_Find);
+
+// What the first lookup after a change cost when the index was dropped
+static void ItemLookup_Build(benchmark::State& state)
+{
+	const auto items = CreateItems();
+	ItemLookup lookup(items);
+
+	for (auto _ : state)
+	{
+		lookup.Clear();
+		benchmark::DoNotOptimize(lookup.FindId(0));
+	}
+}
+BENCHMARK(ItemLookup_Build)->Unit(benchmark::kMillisecond);
+
+// An item inserted and another removed in the middle, each followed by a lookup
+static void ItemLookup_InsertAndErase(benchmark::State& state)
+{
+	auto items = CreateItems();
+	ItemLookup lookup(items);
+	std::mt19937 random(46);
+	const std::vector<Entry> added = { { -1, "New item" } };
+
+	for (auto _ : state)
+	{
+		const size_t index = random() % items.GetCount();
+		items.Insert(index, added.begin(), added.end());
+		lookup.OnInsert(index, 1);
+		benchmark::DoNotOptimize(lookup.FindId(-1));
+
+		lookup.OnErasing(index, 1);
+		items.Erase(index, 1);
+		benchmark::DoNotOptimize(lookup.FindValue("Item number 5"));
+	}
+}
+BENCHMARK(ItemLookup_InsertAndErase)->Unit(benchmark::kMillisecond);
\ No newline at end of file
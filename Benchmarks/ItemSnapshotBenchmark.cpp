@@ -0,0 +1,59 @@
+#include "ItemSnapshot.h"
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+	constexpr size_t Count = 1000000;
+
+	struct Entry
+	{
+		int Id;
+		std::string Value;
+		bool Tabulated = false;
+		bool Visible = true;
+		bool Selected = false;
+	};
+
+	std::shared_ptr<const ItemSnapshot> CreateSnapshot()
+	{
+		std::vector<Entry> entries(Count);
+		for (size_t i = 0; i < Count; ++i) entries[i] = { static_cast<int>(i), "Item number " + std::to_string(i) };
+
+		ItemSnapshot::Builder builder;
+		builder.Add(entries.begin(), entries.end());
+
+		return builder.Build();
+	}
+}
+
+// A producer appending a batch of 100 items to a million, the full chunks are shared
+static void ItemSnapshot_Append(benchmark::State& state)
+{
+	auto snapshot = CreateSnapshot();
+	const std::vector<Entry> entries(100, Entry{ -1, "Appended item" });
+
+	for (auto _ : state)
+	{
+		ItemSnapshot::Builder builder(*snapshot, snapshot->GetCount());
+		builder.Add(entries.begin(), entries.end());
+		snapshot = builder.Build();
+	}
+}
+BENCHMARK(ItemSnapshot_Append);
+
+// Reading the rows of a paint
+static void ItemSnapshot_Read(benchmark::State& state)
+{
+	const auto snapshot = CreateSnapshot();
+	size_t first = 0;
+
+	for (auto _ : state)
+	{
+		for (size_t i = first; i < first + 40; ++i) benchmark::DoNotOptimize(snapshot->GetValue(i));
+		first = (first + 7919) % (Count - 40);
+	}
+}
+BENCHMARK(ItemSnapshot_Read);
\ No newline at end of file
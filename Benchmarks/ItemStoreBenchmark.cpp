@@ -0,0 +1,74 @@
+#include "ItemStore.h"
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+	constexpr size_t Count = 1000000;
+
+	struct Entry
+	{
+		int Id;
+		std::string Value;
+		bool Tabulated = false;
+		bool Visible = true;
+		bool Selected = false;
+	};
+
+	std::vector<Entry> CreateEntries()
+	{
+		std::vector<Entry> ret(Count);
+
+		for (size_t i = 0; i < Count; ++i) ret[i] = { static_cast<int>(i), "Item number " + std::to_string(i) };
+
+		return ret;
+	}
+}
+
+static void ItemStore_Assign(benchmark::State& state)
+{
+	const auto entries = CreateEntries();
+
+	for (auto _ : state)
+	{
+		ItemStore store;
+		store.Assign(entries.begin(), entries.end());
+		benchmark::DoNotOptimize(store.GetTextCapacity());
+	}
+}
+BENCHMARK(ItemStore_Assign)->Unit(benchmark::kMillisecond);
+
+// Reading every value, as a search or a copy of the whole list does
+static void ItemStore_Walk(benchmark::State& state)
+{
+	const auto entries = CreateEntries();
+	ItemStore store;
+	store.Assign(entries.begin(), entries.end());
+
+	for (auto _ : state)
+	{
+		size_t length = 0;
+		for (const auto item : store) length += item.Value.size();
+		benchmark::DoNotOptimize(length);
+	}
+}
+BENCHMARK(ItemStore_Walk)->Unit(benchmark::kMillisecond);
+
+// GetDataSource used to copy the items into a vector of ListItem every call
+static void ItemStore_CopyToVector(benchmark::State& state)
+{
+	const auto entries = CreateEntries();
+	ItemStore store;
+	store.Assign(entries.begin(), entries.end());
+
+	for (auto _ : state)
+	{
+		std::vector<Entry> copy;
+		copy.reserve(store.GetCount());
+		for (const auto item : store) copy.push_back({ item.Id, std::string(item.Value), item.Tabulated, item.Visible, item.Selected });
+		benchmark::DoNotOptimize(copy.data());
+	}
+}
+BENCHMARK(ItemStore_CopyToVector)->Unit(benchmark::kMillisecond);
\ No newline at end of file
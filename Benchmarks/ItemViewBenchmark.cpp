@@ -0,0 +1,149 @@
+#include "ItemView.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	constexpr size_t Count = 1000000;
+
+	std::vector<int> CreateValues()
+	{
+		std::mt19937 random(41);
+		std::vector<int> ret(Count);
+
+		for (auto& value : ret) value = static_cast<int>(random() % 100000);
+
+		return ret;
+	}
+
+	// 12 random lowercase characters per item
+	std::vector<std::string> CreateStrings()
+	{
+		std::mt19937 random(42);
+		std::vector<std::string> ret(Count);
+
+		for (auto& value : ret)
+		{
+			for (int i = 0; i < 12; ++i) value += static_cast<char>('a' + random() % 26);
+		}
+
+		return ret;
+	}
+
+	ItemView::Predicate StartsWith(const std::vector<std::string>& values, const std::string& prefix)
+	{
+		return [&values, prefix](size_t index) { return values[index].starts_with(prefix); };
+	}
+}
+
+static void ItemView_Sort(benchmark::State& state)
+{
+	const auto values = CreateValues();
+	ItemView view;
+	view.Reset(values.size());
+
+	for (auto _ : state)
+	{
+		view.Sort([&](size_t a, size_t b) { return values[a] < values[b]; });
+	}
+}
+BENCHMARK(ItemView_Sort)->Unit(benchmark::kMillisecond);
+
+// Renaming an item of a sorted list, it moves to the place of its new value
+static void ItemView_Update(benchmark::State& state)
+{
+	auto values = CreateValues();
+	ItemView view;
+	view.Reset(values.size());
+	view.Sort([&](size_t a, size_t b) { return values[a] < values[b]; });
+	std::mt19937 random(41);
+
+	for (auto _ : state)
+	{
+		const size_t index = random() % Count;
+
+		view.OnUpdating(index);
+		values[index] = static_cast<int>(random() % 100000);
+		benchmark::DoNotOptimize(view.OnUpdated(index));
+	}
+}
+BENCHMARK(ItemView_Update);
+
+// The same rename as an erase and an insert, the way updates were placed before
+static void ItemView_UpdateAsEraseAndInsert(benchmark::State& state)
+{
+	auto values = CreateValues();
+	ItemView view;
+	view.Reset(values.size());
+	view.Sort([&](size_t a, size_t b) { return values[a] < values[b]; });
+	std::mt19937 random(41);
+
+	for (auto _ : state)
+	{
+		const size_t index = random() % Count;
+
+		values[index] = static_cast<int>(random() % 100000);
+		view.OnErase(index, 1);
+		benchmark::DoNotOptimize(view.OnInsert(index, 1));
+	}
+}
+BENCHMARK(ItemView_UpdateAsEraseAndInsert)->Unit(benchmark::kMillisecond);
+
+// Appending an item to a sorted and filtered list
+static void ItemView_Append(benchmark::State& state)
+{
+	auto values = CreateValues();
+	ItemView view;
+	view.Reset(values.size());
+	view.Sort([&](size_t a, size_t b) { return values[a] < values[b]; });
+	view.Filter([&](size_t index) { return values[index] % 2 == 0; });
+	std::mt19937 random(41);
+
+	for (auto _ : state)
+	{
+		values.push_back(static_cast<int>(random() % 100000));
+		benchmark::DoNotOptimize(view.OnInsert(values.size() - 1, 1));
+	}
+}
+BENCHMARK(ItemView_Append);
+
+// Type-ahead filter on the first character, every item is checked
+static void ItemView_Filter(benchmark::State& state)
+{
+	const auto values = CreateStrings();
+	ItemView view;
+	view.Reset(values.size());
+
+	for (auto _ : state)
+	{
+		view.Filter(StartsWith(values, "a"));
+	}
+
+	state.counters["Rows"] = static_cast<double>(view.GetCount());
+}
+BENCHMARK(ItemView_Filter)->Unit(benchmark::kMillisecond);
+
+// Next characters typed ("ab", "abc", "abcd"), only the rows of the previous prefix are checked. The iterations are
+// fixed because each one filters the previous prefix again, out of the timing
+static void ItemView_Narrow(benchmark::State& state)
+{
+	const auto values = CreateStrings();
+	const std::string prefix = std::string("abcd").substr(0, state.range(0));
+	ItemView view;
+	view.Reset(values.size());
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		view.Filter(StartsWith(values, prefix.substr(0, prefix.size() - 1)));
+		state.ResumeTiming();
+
+		view.Narrow(StartsWith(values, prefix));
+	}
+
+	state.counters["Rows"] = static_cast<double>(view.GetCount());
+}
+BENCHMARK(ItemView_Narrow)->Arg(2)->Arg(3)->Arg(4)->Iterations(50)->Unit(benchmark::kMicrosecond);
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include "Layout.h"
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+using namespace Layout;
+
+namespace
+{
+	// 100 docked panels (flow and grid) of 1000 leaves each in a 1920x1080 window
+	struct LargeTree
+	{
+		std::vector<std::unique_ptr<Node>> Nodes;
+
+		LargeTree()
+		{
+			Nodes.push_back(std::make_unique<Node>());
+			Nodes[0]->SetSize(1920, 1080);
+
+			constexpr DockStyle Docks[] = { DockStyle::Top, DockStyle::Left, DockStyle::Right, DockStyle::Bottom };
+
+			for (int i = 0; i < 100; ++i)
+			{
+				auto& panel = Nodes.emplace_back(std::make_unique<Node>());
+				Nodes[0]->Add(panel.get());
+				panel->SetDock(Docks[i % 4]);
+				panel->SetSize(20, 10);
+				panel->SetPanelType(i % 2 ? PanelType::Flow : PanelType::Grid);
+				panel->SetColumns({ { SizeType::AutoSize, 0 }, { SizeType::Percent, 40 }, { SizeType::Absolute, 50 }, { SizeType::Percent, 60 } });
+				panel->SetRows({ { SizeType::Percent, 100 }, { SizeType::AutoSize, 0 } });
+
+				Node* parent = panel.get();
+
+				for (int j = 0; j < 1000; ++j)
+				{
+					auto& leaf = Nodes.emplace_back(std::make_unique<Node>());
+					parent->Add(leaf.get());
+					leaf->SetSize(30, 12);
+					leaf->SetMargin(Thickness{ 1, 1, 1, 1 });
+					leaf->SetCell(j % 2, j % 4);
+				}
+			}
+		}
+	};
+}
+
+static void Layout_Full(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		auto tree = std::make_unique<LargeTree>();
+		state.ResumeTiming();
+
+		tree->Nodes[0]->UpdateLayout();
+
+		state.PauseTiming();
+		tree.reset();
+		state.ResumeTiming();
+	}
+}
+BENCHMARK(Layout_Full)->Unit(benchmark::kMillisecond);
+
+static void Layout_ResizeLeaf(benchmark::State& state)
+{
+	LargeTree tree;
+	tree.Nodes[0]->UpdateLayout();
+	int width = 30;
+
+	for (auto _ : state)
+	{
+		width = width == 30 ? 40 : 30;
+		tree.Nodes[5000]->SetSize(width, 12);
+		tree.Nodes[0]->UpdateLayout();
+	}
+}
+BENCHMARK(Layout_ResizeLeaf)->Unit(benchmark::kMicrosecond);
+
+static void Layout_ResizeWindow(benchmark::State& state)
+{
+	LargeTree tree;
+	tree.Nodes[0]->UpdateLayout();
+	int width = 1920;
+
+	for (auto _ : state)
+	{
+		width = width == 1920 ? 1921 : 1920;
+		tree.Nodes[0]->SetSize(width, 1080);
+		tree.Nodes[0]->UpdateLayout();
+	}
+}
+BENCHMARK(Layout_ResizeWindow)->Unit(benchmark::kMicrosecond);
\ No newline at end of file
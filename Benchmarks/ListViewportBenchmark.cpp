@@ -0,0 +1,95 @@
+#include "ListViewport.h"
+#include "IListDataProvider.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	class GeneratedProvider final : public IListDataProvider
+	{
+	private:
+
+		size_t m_Count;
+
+	public:
+
+		explicit GeneratedProvider(size_t count) : m_Count(count) {}
+
+		size_t GetCount() const override { return m_Count; }
+
+		void GetText(size_t first, std::span<std::string> text) const override
+		{
+			for (size_t i = 0; i < text.size(); ++i)
+			{
+				text[i].assign("Item ");
+				text[i].append(std::to_string(first + i));
+			}
+		}
+	};
+}
+
+// One paint of a virtual list of 10M items scrolled anywhere: fetching the 40 visible rows, their bounds and a hit test
+static void ListViewport_VirtualFrame(benchmark::State& state)
+{
+	constexpr size_t Count = 10000000;
+	GeneratedProvider provider(Count);
+	ListViewport viewport;
+	viewport.SetArea(2, 2, 302, 2 + 16 * 40);
+	viewport.SetItemSize(300, 16, 3);
+	viewport.SetRowNumber(Count);
+	viewport.SetCount(provider.GetCount());
+
+	std::vector<std::string> text;
+	std::mt19937 random(39);
+
+	for (auto _ : state)
+	{
+		viewport.SetScrolling(random() % Count, 0);
+
+		const auto [first, last] = viewport.GetVisibleRange();
+		text.resize(last - first);
+		provider.GetText(first, text);
+
+		for (size_t i = first; i < last; ++i)
+		{
+			if (viewport.IsVisible(i)) benchmark::DoNotOptimize(viewport.GetBounds(i));
+		}
+
+		benchmark::DoNotOptimize(viewport.GetIndexFromPoint(10, 2 + static_cast<int>(random() % 600)));
+	}
+}
+BENCHMARK(ListViewport_VirtualFrame);
+
+// Same frame with one height per row
+static void ListViewport_VariableFrame(benchmark::State& state)
+{
+	constexpr size_t Count = 1000000;
+	std::mt19937 random(39);
+	std::vector<int> heights(Count);
+	for (auto& height : heights) height = 14 + random() % 20;
+
+	RowHeightIndex index;
+	index.Reset(std::move(heights));
+
+	ListViewport viewport;
+	viewport.SetArea(2, 2, 302, 2 + 16 * 40);
+	viewport.SetItemSize(300, 16, 3);
+	viewport.SetRowNumber(Count);
+	viewport.SetCount(Count);
+	viewport.SetRowHeights(&index);
+
+	for (auto _ : state)
+	{
+		viewport.SetScrolling(random() % Count, 0);
+
+		const auto [first, last] = viewport.GetVisibleRange();
+
+		for (size_t i = first; i < last; ++i) benchmark::DoNotOptimize(viewport.GetBounds(i));
+
+		benchmark::DoNotOptimize(viewport.GetIndexFromPoint(10, 2 + static_cast<int>(random() % 600)));
+	}
+}
+BENCHMARK(ListViewport_VariableFrame);
\ No newline at end of file
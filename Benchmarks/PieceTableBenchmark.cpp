@@ -0,0 +1,72 @@
+#include "PieceTable.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+
+namespace
+{
+	// 8 MB document of 60 character lines
+	const std::string& GetDocument()
+	{
+		static const std::string document = []
+		{
+			std::mt19937 random(33);
+			std::string ret;
+			ret.reserve(8 << 20);
+
+			while (ret.size() < (8u << 20))
+			{
+				for (int i = 0; i < 60; ++i) ret += static_cast<char>('a' + random() % 26);
+				ret += '\n';
+			}
+
+			return ret;
+		}();
+
+		return document;
+	}
+}
+
+static void PieceTable_RandomEdit(benchmark::State& state)
+{
+	PieceTable table(GetDocument());
+	std::mt19937 random(33);
+
+	for (auto _ : state)
+	{
+		const size_t offset = random() % table.GetLength();
+		table.Insert(offset, "x");
+		table.Erase(offset / 2, 1);
+	}
+}
+BENCHMARK(PieceTable_RandomEdit);
+
+// Same edits on a plain string, as TextBox did before
+static void PieceTable_RandomEditString(benchmark::State& state)
+{
+	std::string text = GetDocument();
+	std::mt19937 random(33);
+
+	for (auto _ : state)
+	{
+		const size_t offset = random() % text.size();
+		text.insert(offset, 1, 'x');
+		text.erase(offset / 2, 1);
+	}
+}
+BENCHMARK(PieceTable_RandomEditString);
+
+static void PieceTable_GetLineFromOffset(benchmark::State& state)
+{
+	PieceTable table(GetDocument());
+	std::mt19937 random(33);
+
+	for (int i = 0; i < 10000; ++i) table.Insert(random() % table.GetLength(), "y");
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(table.GetLineFromOffset(random() % table.GetLength()));
+	}
+}
+BENCHMARK(PieceTable_GetLineFromOffset);
\ No newline at end of file
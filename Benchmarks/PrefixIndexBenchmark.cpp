@@ -0,0 +1,123 @@
+#include "PrefixIndex.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	constexpr size_t Count = 500000;
+
+	std::vector<std::string> CreateValues()
+	{
+		const char* syllables[] = { "ka", "lo", "mi", "ne", "ru", "sa", "to", "vi", "be", "do", "fu", "ga" };
+		std::mt19937 random(44);
+		std::vector<std::string> ret(Count);
+
+		for (size_t i = 0; i < Count; ++i)
+		{
+			for (size_t j = 2 + random() % 4; j > 0; --j) ret[i] += syllables[random() % 12];
+			ret[i][0] = static_cast<char>(ret[i][0] - 'a' + 'A');
+			ret[i] += " " + std::to_string(i);
+		}
+
+		return ret;
+	}
+}
+
+// Time the UI thread is held by Build before the sorting goes to the background
+static void PrefixIndex_Build(benchmark::State& state)
+{
+	const auto values = CreateValues();
+
+	for (auto _ : state)
+	{
+		PrefixIndex index;
+		index.Build(values);
+
+		state.PauseTiming();
+		index.WaitForBuild();
+		state.ResumeTiming();
+	}
+}
+BENCHMARK(PrefixIndex_Build)->Unit(benchmark::kMillisecond);
+
+static void PrefixIndex_Find(benchmark::State& state)
+{
+	PrefixIndex index;
+	index.Build(CreateValues());
+	index.WaitForBuild();
+	std::vector<size_t> matches(10);
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(index.Find("kalo", matches));
+	}
+}
+BENCHMARK(PrefixIndex_Find);
+
+// Same query while the index is sorted in the background
+static void PrefixIndex_Scan(benchmark::State& state)
+{
+	const auto values = CreateValues();
+	std::vector<size_t> matches(10);
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		PrefixIndex index;
+		index.Build(values);
+		state.ResumeTiming();
+
+		benchmark::DoNotOptimize(index.Find("kalo", matches));
+
+		state.PauseTiming();
+		index.WaitForBuild();
+		state.ResumeTiming();
+	}
+}
+BENCHMARK(PrefixIndex_Scan)->Unit(benchmark::kMillisecond);
+
+static void PrefixIndex_InsertAtFront(benchmark::State& state)
+{
+	PrefixIndex index;
+	index.Build(CreateValues());
+	index.WaitForBuild();
+	const std::vector<std::string> added = { "Kalo new" };
+
+	for (auto _ : state)
+	{
+		index.Insert(0, added);
+	}
+}
+BENCHMARK(PrefixIndex_InsertAtFront);
+
+static void PrefixIndex_Update(benchmark::State& state)
+{
+	PrefixIndex index;
+	index.Build(CreateValues());
+	index.WaitForBuild();
+	std::mt19937 random(44);
+
+	for (auto _ : state)
+	{
+		index.Update(random() % Count, "Sasa updated");
+	}
+}
+BENCHMARK(PrefixIndex_Update);
+
+static void PrefixIndex_EraseAndInsert(benchmark::State& state)
+{
+	PrefixIndex index;
+	index.Build(CreateValues());
+	index.WaitForBuild();
+	const std::vector<std::string> added = { "Vito back" };
+
+	for (auto _ : state)
+	{
+		index.Erase(10, 1);
+		index.Insert(10, added);
+	}
+}
+BENCHMARK(PrefixIndex_EraseAndInsert);
\ No newline at end of file
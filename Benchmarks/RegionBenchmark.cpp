@@ -0,0 +1,126 @@
+#include "Region.h"
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using Drawing::Region;
+
+namespace
+{
+	struct Rect
+	{
+		int X;
+		int Y;
+		int Width;
+		int Height;
+
+		Rect(int x, int y, int width, int height) : X(x), Y(y), Width(width), Height(height) {}
+
+		// Drawing::Rectangle::Union, which can't be used without the Windows headers
+		static Rect Union(const Rect& lhs, const Rect& rhs)
+		{
+			const int x1 = (std::min)(lhs.X, rhs.X);
+			const int x2 = (std::max)(lhs.X + lhs.Width, rhs.X + rhs.Width);
+			const int y1 = (std::min)(lhs.Y, rhs.Y);
+			const int y2 = (std::max)(lhs.Y + lhs.Height, rhs.Y + rhs.Height);
+
+			return Rect(x1, y1, x2 - x1, y2 - y1);
+		}
+	};
+
+	// Small invalidations (ex: hovered rows, caret) anywhere in a full HD window
+	std::vector<Rect> CreateUpdates(int64_t count)
+	{
+		std::mt19937 random(27);
+		std::vector<Rect> ret;
+
+		for (int64_t i = 0; i < count; ++i) ret.emplace_back(random() % 1920, random() % 1080, 16, 16);
+
+		return ret;
+	}
+
+	int64_t GetArea(const Region& region)
+	{
+		int64_t ret = 0;
+		region.ForEach([&](int, int, int width, int height) { ret += static_cast<int64_t>(width) * height; });
+		return ret;
+	}
+
+	int64_t GetDamagedArea(const std::vector<Rect>& updates)
+	{
+		Region exact;
+		for (const auto& r : updates) exact.Union(r);
+		return GetArea(exact);
+	}
+}
+
+// Damage of small invalidations (ex: hovered rows, caret) accumulated over a full HD window, simplified like the
+// paint path does when it gets too fragmented. Covered is the area repainted, Damaged the area really invalidated
+static void Region_AccumulateDamage(benchmark::State& state)
+{
+	const auto updates = CreateUpdates(state.range(0));
+	Region damage;
+
+	for (auto _ : state)
+	{
+		damage.MakeEmpty();
+
+		for (const auto& r : updates)
+		{
+			damage.Union(r);
+
+			if (damage.GetRectangleCount() > 64) damage.Simplify(16);
+		}
+
+		benchmark::DoNotOptimize(damage);
+	}
+
+	state.SetItemsProcessed(state.iterations() * updates.size());
+	state.counters["Covered"] = static_cast<double>(GetArea(damage));
+	state.counters["Damaged"] = static_cast<double>(GetDamagedArea(updates));
+}
+BENCHMARK(Region_AccumulateDamage)->Arg(10)->Arg(100)->Arg(1000);
+
+// Same updates merged in their bounding box, like Rectangle::Union
+static void Region_AccumulateBoundingBox(benchmark::State& state)
+{
+	const auto updates = CreateUpdates(state.range(0));
+	Rect bounds(0, 0, 0, 0);
+
+	for (auto _ : state)
+	{
+		bounds = updates.front();
+
+		for (const auto& r : updates) bounds = Rect::Union(bounds, r);
+
+		benchmark::DoNotOptimize(bounds);
+	}
+
+	state.SetItemsProcessed(state.iterations() * updates.size());
+	state.counters["Covered"] = static_cast<double>(bounds.Width) * bounds.Height;
+	state.counters["Damaged"] = static_cast<double>(GetDamagedArea(updates));
+}
+BENCHMARK(Region_AccumulateBoundingBox)->Arg(10)->Arg(100)->Arg(1000);
+
+// Check done by OnPaint to know if the system update rectangle is covered by the partial damage
+static void Region_SubtractFromUpdate(benchmark::State& state)
+{
+	std::mt19937 random(2027);
+	Region damage;
+
+	for (int i = 0; i < state.range(0); ++i)
+	{
+		damage.Union(Rect(random() % 1920, random() % 1080, 24, 24));
+	}
+
+	for (auto _ : state)
+	{
+		Region update(0, 0, 1920, 1080);
+		update.Subtract(damage);
+		benchmark::DoNotOptimize(update);
+	}
+}
+BENCHMARK(Region_SubtractFromUpdate)->Arg(4)->Arg(16)->Arg(64);
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include "RowCache.h"
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+
+namespace
+{
+	// Rows of a 400x640 list
+	constexpr int Width = 400;
+	constexpr int Height = 16;
+	constexpr size_t Rows = 40;
+}
+
+// A paint after a selection change, every row is copied from the cache
+static void RowCache_WarmPaint(benchmark::State& state)
+{
+	RowCache cache;
+	for (size_t i = 0; i < Rows; ++i) cache.Add({ i, 0, 1, Width, Height });
+
+	for (auto _ : state)
+	{
+		for (size_t i = 0; i < Rows; ++i) benchmark::DoNotOptimize(cache.Find({ i, 0, 1, Width, Height }));
+	}
+}
+BENCHMARK(RowCache_WarmPaint);
+
+// A paint of rows never drawn, each one takes the pixels of an evicted row
+static void RowCache_ColdPaint(benchmark::State& state)
+{
+	RowCache cache;
+	size_t item = 0;
+
+	for (auto _ : state)
+	{
+		for (size_t i = 0; i < Rows; ++i)
+		{
+			auto* surface = cache.Add({ item++, 0, 1, Width, Height });
+			std::fill(surface->Pixels.begin(), surface->Pixels.end(), 0xFFFFFFu);
+		}
+	}
+}
+BENCHMARK(RowCache_ColdPaint);
+
+// An item inserted above the rows of a full cache
+static void RowCache_Insert(benchmark::State& state)
+{
+	RowCache cache;
+	for (size_t i = 0; i < RowCache::DefaultBudget / (Width * Height); ++i) cache.Add({ i, 0, 1, Width, Height });
+
+	for (auto _ : state)
+	{
+		cache.OnInsert(0, 1);
+		cache.OnErase(0, 1);
+	}
+}
+BENCHMARK(RowCache_Insert);
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include "RowHeightIndex.h"
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+	constexpr size_t Count = 1000000;
+
+	RowHeightIndex CreateIndex()
+	{
+		std::mt19937 random(45);
+		std::vector<int> heights(Count);
+		for (auto& height : heights) height = 14 + random() % 40;
+
+		RowHeightIndex ret;
+		ret.Reset(std::move(heights));
+
+		return ret;
+	}
+}
+
+static void RowHeightIndex_SetHeight(benchmark::State& state)
+{
+	auto index = CreateIndex();
+	std::mt19937 random(45);
+
+	for (auto _ : state)
+	{
+		index.SetHeight(random() % Count, 14 + random() % 40);
+	}
+}
+BENCHMARK(RowHeightIndex_SetHeight);
+
+static void RowHeightIndex_GetOffset(benchmark::State& state)
+{
+	const auto index = CreateIndex();
+	std::mt19937 random(45);
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(index.GetOffset(random() % Count));
+	}
+}
+BENCHMARK(RowHeightIndex_GetOffset);
+
+static void RowHeightIndex_GetRow(benchmark::State& state)
+{
+	const auto index = CreateIndex();
+	std::mt19937_64 random(45);
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(index.GetRow(static_cast<long long>(random() % index.GetTotal())));
+	}
+}
+BENCHMARK(RowHeightIndex_GetRow);
+
+// An item of a sorted list renamed to a close value (Arg 0) or anywhere (Arg 1)
+static void RowHeightIndex_Move(benchmark::State& state)
+{
+	auto index = CreateIndex();
+	std::mt19937 random(45);
+	const size_t distance = state.range(0) == 0 ? 100 : Count;
+
+	for (auto _ : state)
+	{
+		const size_t from = random() % Count;
+		const size_t to = (std::min)(Count - 1, from + random() % distance);
+		index.Move(from, to);
+	}
+}
+BENCHMARK(RowHeightIndex_Move)->Arg(0)->Arg(1);
+
+static void RowHeightIndex_Insert(benchmark::State& state)
+{
+	auto index = CreateIndex();
+	std::mt19937 random(45);
+	const std::vector<int> heights = { 20 };
+
+	for (auto _ : state)
+	{
+		index.Insert(random() % index.GetCount(), heights);
+		index.Erase(random() % index.GetCount(), 1);
+	}
+}
+BENCHMARK(RowHeightIndex_Insert)->Unit(benchmark::kMillisecond);
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include "SelectionModel.h"
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <random>
+
+namespace
+{
+	constexpr size_t Count = 1000000;
+}
+
+// Ctrl+click anywhere in a list of 1M items holding a scattered selection
+static void SelectionModel_Toggle(benchmark::State& state)
+{
+	SelectionModel model;
+	std::mt19937 random(40);
+
+	for (size_t i = 0; i < Count / 2; ++i) model.Toggle(random() % Count);
+
+	for (auto _ : state) model.Toggle(random() % Count);
+}
+BENCHMARK(SelectionModel_Toggle);
+
+// Toggling after select all, where a list of selected indices has to find and remove each one
+static void SelectionModel_ToggleAfterSelectAll(benchmark::State& state)
+{
+	SelectionModel model;
+	model.SelectAll(Count);
+	std::mt19937 random(40);
+
+	for (auto _ : state) model.Toggle(random() % Count);
+}
+BENCHMARK(SelectionModel_ToggleAfterSelectAll);
+
+static void SelectionModel_IsSelected(benchmark::State& state)
+{
+	SelectionModel model;
+	std::mt19937 random(40);
+
+	for (size_t i = 0; i < Count / 2; ++i) model.Toggle(random() % Count);
+
+	for (auto _ : state) benchmark::DoNotOptimize(model.IsSelected(random() % Count));
+}
+BENCHMARK(SelectionModel_IsSelected);
+
+static void SelectionModel_ShiftClick(benchmark::State& state)
+{
+	SelectionModel model;
+	std::mt19937 random(40);
+
+	for (auto _ : state)
+	{
+		const size_t a = random() % Count;
+		const size_t b = random() % Count;
+
+		model.Clear();
+		model.SelectRange((std::min)(a, b), (std::max)(a, b) + 1, true);
+	}
+}
+BENCHMARK(SelectionModel_ShiftClick);
+
+static void SelectionModel_SelectAllAndClear(benchmark::State& state)
+{
+	SelectionModel model;
+
+	for (auto _ : state)
+	{
+		model.SelectAll(Count);
+		model.Clear();
+	}
+}
+BENCHMARK(SelectionModel_SelectAllAndClear);
+
+// Inserting an item at the top of a list with a scattered selection moves every range
+static void SelectionModel_InsertAtTop(benchmark::State& state)
+{
+	SelectionModel model;
+	std::mt19937 random(40);
+
+	for (int64_t i = 0; i < state.range(0); ++i) model.Select(random() % Count, true);
+
+	for (auto _ : state)
+	{
+		model.Insert(0, 1);
+		model.Erase(0, 1);
+	}
+}
+BENCHMARK(SelectionModel_InsertAtTop)->Arg(100)->Arg(10000);
+
+// Appending rows below a scattered selection (InsertItems at the end of a log view) moves no range
+static void SelectionModel_Append(benchmark::State& state)
+{
+	SelectionModel model;
+	std::mt19937 random(41);
+	size_t count = Count;
+
+	for (int i = 0; i < 1000; ++i) model.Select(random() % Count, true);
+
+	for (auto _ : state) model.Insert(count++, 1);
+}
+BENCHMARK(SelectionModel_Append);
+
+// RemoveRange of 10 rows in the middle of a list with 1000 selected rows
+static void SelectionModel_EraseInMiddle(benchmark::State& state)
+{
+	SelectionModel model;
+	std::mt19937 random(41);
+
+	for (int i = 0; i < 1000; ++i) model.Select(random() % Count, true);
+
+	for (auto _ : state)
+	{
+		const size_t index = random() % (Count - 10);
+
+		model.Erase(index, 10);
+		model.Insert(index, 10);
+	}
+}
+BENCHMARK(SelectionModel_EraseInMiddle);
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include "SpatialGrid.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+
+namespace
+{
+	// 10000 controls of 36x26 pixels in a 4000x3000 window
+	SpatialGrid<int> CreateGrid()
+	{
+		SpatialGrid<int> grid;
+
+		for (int i = 0; i < 10000; ++i)
+		{
+			grid.Update(i, (i % 100) * 40, (i / 100) * 30, 36, 26);
+		}
+
+		return grid;
+	}
+}
+
+static void SpatialGrid_QueryPoint(benchmark::State& state)
+{
+	auto grid = CreateGrid();
+	std::mt19937 random(28);
+
+	for (auto _ : state)
+	{
+		int hits = 0;
+		grid.QueryPoint(random() % 4000, random() % 3000, [&](int) { ++hits; });
+		benchmark::DoNotOptimize(hits);
+	}
+}
+BENCHMARK(SpatialGrid_QueryPoint);
+
+// Former hit test: every control checked against the point
+static void SpatialGrid_QueryPointLinear(benchmark::State& state)
+{
+	struct Bounds { int X, Y, Width, Height; };
+	std::vector<Bounds> bounds;
+	std::mt19937 random(28);
+
+	for (int i = 0; i < 10000; ++i)
+	{
+		bounds.push_back(Bounds{ (i % 100) * 40, (i / 100) * 30, 36, 26 });
+	}
+
+	for (auto _ : state)
+	{
+		const int x = random() % 4000;
+		const int y = random() % 3000;
+		int hits = 0;
+
+		for (const auto& b : bounds)
+		{
+			if (b.X <= x && x < b.X + b.Width && b.Y <= y && y < b.Y + b.Height) ++hits;
+		}
+
+		benchmark::DoNotOptimize(hits);
+	}
+}
+BENCHMARK(SpatialGrid_QueryPointLinear);
+
+static void SpatialGrid_Move(benchmark::State& state)
+{
+	auto grid = CreateGrid();
+	std::mt19937 random(28);
+
+	for (auto _ : state)
+	{
+		grid.Update(random() % 10000, random() % 3960, random() % 2970, 36, 26);
+	}
+}
+BENCHMARK(SpatialGrid_Move);
+
+static void SpatialGrid_QueryRectangle(benchmark::State& state)
+{
+	auto grid = CreateGrid();
+	std::mt19937 random(28);
+
+	for (auto _ : state)
+	{
+		int hits = 0;
+		grid.QueryRectangle(random() % 3700, random() % 2800, 300, 200, [&](int) { ++hits; });
+		benchmark::DoNotOptimize(hits);
+	}
+}
+BENCHMARK(SpatialGrid_QueryRectangle);
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include "TabOrder.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+
+namespace
+{
+	constexpr int Count = 10000;
+
+	// A window of 10000 tab stops, one in ten of them disabled
+	TabOrder<int> CreateOrder()
+	{
+		TabOrder<int> ret;
+
+		for (int i = 1; i <= Count; ++i) ret.Update(i, ret.GetNextIndex(), i % 10 != 0);
+
+		return ret;
+	}
+}
+
+// Pressing Tab through the whole window
+static void TabOrder_Next(benchmark::State& state)
+{
+	const auto order = CreateOrder();
+	int item = 1;
+
+	for (auto _ : state)
+	{
+		item = order.GetNext(item, [](int) { return true; });
+	}
+
+	benchmark::DoNotOptimize(item);
+}
+BENCHMARK(TabOrder_Next);
+
+// Enabling and disabling a control, or moving it to another tab index
+static void TabOrder_Update(benchmark::State& state)
+{
+	auto order = CreateOrder();
+	std::mt19937 random(50);
+
+	for (auto _ : state)
+	{
+		order.Update(1 + random() % Count, random() % Count, random() % 2 == 0);
+	}
+}
+BENCHMARK(TabOrder_Update);
+
+// A control created then deleted
+static void TabOrder_AddAndRemove(benchmark::State& state)
+{
+	auto order = CreateOrder();
+
+	for (auto _ : state)
+	{
+		order.Update(Count + 1, order.GetNextIndex(), true);
+		order.Remove(Count + 1);
+	}
+}
+BENCHMARK(TabOrder_AddAndRemove);
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include "TextMeasurer.h"
+#include "DeterministicTextMetrics.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	const FontDescriptor Regular{ "Segoe", 12, false, false };
+
+	// 1000 random words of 24 characters
+	std::vector<std::string> CreateWords()
+	{
+		std::vector<std::string> words;
+		std::mt19937 random(31);
+
+		for (int i = 0; i < 1000; ++i)
+		{
+			std::string word;
+			for (int j = 0; j < 24; ++j) word += static_cast<char>('a' + random() % 26);
+			words.push_back(word);
+		}
+
+		return words;
+	}
+}
+
+static void TextMeasurer_Advances(benchmark::State& state)
+{
+	TextMeasurer measurer(std::make_unique<DeterministicTextMetrics>(false));
+	const auto words = CreateWords();
+	size_t i = 0;
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(measurer.MeasureWidth(Regular, words[i++ % words.size()]));
+	}
+}
+BENCHMARK(TextMeasurer_Advances);
+
+static void TextMeasurer_KerningCache(benchmark::State& state)
+{
+	TextMeasurer measurer(std::make_unique<DeterministicTextMetrics>(true));
+	const auto words = CreateWords();
+	size_t i = 0;
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(measurer.MeasureWidth(Regular, words[i++ % words.size()]));
+	}
+}
+BENCHMARK(TextMeasurer_KerningCache);
+
+// Every string measured by the backend, as before the measurer
+static void TextMeasurer_Backend(benchmark::State& state)
+{
+	DeterministicTextMetrics metrics(true);
+	const auto words = CreateWords();
+	size_t i = 0;
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(metrics.MeasureWidth(Regular, words[i++ % words.size()]));
+	}
+}
+BENCHMARK(TextMeasurer_Backend);
\ No newline at end of file
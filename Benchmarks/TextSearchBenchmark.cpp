@@ -0,0 +1,88 @@
+#include "TextSearch.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+
+namespace
+{
+	// 16 MB of log lines
+	const std::string& GetBuffer()
+	{
+		static const std::string buffer = []
+		{
+			std::mt19937 random(36);
+			std::string ret;
+			ret.reserve(16 << 20);
+
+			while (ret.size() < (16u << 20))
+			{
+				ret += "The quick brown fox jumps over the lazy dog while logging request id=";
+				ret += std::to_string(random() % 100000);
+				ret += '\n';
+			}
+
+			return ret;
+		}();
+
+		return buffer;
+	}
+
+	void CountMatches(benchmark::State& state, const char* pattern, bool isCaseSensitive)
+	{
+		const auto& buffer = GetBuffer();
+		TextSearch search;
+		search.SetPattern(pattern, isCaseSensitive);
+
+		for (auto _ : state)
+		{
+			size_t count = 0;
+			for (size_t i = search.Find(buffer); i != TextSearch::NotFound; i = search.Find(buffer, i + 1)) ++count;
+			benchmark::DoNotOptimize(count);
+		}
+
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * buffer.size()));
+	}
+}
+
+static void TextSearch_Short(benchmark::State& state) { CountMatches(state, "id=4242", true); }
+BENCHMARK(TextSearch_Short)->Unit(benchmark::kMillisecond);
+
+static void TextSearch_ShortCaseInsensitive(benchmark::State& state) { CountMatches(state, "LAZY DOG", false); }
+BENCHMARK(TextSearch_ShortCaseInsensitive)->Unit(benchmark::kMillisecond);
+
+static void TextSearch_Long(benchmark::State& state) { CountMatches(state, "over the lazy cat while logging", true); }
+BENCHMARK(TextSearch_Long)->Unit(benchmark::kMillisecond);
+
+static void TextSearch_StringFind(benchmark::State& state)
+{
+	const auto& buffer = GetBuffer();
+
+	for (auto _ : state)
+	{
+		size_t count = 0;
+		for (size_t i = buffer.find("id=4242"); i != std::string::npos; i = buffer.find("id=4242", i + 1)) ++count;
+		benchmark::DoNotOptimize(count);
+	}
+
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * buffer.size()));
+}
+BENCHMARK(TextSearch_StringFind)->Unit(benchmark::kMillisecond);
+
+// Typing inside a document while every match is highlighted
+static void TextSearch_EditWithCachedMatches(benchmark::State& state)
+{
+	PieceTable document(GetBuffer());
+	TextSearch search;
+	search.SetPattern("id=4242");
+	search.FindAll(document);
+	std::mt19937 random(36);
+
+	for (auto _ : state)
+	{
+		const size_t offset = random() % document.GetLength();
+		document.Insert(offset, "x");
+		search.OnEdit(document, offset, 0, 1);
+	}
+}
+BENCHMARK(TextSearch_EditWithCachedMatches);
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include "TextView.h"
+#include "DeterministicTextMetrics.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+
+namespace
+{
+	constexpr size_t LineCount = 1000000;
+	constexpr int VisibleLines = 50;
+
+	const FontDescriptor Regular{ "Segoe", 12, false, false };
+
+	// 1M lines of 40 to 80 characters
+	std::string CreateText()
+	{
+		std::mt19937 random(35);
+		std::string ret;
+
+		for (size_t line = 0; line < LineCount; ++line)
+		{
+			const size_t length = 40 + random() % 41;
+			for (size_t i = 0; i < length; ++i) ret += static_cast<char>('a' + random() % 26);
+			ret += '\n';
+		}
+
+		return ret;
+	}
+
+	const PieceTable& GetDocument()
+	{
+		static const PieceTable document(CreateText());
+		return document;
+	}
+
+	// Layouts of a frame: the text drawn and the caret positions
+	void Draw(TextView& view)
+	{
+		view.ForEachVisibleLine([](size_t, size_t offset, int y, const TextView::LineLayout& layout)
+			{
+				benchmark::DoNotOptimize(offset);
+				benchmark::DoNotOptimize(y);
+				benchmark::DoNotOptimize(layout.Positions.back());
+			});
+	}
+}
+
+// Jumping anywhere in the document (scroll bar drag, go to line) and drawing the frame, nothing is cached
+static void TextView_ScrollToLine(benchmark::State& state)
+{
+	TextMeasurer measurer(std::make_unique<DeterministicTextMetrics>());
+	TextView view(GetDocument());
+	view.SetFont(measurer, Regular);
+	view.SetViewportHeight(VisibleLines * view.GetLineHeight());
+	std::mt19937 random(35);
+
+	for (auto _ : state)
+	{
+		view.ScrollTo(random() % LineCount);
+		Draw(view);
+	}
+}
+BENCHMARK(TextView_ScrollToLine);
+
+// Wheel scrolling of 3 lines and drawing the frame, only the new lines are laid out
+static void TextView_ScrollBy(benchmark::State& state)
+{
+	TextMeasurer measurer(std::make_unique<DeterministicTextMetrics>());
+	TextView view(GetDocument());
+	view.SetFont(measurer, Regular);
+	view.SetViewportHeight(VisibleLines * view.GetLineHeight());
+	view.ScrollTo(LineCount / 2);
+
+	for (auto _ : state)
+	{
+		view.ScrollBy(3);
+		Draw(view);
+
+		if (view.GetFirstVisibleLine() + VisibleLines >= LineCount) view.ScrollTo(0);
+	}
+}
+BENCHMARK(TextView_ScrollBy);
+
+// Redrawing the same frame (caret blink, hover), every layout comes from the cache
+static void TextView_Redraw(benchmark::State& state)
+{
+	TextMeasurer measurer(std::make_unique<DeterministicTextMetrics>());
+	TextView view(GetDocument());
+	view.SetFont(measurer, Regular);
+	view.SetViewportHeight(VisibleLines * view.GetLineHeight());
+	view.ScrollTo(LineCount / 2);
+	Draw(view);
+
+	for (auto _ : state)
+	{
+		Draw(view);
+	}
+}
+BENCHMARK(TextView_Redraw);
+
+// Click in the visible lines
+static void TextView_HitTest(benchmark::State& state)
+{
+	TextMeasurer measurer(std::make_unique<DeterministicTextMetrics>());
+	TextView view(GetDocument());
+	view.SetFont(measurer, Regular);
+	view.SetViewportHeight(VisibleLines * view.GetLineHeight());
+	view.ScrollTo(LineCount / 2);
+	std::mt19937 random(35);
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(view.GetOffsetFromPoint(random() % 600, random() % (VisibleLines * view.GetLineHeight())));
+	}
+}
+BENCHMARK(TextView_HitTest);
\ No newline at end of file
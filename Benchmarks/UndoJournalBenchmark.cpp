@@ -0,0 +1,108 @@
+#include "UndoJournal.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+
+namespace
+{
+	std::string CreateText(size_t length)
+	{
+		std::mt19937 random(34);
+		std::string ret;
+		ret.reserve(length);
+
+		for (size_t i = 0; i < length; ++i) ret += static_cast<char>('a' + random() % 26);
+
+		return ret;
+	}
+}
+
+// One character per keystroke, merged in the last entry until it's full
+static void UndoJournal_Typing(benchmark::State& state)
+{
+	UndoJournal journal;
+	size_t offset = 0;
+
+	for (auto _ : state)
+	{
+		journal.Record(offset++, {}, "x");
+	}
+
+	state.counters["Entries"] = static_cast<double>(journal.GetCount());
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(UndoJournal_Typing);
+
+// Backspace held down, each removal is prepended to the last entry
+static void UndoJournal_Backspace(benchmark::State& state)
+{
+	UndoJournal journal;
+	size_t offset = 1 << 30;
+
+	for (auto _ : state)
+	{
+		journal.Record(--offset, "x", {});
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(UndoJournal_Backspace);
+
+// Undoing then redoing a replacement of Arg bytes, as a paste or a replace all would record
+static void UndoJournal_UndoRedoLarge(benchmark::State& state)
+{
+	const std::string removed = CreateText(state.range(0));
+	const std::string inserted = CreateText(state.range(0));
+	UndoJournal journal(64 << 20);
+
+	for (int i = 0; i < 8; ++i) journal.Record(0, removed, inserted);
+
+	for (auto _ : state)
+	{
+		while (const auto* edit = journal.Undo()) benchmark::DoNotOptimize(edit->Removed.data());
+		while (const auto* edit = journal.Redo()) benchmark::DoNotOptimize(edit->Inserted.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * 16);
+}
+BENCHMARK(UndoJournal_UndoRedoLarge)->Arg(1 << 10)->Arg(1 << 20);
+
+// Recording at the budget, every new entry drops the oldest ones
+static void UndoJournal_EvictAtBudget(benchmark::State& state)
+{
+	const std::string text = CreateText(state.range(0));
+	UndoJournal journal(1 << 20);
+
+	// Entries also count their own size, so this goes over the budget and the journal is full
+	for (size_t i = 0; i < journal.GetMemoryBudget() / (2 * text.length()); ++i) journal.Record(0, text, text);
+
+	for (auto _ : state)
+	{
+		journal.BreakMerge();
+		journal.Record(0, text, text);
+	}
+
+	state.counters["Entries"] = static_cast<double>(journal.GetCount());
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(UndoJournal_EvictAtBudget)->Arg(16)->Arg(4 << 10);
+
+// A new edit after undoing everything drops the whole redo history
+static void UndoJournal_DropRedo(benchmark::State& state)
+{
+	const std::string text = CreateText(64);
+	UndoJournal journal;
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		for (int i = 0; i < 1000; ++i) journal.Record(0, text, text);
+		while (journal.Undo() != nullptr) {}
+		state.ResumeTiming();
+
+		journal.Record(0, {}, "x");
+		journal.BreakMerge();
+	}
+}
+BENCHMARK(UndoJournal_DropRedo)->Iterations(1000);
\ No newline at end of file
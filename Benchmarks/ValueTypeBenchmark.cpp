@@ -0,0 +1,148 @@
+#include "Color.h"
+#include "Rectangle.h"
+
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+	constexpr size_t Count = 100000;
+
+	std::vector<Drawing::Rectangle> CreateRectangles()
+	{
+		std::mt19937 random(26);
+		std::vector<Drawing::Rectangle> ret;
+		ret.reserve(Count);
+
+		for (size_t i = 0; i < Count; ++i) ret.emplace_back(random() % 1920, random() % 1080, 1 + random() % 200, 1 + random() % 40);
+
+		return ret;
+	}
+
+	std::vector<Color> CreateColors()
+	{
+		std::mt19937 random(26);
+		std::vector<Color> ret;
+		ret.reserve(Count);
+
+		for (size_t i = 0; i < Count; ++i) ret.emplace_back(static_cast<uint32_t>(random()));
+
+		return ret;
+	}
+}
+
+// Element by element copy, the compiler turns it into a block copy for trivially copyable types
+static void ValueType_CopyRectangles(benchmark::State& state)
+{
+	const auto source = CreateRectangles();
+	auto target = source;
+
+	for (auto _ : state)
+	{
+		std::copy(source.begin(), source.end(), target.begin());
+		benchmark::ClobberMemory();
+	}
+
+	state.SetBytesProcessed(state.iterations() * Count * sizeof(Drawing::Rectangle));
+}
+BENCHMARK(ValueType_CopyRectangles);
+
+static void ValueType_MemcpyRectangles(benchmark::State& state)
+{
+	const auto source = CreateRectangles();
+	auto target = source;
+
+	for (auto _ : state)
+	{
+		std::memcpy(target.data(), source.data(), Count * sizeof(Drawing::Rectangle));
+		benchmark::ClobberMemory();
+	}
+
+	state.SetBytesProcessed(state.iterations() * Count * sizeof(Drawing::Rectangle));
+}
+BENCHMARK(ValueType_MemcpyRectangles);
+
+// Bounding box of every rectangle (dirty area of a layout pass)
+static void ValueType_UnionRectangles(benchmark::State& state)
+{
+	const auto rectangles = CreateRectangles();
+
+	for (auto _ : state)
+	{
+		auto bounds = rectangles.front();
+		for (const auto& r : rectangles) bounds = Drawing::Rectangle::Union(bounds, r);
+		benchmark::DoNotOptimize(bounds);
+	}
+
+	state.SetItemsProcessed(state.iterations() * Count);
+}
+BENCHMARK(ValueType_UnionRectangles);
+
+// Hit test of a point against every rectangle
+static void ValueType_ContainsRectangles(benchmark::State& state)
+{
+	const auto rectangles = CreateRectangles();
+	std::mt19937 random(26);
+
+	for (auto _ : state)
+	{
+		const Point p(random() % 1920, random() % 1080);
+		size_t hits = 0;
+
+		for (const auto& r : rectangles) hits += r.Contains(p);
+		benchmark::DoNotOptimize(hits);
+	}
+
+	state.SetItemsProcessed(state.iterations() * Count);
+}
+BENCHMARK(ValueType_ContainsRectangles);
+
+static void ValueType_CopyColors(benchmark::State& state)
+{
+	const auto source = CreateColors();
+	auto target = source;
+
+	for (auto _ : state)
+	{
+		std::copy(source.begin(), source.end(), target.begin());
+		benchmark::ClobberMemory();
+	}
+
+	state.SetBytesProcessed(state.iterations() * Count * sizeof(Color));
+}
+BENCHMARK(ValueType_CopyColors);
+
+// Colors equal to a given one (brush cache lookups, palette matching)
+static void ValueType_CompareColors(benchmark::State& state)
+{
+	const auto colors = CreateColors();
+	const Color color = colors[Count / 2];
+
+	for (auto _ : state)
+	{
+		size_t matches = 0;
+		for (const auto& c : colors) matches += c == color;
+		benchmark::DoNotOptimize(matches);
+	}
+
+	state.SetItemsProcessed(state.iterations() * Count);
+}
+BENCHMARK(ValueType_CompareColors);
+
+// Fading every color halfway to white
+static void ValueType_LerpColors(benchmark::State& state)
+{
+	const auto colors = CreateColors();
+	std::vector<Color> target(Count);
+
+	for (auto _ : state)
+	{
+		for (size_t i = 0; i < Count; ++i) target[i] = Color::Lerp(colors[i], Color::White(), 0.5f);
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * Count);
+}
+BENCHMARK(ValueType_LerpColors);
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include "AdvanceIndex.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+TEST(AdvanceIndexTests, PositionsAndIndices)
+{
+	const int advances[] = { 5, 0, 7, 3 };
+	AdvanceIndex index;
+	index.Assign(advances, 4);
+
+	EXPECT_EQ(index.GetCount(), 4u);
+	EXPECT_EQ(index.GetWidth(), 15);
+	EXPECT_EQ(index.GetPosition(0), 0);
+	EXPECT_EQ(index.GetPosition(2), 5);
+	EXPECT_EQ(index.GetPosition(3), 12);
+	EXPECT_EQ(index.GetPosition(4), 15);
+	EXPECT_EQ(index.GetAdvance(2), 7);
+
+	EXPECT_EQ(index.FindIndex(-1), 0u);
+	EXPECT_EQ(index.FindIndex(5), 1u);	// Zero width characters are skipped
+	EXPECT_EQ(index.FindIndex(6), 3u);
+	EXPECT_EQ(index.FindIndex(15), 4u);
+	EXPECT_EQ(index.FindIndex(16), 4u);
+}
+
+TEST(AdvanceIndexTests, EditsAcrossBlocks)
+{
+	std::vector<int> advances(5000, 2);
+	AdvanceIndex index;
+	index.Assign(advances.data(), advances.size());
+
+	index.Erase(100, 4000);
+	EXPECT_EQ(index.GetCount(), 1000u);
+	EXPECT_EQ(index.GetWidth(), 2000);
+	EXPECT_EQ(index.GetPosition(999), 1998);
+
+	const int wide = 10;
+	index.Insert(500, &wide, 1);
+	EXPECT_EQ(index.GetPosition(501), 1010);
+	EXPECT_EQ(index.FindIndex(1005), 501u);
+
+	index.Erase(0, 2000);
+	EXPECT_EQ(index.GetCount(), 0u);
+	EXPECT_EQ(index.GetWidth(), 0);
+	EXPECT_EQ(index.FindIndex(1), 0u);
+}
+
+TEST(AdvanceIndexTests, MatchesPrefixSums)
+{
+	std::mt19937 random(32);
+	AdvanceIndex index;
+	std::vector<int> reference;
+
+	for (int i = 0; i < 50000; ++i)
+	{
+		const int operation = random() % 10;
+		const size_t count = random() % 50 == 0 ? random() % 3000 : 1 + random() % 3;
+
+		if (operation < 5)
+		{
+			const size_t at = random() % (reference.size() + 1);
+			std::vector<int> advances(count);
+
+			for (auto& a : advances) a = random() % 4;
+
+			reference.insert(reference.begin() + at, advances.begin(), advances.end());
+			index.Insert(at, advances.data(), advances.size());
+		}
+		else if (operation < 8 && !reference.empty())
+		{
+			const size_t at = random() % reference.size();
+			const size_t n = (std::min)(count, reference.size() - at);
+
+			reference.erase(reference.begin() + at, reference.begin() + at + n);
+			index.Erase(at, n);
+		}
+		else if (operation == 9 && random() % 200 == 0)
+		{
+			index.Assign(reference.data(), reference.size());
+		}
+
+		ASSERT_EQ(index.GetCount(), reference.size());
+
+		if (i % 7 != 0) continue;
+
+		std::vector<int> positions(reference.size() + 1, 0);
+		for (size_t k = 0; k < reference.size(); ++k) positions[k + 1] = positions[k] + reference[k];
+
+		ASSERT_EQ(index.GetWidth(), positions.back());
+
+		for (int k = 0; k < 5; ++k)
+		{
+			const size_t at = random() % (reference.size() + 1);
+			ASSERT_EQ(index.GetPosition(at), positions[at]);
+			if (at < reference.size()) ASSERT_EQ(index.GetAdvance(at), reference[at]);
+
+			const int x = static_cast<int>(random() % (positions.back() + 3)) - 1;
+			const size_t expected = x <= 0 ? 0 : x > positions.back() ? reference.size() : std::lower_bound(positions.begin(), positions.end(), x) - positions.begin();
+			ASSERT_EQ(index.FindIndex(x), expected);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include "AmbientProperty.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+	// Resolves its value the same way WinAPI does for Font, ForeColor and BackgroundColor
+	class Node
+	{
+	private:
+
+		const Node* m_Parent;
+		AmbientProperty<int> m_Local;
+		mutable int m_Value;
+		mutable unsigned long long m_Version;
+		mutable unsigned long long m_AmbientVersion;
+
+		const Node* GetAmbientParent() const noexcept { return m_Parent; }
+
+	public:
+
+		mutable int Copies = 0;
+
+		Node(const Node* parent, int value)
+			:
+			m_Parent(parent),
+			m_Local(value),
+			m_Value(value),
+			m_Version(0),
+			m_AmbientVersion(0)
+		{
+
+		}
+
+		void Set(int value) { m_Local.Set(value); }
+		void SetDefault(int value) { m_Local.SetDefault(value); }
+
+		int Get() const
+		{
+			if (m_AmbientVersion != AmbientVersion::GetCurrent())
+			{
+				auto parent = [](const Node* n) { return n->GetAmbientParent(); };
+
+				if (AmbientProperty<int>::Find(this, &Node::m_Local, parent).CopyTo(m_Value, m_Version)) ++Copies;
+
+				m_AmbientVersion = AmbientVersion::GetCurrent();
+			}
+
+			return m_Value;
+		}
+	};
+}
+
+TEST(AmbientPropertyTests, InheritsFromNearestSetAncestor)
+{
+	Node window(nullptr, 1);
+	Node panel(&window, 2);
+	Node button(&panel, 3);
+
+	// Nothing set, every node keeps its own default
+	EXPECT_EQ(window.Get(), 1);
+	EXPECT_EQ(panel.Get(), 2);
+	EXPECT_EQ(button.Get(), 3);
+
+	window.Set(10);
+	EXPECT_EQ(panel.Get(), 10);
+	EXPECT_EQ(button.Get(), 10);
+
+	panel.Set(20);
+	EXPECT_EQ(window.Get(), 10);
+	EXPECT_EQ(button.Get(), 20);
+
+	button.Set(30);
+	window.Set(40);
+	EXPECT_EQ(panel.Get(), 20);
+	EXPECT_EQ(button.Get(), 30);
+}
+
+TEST(AmbientPropertyTests, DefaultsAreNotInherited)
+{
+	Node window(nullptr, 1);
+	Node button(&window, 3);
+
+	window.SetDefault(5);
+	EXPECT_EQ(window.Get(), 5);
+	EXPECT_EQ(button.Get(), 3);
+
+	// A default never overrides an explicit value
+	button.Set(7);
+	button.SetDefault(8);
+	EXPECT_EQ(button.Get(), 7);
+}
+
+TEST(AmbientPropertyTests, CopiesOnlyWhenTheSourceChanged)
+{
+	Node window(nullptr, 1);
+	Node button(&window, 3);
+
+	window.Set(10);
+	EXPECT_EQ(button.Get(), 10);
+	const int copies = button.Copies;
+
+	// Unrelated changes move the version but the resolved value is still the same
+	Node other(nullptr, 0);
+	other.Set(99);
+	EXPECT_EQ(button.Get(), 10);
+	EXPECT_EQ(button.Copies, copies);
+
+	window.Set(10);
+	EXPECT_EQ(button.Get(), 10);
+	EXPECT_EQ(button.Copies, copies + 1);
+}
+
+TEST(AmbientPropertyTests, VersionsAreUnique)
+{
+	AmbientProperty<int> a(0);
+	AmbientProperty<double> b(0.0);
+	const auto first = a.GetVersion();
+
+	b.Set(1.0);
+	a.Set(1);
+
+	EXPECT_LT(first, b.GetVersion());
+	EXPECT_LT(b.GetVersion(), a.GetVersion());
+	EXPECT_EQ(a.GetVersion(), AmbientVersion::GetCurrent());
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "ChunkedPaste.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+namespace
+{
+	// In memory clipboard remembering how far it was read. Limit simulates a source shorter than it reported
+	class StringSource final : public IClipboardSource
+	{
+	public:
+
+		std::string Text;
+		size_t Limit = SIZE_MAX;
+		size_t ReadEnd = 0;
+
+		explicit StringSource(std::string text) : Text(std::move(text)) {}
+
+		size_t GetLength() override { return Text.size(); }
+
+		std::string_view Read(size_t offset, size_t count) override
+		{
+			ReadEnd = (std::max)(ReadEnd, offset + count);
+
+			const size_t end = (std::min)(Limit, Text.size());
+			if (offset >= end) return {};
+
+			return std::string_view(Text).substr(offset, (std::min)(count, end - offset));
+		}
+	};
+}
+
+TEST(ChunkedPasteTests, ChunksAreBoundedAndClamped)
+{
+	StringSource source(std::string(1000, 'x'));
+	ChunkedPaste paste(source, 300, 64);
+	std::string pasted;
+	size_t chunks = 0;
+
+	EXPECT_EQ(paste.GetLength(), 300u);
+
+	for (auto chunk = paste.Next(); !chunk.empty(); chunk = paste.Next())
+	{
+		EXPECT_LE(chunk.size(), 64u);
+		pasted += chunk;
+		++chunks;
+		EXPECT_EQ(paste.GetPosition(), pasted.size());
+	}
+
+	EXPECT_EQ(pasted.size(), 300u);
+	EXPECT_EQ(chunks, 5u);
+	EXPECT_TRUE(paste.IsComplete());
+
+	// The characters over the maximum length are never read
+	EXPECT_LE(source.ReadEnd, 300u);
+}
+
+TEST(ChunkedPasteTests, NothingToPaste)
+{
+	StringSource source("abc");
+	ChunkedPaste paste(source, 0);
+
+	EXPECT_EQ(paste.GetLength(), 0u);
+	EXPECT_TRUE(paste.Next().empty());
+	EXPECT_TRUE(paste.IsComplete());
+}
+
+TEST(ChunkedPasteTests, ShortSourceCompletes)
+{
+	StringSource source(std::string(1000, 'x'));
+	source.Limit = 100;
+	ChunkedPaste paste(source, 5000, 64);
+	size_t total = 0;
+
+	for (auto chunk = paste.Next(); !chunk.empty(); chunk = paste.Next()) total += chunk.size();
+
+	EXPECT_EQ(total, 100u);
+	EXPECT_EQ(paste.GetLength(), 100u);
+	EXPECT_TRUE(paste.IsComplete());
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include "ControlRegistry.h"
+
+#include <gtest/gtest.h>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+	// Registers itself the way Control does: the id when constructed, the handle when created and until WM_NCDESTROY,
+	// both removed when destroyed
+	struct Item
+	{
+		static inline ControlRegistry<Item> Registry;
+
+		unsigned int Id;
+		const void* Handle = nullptr;
+
+		explicit Item(unsigned int id) : Id(id) { Registry.AddId(Id, this); }
+		~Item() { Registry.Remove(this, Id, Handle); }
+
+		void Create(const void* handle)
+		{
+			Handle = handle;
+			Registry.AddHandle(Handle, this);
+		}
+
+		void Destroy()
+		{
+			Registry.RemoveHandle(this, Handle);
+		}
+	};
+
+	const void* GetHandle(size_t i)
+	{
+		return reinterpret_cast<const void*>(0x1000 + i * 8);
+	}
+}
+
+TEST(ControlRegistryTests, DestroyedItemsAreRemoved)
+{
+	{
+		Item a(1);
+		Item b(2);
+		a.Create(GetHandle(1));
+		b.Create(GetHandle(2));
+
+		EXPECT_EQ(Item::Registry.GetCount(), 2u);
+		EXPECT_EQ(Item::Registry.FindById(2), &b);
+		EXPECT_EQ(Item::Registry.FindByHandle(GetHandle(1)), &a);
+
+		b.Destroy();
+		EXPECT_EQ(Item::Registry.FindByHandle(GetHandle(2)), nullptr);
+		EXPECT_EQ(Item::Registry.FindById(2), &b);
+	}
+
+	EXPECT_EQ(Item::Registry.GetCount(), 0u);
+	EXPECT_EQ(Item::Registry.FindById(1), nullptr);
+	EXPECT_EQ(Item::Registry.FindByHandle(GetHandle(1)), nullptr);
+}
+
+TEST(ControlRegistryTests, ReusedHandleIsKept)
+{
+	auto a = std::make_unique<Item>(1);
+	a->Create(GetHandle(1));
+	a->Destroy();
+
+	// The system gives the handle to the next window before the first item is deleted
+	Item b(2);
+	b.Create(GetHandle(1));
+	a.reset();
+
+	EXPECT_EQ(Item::Registry.FindByHandle(GetHandle(1)), &b);
+	EXPECT_EQ(Item::Registry.FindById(2), &b);
+}
+
+TEST(ControlRegistryTests, ChangesMatchMap)
+{
+	std::mt19937 random(49);
+	std::vector<std::unique_ptr<Item>> items;
+	std::map<const void*, Item*> handles;
+	unsigned int nextId = 1;
+
+	for (int i = 0; i < 20000; ++i)
+	{
+		const int operation = random() % 4;
+		const auto handle = GetHandle(random() % 32);
+
+		if (operation == 0 || items.empty())
+		{
+			items.push_back(std::make_unique<Item>(nextId++));
+		}
+		else if (operation == 1 && !handles.contains(handle))
+		{
+			auto& item = items[random() % items.size()];
+
+			if (item->Handle == nullptr)
+			{
+				item->Create(handle);
+				handles[handle] = item.get();
+			}
+		}
+		else if (operation == 2)
+		{
+			auto& item = items[random() % items.size()];
+
+			if (item->Handle != nullptr && handles[item->Handle] == item.get())
+			{
+				item->Destroy();
+				handles.erase(item->Handle);
+			}
+		}
+		else
+		{
+			const size_t index = random() % items.size();
+
+			if (items[index]->Handle != nullptr && handles[items[index]->Handle] == items[index].get()) handles.erase(items[index]->Handle);
+
+			items.erase(items.begin() + index);
+		}
+
+		ASSERT_EQ(Item::Registry.GetCount(), items.size());
+
+		for (const auto& item : items) ASSERT_EQ(Item::Registry.FindById(item->Id), item.get());
+
+		for (size_t h = 0; h < 32; ++h)
+		{
+			const auto it = handles.find(GetHandle(h));
+			ASSERT_EQ(Item::Registry.FindByHandle(GetHandle(h)), it != handles.end() ? it->second : nullptr);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,134 @@
+#include "GraphemeIndex.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	size_t CountClusters(const std::string& text)
+	{
+		PieceTable document(text);
+		GraphemeIndex index(document);
+		return index.GetClusterCount();
+	}
+
+	std::vector<size_t> GetStops(GraphemeIndex& index, size_t length)
+	{
+		std::vector<size_t> ret;
+
+		for (size_t i = 0; i <= length; ++i)
+		{
+			if (index.IsStop(i)) ret.push_back(i);
+		}
+
+		return ret;
+	}
+}
+
+TEST(GraphemeIndexTests, Clusters)
+{
+	EXPECT_EQ(CountClusters("abc"), 3u);
+	EXPECT_EQ(CountClusters("caf\xC3\xA9"), 4u);
+	EXPECT_EQ(CountClusters("e\xCC\x81"), 1u);							// e + combining acute
+	EXPECT_EQ(CountClusters("\r\n"), 1u);
+	EXPECT_EQ(CountClusters("\n\r"), 2u);
+	EXPECT_EQ(CountClusters("\xF0\x9F\x87\xA7\xF0\x9F\x87\xB7\xF0\x9F\x87\xBA\xF0\x9F\x87\xB8"), 2u);	// Two flags
+	EXPECT_EQ(CountClusters("\xF0\x9F\x87\xA7\xF0\x9F\x87\xB7\xF0\x9F\x87\xBA"), 2u);					// Flag + lone regional indicator
+	EXPECT_EQ(CountClusters("\xF0\x9F\x91\xA8\xE2\x80\x8D\xF0\x9F\x91\xA9\xE2\x80\x8D\xF0\x9F\x91\xA7"), 1u);	// ZWJ family
+	EXPECT_EQ(CountClusters("\xF0\x9F\x91\x8D\xF0\x9F\x8F\xBD"), 1u);	// Thumbs up + skin tone
+	EXPECT_EQ(CountClusters("\xE1\x84\x80\xE1\x85\xA1\xE1\x86\xA8"), 1u);	// Hangul L V T
+	EXPECT_EQ(CountClusters("\xEA\xB0\x80\xEA\xB0\x81"), 2u);			// Two Hangul syllables
+	EXPECT_EQ(CountClusters("\xE9\xE8\xFF"), 3u);						// ANSI bytes are clusters of their own
+}
+
+TEST(GraphemeIndexTests, CaretMovement)
+{
+	PieceTable document("a\xC3\xA9" "b");
+	GraphemeIndex index(document);
+
+	EXPECT_EQ(index.GetNextStop(1), 3u);
+	EXPECT_EQ(index.GetPreviousStop(3), 1u);
+	EXPECT_EQ(index.Snap(2), 1u);
+	EXPECT_FALSE(index.IsStop(2));
+	EXPECT_EQ(index.GetNextStop(4), 4u);
+	EXPECT_EQ(index.GetPreviousStop(0), 0u);
+}
+
+TEST(GraphemeIndexTests, EditsMatchFreshIndex)
+{
+	const char* pieces[] = { "a", "b", "\r", "\n", "\r\n", "\xC3\xA9", "\xCC\x81", "\xE2\x80\x8D", "\xF0\x9F\x91\xA8", "\xF0\x9F\x87\xA7",
+		"\xF0\x9F\x8F\xBD", "\xE1\x84\x80", "\xE1\x85\xA1", "\xE1\x86\xA8", "\xEA\xB0\x80", "\xFF", "\x80", "\xE2\x82" };
+	constexpr size_t PieceCount = sizeof(pieces) / sizeof(pieces[0]);
+
+	std::mt19937 random(38);
+
+	auto createText = [&](size_t count)
+	{
+		std::string ret;
+		for (size_t i = 0; i < count; ++i) ret += pieces[random() % PieceCount];
+		return ret;
+	};
+
+	for (int round = 0; round < 30; ++round)
+	{
+		auto reference = round % 3 == 0 ? std::string(random() % 20000, 'x') : createText(random() % 3000);
+		PieceTable document(reference);
+		GraphemeIndex index(document);
+
+		for (int i = 0; i < 200; ++i)
+		{
+			const int operation = random() % 4;
+
+			if (operation == 0)
+			{
+				const size_t offset = random() % (reference.size() + 1);
+				const auto text = createText(1 + random() % (random() % 10 == 0 ? 3000 : 4));
+
+				document.Insert(offset, text);
+				reference.insert(offset, text);
+				index.OnInsert(offset, text.size());
+			}
+			else if (operation == 1 && !reference.empty())
+			{
+				const size_t offset = random() % reference.size();
+				const size_t count = (std::min)(static_cast<size_t>(1 + random() % (random() % 10 == 0 ? 9000 : 6)), reference.size() - offset);
+
+				document.Erase(offset, count);
+				reference.erase(offset, count);
+				index.OnErase(offset, count);
+			}
+			else
+			{
+				// Builds a few blocks before the next edits
+				for (int q = 0; q < 5; ++q)
+				{
+					const size_t offset = random() % (reference.size() + 1);
+					index.IsStop(offset);
+					index.GetNextStop(offset);
+					index.GetPreviousStop(offset);
+				}
+			}
+
+			if (i % 20 != 0) continue;
+
+			GraphemeIndex fresh(document);
+			const auto expected = GetStops(fresh, reference.size());
+			ASSERT_EQ(GetStops(index, reference.size()), expected);
+
+			if (!reference.empty()) ASSERT_EQ(index.GetClusterCount(), expected.size() - 1);
+
+			for (int q = 0; q < 20; ++q)
+			{
+				const size_t offset = random() % (reference.size() + 1);
+				const auto next = std::upper_bound(expected.begin(), expected.end(), offset);
+				const auto previous = std::lower_bound(expected.begin(), expected.end(), offset);
+
+				ASSERT_EQ(index.GetNextStop(offset), next == expected.end() ? reference.size() : *next);
+				ASSERT_EQ(index.GetPreviousStop(offset), previous == expected.begin() ? 0 : *(previous - 1));
+			}
+		}
+	}
+}
\ No newline at end of file
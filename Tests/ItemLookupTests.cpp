@@ -0,0 +1,132 @@
+#include "ItemLookup.h"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	struct Entry
+	{
+		int Id;
+		std::string Value;
+		bool Tabulated = false;
+		bool Visible = true;
+		bool Selected = false;
+	};
+
+	std::vector<size_t> FindAllLinear(const ItemStore& items, int id, std::string_view value)
+	{
+		std::vector<size_t> ret;
+
+		for (size_t i = 0; i < items.GetCount(); ++i)
+		{
+			if (items.GetId(i) == id && items.GetValue(i) == value) ret.push_back(i);
+		}
+
+		return ret;
+	}
+
+	void ExpectEqual(ItemLookup& lookup, const ItemStore& items)
+	{
+		for (int id = 0; id < 9; ++id)
+		{
+			size_t expected = ItemLookup::NotFound;
+			for (size_t i = 0; i < items.GetCount() && expected == ItemLookup::NotFound; ++i) if (items.GetId(i) == id) expected = i;
+
+			ASSERT_EQ(lookup.FindId(id), expected);
+
+			for (int v = 0; v < 11; ++v)
+			{
+				const std::string value = "v" + std::to_string(v);
+				const auto all = FindAllLinear(items, id, value);
+
+				ASSERT_EQ(lookup.FindAll(id, value), all);
+				ASSERT_EQ(lookup.Find(id, value), all.empty() ? ItemLookup::NotFound : all.front());
+			}
+		}
+
+		for (int v = 0; v < 11; ++v)
+		{
+			const std::string value = "v" + std::to_string(v);
+			size_t expected = ItemLookup::NotFound;
+			for (size_t i = 0; i < items.GetCount() && expected == ItemLookup::NotFound; ++i) if (items.GetValue(i) == value) expected = i;
+
+			ASSERT_EQ(lookup.FindValue(value), expected);
+		}
+	}
+}
+
+TEST(ItemLookupTests, Duplicates)
+{
+	const std::vector<Entry> entries = { { 1, "a" }, { 2, "b" }, { 1, "a" }, { 1, "b" }, { 1, "a" } };
+	ItemStore items;
+	items.Assign(entries.begin(), entries.end());
+	ItemLookup lookup(items);
+
+	EXPECT_EQ(lookup.FindAll(1, "a"), (std::vector<size_t>{ 0, 2, 4 }));
+	EXPECT_EQ(lookup.Find(1, "b"), 3u);
+	EXPECT_EQ(lookup.FindValue("b"), 1u);
+	EXPECT_EQ(lookup.FindId(3), ItemLookup::NotFound);
+
+	// Removing from the middle of the chains shifts the positions after them
+	lookup.OnErasing(1, 2);
+	items.Erase(1, 2);
+	EXPECT_EQ(lookup.FindAll(1, "a"), (std::vector<size_t>{ 0, 2 }));
+	EXPECT_EQ(lookup.FindValue("b"), 1u);
+
+	const std::vector<Entry> added = { { 1, "a" } };
+	items.Insert(1, added.begin(), added.end());
+	lookup.OnInsert(1, 1);
+	EXPECT_EQ(lookup.FindAll(1, "a"), (std::vector<size_t>{ 0, 1, 3 }));
+}
+
+TEST(ItemLookupTests, ChangesMatchLinearSearch)
+{
+	std::mt19937 random(46);
+	auto createEntry = [&random]() { return Entry{ static_cast<int>(random() % 8), "v" + std::to_string(random() % 10) }; };
+
+	for (int round = 0; round < 200; ++round)
+	{
+		std::vector<Entry> entries(random() % 40);
+		for (auto& entry : entries) entry = createEntry();
+
+		ItemStore items;
+		items.Assign(entries.begin(), entries.end());
+		ItemLookup lookup(items);
+
+		for (int i = 0; i < 60; ++i)
+		{
+			const int operation = random() % 6;
+
+			if (operation == 0)
+			{
+				std::vector<Entry> added(1 + random() % (random() % 4 == 0 ? 30 : 3));
+				for (auto& entry : added) entry = createEntry();
+
+				const size_t index = random() % 3 == 0 ? items.GetCount() : random() % (items.GetCount() + 1);
+				items.Insert(index, added.begin(), added.end());
+				lookup.OnInsert(index, added.size());
+			}
+			else if (operation == 1 && !items.IsEmpty())
+			{
+				const size_t index = random() % items.GetCount();
+				const size_t count = 1 + random() % (random() % 4 == 0 ? items.GetCount() - index : (std::min)(size_t{ 3 }, items.GetCount() - index));
+
+				lookup.OnErasing(index, count);
+				items.Erase(index, count);
+			}
+			else if (operation <= 3 && !items.IsEmpty())
+			{
+				const size_t index = random() % items.GetCount();
+
+				lookup.OnUpdating(index);
+				items.Set(index, createEntry());
+				lookup.OnUpdated(index);
+			}
+
+			ExpectEqual(lookup, items);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include "ItemSnapshot.h"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	struct Entry
+	{
+		int Id;
+		std::string Value;
+		bool Tabulated = false;
+		bool Visible = true;
+		bool Selected = false;
+	};
+
+	void ExpectEqual(const ItemSnapshot& snapshot, const std::vector<Entry>& entries)
+	{
+		ASSERT_EQ(snapshot.GetCount(), entries.size());
+
+		for (size_t i = 0; i < entries.size(); ++i)
+		{
+			ASSERT_EQ(snapshot.GetId(i), entries[i].Id);
+			ASSERT_EQ(snapshot.GetValue(i), entries[i].Value);
+			ASSERT_EQ(snapshot[i].Value, entries[i].Value);
+		}
+	}
+}
+
+TEST(ItemSnapshotTests, Build)
+{
+	std::mt19937 random(48);
+	std::vector<Entry> entries(ItemSnapshot::ChunkSize * 2 + 10);
+	for (size_t i = 0; i < entries.size(); ++i) entries[i] = { static_cast<int>(i), "v" + std::to_string(random() % 1000) };
+
+	ItemSnapshot::Builder builder;
+	builder.Add(entries.begin(), entries.begin() + 100);
+	for (size_t i = 100; i < entries.size(); ++i) builder.Add(entries[i]);
+
+	EXPECT_EQ(builder.GetCount(), entries.size());
+
+	const auto snapshot = builder.Build();
+	EXPECT_EQ(builder.GetCount(), 0u);
+	ExpectEqual(*snapshot, entries);
+}
+
+TEST(ItemSnapshotTests, SharesPrefix)
+{
+	std::mt19937 random(48);
+
+	for (int round = 0; round < 20; ++round)
+	{
+		std::vector<Entry> entries(random() % 20000);
+		for (size_t i = 0; i < entries.size(); ++i) entries[i] = { static_cast<int>(i), "v" + std::to_string(random() % 1000) };
+
+		ItemSnapshot::Builder builder;
+		builder.Add(entries.begin(), entries.end());
+		const auto base = builder.Build();
+
+		const size_t count = random() % (entries.size() + 1);
+		std::vector<Entry> added(random() % 9000);
+		for (auto& entry : added) entry = { -1, "m" + std::to_string(random()) };
+
+		ItemSnapshot::Builder next(*base, count);
+		next.Add(added.begin(), added.end());
+		const auto snapshot = next.Build();
+
+		// The base is left as it was, the full chunks of the prefix are shared
+		ExpectEqual(*base, entries);
+
+		entries.resize(count);
+		entries.insert(entries.end(), added.begin(), added.end());
+		ExpectEqual(*snapshot, entries);
+		EXPECT_EQ(snapshot->GetSharedCount(*base), count / ItemSnapshot::ChunkSize * ItemSnapshot::ChunkSize);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include "ItemStore.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	// Same members as ListItem, the way the controls hand their items to the store
+	struct Entry
+	{
+		int Id;
+		std::string Value;
+		bool Tabulated = false;
+		bool Visible = true;
+		bool Selected = false;
+	};
+
+	void ExpectEqual(const ItemStore& store, const std::vector<Entry>& entries)
+	{
+		ASSERT_EQ(store.GetCount(), entries.size());
+		size_t i = 0;
+
+		for (const auto item : store)
+		{
+			ASSERT_EQ(item.Id, entries[i].Id);
+			ASSERT_EQ(item.Value, entries[i].Value);
+			ASSERT_EQ(item.Tabulated, entries[i].Tabulated);
+			ASSERT_EQ(item.Visible, entries[i].Visible);
+			ASSERT_EQ(item.Selected, entries[i].Selected);
+			++i;
+		}
+
+		ASSERT_EQ(i, entries.size());
+	}
+}
+
+TEST(ItemStoreTests, InsertAndErase)
+{
+	std::vector<Entry> entries = { { 1, "one" }, { 2, "two", true }, { 3, "three", false, false, true } };
+	ItemStore store;
+	store.Assign(entries.begin(), entries.end());
+	ExpectEqual(store, entries);
+
+	const std::vector<Entry> added = { { 4, "four" }, { 5, "" } };
+	entries.insert(entries.begin() + 1, added.begin(), added.end());
+	store.Insert(1, added.begin(), added.end());
+	ExpectEqual(store, entries);
+
+	entries.erase(entries.begin(), entries.begin() + 2);
+	store.Erase(0, 2);
+	ExpectEqual(store, entries);
+
+	store.Clear();
+	EXPECT_TRUE(store.IsEmpty());
+	EXPECT_EQ(store.begin(), store.end());
+}
+
+TEST(ItemStoreTests, ShorterValueIsWrittenInPlace)
+{
+	const std::vector<Entry> entries = { { 1, "a long value" }, { 2, "another one" } };
+	ItemStore store;
+	store.Assign(entries.begin(), entries.end());
+
+	const size_t capacity = store.GetTextCapacity();
+	store.Set(0, Entry{ 1, "short" });
+
+	EXPECT_EQ(store.GetValue(0), "short");
+	EXPECT_EQ(store.GetValue(1), "another one");
+	EXPECT_EQ(store.GetTextCapacity(), capacity);
+}
+
+TEST(ItemStoreTests, ErasedValuesAreReclaimed)
+{
+	std::vector<Entry> entries;
+	for (int i = 0; i < 1000; ++i) entries.push_back({ i, std::string(20, static_cast<char>('a' + i % 26)) });
+
+	ItemStore store;
+	store.Assign(entries.begin(), entries.end());
+
+	store.Erase(0, 900);
+	entries.erase(entries.begin(), entries.begin() + 900);
+
+	ExpectEqual(store, entries);
+	EXPECT_LE(store.GetTextCapacity(), 2 * 20 * entries.size());
+}
+
+TEST(ItemStoreTests, ChangesMatchVector)
+{
+	std::mt19937 random(43);
+	std::vector<Entry> entries;
+	ItemStore store;
+
+	for (int i = 0; i < 20000; ++i)
+	{
+		const int operation = random() % 5;
+
+		if (operation == 0 || entries.empty())
+		{
+			const size_t index = random() % (entries.size() + 1);
+			std::vector<Entry> added(1 + random() % 5);
+			for (auto& entry : added) entry = { static_cast<int>(random()), std::string(random() % 40, static_cast<char>('a' + random() % 26)) };
+
+			entries.insert(entries.begin() + index, added.begin(), added.end());
+			store.Insert(index, added.begin(), added.end());
+		}
+		else if (operation == 1)
+		{
+			const size_t index = random() % entries.size();
+			const size_t count = 1 + random() % (std::min)(size_t{ 4 }, entries.size() - index);
+
+			entries.erase(entries.begin() + index, entries.begin() + index + count);
+			store.Erase(index, count);
+		}
+		else if (operation == 2)
+		{
+			const size_t index = random() % entries.size();
+			Entry entry = { static_cast<int>(random()), std::string(random() % 40, 'x'), random() % 2 == 0, random() % 2 == 0, random() % 2 == 0 };
+
+			entries[index] = entry;
+			store.Set(index, entry);
+		}
+		else
+		{
+			const size_t index = random() % entries.size();
+			const bool value = random() % 2 == 0;
+
+			switch (random() % 3)
+			{
+			case 0: entries[index].Tabulated = value; store.SetTabulated(index, value); break;
+			case 1: entries[index].Visible = value; store.SetVisible(index, value); break;
+			default: entries[index].Selected = value; store.SetSelected(index, value); break;
+			}
+		}
+
+		ASSERT_EQ(store.GetCount(), entries.size());
+		if (i % 97 == 0) ExpectEqual(store, entries);
+	}
+
+	ExpectEqual(store, entries);
+}
\ No newline at end of file
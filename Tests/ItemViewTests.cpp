@@ -0,0 +1,243 @@
+#include "ItemView.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+	// Source items of the view and the settings a fresh view is built with
+	struct List
+	{
+		std::vector<int> Values;
+		bool IsSorted = false;
+		bool IsFiltered = false;
+		int Minimum = 0;
+
+		ItemView::Comparer GetComparer() { return [this](size_t a, size_t b) { return Values[a] < Values[b]; }; }
+		ItemView::Predicate GetPredicate() { return [this, minimum = Minimum](size_t index) { return Values[index] >= minimum; }; }
+
+		ItemView CreateView()
+		{
+			ItemView view;
+			view.Reset(Values.size());
+
+			if (IsSorted) view.Sort(GetComparer());
+			if (IsFiltered) view.Filter(GetPredicate());
+
+			return view;
+		}
+	};
+
+	std::vector<size_t> GetSourceIndices(const ItemView& view)
+	{
+		std::vector<size_t> ret;
+		for (size_t row = 0; row < view.GetCount(); ++row) ret.push_back(view.GetSourceIndex(row));
+		return ret;
+	}
+
+	// Sorted rows of the source indices [first, last) in rows (row of each source index)
+	std::vector<size_t> GetRowsOf(const std::vector<size_t>& rows, size_t first, size_t last)
+	{
+		std::vector<size_t> ret;
+
+		for (size_t index = first; index < last; ++index)
+		{
+			if (rows[index] != ItemView::NotFound) ret.push_back(rows[index]);
+		}
+
+		std::sort(ret.begin(), ret.end());
+		return ret;
+	}
+
+	// Row map of a change found from the source indices of the rows before it. shift gives the new source index of an
+	// old one (NotFound when it's removed)
+	template<typename F>
+	std::vector<size_t> GetExpectedRowMap(const std::vector<size_t>& sources, const ItemView& view, F&& shift)
+	{
+		const auto rows = view.GetRows();
+		std::vector<size_t> ret;
+
+		for (const size_t index : sources)
+		{
+			const size_t moved = shift(index);
+			ret.push_back(moved == ItemView::NotFound ? ItemView::NotFound : rows[moved]);
+		}
+
+		return ret;
+	}
+
+	std::vector<size_t> Expand(const std::vector<ItemView::RowRange>& ranges)
+	{
+		std::vector<size_t> ret;
+
+		for (size_t i = 0; i < ranges.size(); ++i)
+		{
+			EXPECT_GT(ranges[i].Count, 0u);
+			if (i > 0) EXPECT_GT(ranges[i].First, ranges[i - 1].First + ranges[i - 1].Count);		// Merged and ordered
+
+			for (size_t row = ranges[i].First; row < ranges[i].First + ranges[i].Count; ++row) ret.push_back(row);
+		}
+
+		return ret;
+	}
+}
+
+TEST(ItemViewTests, SortIsStable)
+{
+	List list;
+	list.Values = { 3, 1, 2, 1, 3 };
+
+	auto view = list.CreateView();
+	view.Sort(list.GetComparer());
+	EXPECT_EQ(GetSourceIndices(view), (std::vector<size_t>{ 1, 3, 2, 0, 4 }));
+	EXPECT_EQ(view.GetRow(2), 2u);
+
+	list.Minimum = 2;
+	view.Filter(list.GetPredicate());
+	EXPECT_EQ(GetSourceIndices(view), (std::vector<size_t>{ 2, 0, 4 }));
+	EXPECT_EQ(view.GetRow(1), ItemView::NotFound);
+
+	view.ClearSort();
+	EXPECT_EQ(GetSourceIndices(view), (std::vector<size_t>{ 0, 2, 4 }));
+
+	view.ClearFilter();
+	EXPECT_TRUE(view.IsIdentity());
+}
+
+TEST(ItemViewTests, ParallelSortMatchesStableSort)
+{
+	std::mt19937 random(41);
+	List list;
+
+	for (size_t i = 0; i < ItemView::ParallelSortMinimumCount * 3; ++i) list.Values.push_back(random() % 1000);
+
+	auto view = list.CreateView();
+	view.Sort(list.GetComparer());
+
+	std::vector<size_t> expected(list.Values.size());
+	for (size_t i = 0; i < expected.size(); ++i) expected[i] = i;
+	std::stable_sort(expected.begin(), expected.end(), list.GetComparer());
+
+	EXPECT_EQ(GetSourceIndices(view), expected);
+}
+
+TEST(ItemViewTests, UpdatedItemMoves)
+{
+	List list;
+	list.Values = { 10, 20, 30, 40, 50 };
+	list.IsSorted = true;
+
+	auto view = list.CreateView();
+
+	EXPECT_EQ(view.OnUpdating(0), 0u);
+	list.Values[0] = 45;
+	EXPECT_EQ(view.OnUpdated(0), 3u);
+	EXPECT_EQ(GetSourceIndices(view), (std::vector<size_t>{ 1, 2, 3, 0, 4 }));
+
+	list.Minimum = 25;
+	view.Filter(list.GetPredicate());
+
+	// Filtered out, then back
+	EXPECT_EQ(view.OnUpdating(2), 0u);
+	list.Values[2] = 5;
+	EXPECT_EQ(view.OnUpdated(2), ItemView::NotFound);
+
+	EXPECT_EQ(view.OnUpdating(2), ItemView::NotFound);
+	list.Values[2] = 60;
+	EXPECT_EQ(view.OnUpdated(2), 3u);
+	EXPECT_EQ(GetSourceIndices(view), (std::vector<size_t>{ 3, 0, 4, 2 }));
+}
+
+TEST(ItemViewTests, ChangesMatchFreshView)
+{
+	std::mt19937 random(41);
+
+	for (int round = 0; round < 100; ++round)
+	{
+		List list;
+		list.Values.resize(random() % 200);
+		for (auto& value : list.Values) value = random() % 50;
+
+		auto view = list.CreateView();
+
+		for (int i = 0; i < 200; ++i)
+		{
+			const int operation = random() % 10;
+			const auto rows = view.GetRows();
+			const auto sources = GetSourceIndices(view);
+
+			if (operation < 3)
+			{
+				const size_t index = random() % (list.Values.size() + 1);
+				const size_t count = 1 + random() % (random() % 4 == 0 ? 60 : 4);
+
+				for (size_t j = 0; j < count; ++j) list.Values.insert(list.Values.begin() + index + j, random() % 50);
+
+				const auto ranges = view.OnInsert(index, count);
+				const auto fresh = list.CreateView();
+
+				ASSERT_EQ(Expand(ranges), GetRowsOf(fresh.GetRows(), index, index + count));
+				ASSERT_EQ(ItemView::GetRowMap(ranges, sources.size(), true), GetExpectedRowMap(sources, view, [&](size_t i) { return i >= index ? i + count : i; }));
+			}
+			else if (operation < 5 && !list.Values.empty())
+			{
+				const size_t index = random() % list.Values.size();
+				const size_t count = (std::min)(static_cast<size_t>(1 + random() % (random() % 4 == 0 ? 60 : 4)), list.Values.size() - index);
+
+				list.Values.erase(list.Values.begin() + index, list.Values.begin() + index + count);
+
+				const auto ranges = view.OnErase(index, count);
+
+				ASSERT_EQ(Expand(ranges), GetRowsOf(rows, index, index + count));
+				ASSERT_EQ(ItemView::GetRowMap(ranges, sources.size(), false), GetExpectedRowMap(sources, view, [&](size_t i)
+					{
+						return i >= index + count ? i - count : i >= index ? ItemView::NotFound : i;
+					}));
+			}
+			else if (operation < 8 && !list.Values.empty())
+			{
+				const size_t index = random() % list.Values.size();
+
+				ASSERT_EQ(view.OnUpdating(index), rows[index]);
+
+				list.Values[index] = random() % 50;
+
+				ASSERT_EQ(view.OnUpdated(index), list.CreateView().GetRow(index));
+			}
+			else if (operation == 8)
+			{
+				list.IsSorted = !list.IsSorted;
+				if (list.IsSorted) view.Sort(list.GetComparer()); else view.ClearSort();
+			}
+			else
+			{
+				const int choice = random() % 3;
+
+				if (choice == 0 && list.IsFiltered)
+				{
+					list.Minimum += random() % 5;
+					view.Narrow(list.GetPredicate());
+				}
+				else if (choice == 1)
+				{
+					list.IsFiltered = true;
+					list.Minimum = random() % 30;
+					view.Filter(list.GetPredicate());
+				}
+				else
+				{
+					list.IsFiltered = false;
+					view.ClearFilter();
+				}
+			}
+
+			const auto fresh = list.CreateView();
+
+			ASSERT_EQ(view.GetSourceCount(), list.Values.size());
+			ASSERT_EQ(GetSourceIndices(view), GetSourceIndices(fresh));
+			ASSERT_EQ(view.GetRows(), fresh.GetRows());
+		}
+	}
+}
\ No newline at end of file
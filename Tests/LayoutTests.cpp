@@ -0,0 +1,237 @@
+#include "Layout.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace Layout;
+
+namespace
+{
+	struct Spec
+	{
+		int Parent;
+		PanelType Panel;
+		DockStyle Dock;
+		int X;
+		int Y;
+		int Width;
+		int Height;
+		bool IsAutoSize;
+		bool IsVisible;
+		Thickness Margin;
+		Thickness Padding;
+		FlowDirection Direction;
+		bool IsWrapContents;
+		int Row;
+		int Column;
+		int RowSpan;
+		int ColumnSpan;
+		int ContentWidth;	// Wrapping text of this width when > 0
+	};
+
+	struct Tree
+	{
+		std::vector<std::unique_ptr<Node>> Nodes;
+		std::vector<Rect> Arranged;
+
+		void Build(const std::vector<Spec>& specs)
+		{
+			Nodes.clear();
+			Arranged.assign(specs.size(), Rect{ -1, -1, -1, -1 });
+
+			for (size_t i = 0; i < specs.size(); ++i)
+			{
+				Nodes.push_back(std::make_unique<Node>());
+				Nodes.back()->OnArranged = [this, i](const Rect& r) { Arranged[i] = r; };
+			}
+
+			for (size_t i = 0; i < specs.size(); ++i) Apply(i, specs[i]);
+		}
+
+		void Apply(size_t i, const Spec& s)
+		{
+			auto* node = Nodes[i].get();
+
+			if (s.Parent >= 0 && node->GetParent() == nullptr) Nodes[s.Parent]->Add(node);
+
+			node->SetPanelType(s.Panel);
+			node->SetDock(s.Dock);
+			node->SetLocation(s.X, s.Y);
+			node->SetSize(s.Width, s.Height);
+			node->SetAutoSize(s.IsAutoSize);
+			node->SetVisible(s.IsVisible);
+			node->SetMargin(s.Margin);
+			node->SetPadding(s.Padding);
+			node->SetFlowDirection(s.Direction);
+			node->SetWrapContents(s.IsWrapContents);
+			node->SetCell(s.Row, s.Column, s.RowSpan, s.ColumnSpan);
+
+			if (s.ContentWidth > 0)
+			{
+				const int content = s.ContentWidth;
+				node->SetMeasureFunction([content](Extent available)
+					{
+						const int width = (std::min)(content, (std::max)(available.Width, 10));
+						return Extent{ width, (content + width - 1) / width * 12 };
+					});
+			}
+			else
+			{
+				node->SetMeasureFunction(nullptr);
+			}
+
+			if (s.Panel == PanelType::Grid)
+			{
+				node->SetColumns({ { SizeType::AutoSize, 0 }, { SizeType::Percent, 40 }, { SizeType::Absolute, 50 }, { SizeType::Percent, 60 } });
+				node->SetRows({ { SizeType::Percent, 100 }, { SizeType::AutoSize, 0 } });
+			}
+		}
+	};
+
+	bool IsReachable(const std::vector<Spec>& specs, int i)
+	{
+		for (; i >= 0; i = specs[i].Parent)
+		{
+			if (!specs[i].IsVisible) return false;
+		}
+
+		return true;
+	}
+}
+
+TEST(LayoutTests, DockOrder)
+{
+	Node root, top, left, fill;
+	root.Add(&top);
+	root.Add(&left);
+	root.Add(&fill);
+	root.SetSize(200, 100);
+	top.SetDock(DockStyle::Top);
+	top.SetSize(0, 20);
+	left.SetDock(DockStyle::Left);
+	left.SetSize(30, 0);
+	fill.SetDock(DockStyle::Fill);
+	root.UpdateLayout();
+
+	EXPECT_EQ(top.GetBounds(), (Rect{ 0, 0, 200, 20 }));
+	EXPECT_EQ(left.GetBounds(), (Rect{ 0, 20, 30, 80 }));
+	EXPECT_EQ(fill.GetBounds(), (Rect{ 30, 20, 170, 80 }));
+	EXPECT_TRUE(root.IsLayoutValid());
+}
+
+TEST(LayoutTests, Anchors)
+{
+	Node root, child;
+	root.Add(&child);
+	root.SetSize(200, 100);
+	child.SetLocation(10, 10);
+	child.SetSize(50, 20);
+	root.UpdateLayout();
+
+	child.SetAnchor(AnchorStyles::Right | AnchorStyles::Bottom);
+	root.SetSize(300, 150);
+	root.UpdateLayout();
+	EXPECT_EQ(child.GetBounds(), (Rect{ 110, 60, 50, 20 }));
+
+	child.SetAnchor(AnchorStyles::Left | AnchorStyles::Right | AnchorStyles::Top);
+	root.SetSize(400, 150);
+	root.UpdateLayout();
+	EXPECT_EQ(child.GetBounds(), (Rect{ 110, 60, 150, 20 }));
+}
+
+TEST(LayoutTests, MarginReachesSiblings)
+{
+	Node root, first, second;
+	root.Add(&first);
+	root.Add(&second);
+	root.SetSize(200, 100);
+	first.SetDock(DockStyle::Top);
+	first.SetSize(0, 20);
+	second.SetDock(DockStyle::Top);
+	second.SetSize(0, 20);
+	root.UpdateLayout();
+
+	first.SetMargin(Thickness{ 3, 3, 3, 3 });
+	root.UpdateLayout();
+
+	EXPECT_EQ(first.GetBounds(), (Rect{ 3, 3, 194, 20 }));
+	EXPECT_EQ(second.GetBounds().Y, 26);
+}
+
+TEST(LayoutTests, IncrementalMatchesFromScratch)
+{
+	std::mt19937 random(29);
+	auto next = [&](int a, int b) { return std::uniform_int_distribution<int>(a, b)(random); };
+
+	auto createSpec = [&](int i)
+	{
+		Spec s;
+		s.Parent = i == 0 ? -1 : next(0, i - 1);
+		s.Panel = static_cast<PanelType>(next(0, 2));
+		s.Dock = static_cast<DockStyle>(next(0, 5));
+		s.X = next(0, 100);
+		s.Y = next(0, 100);
+		s.Width = next(0, 200);
+		s.Height = next(0, 200);
+		s.IsAutoSize = next(0, 3) == 0;
+		s.IsVisible = next(0, 9) != 0;
+		s.Margin = Thickness{ next(0, 3), next(0, 3), next(0, 3), next(0, 3) };
+		s.Padding = Thickness{ next(0, 5), next(0, 5), next(0, 5), next(0, 5) };
+		s.Direction = static_cast<FlowDirection>(next(0, 3));
+		s.IsWrapContents = next(0, 1);
+		s.Row = next(0, 2);
+		s.Column = next(0, 4);
+		s.RowSpan = next(1, 2);
+		s.ColumnSpan = next(1, 2);
+		s.ContentWidth = next(0, 2) == 0 ? next(1, 300) : 0;
+
+		if (i == 0)
+		{
+			s.IsAutoSize = false;
+			s.IsVisible = true;
+			s.Width = next(100, 800);
+			s.Height = next(100, 600);
+		}
+
+		return s;
+	};
+
+	for (int trial = 0; trial < 100; ++trial)
+	{
+		const int count = next(2, 60);
+		std::vector<Spec> specs;
+
+		for (int i = 0; i < count; ++i) specs.push_back(createSpec(i));
+
+		Tree incremental;
+		incremental.Build(specs);
+		incremental.Nodes[0]->UpdateLayout();
+
+		for (int step = 0; step < 30; ++step)
+		{
+			const int i = next(0, count - 1);
+			auto s = createSpec(i);
+			s.Parent = specs[i].Parent;
+			specs[i] = s;
+			incremental.Apply(i, s);
+			incremental.Nodes[0]->UpdateLayout();
+
+			Tree reference;
+			reference.Build(specs);
+			reference.Nodes[0]->UpdateLayout();
+
+			for (int k = 0; k < count; ++k)
+			{
+				if (!IsReachable(specs, k)) continue;
+
+				ASSERT_EQ(incremental.Nodes[k]->GetBounds(), reference.Nodes[k]->GetBounds()) << "trial " << trial << " step " << step << " node " << k;
+				ASSERT_EQ(incremental.Arranged[k], incremental.Nodes[k]->GetBounds());
+			}
+
+			ASSERT_TRUE(incremental.Nodes[0]->IsLayoutValid());
+		}
+	}
+}
\ No newline at end of file
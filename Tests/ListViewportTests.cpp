@@ -0,0 +1,141 @@
+#include "ListViewport.h"
+
+#include <gtest/gtest.h>
+#include <climits>
+#include <random>
+#include <vector>
+
+TEST(ListViewportTests, SingleColumn)
+{
+	ListViewport viewport;
+	viewport.SetArea(3, 3, 203, 163);
+	viewport.SetItemSize(200, 16, 0);
+	viewport.SetRowNumber(100);
+	viewport.SetCount(100);
+	viewport.SetScrolling(10, 0);
+
+	EXPECT_EQ(viewport.GetVisibleRange(), std::make_pair(size_t{ 10 }, size_t{ 20 }));
+	EXPECT_TRUE(viewport.IsVisible(10));
+	EXPECT_TRUE(viewport.IsVisible(19));
+	EXPECT_FALSE(viewport.IsVisible(9));
+	EXPECT_FALSE(viewport.IsVisible(20));
+
+	EXPECT_EQ(viewport.GetIndexFromPoint(5, 3), 10u);
+	EXPECT_EQ(viewport.GetIndexFromPoint(5, 3 + 16 * 9 + 2), 19u);
+	EXPECT_EQ(viewport.GetIndexFromPoint(2, 10), ListViewport::NotFound);
+
+	const auto bounds = viewport.GetBounds(12);
+	EXPECT_EQ(bounds.Left, 3);
+	EXPECT_EQ(bounds.Top, 3 + 32);
+	EXPECT_EQ(bounds.Right, 203);
+	EXPECT_EQ(bounds.Bottom, 3 + 48);
+
+	EXPECT_EQ(viewport.GetScrollingToBottom(50), 41u);
+	EXPECT_EQ(viewport.GetScrollingToBottom(3), 0u);
+}
+
+TEST(ListViewportTests, MultiColumn)
+{
+	// Columns 120 pixels wide with 3 pixels of spacing: 4 of them fit in 500 pixels
+	ListViewport viewport;
+	viewport.SetArea(0, 0, 500, 160);
+	viewport.SetItemSize(120, 16, 3);
+	viewport.SetRowNumber(10);
+	viewport.SetCount(95);
+	viewport.SetScrolling(0, 2);
+
+	EXPECT_EQ(viewport.GetVisibleRange(), std::make_pair(size_t{ 20 }, size_t{ 60 }));
+	EXPECT_EQ(viewport.GetIndexFromPoint(0, 0), 20u);
+	EXPECT_EQ(viewport.GetIndexFromPoint(121, 17), 31u);
+	EXPECT_EQ(viewport.GetIndexFromPoint(119, 0), ListViewport::NotFound);		// Spacing between the columns
+
+	viewport.SetScrolling(0, 8);
+	EXPECT_EQ(viewport.GetVisibleRange(), std::make_pair(size_t{ 80 }, size_t{ 95 }));
+	EXPECT_EQ(viewport.GetIndexFromPoint(130, 100), ListViewport::NotFound);		// Past the last item
+}
+
+TEST(ListViewportTests, FarBoundsAreClamped)
+{
+	ListViewport viewport;
+	viewport.SetArea(0, 0, 100, 100);
+	viewport.SetItemSize(100, 16, 0);
+	viewport.SetRowNumber(1000000000);
+	viewport.SetCount(1000000000);
+
+	EXPECT_EQ(viewport.GetBounds(999999999).Top, INT_MAX);
+	EXPECT_FALSE(viewport.IsVisible(999999999));
+}
+
+TEST(ListViewportTests, EmptyArea)
+{
+	ListViewport viewport;
+	viewport.SetArea(0, 0, 100, 0);
+	viewport.SetItemSize(100, 16, 0);
+	viewport.SetRowNumber(10);
+	viewport.SetCount(10);
+
+	EXPECT_EQ(viewport.GetVisibleRange(), std::make_pair(size_t{ 0 }, size_t{ 0 }));
+
+	viewport.SetRowNumber(0);
+	EXPECT_EQ(viewport.GetIndexFromPoint(0, 0), ListViewport::NotFound);
+}
+
+TEST(ListViewportTests, VariableHeightsMatchLinearLayout)
+{
+	std::mt19937 random(39);
+
+	for (int round = 0; round < 50; ++round)
+	{
+		std::vector<int> heights(1 + random() % 300);
+		for (auto& height : heights) height = 1 + random() % 40;
+
+		RowHeightIndex index;
+		index.Reset(heights);
+
+		const int areaHeight = 1 + random() % 400;
+		ListViewport viewport;
+		viewport.SetArea(5, 7, 105, 7 + areaHeight);
+		viewport.SetItemSize(100, 16, 0);
+		viewport.SetRowNumber(heights.size());
+		viewport.SetCount(heights.size());
+		viewport.SetRowHeights(&index);
+
+		for (int i = 0; i < 20; ++i)
+		{
+			const size_t scrolling = random() % heights.size();
+			viewport.SetScrolling(scrolling, 0);
+
+			// Tops computed row by row
+			std::vector<long long> tops(heights.size() + 1, 0);
+			for (size_t row = 0; row < heights.size(); ++row) tops[row + 1] = tops[row] + heights[row];
+
+			size_t last = scrolling;
+			while (last < heights.size() && tops[last + 1] - tops[scrolling] <= areaHeight) ++last;
+
+			// An item taller than the area leaves nothing to draw
+			ASSERT_EQ(viewport.GetVisibleRange(), last == scrolling ? std::make_pair(size_t{ 0 }, size_t{ 0 }) : std::make_pair(scrolling, last));
+
+			for (size_t row = 0; row < heights.size(); ++row)
+			{
+				const auto bounds = viewport.GetBounds(row);
+				ASSERT_EQ(bounds.Top, 7 + tops[row] - tops[scrolling]);
+				ASSERT_EQ(bounds.Bottom, bounds.Top + heights[row]);
+				ASSERT_EQ(viewport.IsVisible(row), row >= scrolling && row < last);
+			}
+
+			const int y = 7 + static_cast<int>(random() % areaHeight);
+			size_t expected = scrolling;
+			while (expected < heights.size() && tops[expected + 1] - tops[scrolling] <= y - 7) ++expected;
+
+			ASSERT_EQ(viewport.GetIndexFromPoint(50, y), expected < heights.size() ? expected : ListViewport::NotFound);
+
+			// The bottom scrolling shows the whole item with as many rows above it as possible
+			const size_t item = random() % heights.size();
+			const size_t bottom = viewport.GetScrollingToBottom(item);
+
+			ASSERT_LE(bottom, item);
+			if (tops[item + 1] - tops[item] <= areaHeight) ASSERT_LE(tops[item + 1] - tops[bottom], areaHeight);
+			if (bottom > 0) ASSERT_GT(tops[item + 1] - tops[bottom - 1], areaHeight);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+#include "PieceTable.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <string>
+
+TEST(PieceTableTests, InsertAndErase)
+{
+	PieceTable table("Hello\nWorld");
+	table.Insert(5, ",");
+	table.Insert(table.GetLength(), "!\n");
+	table.Erase(0, 1);
+	table.Insert(0, "J");
+
+	EXPECT_EQ(table.GetText(), "Jello,\nWorld!\n");
+	EXPECT_EQ(table.GetLineCount(), 3u);
+	EXPECT_EQ(table.GetLineStart(1), 7u);
+	EXPECT_EQ(table.GetLineStart(2), 14u);
+	EXPECT_EQ(table.GetLineStart(3), 14u);
+	EXPECT_EQ(table.GetLineFromOffset(7), 1u);
+	EXPECT_EQ(table.GetText(2, 8), "llo,\nWor");
+}
+
+TEST(PieceTableTests, ChunksCoverTheRange)
+{
+	PieceTable table("abcdef");
+	table.Insert(3, "XYZ");
+	table.Insert(0, "12");
+
+	std::string text;
+	size_t chunks = 0;
+	table.ForEachChunk(1, 8, [&](std::string_view chunk) { text += chunk; ++chunks; });
+
+	EXPECT_EQ(text, "2abcXYZd");
+	EXPECT_GT(chunks, 1u);
+}
+
+TEST(PieceTableTests, MatchesString)
+{
+	std::mt19937 random(33);
+
+	for (int round = 0; round < 10; ++round)
+	{
+		std::string reference;
+		const int length = random() % 500;
+
+		for (int i = 0; i < length; ++i) reference += "ab\nc"[random() % 4];
+
+		PieceTable table(reference);
+
+		for (int i = 0; i < 3000; ++i)
+		{
+			const int operation = random() % 6;
+
+			if (operation < 3)
+			{
+				size_t offset = random() % (reference.size() + 1);
+				std::string text;
+				const int count = 1 + random() % (random() % 10 == 0 ? 50 : 3);
+
+				for (int k = 0; k < count; ++k) text += "xy\nz"[random() % 4];
+
+				// Appending is the common case when typing
+				if (operation == 0) offset = reference.size();
+
+				reference.insert(offset, text);
+				table.Insert(offset, text);
+			}
+			else if (operation < 5 && !reference.empty())
+			{
+				const size_t offset = random() % reference.size();
+				const size_t count = (std::min)(static_cast<size_t>(1 + random() % 20), reference.size() - offset);
+
+				reference.erase(offset, count);
+				table.Erase(offset, count);
+			}
+			else if (random() % 100 == 0)
+			{
+				table.Assign(reference);
+			}
+
+			ASSERT_EQ(table.GetLength(), reference.size());
+
+			if (i % 5 != 0) continue;
+
+			ASSERT_EQ(table.GetText(), reference);
+
+			const size_t lines = 1 + std::count(reference.begin(), reference.end(), '\n');
+			ASSERT_EQ(table.GetLineCount(), lines);
+
+			for (int k = 0; k < 5; ++k)
+			{
+				const size_t offset = random() % (reference.size() + 1);
+				ASSERT_EQ(table.GetLineFromOffset(offset), static_cast<size_t>(std::count(reference.begin(), reference.begin() + offset, '\n')));
+
+				if (offset < reference.size()) ASSERT_EQ(table.GetChar(offset), reference[offset]);
+
+				const size_t count = random() % 30;
+				ASSERT_EQ(table.GetText(offset, count), reference.substr(offset, count));
+
+				const size_t line = random() % (lines + 1);
+				size_t start = line == 0 ? 0 : reference.size();
+
+				for (size_t c = 0, n = 0; line > 0 && c < reference.size(); ++c)
+				{
+					if (reference[c] == '\n' && ++n == line)
+					{
+						start = c + 1;
+						break;
+					}
+				}
+
+				ASSERT_EQ(table.GetLineStart(line), start);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,158 @@
+#include "PrefixIndex.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	std::string ToLower(std::string value)
+	{
+		for (auto& c : value) if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+		return value;
+	}
+
+	// First count indices of the values starting with the prefix, by value and then by index
+	std::vector<size_t> FindLinear(const std::vector<std::string>& values, const std::string& prefix, size_t count)
+	{
+		std::vector<size_t> ret;
+		const auto key = ToLower(prefix);
+
+		for (size_t i = 0; i < values.size(); ++i)
+		{
+			if (ToLower(values[i]).starts_with(key)) ret.push_back(i);
+		}
+
+		std::stable_sort(ret.begin(), ret.end(), [&](size_t a, size_t b) { return ToLower(values[a]) < ToLower(values[b]); });
+		if (ret.size() > count) ret.resize(count);
+
+		return ret;
+	}
+
+	std::vector<size_t> Find(const PrefixIndex& index, const std::string& prefix, size_t count)
+	{
+		std::vector<size_t> ret(count);
+		ret.resize(index.Find(prefix, ret));
+		return ret;
+	}
+
+	std::string CreateWord(std::mt19937& random)
+	{
+		std::string ret;
+		for (size_t i = 1 + random() % 5; i > 0; --i) ret += "aAbBc"[random() % 5];
+		return ret;
+	}
+}
+
+TEST(PrefixIndexTests, FindIgnoresCase)
+{
+	PrefixIndex index;
+	index.Build({ "Banana", "apple", "Apricot", "avocado", "apple" });
+
+	EXPECT_EQ(Find(index, "AP", 10), (std::vector<size_t>{ 1, 4, 2 }));
+	EXPECT_EQ(Find(index, "a", 2), (std::vector<size_t>{ 1, 4 }));
+	EXPECT_EQ(Find(index, "c", 10), (std::vector<size_t>{}));
+	EXPECT_EQ(Find(index, "", 1), (std::vector<size_t>{ 1 }));
+}
+
+TEST(PrefixIndexTests, InsertsAtTheSamePlace)
+{
+	// Each insertion halves the gap between the labels of its neighbours until they are all spaced again
+	std::vector<std::string> values = { "first", "last" };
+	PrefixIndex index;
+	index.Build(values);
+
+	for (int i = 0; i < 200; ++i)
+	{
+		const std::vector<std::string> added = { "item " + std::to_string(i) };
+		values.insert(values.begin() + 1, added.begin(), added.end());
+		index.Insert(1, added);
+	}
+
+	EXPECT_EQ(Find(index, "item 1", 3), FindLinear(values, "item 1", 3));
+	EXPECT_EQ(Find(index, "l", 1), (std::vector<size_t>{ values.size() - 1 }));
+	EXPECT_EQ(Find(index, "f", 1), (std::vector<size_t>{ 0 }));
+}
+
+TEST(PrefixIndexTests, ScansDuringBuild)
+{
+	std::mt19937 random(44);
+	std::vector<std::string> values(PrefixIndex::BackgroundBuildMinimumCount + 1000);
+	for (auto& value : values) value = CreateWord(random);
+
+	PrefixIndex index;
+	index.Build(values);
+
+	// Queries and changes made before the index is ready give the same results as after
+	for (int i = 0; i < 20; ++i)
+	{
+		const size_t at = random() % values.size();
+		values[at] = CreateWord(random);
+		index.Update(at, values[at]);
+
+		const std::vector<std::string> added = { CreateWord(random) };
+		values.insert(values.begin() + at, added.begin(), added.end());
+		index.Insert(at, added);
+
+		const auto prefix = CreateWord(random);
+		ASSERT_EQ(Find(index, prefix, 5), FindLinear(values, prefix, 5));
+	}
+
+	index.WaitForBuild();
+	EXPECT_TRUE(index.IsReady());
+
+	for (int i = 0; i < 20; ++i)
+	{
+		const auto prefix = CreateWord(random);
+		ASSERT_EQ(Find(index, prefix, 5), FindLinear(values, prefix, 5));
+	}
+}
+
+TEST(PrefixIndexTests, ChangesMatchLinearSearch)
+{
+	std::mt19937 random(44);
+
+	for (int round = 0; round < 20; ++round)
+	{
+		std::vector<std::string> values(random() % 200);
+		for (auto& value : values) value = CreateWord(random);
+
+		PrefixIndex index;
+		index.Build(values);
+
+		for (int i = 0; i < 300; ++i)
+		{
+			const int operation = random() % 3;
+
+			if (operation == 0 || values.empty())
+			{
+				const size_t at = random() % (values.size() + 1);
+				std::vector<std::string> added(random() % 2 == 0 ? 1 + random() % 3 : 20 + random() % 10);
+				for (auto& value : added) value = CreateWord(random);
+
+				values.insert(values.begin() + at, added.begin(), added.end());
+				index.Insert(at, added);
+			}
+			else if (operation == 1)
+			{
+				const size_t at = random() % values.size();
+				const size_t count = 1 + random() % (std::min)(values.size() > 40 ? size_t{ 30 } : size_t{ 5 }, values.size() - at);
+
+				values.erase(values.begin() + at, values.begin() + at + count);
+				index.Erase(at, count);
+			}
+			else
+			{
+				const size_t at = random() % values.size();
+				values[at] = CreateWord(random);
+				index.Update(at, values[at]);
+			}
+
+			const auto prefix = CreateWord(random).substr(0, random() % 3);
+			const size_t count = 1 + random() % 8;
+			ASSERT_EQ(Find(index, prefix, count), FindLinear(values, prefix, count));
+		}
+	}
+}
\ No newline at end of file
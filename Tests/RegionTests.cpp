@@ -0,0 +1,194 @@
+#include "Region.h"
+
+#include <gtest/gtest.h>
+#include <random>
+
+using Drawing::Region;
+
+namespace
+{
+	struct Rect
+	{
+		int X;
+		int Y;
+		int Width;
+		int Height;
+
+		Rect(int x, int y, int width, int height) : X(x), Y(y), Width(width), Height(height) {}
+	};
+
+	// Reference model: one bool per pixel of a small canvas
+	constexpr int CanvasSize = 64;
+
+	struct Bitmap
+	{
+		bool Pixels[CanvasSize][CanvasSize] = {};
+
+		void Apply(const Rect& r, int operation)
+		{
+			for (int y = 0; y < CanvasSize; ++y)
+			{
+				for (int x = 0; x < CanvasSize; ++x)
+				{
+					const bool inside = x >= r.X && x < r.X + r.Width && y >= r.Y && y < r.Y + r.Height;
+
+					if (operation == 0) Pixels[y][x] |= inside;
+					else if (operation == 1) Pixels[y][x] &= inside;
+					else Pixels[y][x] &= !inside;
+				}
+			}
+		}
+	};
+
+	// The rectangles of the region must cover the bitmap exactly, without overlapping
+	::testing::AssertionResult Matches(const Region& region, const Bitmap& bitmap)
+	{
+		Bitmap covered;
+		bool isOverlapping = false;
+
+		region.ForEach([&](int x, int y, int width, int height)
+			{
+				for (int j = y; j < y + height; ++j)
+				{
+					for (int i = x; i < x + width; ++i)
+					{
+						isOverlapping |= covered.Pixels[j][i];
+						covered.Pixels[j][i] = true;
+					}
+				}
+			});
+
+		if (isOverlapping) return ::testing::AssertionFailure() << "rectangles overlap";
+
+		for (int y = 0; y < CanvasSize; ++y)
+		{
+			for (int x = 0; x < CanvasSize; ++x)
+			{
+				if (covered.Pixels[y][x] != bitmap.Pixels[y][x] || region.Contains(x, y) != bitmap.Pixels[y][x])
+				{
+					return ::testing::AssertionFailure() << "mismatch at " << x << ", " << y;
+				}
+			}
+		}
+
+		return ::testing::AssertionSuccess();
+	}
+
+	Rect RandomRect(std::mt19937& random, int maximumSize)
+	{
+		Rect r(random() % CanvasSize, random() % CanvasSize, random() % maximumSize, random() % maximumSize);
+		r.Width = (std::min)(r.Width, CanvasSize - r.X);
+		r.Height = (std::min)(r.Height, CanvasSize - r.Y);
+		return r;
+	}
+}
+
+TEST(RegionTests, EmptyRegion)
+{
+	Region region;
+
+	EXPECT_TRUE(region.IsEmpty());
+	EXPECT_EQ(region.GetRectangleCount(), 0u);
+	EXPECT_FALSE(region.Contains(0, 0));
+	EXPECT_TRUE(Region(5, 5, 0, 10).IsEmpty());
+}
+
+TEST(RegionTests, OverlappingRectanglesAreSplitInBands)
+{
+	Region region(0, 0, 6, 2);
+	region.Union(Rect(3, 1, 6, 2));
+
+	// Band 0: [0, 6), band 1: [0, 9), band 2: [3, 9)
+	EXPECT_EQ(region.GetBandCount(), 3u);
+	EXPECT_EQ(region.GetRectangleCount(), 3u);
+	EXPECT_EQ(region.GetBounds<Rect>().Width, 9);
+	EXPECT_EQ(region.GetBounds<Rect>().Height, 3);
+}
+
+TEST(RegionTests, AdjacentBandsAreCoalesced)
+{
+	Region region(0, 0, 10, 5);
+	region.Union(Rect(0, 5, 10, 5));
+
+	EXPECT_EQ(region, Region(0, 0, 10, 10));
+	EXPECT_EQ(region.GetRectangleCount(), 1u);
+}
+
+TEST(RegionTests, Offset)
+{
+	Region region(0, 0, 4, 4);
+	region.Offset(10, 20);
+
+	EXPECT_TRUE(region.Contains(10, 20));
+	EXPECT_FALSE(region.Contains(0, 0));
+	EXPECT_EQ(region, Region(10, 20, 4, 4));
+}
+
+TEST(RegionTests, OperationsMatchBitmap)
+{
+	std::mt19937 random(27);
+
+	for (int round = 0; round < 2000; ++round)
+	{
+		Region region;
+		Bitmap bitmap;
+
+		for (int step = 0; step < 12; ++step)
+		{
+			const int operation = step == 0 ? 0 : random() % 3;
+			const auto r = RandomRect(random, 20);
+
+			if (operation == 0) region.Union(r);
+			else if (operation == 1) region.Intersect(r);
+			else region.Subtract(r);
+
+			bitmap.Apply(r, operation);
+			ASSERT_TRUE(Matches(region, bitmap)) << "round " << round << " step " << step;
+		}
+
+		// The representation is canonical: the same area built from its own rectangles is equal
+		Region rebuilt;
+		region.ForEach([&](int x, int y, int width, int height) { rebuilt.Union(Rect(x, y, width, height)); });
+		ASSERT_EQ(rebuilt, region);
+
+		for (int i = 0; i < 20; ++i)
+		{
+			const Rect r(random() % CanvasSize, random() % CanvasSize, random() % 10 + 1, random() % 10 + 1);
+			bool isIntersecting = false;
+
+			for (int y = r.Y; y < (std::min)(r.Y + r.Height, CanvasSize); ++y)
+			{
+				for (int x = r.X; x < (std::min)(r.X + r.Width, CanvasSize); ++x)
+				{
+					isIntersecting |= bitmap.Pixels[y][x];
+				}
+			}
+
+			ASSERT_EQ(region.IntersectsWith(r), isIntersecting);
+		}
+	}
+}
+
+TEST(RegionTests, SimplifyCoversTheSameArea)
+{
+	std::mt19937 random(2027);
+
+	for (int round = 0; round < 500; ++round)
+	{
+		Region region;
+
+		for (int i = 0; i < 10; ++i)
+		{
+			region.Union(RandomRect(random, 12));
+		}
+
+		for (size_t maximum = 1; maximum <= 8; ++maximum)
+		{
+			Region simplified = region;
+			simplified.Simplify(maximum);
+
+			EXPECT_LE(simplified.GetRectangleCount(), (std::max)(maximum, size_t(1)));
+			EXPECT_TRUE(Region::Subtract(region, simplified).IsEmpty());
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,152 @@
+#include "RowCache.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+	// Keys of the rows a cache of the budget holds, most recently used first
+	struct Reference
+	{
+		size_t Budget;
+		std::vector<RowCache::Key> Keys;
+
+		static size_t GetPixelCount(const RowCache::Key& key) { return static_cast<size_t>(key.Width) * key.Height; }
+
+		size_t GetPixelCount() const
+		{
+			size_t ret = 0;
+			for (const auto& key : Keys) ret += GetPixelCount(key);
+			return ret;
+		}
+
+		void Evict(size_t budget)
+		{
+			while (!Keys.empty() && GetPixelCount() > budget) Keys.pop_back();
+		}
+
+		bool Find(const RowCache::Key& key)
+		{
+			const auto it = std::find(Keys.begin(), Keys.end(), key);
+			if (it == Keys.end()) return false;
+
+			std::rotate(Keys.begin(), it, it + 1);
+			return true;
+		}
+
+		bool Add(const RowCache::Key& key)
+		{
+			if (key.Width <= 0 || key.Height <= 0 || GetPixelCount(key) > Budget) return false;
+
+			std::erase(Keys, key);
+			Evict(Budget - GetPixelCount(key));
+			Keys.insert(Keys.begin(), key);
+
+			return true;
+		}
+	};
+}
+
+TEST(RowCacheTests, KeyedByFont)
+{
+	RowCache cache;
+	auto* surface = cache.Add({ 3, 0, 1, 4, 2 });
+	ASSERT_NE(surface, nullptr);
+	std::fill(surface->Pixels.begin(), surface->Pixels.end(), 7u);
+
+	EXPECT_EQ(cache.Find({ 3, 0, 2, 4, 2 }), nullptr);
+	ASSERT_NE(cache.Find({ 3, 0, 1, 4, 2 }), nullptr);
+	EXPECT_EQ(cache.Find({ 3, 0, 1, 4, 2 })->Pixels[0], 7u);
+}
+
+TEST(RowCacheTests, PixelsFollowShiftedItems)
+{
+	RowCache cache;
+
+	for (size_t i = 0; i < 10; ++i)
+	{
+		auto* surface = cache.Add({ i, 0, 0, 4, 2 });
+		std::fill(surface->Pixels.begin(), surface->Pixels.end(), static_cast<uint32_t>(i));
+	}
+
+	cache.OnInsert(3, 2);
+	cache.OnErase(0, 1);
+
+	EXPECT_EQ(cache.GetCount(), 9u);
+
+	for (size_t i = 1; i < 10; ++i)
+	{
+		const size_t item = i < 3 ? i - 1 : i + 1;
+		const auto* surface = cache.Find({ item, 0, 0, 4, 2 });
+
+		ASSERT_NE(surface, nullptr);
+		EXPECT_EQ(surface->Pixels[0], i);
+	}
+}
+
+TEST(RowCacheTests, MatchesLeastRecentlyUsed)
+{
+	std::mt19937 random(47);
+
+	for (int round = 0; round < 100; ++round)
+	{
+		const size_t budget = 50 + random() % 400;
+		RowCache cache(budget);
+		Reference reference{ budget };
+
+		for (int i = 0; i < 300; ++i)
+		{
+			const RowCache::Key key{ random() % 20, random() % 3, random() % 2, static_cast<int>(random() % 12) - 1, static_cast<int>(random() % 12) };
+			const int operation = random() % 10;
+
+			if (operation < 4)
+			{
+				ASSERT_EQ(cache.Find(key) != nullptr, reference.Find(key));
+			}
+			else if (operation < 8)
+			{
+				const auto* surface = cache.Add(key);
+
+				ASSERT_EQ(surface != nullptr, reference.Add(key));
+				if (surface != nullptr) ASSERT_EQ(surface->Pixels.size(), Reference::GetPixelCount(key));
+			}
+			else if (operation == 8)
+			{
+				const size_t item = random() % 20;
+
+				cache.Invalidate(item);
+				std::erase_if(reference.Keys, [item](const RowCache::Key& key) { return key.Item == item; });
+			}
+			else
+			{
+				const size_t index = random() % 20;
+				const size_t count = 1 + random() % 3;
+
+				if (random() % 2 == 0)
+				{
+					cache.OnInsert(index, count);
+					for (auto& key : reference.Keys) if (key.Item >= index) key.Item += count;
+				}
+				else
+				{
+					cache.OnErase(index, count);
+					std::erase_if(reference.Keys, [&](const RowCache::Key& key) { return key.Item >= index && key.Item < index + count; });
+					for (auto& key : reference.Keys) if (key.Item >= index + count) key.Item -= count;
+				}
+			}
+
+			if (i % 50 == 0 && random() % 4 == 0)
+			{
+				reference.Budget = random() % 400;
+				cache.SetBudget(reference.Budget);
+				reference.Evict(reference.Budget);
+			}
+
+			ASSERT_EQ(cache.GetCount(), reference.Keys.size());
+			ASSERT_EQ(cache.GetPixelCount(), reference.GetPixelCount());
+			ASSERT_LE(cache.GetPixelCount(), cache.GetBudget());
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+#include "RowHeightIndex.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+	// Offsets and rows found from prefix sums of the heights
+	void ExpectEqual(const RowHeightIndex& index, const std::vector<int>& heights)
+	{
+		std::vector<long long> tops(heights.size() + 1, 0);
+		for (size_t row = 0; row < heights.size(); ++row) tops[row + 1] = tops[row] + heights[row];
+
+		ASSERT_EQ(index.GetCount(), heights.size());
+		ASSERT_EQ(index.GetTotal(), tops.back());
+
+		for (size_t row = 0; row < heights.size(); ++row) ASSERT_EQ(index.GetHeight(row), heights[row]);
+		for (size_t row = 0; row <= heights.size(); ++row) ASSERT_EQ(index.GetOffset(row), tops[row]);
+
+		for (long long offset = -2; offset <= tops.back() + 2; ++offset)
+		{
+			// Rows of no height are skipped
+			const size_t expected = offset < 0 ? 0 : static_cast<size_t>(std::upper_bound(tops.begin() + 1, tops.end(), offset) - (tops.begin() + 1));
+			ASSERT_EQ(index.GetRow(offset), expected);
+		}
+	}
+}
+
+TEST(RowHeightIndexTests, Offsets)
+{
+	RowHeightIndex index;
+	index.Reset({ 10, 20, 0, 5 });
+
+	EXPECT_EQ(index.GetOffset(0), 0);
+	EXPECT_EQ(index.GetOffset(3), 30);
+	EXPECT_EQ(index.GetTotal(), 35);
+	EXPECT_EQ(index.GetRow(9), 0u);
+	EXPECT_EQ(index.GetRow(10), 1u);
+	EXPECT_EQ(index.GetRow(30), 3u);
+	EXPECT_EQ(index.GetRow(35), 4u);
+
+	index.SetHeight(0, 1);
+	EXPECT_EQ(index.GetOffset(1), 1);
+	EXPECT_EQ(index.GetRow(1), 1u);
+}
+
+TEST(RowHeightIndexTests, Move)
+{
+	RowHeightIndex index;
+	index.Reset({ 1, 2, 3, 4, 5 });
+
+	index.Move(0, 3);
+	ExpectEqual(index, { 2, 3, 4, 1, 5 });
+
+	index.Move(4, 1);
+	ExpectEqual(index, { 2, 5, 3, 4, 1 });
+}
+
+TEST(RowHeightIndexTests, ChangesMatchPrefixSums)
+{
+	std::mt19937 random(45);
+
+	for (int round = 0; round < 300; ++round)
+	{
+		std::vector<int> heights(random() % 100);
+		for (auto& height : heights) height = random() % 4 == 0 ? 0 : 1 + random() % 30;
+
+		RowHeightIndex index;
+		index.Reset(heights);
+
+		for (int i = 0; i < 10; ++i)
+		{
+			const int operation = random() % 4;
+
+			if (operation == 0 && !heights.empty())
+			{
+				const size_t row = random() % heights.size();
+				heights[row] = random() % 40;
+				index.SetHeight(row, heights[row]);
+			}
+			else if (operation == 1)
+			{
+				const size_t row = random() % (heights.size() + 1);
+				std::vector<int> added(1 + random() % 4);
+				for (auto& height : added) height = random() % 20;
+
+				heights.insert(heights.begin() + row, added.begin(), added.end());
+				index.Insert(row, added);
+			}
+			else if (operation == 2 && !heights.empty())
+			{
+				const size_t row = random() % heights.size();
+				const size_t count = 1 + random() % (heights.size() - row);
+
+				heights.erase(heights.begin() + row, heights.begin() + row + count);
+				index.Erase(row, count);
+			}
+			else if (!heights.empty())
+			{
+				const size_t from = random() % heights.size();
+				const size_t to = random() % heights.size();
+				const int height = heights[from];
+
+				heights.erase(heights.begin() + from);
+				heights.insert(heights.begin() + to, height);
+				index.Move(from, to);
+			}
+
+			ExpectEqual(index, heights);
+		}
+	}
+}
\ No newline at end of file
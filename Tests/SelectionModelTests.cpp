@@ -0,0 +1,163 @@
+#include "SelectionModel.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+	// Checks the model against one flag per item
+	void ExpectSame(const SelectionModel& model, const std::vector<char>& reference)
+	{
+		size_t count = 0;
+		size_t first = SelectionModel::NotFound;
+		size_t last = SelectionModel::NotFound;
+
+		for (size_t i = 0; i < reference.size(); ++i)
+		{
+			ASSERT_EQ(model.IsSelected(i), static_cast<bool>(reference[i])) << i;
+
+			if (!reference[i]) continue;
+
+			++count;
+			if (first == SelectionModel::NotFound) first = i;
+			last = i;
+		}
+
+		ASSERT_EQ(model.GetCount(), count);
+		ASSERT_EQ(model.GetFirst(), first);
+		ASSERT_EQ(model.GetLast(), last);
+
+		// Ranges are disjoint, not touching and in order
+		size_t previous = 0;
+		size_t ranges = 0;
+		size_t total = 0;
+
+		model.ForEachRange([&](size_t rangeFirst, size_t rangeLast)
+		{
+			ASSERT_LT(rangeFirst, rangeLast);
+			if (ranges != 0) ASSERT_GT(rangeFirst, previous);
+
+			previous = rangeLast;
+			total += rangeLast - rangeFirst;
+			++ranges;
+		});
+
+		ASSERT_EQ(total, count);
+		ASSERT_EQ(model.GetRangeCount(), ranges);
+	}
+}
+
+TEST(SelectionModelTests, RangesMerge)
+{
+	SelectionModel model;
+
+	model.SelectRange(10, 20, true);
+	model.SelectRange(20, 30, true);
+	EXPECT_EQ(model.GetRangeCount(), 1u);
+	EXPECT_EQ(model.GetCount(), 20u);
+
+	model.Toggle(15);
+	EXPECT_EQ(model.GetRangeCount(), 2u);
+	EXPECT_EQ(model.GetCount(), 19u);
+
+	model.Select(15, true);
+	EXPECT_EQ(model.GetRangeCount(), 1u);
+
+	model.SelectAll(1000000);
+	EXPECT_EQ(model.GetRangeCount(), 1u);
+	EXPECT_EQ(model.GetCount(), 1000000u);
+
+	model.Clear();
+	EXPECT_EQ(model.GetCount(), 0u);
+	EXPECT_EQ(model.GetFirst(), SelectionModel::NotFound);
+}
+
+TEST(SelectionModelTests, InsertAndErase)
+{
+	SelectionModel model;
+	model.SelectRange(5, 10, true);
+	model.Select(20, true);
+
+	// Inserted items are unselected and split the range they land in
+	model.Insert(7, 3);
+	EXPECT_TRUE(model.IsSelected(6));
+	EXPECT_FALSE(model.IsSelected(7));
+	EXPECT_TRUE(model.IsSelected(10));
+	EXPECT_TRUE(model.IsSelected(23));
+	EXPECT_EQ(model.GetCount(), 6u);
+
+	// Erasing the gap joins the two parts again
+	model.Erase(7, 3);
+	EXPECT_EQ(model.GetRangeCount(), 2u);
+	EXPECT_TRUE(model.IsSelected(20));
+
+	model.Erase(0, 8);
+	EXPECT_EQ(model.GetFirst(), 0u);
+	EXPECT_EQ(model.GetLast(), 12u);
+	EXPECT_EQ(model.GetCount(), 3u);
+}
+
+TEST(SelectionModelTests, MatchesFlags)
+{
+	std::mt19937 random(40);
+
+	for (int round = 0; round < 200; ++round)
+	{
+		const size_t count = 1 + random() % 300;
+		SelectionModel model;
+		std::vector<char> reference(count, 0);
+
+		for (int i = 0; i < 300; ++i)
+		{
+			const int operation = random() % 8;
+			const size_t a = random() % reference.size();
+			const size_t b = random() % (reference.size() + 1);
+
+			if (operation == 0)
+			{
+				model.Toggle(a);
+				reference[a] ^= 1;
+			}
+			else if (operation == 1)
+			{
+				const bool value = random() % 2;
+				model.Select(a, value);
+				reference[a] = value;
+			}
+			else if (operation <= 3)
+			{
+				const size_t first = (std::min)(a, b);
+				const size_t last = (std::max)(a, b);
+				model.SelectRange(first, last, operation == 2);
+				std::fill(reference.begin() + first, reference.begin() + last, operation == 2);
+			}
+			else if (operation == 4 && random() % 20 == 0)
+			{
+				model.SelectAll(reference.size());
+				std::fill(reference.begin(), reference.end(), 1);
+			}
+			else if (operation == 5 && random() % 20 == 0)
+			{
+				model.Clear();
+				std::fill(reference.begin(), reference.end(), 0);
+			}
+			else if (operation == 6)
+			{
+				const size_t inserted = 1 + random() % 10;
+				model.Insert(b, inserted);
+				reference.insert(reference.begin() + b, inserted, 0);
+			}
+			else if (operation == 7 && reference.size() > 1)
+			{
+				const size_t erased = (std::min)(static_cast<size_t>(1 + random() % 10), reference.size() - a - 1);
+				model.Erase(a, erased);
+				reference.erase(reference.begin() + a, reference.begin() + a + erased);
+			}
+
+			ExpectSame(model, reference);
+			if (HasFatalFailure()) return;
+		}
+	}
+}
\ No newline at end of file
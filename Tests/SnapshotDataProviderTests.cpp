@@ -0,0 +1,135 @@
+#include "SnapshotDataProvider.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	struct Entry
+	{
+		int Id;
+		std::string Value;
+		bool Tabulated = false;
+		bool Visible = true;
+		bool Selected = false;
+	};
+
+	constexpr int Producers = 4;
+	constexpr int Batches = 200;
+	constexpr int BatchSize = 97;
+
+	std::string GetValue(int id)
+	{
+		return "p" + std::to_string(id / 1000000) + ":" + std::to_string(id / 1000 % 1000) + ":" + std::to_string(id % 1000);
+	}
+}
+
+TEST(SnapshotDataProviderTests, RefreshTakesThePublishedSnapshot)
+{
+	SnapshotDataProvider provider;
+	EXPECT_FALSE(provider.Refresh());
+	EXPECT_EQ(provider.GetCount(), 0u);
+
+	ItemSnapshot::Builder builder;
+	builder.Add(Entry{ 1, "one" });
+	provider.Publish(builder.Build());
+
+	// Nothing changes for the control until it refreshes
+	EXPECT_EQ(provider.GetCount(), 0u);
+	EXPECT_TRUE(provider.Refresh());
+	EXPECT_FALSE(provider.Refresh());
+
+	std::string text;
+	provider.GetText(0, { &text, 1 });
+	EXPECT_EQ(text, "one");
+
+	// A producer building on a snapshot which isn't the published one anymore must start again
+	const auto base = provider.GetPublished();
+	provider.Publish(ItemSnapshot::Builder().Build());
+	EXPECT_FALSE(provider.Publish(base, ItemSnapshot::Builder(*base, 1).Build()));
+}
+
+// Producers append batches to the latest snapshot while the control thread refreshes and reads rows
+TEST(SnapshotDataProviderTests, ConcurrentProducers)
+{
+	SnapshotDataProvider provider;
+	std::vector<std::thread> producers;
+
+	for (int p = 0; p < Producers; ++p)
+	{
+		producers.emplace_back([&provider, p]()
+			{
+				for (int batch = 0; batch < Batches; ++batch)
+				{
+					std::vector<Entry> entries(BatchSize);
+
+					for (int i = 0; i < BatchSize; ++i)
+					{
+						const int id = p * 1000000 + batch * 1000 + i;
+						entries[i] = { id, GetValue(id) };
+					}
+
+					for (;;)
+					{
+						const auto base = provider.GetPublished();
+						auto builder = base != nullptr ? ItemSnapshot::Builder(*base, base->GetCount()) : ItemSnapshot::Builder();
+						builder.Add(entries.begin(), entries.end());
+
+						if (provider.Publish(base, builder.Build())) break;
+					}
+				}
+			});
+	}
+
+	std::mt19937 random(48);
+	std::vector<std::string> page(64);
+	size_t count = 0;
+	const size_t total = static_cast<size_t>(Producers) * Batches * BatchSize;
+
+	while (count < total)
+	{
+		if (!provider.Refresh()) continue;
+
+		// Whole batches only, never fewer items than before
+		ASSERT_GE(provider.GetCount(), count);
+		ASSERT_EQ(provider.GetCount() % BatchSize, 0u);
+		count = provider.GetCount();
+
+		// The rows of the current snapshot stay the same while other snapshots are published
+		const auto snapshot = provider.GetSnapshot();
+		const size_t first = random() % count;
+		const size_t length = (std::min)(page.size(), count - first);
+		provider.GetText(first, { page.data(), length });
+
+		for (size_t i = 0; i < length; ++i)
+		{
+			ASSERT_EQ(page[i], GetValue(snapshot->GetId(first + i)));
+		}
+	}
+
+	for (auto& producer : producers) producer.join();
+
+	// Every batch once, in order for each producer
+	const auto snapshot = provider.GetSnapshot();
+	std::vector<int> next(Producers, 0);
+
+	for (size_t i = 0; i < snapshot->GetCount(); i += BatchSize)
+	{
+		const int id = snapshot->GetId(i);
+		const int producer = id / 1000000;
+
+		ASSERT_EQ(id / 1000 % 1000, next[producer]++);
+
+		for (size_t k = 0; k < BatchSize; ++k)
+		{
+			ASSERT_EQ(snapshot->GetId(i + k), id + static_cast<int>(k));
+			ASSERT_EQ(snapshot->GetValue(i + k), GetValue(id + static_cast<int>(k)));
+		}
+	}
+
+	EXPECT_EQ(next, std::vector<int>(Producers, Batches));
+}
\ No newline at end of file
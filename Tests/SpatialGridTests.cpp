@@ -0,0 +1,128 @@
+#include "SpatialGrid.h"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace
+{
+	struct Bounds
+	{
+		int X;
+		int Y;
+		int Width;
+		int Height;
+		bool IsLive;
+	};
+
+	bool Contains(const Bounds& b, int x, int y)
+	{
+		return b.IsLive && b.X <= x && x < b.X + b.Width && b.Y <= y && y < b.Y + b.Height;
+	}
+
+	bool Intersects(const Bounds& b, int x, int y, int width, int height)
+	{
+		return b.IsLive && b.Width > 0 && b.Height > 0 && b.X < x + width && x < b.X + b.Width && b.Y < y + height && y < b.Y + b.Height;
+	}
+}
+
+TEST(SpatialGridTests, PointQuery)
+{
+	SpatialGrid<int> grid(64);
+	grid.Update(1, 0, 0, 100, 100);
+	grid.Update(2, 50, 50, 10, 10);
+
+	std::set<int> hits;
+	grid.QueryPoint(55, 55, [&](int key) { hits.insert(key); });
+	EXPECT_EQ(hits, (std::set<int>{ 1, 2 }));
+
+	hits.clear();
+	grid.QueryPoint(60, 60, [&](int key) { hits.insert(key); });
+	EXPECT_EQ(hits, (std::set<int>{ 1 }));
+}
+
+TEST(SpatialGridTests, UpdateMovesAndRemoveForgets)
+{
+	SpatialGrid<int> grid(64);
+	grid.Update(1, 0, 0, 10, 10);
+	grid.Update(1, 500, 500, 10, 10);
+
+	size_t count = 0;
+	grid.QueryPoint(5, 5, [&](int) { ++count; });
+	EXPECT_EQ(count, 0u);
+
+	grid.QueryPoint(505, 505, [&](int) { ++count; });
+	EXPECT_EQ(count, 1u);
+
+	grid.Remove(1);
+	EXPECT_FALSE(grid.Contains(1));
+	EXPECT_EQ(grid.GetCount(), 0u);
+}
+
+TEST(SpatialGridTests, NegativeCoordinatesAndLargeItems)
+{
+	SpatialGrid<int> grid(64);
+	grid.Update(1, -200, -200, 50, 50);
+	grid.Update(2, 0, 0, 20000, 20000);	// Covers too many cells, kept apart
+
+	std::set<int> hits;
+	grid.QueryPoint(-180, -180, [&](int key) { hits.insert(key); });
+	EXPECT_EQ(hits, (std::set<int>{ 1 }));
+
+	hits.clear();
+	grid.QueryRectangle(-300, -300, 400, 400, [&](int key) { hits.insert(key); });
+	EXPECT_EQ(hits, (std::set<int>{ 1, 2 }));
+}
+
+TEST(SpatialGridTests, QueriesMatchBruteForce)
+{
+	constexpr int Count = 2000;
+	std::mt19937 random(28);
+	auto next = [&](int a, int b) { return std::uniform_int_distribution<int>(a, b)(random); };
+
+	SpatialGrid<int> grid(64);
+	std::vector<Bounds> bounds(Count, Bounds{ 0, 0, 0, 0, false });
+
+	for (int i = 0; i < 40000; ++i)
+	{
+		const int key = next(0, Count - 1);
+		const int operation = next(0, 9);
+
+		if (operation < 7)
+		{
+			bounds[key] = Bounds{ next(-100, 3000), next(-100, 3000), next(0, operation == 0 ? 2000 : 120), next(0, operation == 0 ? 2000 : 60), true };
+			grid.Update(key, bounds[key].X, bounds[key].Y, bounds[key].Width, bounds[key].Height);
+		}
+		else
+		{
+			bounds[key].IsLive = false;
+			grid.Remove(key);
+		}
+	}
+
+	for (int q = 0; q < 1000; ++q)
+	{
+		const int x = next(-150, 3100);
+		const int y = next(-150, 3100);
+
+		std::set<int> actual;
+		std::set<int> expected;
+
+		grid.QueryPoint(x, y, [&](int key) { actual.insert(key); });
+		for (int k = 0; k < Count; ++k) if (Contains(bounds[k], x, y)) expected.insert(k);
+		ASSERT_EQ(actual, expected);
+
+		const int width = next(1, q % 10 == 0 ? 4000 : 300);
+		const int height = next(1, 300);
+		std::multiset<int> found;
+
+		expected.clear();
+		grid.QueryRectangle(x, y, width, height, [&](int key) { found.insert(key); });
+		for (int k = 0; k < Count; ++k) if (Intersects(bounds[k], x, y, width, height)) expected.insert(k);
+
+		// Every item is reported once even when it's in several cells
+		ASSERT_EQ(found.size(), expected.size());
+		ASSERT_EQ(std::set<int>(found.begin(), found.end()), expected);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,159 @@
+#include "TabOrder.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <map>
+#include <random>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+	// Registered items with their tab index and registration order, the chain is sorted again for every query
+	struct Model
+	{
+		struct Slot
+		{
+			int TabIndex;
+			uint64_t Sequence;
+			bool IsLinked;
+		};
+
+		std::map<int, Slot> Slots;
+		uint64_t Sequence = 0;
+
+		void Update(int item, int tabIndex, bool isLinked)
+		{
+			auto [it, isNew] = Slots.try_emplace(item);
+			if (isNew) it->second.Sequence = Sequence++;
+			it->second.TabIndex = tabIndex;
+			it->second.IsLinked = isLinked;
+		}
+
+		template<typename Predicate>
+		int GetNext(int item, bool isForward, Predicate&& predicate) const
+		{
+			std::vector<std::tuple<int, uint64_t, int>> chain;
+
+			for (const auto& [key, slot] : Slots)
+			{
+				if (slot.IsLinked) chain.emplace_back(slot.TabIndex, slot.Sequence, key);
+			}
+
+			std::sort(chain.begin(), chain.end());
+			if (!isForward) std::reverse(chain.begin(), chain.end());
+
+			// Items after this one in the walking order, then the ones before it
+			size_t first = 0;
+
+			if (const auto it = Slots.find(item); it != Slots.end())
+			{
+				const auto order = std::make_pair(it->second.TabIndex, it->second.Sequence);
+				const auto isBefore = [&](size_t i)
+					{
+						const auto other = std::make_pair(std::get<0>(chain[i]), std::get<1>(chain[i]));
+						return isForward ? other <= order : other >= order;
+					};
+
+				while (first < chain.size() && isBefore(first)) ++first;
+			}
+
+			for (size_t i = 0; i < chain.size(); ++i)
+			{
+				const int other = std::get<2>(chain[(first + i) % chain.size()]);
+
+				if (other == item) break;
+				if (predicate(other)) return other;
+			}
+
+			return 0;
+		}
+	};
+}
+
+TEST(TabOrderTests, DisabledItemsAreSkipped)
+{
+	TabOrder<int> order;
+	order.Update(1, 0, true);
+	order.Update(2, 1, false);
+	order.Update(3, 2, true);
+
+	EXPECT_EQ(order.GetCount(), 3u);
+	EXPECT_EQ(order.GetLinkedCount(), 2u);
+	EXPECT_EQ(order.GetNextIndex(), 3);
+
+	const auto any = [](int) { return true; };
+	EXPECT_EQ(order.GetNext(1, any), 3);
+	EXPECT_EQ(order.GetNext(3, any), 1);
+	EXPECT_EQ(order.GetPrevious(1, any), 3);
+
+	// Going on from a disabled item starts from its place in the chain
+	EXPECT_EQ(order.GetNext(2, any), 3);
+	EXPECT_EQ(order.GetPrevious(2, any), 1);
+
+	// No other item to go to
+	EXPECT_EQ(order.GetNext(1, [](int item) { return item != 3; }), 0);
+}
+
+TEST(TabOrderTests, RemovedItemsAreForgotten)
+{
+	TabOrder<int> order;
+	order.Update(1, 0, true);
+	order.Update(2, 1, true);
+	order.Remove(2);
+	order.Remove(7);
+
+	EXPECT_FALSE(order.Contains(2));
+	EXPECT_EQ(order.GetCount(), 1u);
+	EXPECT_EQ(order.GetLinkedCount(), 1u);
+	EXPECT_EQ(order.GetNext(1, [](int) { return true; }), 0);
+
+	// Registered again after the items already there with the same index
+	order.Update(3, 0, true);
+	order.Update(2, 0, true);
+	EXPECT_EQ(order.GetNext(1, [](int) { return true; }), 3);
+	EXPECT_EQ(order.GetNext(3, [](int) { return true; }), 2);
+}
+
+TEST(TabOrderTests, ChangesMatchSortedChain)
+{
+	std::mt19937 random(50);
+
+	for (int round = 0; round < 100; ++round)
+	{
+		TabOrder<int> order;
+		Model model;
+		std::vector<bool> isAccepted(64);
+
+		for (int i = 0; i < 300; ++i)
+		{
+			const int item = 1 + random() % 40;
+			const int operation = random() % 5;
+
+			if (operation < 3)
+			{
+				const int tabIndex = random() % 20;
+				const bool isLinked = random() % 4 != 0;
+
+				order.Update(item, tabIndex, isLinked);
+				model.Update(item, tabIndex, isLinked);
+			}
+			else if (operation == 3)
+			{
+				order.Remove(item);
+				model.Slots.erase(item);
+			}
+			else
+			{
+				isAccepted[item] = random() % 3 != 0;
+			}
+
+			const auto predicate = [&](int other) { return isAccepted[other]; };
+			const int from = 1 + random() % 40;
+
+			ASSERT_EQ(order.GetCount(), model.Slots.size());
+			ASSERT_EQ(order.GetNext(from, predicate), model.GetNext(from, true, predicate));
+			ASSERT_EQ(order.GetPrevious(from, predicate), model.GetNext(from, false, predicate));
+		}
+	}
+}
\ No newline at end of file
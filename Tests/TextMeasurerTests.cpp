@@ -0,0 +1,107 @@
+#include "TextMeasurer.h"
+#include "DeterministicTextMetrics.h"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+
+namespace
+{
+	const FontDescriptor Regular{ "Segoe", 12, false, false };
+	const FontDescriptor Bold{ "Segoe", 16, true, false };
+
+	// Counts the calls reaching the backend
+	class CountingTextMetrics final : public ITextMetrics
+	{
+	private:
+
+		DeterministicTextMetrics m_Metrics;
+
+	public:
+
+		size_t FontLoads = 0;
+		size_t Measures = 0;
+
+		explicit CountingTextMetrics(bool hasKerning) : m_Metrics(hasKerning) {}
+
+		FontMetrics GetFontMetrics(const FontDescriptor& font) override { ++FontLoads; return m_Metrics.GetFontMetrics(font); }
+		void GetAdvances(const FontDescriptor& font, int (&advances)[256]) override { m_Metrics.GetAdvances(font, advances); }
+		bool HasKerning(const FontDescriptor& font) override { return m_Metrics.HasKerning(font); }
+		int MeasureWidth(const FontDescriptor& font, std::string_view text) override { ++Measures; return m_Metrics.MeasureWidth(font, text); }
+	};
+}
+
+TEST(TextMeasurerTests, MatchesBackend)
+{
+	for (const bool hasKerning : { false, true })
+	{
+		TextMeasurer measurer(std::make_unique<DeterministicTextMetrics>(hasKerning), 64);
+		DeterministicTextMetrics reference(hasKerning);
+		std::mt19937 random(31);
+
+		for (int i = 0; i < 20000; ++i)
+		{
+			std::string text;
+			const int length = random() % 20;
+
+			for (int j = 0; j < length; ++j) text += "AVToLTabc xyz"[random() % 13];
+
+			const auto& font = i % 2 ? Regular : Bold;
+			ASSERT_EQ(measurer.MeasureWidth(font, text), reference.MeasureWidth(font, text)) << text;
+		}
+
+		// Only the kerning path uses the extent cache
+		EXPECT_EQ(measurer.GetCacheHits() + measurer.GetCacheMisses() > 0, hasKerning);
+	}
+}
+
+TEST(TextMeasurerTests, LoadsEachFontOnce)
+{
+	auto backend = std::make_unique<CountingTextMetrics>(false);
+	auto& counter = *backend;
+	TextMeasurer measurer(std::move(backend));
+
+	for (int i = 0; i < 100; ++i)
+	{
+		measurer.MeasureWidth(Regular, "Hello");
+		measurer.MeasureWidth(Bold, "World");
+	}
+
+	EXPECT_EQ(counter.FontLoads, 2u);
+	EXPECT_EQ(counter.Measures, 0u);
+
+	measurer.Clear();
+	measurer.MeasureWidth(Regular, "Hello");
+	EXPECT_EQ(counter.FontLoads, 3u);
+}
+
+TEST(TextMeasurerTests, KerningExtentsAreEvicted)
+{
+	auto backend = std::make_unique<CountingTextMetrics>(true);
+	auto& counter = *backend;
+	TextMeasurer measurer(std::move(backend), 2);
+
+	measurer.MeasureWidth(Regular, "AV");
+	measurer.MeasureWidth(Regular, "To");
+	measurer.MeasureWidth(Regular, "AV");	// Hit, "To" becomes the least recently used
+	measurer.MeasureWidth(Regular, "LT");	// Evicts "To"
+	measurer.MeasureWidth(Regular, "AV");
+	measurer.MeasureWidth(Regular, "To");
+
+	EXPECT_EQ(measurer.GetCacheHits(), 2u);
+	EXPECT_EQ(measurer.GetCacheMisses(), 4u);
+	EXPECT_EQ(counter.Measures, 4u);
+}
+
+TEST(TextMeasurerTests, MeasureUsesFontHeight)
+{
+	TextMeasurer measurer(std::make_unique<DeterministicTextMetrics>());
+	DeterministicTextMetrics reference;
+
+	const auto extent = measurer.Measure(Regular, "A");
+	EXPECT_EQ(extent.Width, reference.MeasureWidth(Regular, "A"));
+	EXPECT_EQ(extent.Height, reference.GetFontMetrics(Regular).Height);
+
+	// Only the characters inside the view are measured
+	EXPECT_EQ(measurer.Measure(Regular, std::string_view("AB", 1)), extent);
+}
\ No newline at end of file
@@ -0,0 +1,147 @@
+#include "TextSearch.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	char Fold(char c, bool isCaseSensitive)
+	{
+		return !isCaseSensitive && c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+	}
+
+	std::vector<size_t> FindAllNaive(const std::string& text, const std::string& pattern, bool isCaseSensitive)
+	{
+		std::vector<size_t> ret;
+
+		for (size_t i = 0; !pattern.empty() && i + pattern.size() <= text.size(); ++i)
+		{
+			size_t j = 0;
+			while (j < pattern.size() && Fold(text[i + j], isCaseSensitive) == Fold(pattern[j], isCaseSensitive)) ++j;
+			if (j == pattern.size()) ret.push_back(i);
+		}
+
+		return ret;
+	}
+
+	std::string CreateText(std::mt19937& random, const char* alphabet, size_t alphabetLength, size_t length)
+	{
+		std::string ret;
+		for (size_t i = 0; i < length; ++i) ret += alphabet[random() % alphabetLength];
+		return ret;
+	}
+}
+
+TEST(TextSearchTests, FindMatchesStringFind)
+{
+	std::mt19937 random(36);
+	TextSearch search;
+
+	for (int i = 0; i < 2000; ++i)
+	{
+		const auto text = CreateText(random, "abcd", 4, random() % 200);
+		const auto pattern = CreateText(random, "abcd", 4, 1 + random() % 20);
+		const size_t start = random() % (text.size() + 2);
+
+		search.SetPattern(pattern);
+		ASSERT_EQ(search.Find(text, start), text.find(pattern, start)) << text << " / " << pattern;
+	}
+}
+
+TEST(TextSearchTests, CaseInsensitive)
+{
+	TextSearch search;
+	search.SetPattern("LAZY dog", false);
+
+	EXPECT_EQ(search.Find("The lazy DOG"), 4u);
+	EXPECT_EQ(search.Find("The lazy cat"), TextSearch::NotFound);
+
+	// Long patterns go through Horspool
+	search.SetPattern("OVER THE LAZY DOG WHILE", false);
+	EXPECT_EQ(search.Find("jumps over the lazy dog while logging"), 6u);
+}
+
+TEST(TextSearchTests, ReplaceAll)
+{
+	PieceTable document("aaa lazy bb lazy");
+	TextSearch search;
+	search.SetPattern("lazy");
+
+	const auto replacement = search.ReplaceAll(document, "sleepy");
+	EXPECT_EQ(replacement.Count, 2u);
+
+	auto text = document.GetText();
+	text.replace(replacement.Offset, replacement.Length, replacement.Text);
+	EXPECT_EQ(text, "aaa sleepy bb sleepy");
+}
+
+TEST(TextSearchTests, CachedMatchesFollowEdits)
+{
+	std::mt19937 random(36);
+	const char* alphabet = "abAB\nc";
+
+	for (int round = 0; round < 100; ++round)
+	{
+		auto reference = CreateText(random, alphabet, 6, random() % 400);
+		PieceTable document(reference);
+		TextSearch search;
+		bool isCaseSensitive = random() % 2;
+		auto pattern = CreateText(random, alphabet, 5, 1 + random() % (random() % 3 == 0 ? 20 : 4));
+
+		search.SetPattern(pattern, isCaseSensitive);
+		ASSERT_EQ(search.FindAll(document), FindAllNaive(reference, pattern, isCaseSensitive));
+
+		for (int i = 0; i < 300; ++i)
+		{
+			const int operation = random() % 8;
+
+			if (operation < 3)
+			{
+				const size_t offset = random() % (reference.size() + 1);
+				const auto text = CreateText(random, alphabet, 6, 1 + random() % (random() % 5 == 0 ? 30 : 3));
+
+				reference.insert(offset, text);
+				document.Insert(offset, text);
+				search.OnEdit(document, offset, 0, text.size());
+			}
+			else if (operation < 5 && !reference.empty())
+			{
+				const size_t offset = random() % reference.size();
+				const size_t count = (std::min)(static_cast<size_t>(1 + random() % 10), reference.size() - offset);
+
+				reference.erase(offset, count);
+				document.Erase(offset, count);
+				search.OnEdit(document, offset, count, 0);
+			}
+			else if (operation == 5)
+			{
+				// Extending the pattern refines the cached matches (incremental search)
+				if (random() % 2 && pattern.size() < 25)
+				{
+					pattern += alphabet[random() % 5];
+				}
+				else
+				{
+					pattern = CreateText(random, alphabet, 5, 1 + random() % (random() % 3 == 0 ? 20 : 4));
+					isCaseSensitive = random() % 2;
+				}
+
+				search.SetPattern(pattern, isCaseSensitive);
+			}
+			else
+			{
+				const auto expected = FindAllNaive(reference, pattern, isCaseSensitive);
+				ASSERT_EQ(search.FindAll(document), expected);
+
+				const size_t offset = random() % (reference.size() + 1);
+				const auto next = std::lower_bound(expected.begin(), expected.end(), offset);
+				ASSERT_EQ(search.FindNext(document, offset), expected.empty() ? TextSearch::NotFound : next != expected.end() ? *next : expected.front());
+			}
+		}
+
+		ASSERT_EQ(search.FindAll(document), FindAllNaive(reference, pattern, isCaseSensitive));
+	}
+}
\ No newline at end of file
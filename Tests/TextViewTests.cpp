@@ -0,0 +1,139 @@
+#include "TextView.h"
+#include "DeterministicTextMetrics.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	const FontDescriptor Regular{ "Segoe", 12, false, false };
+
+	std::vector<std::string> SplitLines(const std::string& text)
+	{
+		std::vector<std::string> ret(1);
+
+		for (const auto c : text)
+		{
+			if (c == '\n') ret.emplace_back();
+			else ret.back() += c;
+		}
+
+		return ret;
+	}
+}
+
+TEST(TextViewTests, ViewportAndCaret)
+{
+	TextMeasurer measurer(std::make_unique<DeterministicTextMetrics>());
+	PieceTable document("first\nsecond\nthird\nfourth");
+	TextView view(document);
+	view.SetFont(measurer, Regular);
+	view.SetViewportHeight(2 * view.GetLineHeight());
+
+	EXPECT_EQ(view.GetVisibleLineCount(), 2u);
+
+	view.EnsureVisible(3);
+	EXPECT_EQ(view.GetFirstVisibleLine(), 2u);
+
+	int x, y;
+	view.GetPointFromOffset(document.GetLineStart(3) + 2, x, y);
+	EXPECT_EQ(x, measurer.MeasureWidth(Regular, "fo"));
+	EXPECT_EQ(y, view.GetLineHeight());
+	EXPECT_EQ(view.GetOffsetFromPoint(x, y), document.GetLineStart(3) + 2);
+}
+
+TEST(TextViewTests, LayoutsAreReused)
+{
+	TextMeasurer measurer(std::make_unique<DeterministicTextMetrics>());
+	PieceTable document("a\nb\nc\nd\ne");
+	TextView view(document);
+	view.SetFont(measurer, Regular);
+	view.SetViewportHeight(5 * view.GetLineHeight());
+
+	auto draw = [&] { view.ForEachVisibleLine([](size_t, size_t, int, const TextView::LineLayout&) {}); };
+	draw();
+	const auto misses = view.GetCacheMisses();
+	draw();
+	EXPECT_EQ(view.GetCacheMisses(), misses);
+
+	// Same font again keeps the layouts
+	view.SetFont(measurer, Regular);
+	draw();
+	EXPECT_EQ(view.GetCacheMisses(), misses);
+
+	// Only the edited line is laid out again
+	view.OnEdit(2, 0, 0);
+	document.Insert(document.GetLineStart(2), "x");
+	draw();
+	EXPECT_EQ(view.GetCacheMisses(), misses + 1);
+}
+
+TEST(TextViewTests, MatchesDocument)
+{
+	std::mt19937 random(35);
+	TextMeasurer measurer(std::make_unique<DeterministicTextMetrics>());
+
+	for (int round = 0; round < 10; ++round)
+	{
+		std::string reference;
+		for (int i = 0; i < 300; ++i) reference += "ab\nc de"[random() % 7];
+
+		PieceTable document(reference);
+		TextView view(document, 8 + random() % 20);
+		view.SetFont(measurer, Regular);
+		view.SetViewportHeight(5 * view.GetLineHeight() + 3);
+
+		for (int i = 0; i < 2000; ++i)
+		{
+			const int operation = random() % 5;
+
+			if (operation == 0)
+			{
+				const size_t offset = random() % (reference.size() + 1);
+				std::string text;
+				const int count = 1 + random() % 4;
+
+				for (int k = 0; k < count; ++k) text += "x\ny"[random() % 3];
+
+				view.OnEdit(document.GetLineFromOffset(offset), 0, std::count(text.begin(), text.end(), '\n'));
+				document.Insert(offset, text);
+				reference.insert(offset, text);
+			}
+			else if (operation == 1 && !reference.empty())
+			{
+				const size_t offset = random() % reference.size();
+				const size_t count = (std::min)(static_cast<size_t>(1 + random() % 6), reference.size() - offset);
+				const size_t line = document.GetLineFromOffset(offset);
+
+				view.OnEdit(line, document.GetLineFromOffset(offset + count) - line, 0);
+				document.Erase(offset, count);
+				reference.erase(offset, count);
+			}
+			else if (operation == 2)
+			{
+				view.ScrollBy(static_cast<long long>(random() % 7) - 3);
+			}
+			else if (operation == 3)
+			{
+				view.EnsureVisible(random() % document.GetLineCount());
+			}
+
+			const auto lines = SplitLines(reference);
+			size_t count = 0;
+
+			view.ForEachVisibleLine([&](size_t line, size_t offset, int y, const TextView::LineLayout& layout)
+				{
+					ASSERT_EQ(layout.Text, lines[line]);
+					ASSERT_EQ(offset, document.GetLineStart(line));
+					ASSERT_EQ(y, static_cast<int>(line - view.GetFirstVisibleLine()) * view.GetLineHeight());
+					ASSERT_EQ(layout.Positions.back(), measurer.MeasureWidth(Regular, layout.Text));
+					++count;
+				});
+
+			ASSERT_EQ(count, (std::min)(view.GetVisibleLineCount(), lines.size() - view.GetFirstVisibleLine()));
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,172 @@
+#include "UndoJournal.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	void Revert(std::string& text, const UndoJournal::Edit& e)
+	{
+		ASSERT_EQ(text.compare(e.Offset, e.Inserted.size(), e.Inserted), 0);
+		text.replace(e.Offset, e.Inserted.size(), e.Removed);
+	}
+
+	void Apply(std::string& text, const UndoJournal::Edit& e)
+	{
+		text.replace(e.Offset, e.Removed.size(), e.Inserted);
+	}
+}
+
+TEST(UndoJournalTests, TypingIsMerged)
+{
+	UndoJournal journal;
+	journal.Record(0, "", "a");
+	journal.Record(1, "", "b");
+	journal.Record(2, "", "c");
+	EXPECT_EQ(journal.GetCount(), 1u);
+
+	journal.BreakMerge();
+	journal.Record(3, "", "d");
+	EXPECT_EQ(journal.GetCount(), 2u);
+
+	const auto e = journal.Undo();
+	ASSERT_NE(e, nullptr);
+	EXPECT_EQ(e->Inserted, "d");
+
+	const auto f = journal.Undo();
+	ASSERT_NE(f, nullptr);
+	EXPECT_EQ(f->Inserted, "abc");
+	EXPECT_FALSE(journal.CanUndo());
+	EXPECT_TRUE(journal.CanRedo());
+}
+
+TEST(UndoJournalTests, OverwritingASelectionIsOneStep)
+{
+	std::string text = "hello world";
+	UndoJournal journal;
+
+	journal.Record(6, "world", "");
+	text.erase(6, 5);
+	journal.Record(6, "", "t");
+	text.insert(6, "t");
+	journal.Record(7, "", "here");
+	text.insert(7, "here");
+	EXPECT_EQ(journal.GetCount(), 1u);
+
+	Revert(text, *journal.Undo());
+	EXPECT_EQ(text, "hello world");
+}
+
+TEST(UndoJournalTests, RecordDropsRedo)
+{
+	UndoJournal journal;
+	journal.Record(0, "", "a");
+	journal.BreakMerge();
+	journal.Record(1, "", "b");
+	journal.Undo();
+	EXPECT_TRUE(journal.CanRedo());
+
+	journal.Record(1, "", "c");
+	EXPECT_FALSE(journal.CanRedo());
+	EXPECT_EQ(journal.GetCount(), 2u);
+}
+
+TEST(UndoJournalTests, MemoryBudget)
+{
+	UndoJournal journal(10000);
+
+	for (int i = 0; i < 20000; ++i)
+	{
+		journal.Record(i * 2, "", "a");
+		journal.BreakMerge();
+		ASSERT_LE(journal.GetMemoryUsage(), journal.GetMemoryBudget());
+	}
+
+	EXPECT_GT(journal.GetCount(), 0u);
+	EXPECT_LT(journal.GetCount(), 20000u);
+}
+
+TEST(UndoJournalTests, UndoAndRedoReplayEveryState)
+{
+	std::mt19937 random(34);
+
+	for (int round = 0; round < 20; ++round)
+	{
+		std::string text = "hello world";
+		UndoJournal journal(SIZE_MAX);
+		std::vector<std::string> states{ text };
+		size_t caret = text.size();
+
+		// The journal may merge the edit in the last entry, the last state is updated instead of added then
+		auto recorded = [&]
+		{
+			if (journal.GetCount() + 1 > states.size()) states.push_back(text);
+			else states.back() = text;
+		};
+
+		for (int i = 0; i < 2000; ++i)
+		{
+			const int operation = random() % 20;
+
+			if (operation < 12)
+			{
+				const std::string s(1, "abc \n"[random() % 5]);
+				journal.Record(caret, "", s);
+				text.insert(caret++, s);
+				recorded();
+			}
+			else if (operation < 15 && caret > 0)
+			{
+				journal.Record(caret - 1, text.substr(caret - 1, 1), "");
+				text.erase(--caret, 1);
+				recorded();
+			}
+			else if (operation < 17 && caret < text.size())
+			{
+				journal.Record(caret, text.substr(caret, 1), "");
+				text.erase(caret, 1);
+				recorded();
+			}
+			else if (operation < 18 && caret < text.size())
+			{
+				const size_t count = (std::min)(static_cast<size_t>(1 + random() % 5), text.size() - caret);
+				journal.Record(caret, text.substr(caret, count), "");
+				text.erase(caret, count);
+				recorded();
+				journal.Record(caret, "", "Z");
+				text.insert(caret++, "Z");
+				recorded();
+			}
+			else
+			{
+				caret = random() % (text.size() + 1);
+				journal.BreakMerge();
+			}
+		}
+
+		ASSERT_EQ(states.size(), journal.GetCount() + 1);
+
+		std::string document = text;
+		size_t position = journal.GetCount();
+
+		while (const auto e = journal.Undo())
+		{
+			Revert(document, *e);
+			ASSERT_EQ(document, states[--position]);
+		}
+
+		ASSERT_EQ(document, "hello world");
+
+		while (const auto e = journal.Redo())
+		{
+			Apply(document, *e);
+			ASSERT_EQ(document, states[++position]);
+		}
+
+		ASSERT_EQ(document, text);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "Point.h"
+#include "Size.h"
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+static_assert(std::is_trivially_copyable_v<Point> && std::is_trivially_copyable_v<Size>);
+
+TEST(ValueTypeTests, PointFromWord)
+{
+	// Low word is X, high word is Y, both unsigned like LOWORD and HIWORD
+	EXPECT_EQ(Point(0x00200010), Point(0x10, 0x20));
+	EXPECT_EQ(Point(static_cast<int>(0xFFFF8000u)), Point(0x8000, 0xFFFF));
+	EXPECT_TRUE(Point(0).IsEmpty());
+}
+
+TEST(ValueTypeTests, Arithmetic)
+{
+	EXPECT_EQ(Point(1, 2) + Point(3, 4), Point(4, 6));
+	EXPECT_EQ(Point::Subtract(Point(1, 2), Point(3, 4)), Point(-2, -2));
+	EXPECT_EQ(Size(6, 8) / 2, Size(3, 4));
+	EXPECT_EQ(Size(6, 8) * 2, Size(12, 16));
+	EXPECT_EQ(Size(7, 9) / 2.0f, Size(3, 4));
+	EXPECT_EQ(Size::Add(Size(1, 1), Size(2, 3)), Size(3, 4));
+
+	const Point p(5, 6);
+	EXPECT_TRUE(p.Equals(&p));
+	EXPECT_FALSE(p.Equals(nullptr));
+}
+
+TEST(ValueTypeTests, HashedValuesMatchEquality)
+{
+	std::mt19937 random(26);
+	std::unordered_set<Point, ValueHash<Point>> points;
+	std::vector<Point> values;
+
+	for (int i = 0; i < 2000; ++i)
+	{
+		const Point p(random() % 50, random() % 50);
+
+		if (points.insert(p).second) values.push_back(p);
+	}
+
+	for (const auto& p : values)
+	{
+		EXPECT_TRUE(points.contains(p));
+		EXPECT_EQ(ValueHash<Point>()(p), ValueHash<Point>()(Point(p.X, p.Y)));
+	}
+
+	EXPECT_EQ(points.size(), values.size());
+}
+
+TEST(ValueTypeTests, ArraysAreCopiedAsBytes)
+{
+	std::vector<Point> points(100, Point(0, 0));
+	for (int i = 0; i < 100; ++i) points[i] = Point(i, -i);
+
+	std::vector<Point> copy(points.size(), Point(0, 0));
+	std::memcpy(copy.data(), points.data(), points.size() * sizeof(Point));
+
+	EXPECT_EQ(copy, points);
+}
\ No newline at end of file
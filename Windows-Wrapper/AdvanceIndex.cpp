@@ -0,0 +1,270 @@
+#include "AdvanceIndex.h"
+
+#include <algorithm>
+#include <bit>
+
+AdvanceIndex::AdvanceIndex() noexcept
+	:
+	m_Count(0),
+	m_Width(0)
+{
+
+}
+
+size_t AdvanceIndex::Locate(size_t& index, int& offset) const noexcept
+{
+	if (index >= m_Count)
+	{
+		const auto& last = m_Blocks.back();
+		index -= m_Count - last.GetCount();
+		offset = m_Width - last.GetWidth();
+		return m_Blocks.size() - 1;
+	}
+
+	// Walks down the tree skipping every block which ends before the index
+	size_t block = 0;
+	offset = 0;
+
+	for (size_t step = std::bit_floor(m_Blocks.size()); step > 0; step >>= 1)
+	{
+		if (block + step <= m_Blocks.size() && m_CountTree[block + step] <= index)
+		{
+			block += step;
+			index -= m_CountTree[block];
+			offset += m_WidthTree[block];
+		}
+	}
+
+	return block;
+}
+
+bool AdvanceIndex::Split(size_t block)
+{
+	bool ret = false;
+
+	while (m_Blocks[block].GetCount() > 2 * BlockSize)
+	{
+		auto& b = m_Blocks[block];
+		const int width = b.Positions[BlockSize - 1];
+
+		Block tail;
+		tail.Positions.assign(b.Positions.begin() + BlockSize, b.Positions.end());
+		for (auto& p : tail.Positions) p -= width;
+		b.Positions.resize(BlockSize);
+
+		m_Blocks.insert(m_Blocks.begin() + block + 1, std::move(tail));
+		++block;
+		ret = true;
+	}
+
+	return ret;
+}
+
+bool AdvanceIndex::Merge(size_t block)
+{
+	if (m_Blocks[block].Positions.empty())
+	{
+		if (m_Blocks.size() == 1) return false;
+
+		m_Blocks.erase(m_Blocks.begin() + block);
+		return true;
+	}
+
+	// Keep blocks from degenerating into many tiny ones after erasing
+	if (block + 1 < m_Blocks.size() && m_Blocks[block].GetCount() + m_Blocks[block + 1].GetCount() <= BlockSize)
+	{
+		auto& b = m_Blocks[block];
+		const auto& next = m_Blocks[block + 1];
+		const int width = b.GetWidth();
+
+		for (const auto p : next.Positions) b.Positions.push_back(p + width);
+
+		m_Blocks.erase(m_Blocks.begin() + block + 1);
+		return true;
+	}
+
+	return false;
+}
+
+void AdvanceIndex::Rebuild()
+{
+	const size_t n = m_Blocks.size();
+	m_CountTree.assign(n + 1, 0);
+	m_WidthTree.assign(n + 1, 0);
+
+	for (size_t i = 1; i <= n; ++i)
+	{
+		m_CountTree[i] += m_Blocks[i - 1].GetCount();
+		m_WidthTree[i] += m_Blocks[i - 1].GetWidth();
+
+		if (const size_t parent = i + (i & (~i + 1)); parent <= n)
+		{
+			m_CountTree[parent] += m_CountTree[i];
+			m_WidthTree[parent] += m_WidthTree[i];
+		}
+	}
+}
+
+void AdvanceIndex::Add(size_t block, ptrdiff_t count, int width) noexcept
+{
+	for (size_t i = block + 1; i < m_CountTree.size(); i += i & (~i + 1))
+	{
+		m_CountTree[i] += static_cast<size_t>(count);
+		m_WidthTree[i] += width;
+	}
+}
+
+size_t AdvanceIndex::GetCount() const noexcept
+{
+	return m_Count;
+}
+
+int AdvanceIndex::GetWidth() const noexcept
+{
+	return m_Width;
+}
+
+int AdvanceIndex::GetAdvance(size_t index) const noexcept
+{
+	if (index >= m_Count) return 0;
+
+	int offset;
+	const auto& block = m_Blocks[Locate(index, offset)];
+	return block.Positions[index] - block.GetPosition(index);
+}
+
+void AdvanceIndex::Assign(const int* advances, size_t count)
+{
+	Clear();
+	Insert(0, advances, count);
+}
+
+void AdvanceIndex::Insert(size_t index, const int* advances, size_t count)
+{
+	if (count == 0) return;
+
+	index = (std::min)(index, m_Count);
+
+	if (m_Blocks.empty())
+	{
+		m_Blocks.emplace_back();
+		Rebuild();
+	}
+
+	int offset;
+	const size_t b = Locate(index, offset);
+	auto& block = m_Blocks[b];
+
+	// Prefix sums of the new entries followed by the old ones shifted by the inserted width
+	const int start = block.GetPosition(index);
+	const auto inserted = block.Positions.insert(block.Positions.begin() + index, count, 0);
+	int position = start;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		position += advances[i];
+		inserted[i] = position;
+	}
+
+	const int width = position - start;
+
+	for (auto it = inserted + count; it != block.Positions.end(); ++it) *it += width;
+
+	m_Count += count;
+	m_Width += width;
+
+	if (Split(b))
+	{
+		Rebuild();
+	}
+	else
+	{
+		Add(b, static_cast<ptrdiff_t>(count), width);
+	}
+}
+
+void AdvanceIndex::Erase(size_t index, size_t count)
+{
+	if (index >= m_Count) return;
+
+	count = (std::min)(count, m_Count - index);
+
+	int offset;
+	size_t b = Locate(index, offset);
+	bool isRebuildNeeded = false;
+
+	while (count > 0)
+	{
+		auto& block = m_Blocks[b];
+		const size_t n = (std::min)(count, block.GetCount() - index);
+		const int width = block.Positions[index + n - 1] - block.GetPosition(index);
+		const auto first = block.Positions.begin() + index;
+
+		for (auto it = first + n; it != block.Positions.end(); ++it) *it -= width;
+
+		block.Positions.erase(first, first + n);
+		m_Count -= n;
+		m_Width -= width;
+		count -= n;
+
+		if (block.Positions.empty() && m_Blocks.size() > 1)
+		{
+			m_Blocks.erase(m_Blocks.begin() + b);
+			isRebuildNeeded = true;
+		}
+		else
+		{
+			// Once the blocks moved the tree indices are stale, it's rebuilt at the end anyway
+			if (!isRebuildNeeded) Add(b, -static_cast<ptrdiff_t>(n), -width);
+			++b;
+		}
+
+		index = 0;
+	}
+
+	if (b > 0) --b;
+	if (b < m_Blocks.size() && Merge(b)) isRebuildNeeded = true;
+
+	if (isRebuildNeeded) Rebuild();
+}
+
+void AdvanceIndex::Clear() noexcept
+{
+	m_Blocks.clear();
+	m_CountTree.clear();
+	m_WidthTree.clear();
+	m_Count = 0;
+	m_Width = 0;
+}
+
+int AdvanceIndex::GetPosition(size_t index) const noexcept
+{
+	if (index >= m_Count) return m_Width;
+
+	int offset;
+	const auto& block = m_Blocks[Locate(index, offset)];
+	return offset + block.GetPosition(index);
+}
+
+size_t AdvanceIndex::FindIndex(int x) const noexcept
+{
+	if (x <= 0) return 0;
+	if (x > m_Width) return m_Count;
+
+	// Walks down the tree skipping every block which ends before x, then looks for the first entry ending at or after it
+	size_t block = 0;
+	size_t start = 0;
+
+	for (size_t step = std::bit_floor(m_Blocks.size()); step > 0; step >>= 1)
+	{
+		if (block + step <= m_Blocks.size() && m_WidthTree[block + step] < x)
+		{
+			block += step;
+			x -= m_WidthTree[block];
+			start += m_CountTree[block];
+		}
+	}
+
+	const auto& positions = m_Blocks[block].Positions;
+	return start + static_cast<size_t>(std::lower_bound(positions.begin(), positions.end(), x) - positions.begin()) + 1;
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+/*
+Sequence of character advances (in pixels) answering "x of the caret before character i" and "character under x".
+
+The advances are split in blocks of up to 2 * BlockSize entries holding the prefix sums of their own advances, and two
+Fenwick trees keep the number of entries and the width of the blocks. Both queries walk down the trees to the right
+block and then binary search inside it, and inserting or erasing only rewrites the entries of one block plus log(blocks)
+tree nodes (the trees are only rebuilt when blocks are split, merged or removed).
+Editing a character in a huge text costs a few hundred operations instead of measuring every prefix again.
+*/
+class AdvanceIndex
+{
+private:
+
+	static constexpr size_t BlockSize = 512;
+
+	struct Block
+	{
+		std::vector<int> Positions;	// Sum of the advances of the block up to (and including) each entry
+
+		size_t GetCount() const noexcept { return Positions.size(); }
+		int GetWidth() const noexcept { return Positions.empty() ? 0 : Positions.back(); }
+		int GetPosition(size_t index) const noexcept { return index == 0 ? 0 : Positions[index - 1]; }
+	};
+
+	std::vector<Block> m_Blocks;
+	size_t m_Count;
+	int m_Width;
+
+	// Fenwick trees (1-based) over the entry count and the width of each block
+	std::vector<size_t> m_CountTree;
+	std::vector<int> m_WidthTree;
+
+	// Block holding the index and the position of the index inside it. Index == count returns the end of the last block.
+	// offset receives the position of the first entry of the block
+	size_t Locate(size_t& index, int& offset) const noexcept;
+
+	// Both return true when the blocks changed (so the trees must be rebuilt)
+	bool Split(size_t block);
+	bool Merge(size_t block);
+
+	void Rebuild();
+	void Add(size_t block, ptrdiff_t count, int width) noexcept;
+
+public:
+
+	AdvanceIndex() noexcept;
+
+	size_t GetCount() const noexcept;
+	int GetWidth() const noexcept;
+	int GetAdvance(size_t index) const noexcept;
+
+	void Assign(const int* advances, size_t count);
+	void Insert(size_t index, const int* advances, size_t count);
+	void Erase(size_t index, size_t count);
+	void Clear() noexcept;
+
+	// Sum of the advances before the index (x of the caret placed before that character)
+	int GetPosition(size_t index) const noexcept;
+
+	// Smallest index whose position is greater or equal to x (count when x is past the end)
+	size_t FindIndex(int x) const noexcept;
+};
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma once
+
+// Version counter shared by every AmbientProperty, whatever its type
+class AmbientVersion
+{
+private:
+
+	static inline unsigned long long m_Current = 0;
+
+public:
+
+	static unsigned long long GetCurrent() noexcept { return m_Current; }
+	static unsigned long long Next() noexcept { return ++m_Current; }
+};
+
+/*
+Value inherited from the nearest ancestor which explicitly set it, otherwise the owner keeps its own default (same idea
+of the WinForms ambient properties: Font, ForeColor and BackColor).
+Every change takes a new version from AmbientVersion, so an owner only resolves its values again when the current
+version moved since the last time, and only copies a value when the property it resolves to actually changed.
+*/
+template<typename T>
+class AmbientProperty
+{
+private:
+
+	T m_Value;
+	bool m_IsSet;
+	unsigned long long m_Version;
+
+public:
+
+	explicit AmbientProperty(const T& value)
+		:
+		m_Value(value),
+		m_IsSet(false),
+		m_Version(AmbientVersion::Next())
+	{
+
+	}
+
+	const T& Get() const noexcept { return m_Value; }
+	bool IsSet() const noexcept { return m_IsSet; }
+	unsigned long long GetVersion() const noexcept { return m_Version; }
+
+	// Explicit value, inherited by every descendant which doesn't set its own
+	void Set(const T& value)
+	{
+		m_Value = value;
+		m_IsSet = true;
+		m_Version = AmbientVersion::Next();
+	}
+
+	// Value used by the owner when neither it nor an ancestor set the property. It's never inherited
+	void SetDefault(const T& value)
+	{
+		if (m_IsSet) return;
+
+		m_Value = value;
+		m_Version = AmbientVersion::Next();
+	}
+
+	// Copies the value to target unless version is already the one resolved. Returns true when it was copied
+	bool CopyTo(T& target, unsigned long long& version) const
+	{
+		if (version == m_Version) return false;
+
+		target = m_Value;
+		version = m_Version;
+		return true;
+	}
+
+	// Property of the first owner which set it, walking from owner to the root with getParent(owner), or the one of
+	// owner itself when nobody did
+	template<typename Owner, typename GetParent>
+	static const AmbientProperty& Find(const Owner* owner, AmbientProperty Owner::* property, GetParent&& getParent)
+	{
+		for (auto o = owner; o != nullptr; o = getParent(o))
+		{
+			if ((o->*property).m_IsSet) return o->*property;
+		}
+
+		return owner->*property;
+	}
+};
\ No newline at end of file
@@ -1,10 +1,12 @@
 #include "Application.h"
 #include "Window.h"
 #include "Direct2D.h"
+#include "GdiTextMetrics.h"
 
 bool Application::m_IsRunning = false;
 bool Application::m_HasGraphicsChanged = false;
 GraphicsType Application::m_SetGraphicsType = GraphicsType::GDI;
+std::unique_ptr<TextMeasurer> Application::m_TextMeasurer = nullptr;
 
 std::list<Window*>* Application::Windows = new std::list<Window*>();
 
@@ -47,6 +49,21 @@ void Application::SetGraphicsType(GraphicsType graphicsType) noexcept
 	m_HasGraphicsChanged = true;
 }
 
+TextMeasurer& Application::GetTextMeasurer()
+{
+	if (m_TextMeasurer == nullptr)
+	{
+		m_TextMeasurer = std::make_unique<TextMeasurer>(std::make_unique<GdiTextMetrics>());
+	}
+
+	return *m_TextMeasurer;
+}
+
+void Application::SetTextMetrics(std::unique_ptr<ITextMetrics> backend)
+{
+	m_TextMeasurer = std::make_unique<TextMeasurer>(std::move(backend));
+}
+
 bool Application::CanCloseApplication() noexcept
 {
 	return (Windows->size() == 0);
@@ -2,6 +2,9 @@
 
 #include "CommonObject.h"
 #include "Appheaders.h"
+#include "TextMeasurer.h"
+
+#include <memory>
 
 class Application : public Object
 {
@@ -13,6 +16,7 @@ private:
 	static bool m_IsRunning;
 	static bool m_HasGraphicsChanged;
 	static GraphicsType m_SetGraphicsType;
+	static std::unique_ptr<TextMeasurer> m_TextMeasurer;
 
 	static void AddWindow(Window* window);
 	static bool RemoveWindow(Window* window);
@@ -38,6 +42,10 @@ public:
 	static constexpr GraphicsType GetGraphicsType() noexcept { return m_SetGraphicsType; }
 	static void SetGraphicsType(GraphicsType graphicsType) noexcept;
 
+	// Measurement service shared by every control. Backed by GDI unless another backend is set
+	static TextMeasurer& GetTextMeasurer();
+	static void SetTextMetrics(std::unique_ptr<ITextMetrics> backend);
+
 	virtual void Initialize() = 0;
 	static bool CanCloseApplication() noexcept;
 	static void Exit() noexcept;
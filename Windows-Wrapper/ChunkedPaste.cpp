@@ -0,0 +1,45 @@
+#include "ChunkedPaste.h"
+
+#include <algorithm>
+
+ChunkedPaste::ChunkedPaste(IClipboardSource& source, size_t maximumLength, size_t chunkSize)
+	:
+	m_Source(source),
+	m_Length((std::min)(source.GetLength(), maximumLength)),
+	m_Position(0),
+	m_ChunkSize(chunkSize > 0 ? chunkSize : DefaultChunkSize)
+{
+
+}
+
+size_t ChunkedPaste::GetLength() const noexcept
+{
+	return m_Length;
+}
+
+size_t ChunkedPaste::GetPosition() const noexcept
+{
+	return m_Position;
+}
+
+bool ChunkedPaste::IsComplete() const noexcept
+{
+	return m_Position == m_Length;
+}
+
+std::string_view ChunkedPaste::Next()
+{
+	if (IsComplete()) return {};
+
+	const auto chunk = m_Source.Read(m_Position, (std::min)(m_ChunkSize, m_Length - m_Position));
+
+	// A source shorter than it reported ends the paste
+	if (chunk.empty())
+	{
+		m_Length = m_Position;
+		return {};
+	}
+
+	m_Position += chunk.length();
+	return chunk;
+}
\ No newline at end of file
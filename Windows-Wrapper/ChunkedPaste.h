@@ -0,0 +1,38 @@
+#pragma once
+
+#include "IClipboardSource.h"
+
+/*
+Splits the text of a paste source in bounded chunks.
+
+The length is clamped to the room left in the target before anything is read, so the characters over the maximum
+length are never copied. Each call to Next reads a single chunk, so the caller inserts (and reports the progress of)
+a huge paste piece by piece instead of building a temporary copy of the whole clipboard.
+*/
+class ChunkedPaste
+{
+public:
+
+	static constexpr size_t DefaultChunkSize = 64 * 1024;
+
+private:
+
+	IClipboardSource& m_Source;
+	size_t m_Length;
+	size_t m_Position;
+	size_t m_ChunkSize;
+
+public:
+
+	ChunkedPaste(IClipboardSource& source, size_t maximumLength, size_t chunkSize = DefaultChunkSize);
+
+	// Characters that will be pasted, already limited by the maximum length
+	size_t GetLength() const noexcept;
+
+	// Characters already returned by Next
+	size_t GetPosition() const noexcept;
+	bool IsComplete() const noexcept;
+
+	// Next chunk of the text (empty when the paste is complete). Valid until the next call
+	std::string_view Next();
+};
\ No newline at end of file
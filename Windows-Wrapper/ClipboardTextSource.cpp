@@ -0,0 +1,57 @@
+#include "ClipboardTextSource.h"
+
+ClipboardTextSource::ClipboardTextSource(HWND owner) noexcept
+	:
+	m_IsOpen(OpenClipboard(owner) != 0),
+	m_Data(nullptr),
+	m_Text(nullptr),
+	m_Length(0)
+{
+	if (!m_IsOpen)
+	{
+		return;
+	}
+
+	m_Data = GetClipboardData(CF_TEXT);
+
+	if (m_Data == nullptr)
+	{
+		return;
+	}
+
+	m_Text = static_cast<const char*>(GlobalLock(m_Data));
+
+	// Text is null terminated but the allocation can be larger, so it never reads past the block
+	if (m_Text != nullptr)
+	{
+		m_Length = strnlen(m_Text, GlobalSize(m_Data));
+	}
+}
+
+ClipboardTextSource::~ClipboardTextSource()
+{
+	if (m_Text != nullptr)
+	{
+		GlobalUnlock(m_Data);
+	}
+
+	if (m_IsOpen)
+	{
+		CloseClipboard();
+	}
+}
+
+size_t ClipboardTextSource::GetLength()
+{
+	return m_Length;
+}
+
+std::string_view ClipboardTextSource::Read(size_t offset, size_t count)
+{
+	if (offset >= m_Length)
+	{
+		return {};
+	}
+
+	return std::string_view(m_Text + offset, (std::min)(count, m_Length - offset));
+}
\ No newline at end of file
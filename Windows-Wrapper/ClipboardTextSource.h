@@ -0,0 +1,26 @@
+#pragma once
+
+#include "CommonObject.h"
+#include "IClipboardSource.h"
+
+// CF_TEXT content of the Win32 clipboard. The clipboard stays open and the data locked while the source exists, so the
+// chunks are read straight from the clipboard memory without any copy
+class ClipboardTextSource final : public IClipboardSource
+{
+private:
+
+	bool m_IsOpen;
+	HANDLE m_Data;
+	const char* m_Text;
+	size_t m_Length;
+
+public:
+
+	ClipboardTextSource(HWND owner) noexcept;
+	ClipboardTextSource(const ClipboardTextSource&) = delete;
+	ClipboardTextSource& operator=(const ClipboardTextSource&) = delete;
+	~ClipboardTextSource();
+
+	size_t GetLength() override;
+	std::string_view Read(size_t offset, size_t count) override;
+};
\ No newline at end of file
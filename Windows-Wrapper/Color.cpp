@@ -1,5 +1,6 @@
 #include "Color.h"
-#include "Exceptions.h"
+
+#include <sstream>
 
 void Color::SetR(uint8_t value) noexcept
 {
@@ -21,31 +22,6 @@ void Color::SetA(uint8_t value) noexcept
 	*this = Color(GetR(), GetG(), GetB(), value);
 }
 
-int Color::GetHashCode() const
-{
-	int tmp;
-	std::memcpy(&tmp, &rgba, sizeof(tmp));
-	return tmp;
-}
-
-inline bool Color::Equals(const Object* const c) const
-{
-	if (c == nullptr) return c;
-
-	if (const auto clr = dynamic_cast<const Color*>(c))
-	{
-		return rgba == clr->rgba;
-	}
-
-	throw ArgumentException("Arg_MustBeColor");
-}
-
-inline bool Color::Equals(const Color* const c) const
-{
-	if (c == nullptr) return c;
-	return rgba == c->rgba;
-}
-
 const std::string Color::ToString() const noexcept
 {
 	std::ostringstream oss;
@@ -1,8 +1,10 @@
 #pragma once
 
-#include "IEquatable.h"
+#include "ValueType.h"
 
-struct Color : public IEquatable<Color>
+#include <string>
+
+struct Color
 {
 private:
 
@@ -25,21 +27,6 @@ public:
 	void SetB(uint8_t value) noexcept;
 	void SetA(uint8_t value) noexcept;
 
-	constexpr XMFLOAT3 ToFloat3() const
-	{
-		return XMFLOAT3(((rgba >> 0) & 0xFF) / 255.0f, ((rgba >> 8) & 0xFF) / 255.0f, ((rgba >> 16) & 0xFF) / 255.0f);
-	}
-
-	constexpr XMFLOAT4 ToFloat4() const
-	{
-		return XMFLOAT4(((rgba >> 0) & 0xFF) / 255.0f, ((rgba >> 8) & 0xFF) / 255.0f, ((rgba >> 16) & 0xFF) / 255.0f, ((rgba >> 24) & 0xFF) / 255.0f);
-	}
-
-	constexpr D3DCOLORVALUE ToD3DColor() const
-	{
-		return D3DCOLORVALUE(((rgba >> 0) & 0xFF) / 255.0f, ((rgba >> 8) & 0xFF) / 255.0f, ((rgba >> 16) & 0xFF) / 255.0f, ((rgba >> 24) & 0xFF) / 255.0f);
-	}
-
 	constexpr uint32_t ToRGB() const
 	{
 		return rgba & 0x00FFFFFF;
@@ -50,22 +37,10 @@ public:
 		return rgba;
 	}
 
-	constexpr operator XMFLOAT3() const { return ToFloat3(); }
-	constexpr operator XMFLOAT4() const { return ToFloat4(); }
-
-	static constexpr Color FromFloat3(const XMFLOAT3& value)
-	{
-		return Color(static_cast<uint8_t>(value.x * 255), static_cast<uint8_t>(value.y * 255), static_cast<uint8_t>(value.z * 255));
-	}
-
-	static constexpr Color FromFloat4(const XMFLOAT4& value)
-	{
-		return Color(static_cast<uint8_t>(value.x * 255), static_cast<uint8_t>(value.y * 255), static_cast<uint8_t>(value.z * 255), static_cast<uint8_t>(value.w * 255));
-	}
-
 	static constexpr Color Lerp(Color a, Color b, float i)
 	{
-		return FromFloat4(Math::Lerp(a.ToFloat4(), b.ToFloat4(), i));
+		const auto lerp = [i](uint8_t x, uint8_t y) { return static_cast<uint8_t>((x / 255.0f + (y / 255.0f - x / 255.0f) * i) * 255); };
+		return Color(lerp(a.GetR(), b.GetR()), lerp(a.GetG(), b.GetG()), lerp(a.GetB(), b.GetB()), lerp(a.GetA(), b.GetA()));
 	}
 
 	static constexpr Color Red() { return Color(255, 0, 0, 255); }
@@ -92,8 +67,10 @@ public:
 	static constexpr Color DisabledControlBackground() { return Color(247, 247, 247, 255); }
 	static constexpr Color DisabledForeground() { return Color(82, 86, 82, 255); }
 
-	int GetHashCode() const override;
-	inline bool Equals(const Object* const c) const override;
-	inline bool Equals(const Color* const c) const override;
-	const std::string ToString() const noexcept override;
-};
\ No newline at end of file
+	constexpr int GetHashCode() const noexcept { return static_cast<int>(rgba); }
+	constexpr bool Equals(const Color* const c) const noexcept { return c != nullptr && rgba == c->rgba; }
+	const std::string ToString() const noexcept;
+};
+
+static_assert(EquatableValue<Color>);
+static_assert(sizeof(Color) == sizeof(uint32_t), "Color must stay a packed RGBA value");
\ No newline at end of file
@@ -65,6 +65,79 @@ void ComboBox::Draw(Graphics* const graphics, Drawing::Rectangle rectangle)
 	DrawText(hdc, GetSelectedValue().c_str(), static_cast<int>(GetSelectedValue().length()), &rect, DT_LEFT | DT_VCENTER | DT_CALCRECT);
 }
 
+std::vector<std::string> ComboBox::GetValues(int index, int count) const
+{
+	std::vector<std::string> values;
+	values.reserve(count);
+
+	for (int i = index; i < index + count; ++i)
+	{
+		values.emplace_back(Items.GetValue(i));
+	}
+
+	return values;
+}
+
+void ComboBox::OnDataSourceChanged_Impl()
+{
+	m_TypedText.clear();
+	m_AutoComplete.Build(Items.GetCount(), [this](size_t i) { return Items.GetValue(i); });
+}
+
+void ComboBox::OnItemsInserted_Impl(int index, int count)
+{
+	m_AutoComplete.Insert(index, GetValues(index, count));
+	ListControl::OnItemsInserted_Impl(index, count);
+}
+
+void ComboBox::OnItemsRemoved_Impl(int index, int count)
+{
+	m_AutoComplete.Erase(index, count);
+	ListControl::OnItemsRemoved_Impl(index, count);
+}
+
+void ComboBox::OnItemUpdated_Impl(int index)
+{
+	m_AutoComplete.Update(index, Items.GetValue(index));
+	ListControl::OnItemUpdated_Impl(index);
+}
+
+void ComboBox::OnKeyPressed_Impl(HWND hwnd, char c, int cRepeat)
+{
+	Control::OnKeyPressed_Impl(hwnd, c, cRepeat);
+
+	if (ArgsOnKeyPressed.Handled)
+	{
+		return;
+	}
+
+	// Like the native lists, characters typed after a pause start a new search
+	const ULONGLONG now = GetTickCount64();
+
+	if (now - m_LastKeyPressTime > 1000)
+	{
+		m_TypedText.clear();
+	}
+
+	m_LastKeyPressTime = now;
+
+	if (c == VK_BACK)
+	{
+		if (!m_TypedText.empty()) m_TypedText.pop_back();
+	}
+	else if (static_cast<unsigned char>(c) >= ' ')
+	{
+		m_TypedText.push_back(c);
+	}
+
+	size_t match = 0;
+
+	if (!m_TypedText.empty() && m_AutoComplete.Find(m_TypedText, { &match, 1 }) == 1)
+	{
+		SetSelectedIndex(static_cast<int>(match), true);
+	}
+}
+
 void ComboBox::OnMouseLeftDown_Impl(HWND hwnd, int x, int y, unsigned int keyFlags)
 {
 	RECT rect{ 0 };
@@ -81,7 +154,8 @@ void ComboBox::OnMouseLeftDown_Impl(HWND hwnd, int x, int y, unsigned int keyFla
 ComboBox::ComboBox(Control* parent, const std::string& name, int width, int x, int y)
 	:
 	ListControl(parent, name, width, 0, x, y),	// Default control size without font is 9
-	m_FlatStyle(FlatStyle::Standard_Windows10)
+	m_FlatStyle(FlatStyle::Standard_Windows10),
+	m_LastKeyPressTime(0)
 {
 	// The ComboBox list MUST be inserted on the PARENT. Othewise it will be set in an invalid rectangle of the ComboBox
 	m_ChildWindow = new ComboBoxChildNativeWindow(parent, this, m_Size.Width, 120, m_Location.X, m_Location.Y + m_Size.Height + 5);
@@ -134,10 +208,17 @@ void ComboBox::ComboBoxChildNativeWindow::OnMouseMove_Impl(HWND hwnd, int x, int
 
 	WinAPI::OnMouseMove_Impl(hwnd, x, y, keyFlags);
 
-	// Redraw control only if MouseOverIndex changes to avoid CPU burn
+	// Redraw only the rows which changed their hover state to avoid CPU burn
 	if (m_MouseOverIndex != oldMouseOver)
 	{
-		Update();
+		for (const auto index : { oldMouseOver, m_MouseOverIndex })
+		{
+			if (index < m_RowPosition.size())
+			{
+				const auto& r = m_RowPosition[index];
+				Invalidate(Drawing::Rectangle(r.left, r.top, r.right - r.left, r.bottom - r.top));
+			}
+		}
 	}
 }
 
@@ -177,7 +258,7 @@ void ComboBox::ComboBoxChildNativeWindow::Initialize()
 	}
 
 	// Set default TextBox margin to 3 pixels
-	m_BackgroundColor = Color::WindowBackground();
+	m_LocalBackgroundColor.SetDefault(Color::WindowBackground());
 
 	// Initialize scrollbars after control creation
 	HorizontalScrollBar.Initialize();
@@ -192,11 +273,9 @@ void ComboBox::ComboBoxChildNativeWindow::PreDraw(Graphics* const graphics)
 	if (m_ComboBox->IsRebinding())
 	{
 		// Example test draw with the desired font to calculate each ListBox item size
-		SIZE m_SingleSize;
-		const char* verifier = "A";
-		GetTextExtentPoint32(static_cast<HDC>(graphics->GetHDC().ToPointer()), verifier, 2, &m_SingleSize);
-		SetMinimumItemWidth(m_SingleSize.cx);
-		SetItemHeight(m_SingleSize.cy);
+		const auto m_SingleSize = MeasureItemSample();
+		SetMinimumItemWidth(m_SingleSize.Width);
+		SetItemHeight(m_SingleSize.Height);
 
 		int borderSize = 1;
 
@@ -209,9 +288,9 @@ void ComboBox::ComboBoxChildNativeWindow::PreDraw(Graphics* const graphics)
 
 		SetItemWidth(drawableArea->right - drawableArea->left);
 
-		const auto& dataSource = m_ComboBox->GetDataSource();
+		const auto& items = m_ComboBox->Items;
 
-		int itemsNumber = static_cast<int>(dataSource.size());
+		int itemsNumber = static_cast<int>(items.GetCount());
 
 		// This block will only be executed once after resize
 		m_RowPosition.clear();
@@ -293,6 +372,9 @@ void ComboBox::ComboBoxChildNativeWindow::Draw(Graphics* const graphics, Drawing
 	hbmMem = CreateCompatibleBitmap(hdc, m_Size.Width, m_Size.Height);
 	hbmOld = (HBITMAP)SelectObject(hdcMem, hbmMem);
 
+	// Only the damaged area is drawn
+	graphics->ClipToUpdateRegion(hdcMem);
+
 	RECT r;
 	GetClientRect(hwnd, &r);
 	HBRUSH bgColor = CreateSolidBrush(GetBackgroundColor().ToRGB());
@@ -300,9 +382,9 @@ void ComboBox::ComboBoxChildNativeWindow::Draw(Graphics* const graphics, Drawing
 	SelectObject(hdcMem, bgColor);
 	DeleteObject(bgColor);
 
-	const auto& dataSource = m_ComboBox->GetDataSource();
+	const auto& items = m_ComboBox->Items;
 
-	for (size_t i = 0; i < dataSource.size(); ++i)
+	for (size_t i = 0; i < items.GetCount(); ++i)
 	{
 		RECT cr;
 		CopyRect(&cr, drawableArea);
@@ -317,7 +399,8 @@ void ComboBox::ComboBoxChildNativeWindow::Draw(Graphics* const graphics, Drawing
 		if (cr.left >= drawableArea->left &&
 			cr.top >= drawableArea->top &&
 			cr.right <= drawableArea->right &&
-			cr.bottom <= drawableArea->bottom)
+			cr.bottom <= drawableArea->bottom &&
+			graphics->IsVisible(Drawing::Rectangle(cr.left, cr.top, cr.right - cr.left, cr.bottom - cr.top)))
 		{
 			if (GetMouseOverIndex() == i)
 			{
@@ -334,8 +417,10 @@ void ComboBox::ComboBoxChildNativeWindow::Draw(Graphics* const graphics, Drawing
 				SetTextColor(hdcMem, RGB(m_ForeColor.GetR(), m_ForeColor.GetG(), m_ForeColor.GetB()));
 			}
 
-			DrawText(hdcMem, dataSource[i].Value.c_str(), -1, &cr, DT_LEFT | DT_VCENTER);
-			DrawText(hdcMem, Text.c_str(), static_cast<int>(dataSource[i].Value.length()), &cr, DT_LEFT | DT_VCENTER | DT_CALCRECT);
+			const auto value = items.GetValue(i);
+
+			DrawText(hdcMem, value.data(), static_cast<int>(value.length()), &cr, DT_LEFT | DT_VCENTER);
+			DrawText(hdcMem, Text.c_str(), static_cast<int>(value.length()), &cr, DT_LEFT | DT_VCENTER | DT_CALCRECT);
 		}
 	}
 
@@ -366,7 +451,7 @@ void ComboBox::SetSelectedIndex(int index, bool value)
 	}
 	else
 	{
-		Items[index].Selected = value;
+		Items.SetSelected(static_cast<size_t>(index), value);
 		m_SelectedValue = Items[index].Value;
 	}
 
@@ -377,20 +462,20 @@ void ComboBox::SetSelectedIndex(int index, bool value)
 
 void ComboBox::SetSelectedValue(const ListItem& item)
 {
-	bool err = true;
+	const size_t index = FindItem(item);
 
-	for (size_t i = 0; i < Items.size(); ++i)
-	{
-		if (Items[i].Id == item.Id && Items[i].Value == item.Value)
-		{
-			SetSelectedIndex(static_cast<int>(i), true);
-			err = false;
-			break;
-		}
-	}
-
-	if (err)
+	if (index == ItemLookup::NotFound)
 	{
 		throw ArgumentException("The following Item could not be found on the ComboBox");
 	}
+
+	SetSelectedIndex(static_cast<int>(index), true);
+}
+
+std::vector<int> ComboBox::GetAutoCompleteMatches(const std::string& prefix, size_t count) const
+{
+	std::vector<size_t> matches(count);
+	matches.resize(m_AutoComplete.Find(prefix, matches));
+
+	return std::vector<int>(matches.begin(), matches.end());
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "ListControl.h"
 #include "VerticalScrollBar.h"
+#include "PrefixIndex.h"
 
 class ComboBox : public ListControl
 {
@@ -35,8 +36,19 @@ private:
 
 	ComboBoxChildNativeWindow* m_ChildWindow;
 	FlatStyle m_FlatStyle;
+	PrefixIndex m_AutoComplete;
+	std::string m_TypedText;			// Characters typed since the last pause, searched in m_AutoComplete
+	ULONGLONG m_LastKeyPressTime;
+
+	std::vector<std::string> GetValues(int index, int count) const;
+
+	void OnDataSourceChanged_Impl() override;
+	void OnItemsInserted_Impl(int index, int count) override;
+	void OnItemsRemoved_Impl(int index, int count) override;
+	void OnItemUpdated_Impl(int index) override;
 
 	void Draw(Graphics* const graphics, Drawing::Rectangle rectangle) override;
+	void OnKeyPressed_Impl(HWND hwnd, char c, int cRepeat) override;
 	void OnMouseLeftDown_Impl(HWND hwnd, int x, int y, unsigned int keyFlags) override;
 
 	ComboBox(Control* parent, const std::string& name, int width, int x, int y);
@@ -47,4 +59,8 @@ public:
 
 	void SetSelectedIndex(int index, bool value) override;
 	void SetSelectedValue(const ListItem& item) override;
+
+	// Indices of the first items (in alphabetical order) starting with the prefix, ignoring the case. Large lists are
+	// indexed in the background and scanned until it's done
+	std::vector<int> GetAutoCompleteMatches(const std::string& prefix, size_t count) const;
 };
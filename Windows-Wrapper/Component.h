@@ -13,6 +13,7 @@ class Component : public IComponent
 	friend class ProgressBar;
 	friend class TextBox;
 	friend class ListControl;
+	friend class ListBox;
 
 private:
 
@@ -7,7 +7,7 @@
 #include "CancelEventHandler.h"
 #include "Window.h"
 
-int Control::m_IncrementalTabIndex = 0;
+ControlRegistry<Control> Control::m_Registry;
 
 void Control::OnFocusEnter_Impl(HWND hwnd, HWND hwndOldFocus)
 {
@@ -98,7 +98,7 @@ void Control::OnMouseLeftDown_Impl(HWND hwnd, int x, int y, unsigned int keyFlag
 			SetFocus(static_cast<HWND>(newCtl->Handle.ToPointer()));
 		}
 	}
-	else
+	else if (IsRepaintedOnClick())
 	{
 		Update();
 	}
@@ -123,8 +123,95 @@ void Control::OnNextDialogControl_Impl(HWND hwnd, HWND hwndSetFocus, bool fNext)
 	}
 }
 
+void Control::OnBoundsChanged()
+{
+	// Location and size set by the user (or the system) become the new layout values of the control
+	if (!m_IsApplyingLayout)
+	{
+		if (Parent != nullptr)
+		{
+			m_LayoutNode.SetLocation(m_Location.X, m_Location.Y);
+		}
+
+		m_LayoutNode.SetSize(m_Size.Width, m_Size.Height);
+		m_LayoutNode.SetVisible(m_IsVisible);
+		PerformLayout();
+	}
+
+	if (auto window = GetWindow(); window != nullptr && window != this)
+	{
+		window->UpdateControlIndex(this);
+	}
+}
+
+const WinAPI* Control::GetAmbientParent() const noexcept
+{
+	return Parent;
+}
+
+void Control::OnHandleCreated(HWND hwnd)
+{
+	m_Registry.AddHandle(hwnd, this);
+}
+
+void Control::OnHandleDestroyed(HWND hwnd)
+{
+	m_Registry.RemoveHandle(this, hwnd);
+}
+
+bool Control::IsRepaintedOnClick() const noexcept
+{
+	return true;
+}
+
+void Control::OnEnabledChanged()
+{
+	UpdateTabOrder();
+}
+
+WinAPI* Control::GetMouseWheelTarget(int x, int y) noexcept
+{
+	auto window = GetWindow();
+
+	if (window == nullptr) return this;
+
+	POINT p = { x, y };
+	ScreenToClient(static_cast<HWND>(window->Handle.ToPointer()), &p);
+
+	const auto target = window->GetControlAtPoint(Point(p.x, p.y));
+	return target != nullptr && target->IsEnabled() ? target : this;
+}
+
+void Control::UpdateTabOrder()
+{
+	if (auto window = GetWindow(); window != nullptr && window != this)
+	{
+		if (m_IsTabStop)
+		{
+			window->m_TabOrder.Update(this, m_TabIndex, WinAPI::IsEnabled());
+		}
+		else
+		{
+			window->m_TabOrder.Remove(this);
+		}
+	}
+}
+
+void Control::Unregister()
+{
+	if (auto window = GetWindow(); window != nullptr && window != this)
+	{
+		window->m_ControlIndex.Remove(this);
+		window->m_TabOrder.Remove(this);
+	}
+
+	m_Registry.Remove(this, GetId(), Handle.ToPointer());
+}
+
 void Control::Dispose()
 {
+	Unregister();
+
 	WinAPI::Dispose();
 
 	for (auto c : Controls)
@@ -158,6 +245,7 @@ void Control::EnableTabStop() noexcept
 	if (!IsTabStop())
 	{
 		m_IsTabStop = true;
+		UpdateTabOrder();
 	}
 }
 
@@ -166,6 +254,7 @@ void Control::DisableTabStop() noexcept
 	if (IsTabStop())
 	{
 		m_IsTabStop = false;
+		UpdateTabOrder();
 	}
 }
 
@@ -174,16 +263,6 @@ bool Control::IsTabStop() const noexcept
 	return m_IsTabStop;
 }
 
-void Control::SetFont(Font font) noexcept
-{
-	for (const auto& c : Controls)
-	{
-		c->SetFont(font);
-	}
-
-	WinAPI::SetFont(font);
-}
-
 void Control::SetText(const std::string& text) noexcept
 {
 	Text = text;
@@ -196,7 +275,7 @@ Control::Control(Control* parent, const std::string& text, int width, int height
 	Text(text),
 	m_Padding(0),
 	m_Margin(3, 3, 3, 3),	// Default margin for controls
-	m_TabIndex(m_IncrementalTabIndex++),
+	m_TabIndex(0),
 	m_IsTabSelected(false),
 	m_IsTabStop(true),
 	m_MinSize(0u),
@@ -219,12 +298,32 @@ Control::Control(Control* parent, const std::string& text, int width, int height
 	OnMouseUp(nullptr),
 	OnMouseWheel(nullptr),
 	OnVisibleChanged(nullptr),
-	OnPaint(nullptr)
+	OnPaint(nullptr),
+	m_LayoutSuspendCount(0),
+	m_IsApplyingLayout(false)
 {
 	if (m_Size.Height == 0 || m_Size.Width == 0)
 	{
 		m_Size = CalculateSizeByFont();
 	}
+
+	m_LayoutNode.SetLocation(m_Location.X, m_Location.Y);
+	m_LayoutNode.SetSize(m_Size.Width, m_Size.Height);
+	m_LayoutNode.SetMargin(Layout::Thickness{ m_Margin.Left, m_Margin.Top, m_Margin.Right, m_Margin.Bottom });
+	m_LayoutNode.OnArranged = [this](const Layout::Rect& bounds) { ApplyLayout(bounds); };
+
+	m_Registry.AddId(GetId(), this);
+
+	if (auto window = GetWindow(); window != nullptr)
+	{
+		m_TabIndex = window->m_TabOrder.GetNextIndex();
+		UpdateTabOrder();
+	}
+
+	if (Parent != nullptr)
+	{
+		Parent->m_LayoutNode.Add(&m_LayoutNode);
+	}
 }
 
 Control::Control(const std::string& text) noexcept
@@ -243,6 +342,9 @@ Control::Control(const std::string& text, int width, int height, int x, int y) n
 
 Control::~Control() noexcept(false)
 {
+	// Controls which are never disposed, like the scroll bars of their parent, are only removed here
+	Unregister();
+
 	if (OnActivate != nullptr) { delete OnActivate; OnActivate = nullptr; }
 	if (OnClick != nullptr) { delete OnClick; OnClick = nullptr; }
 	if (OnDeactivate != nullptr) { delete OnDeactivate; OnDeactivate = nullptr; }
@@ -390,6 +492,102 @@ Padding Control::GetMargin() const noexcept
 	return m_Margin;
 }
 
+void Control::SetMargin(const Padding& margin)
+{
+	m_Margin = margin;
+	m_LayoutNode.SetMargin(Layout::Thickness{ margin.Left, margin.Top, margin.Right, margin.Bottom });
+	PerformLayout();
+}
+
+Padding Control::GetPadding() const noexcept
+{
+	return m_Padding;
+}
+
+void Control::SetPadding(const Padding& padding)
+{
+	m_Padding = padding;
+	m_LayoutNode.SetPadding(Layout::Thickness{ padding.Left, padding.Top, padding.Right, padding.Bottom });
+	PerformLayout();
+}
+
+DockStyle Control::GetDockStyle() const noexcept
+{
+	return m_LayoutNode.GetDock();
+}
+
+void Control::SetDockStyle(DockStyle style)
+{
+	m_LayoutNode.SetDock(style);
+	PerformLayout();
+}
+
+AnchorStyles Control::GetAnchor() const noexcept
+{
+	return m_LayoutNode.GetAnchor();
+}
+
+void Control::SetAnchor(AnchorStyles anchor)
+{
+	m_LayoutNode.SetAnchor(anchor);
+	PerformLayout();
+}
+
+// Gives access to the panel settings (flow, grid, auto size, etc...) of the control
+Layout::Node& Control::GetLayoutNode() noexcept
+{
+	return m_LayoutNode;
+}
+
+void Control::SuspendLayout() noexcept
+{
+	++m_LayoutSuspendCount;
+}
+
+void Control::ResumeLayout(bool performLayout)
+{
+	if (m_LayoutSuspendCount > 0) --m_LayoutSuspendCount;
+
+	if (performLayout) PerformLayout();
+}
+
+void Control::PerformLayout()
+{
+	// Layout always runs from the root (only the dirty paths are visited) so a suspended ancestor defers it
+	Control* root = this;
+
+	for (auto c = this; c != nullptr; c = c->Parent)
+	{
+		if (c->m_LayoutSuspendCount > 0) return;
+		root = c;
+	}
+
+	root->m_LayoutNode.UpdateLayout();
+}
+
+void Control::ApplyLayout(const Layout::Rect& bounds)
+{
+	if (m_Location.X == bounds.X && m_Location.Y == bounds.Y && m_Size.Width == bounds.Width && m_Size.Height == bounds.Height) return;
+
+	m_Location = Point(bounds.X, bounds.Y);
+	m_Size = Size(bounds.Width, bounds.Height);
+
+	// The resulting WM_SIZE must not overwrite the layout values with the arranged bounds
+	m_IsApplyingLayout = true;
+
+	if (!Handle.IsNull())
+	{
+		SetWindowPos(static_cast<HWND>(Handle.ToPointer()), nullptr, bounds.X, bounds.Y, bounds.Width, bounds.Height, SWP_NOZORDER | SWP_NOACTIVATE);
+	}
+
+	m_IsApplyingLayout = false;
+
+	if (auto window = GetWindow(); window != nullptr && window != this)
+	{
+		window->UpdateControlIndex(this);
+	}
+}
+
 Control* Control::GetByTabIndex(const int& index) noexcept
 {
 	if (m_TabIndex == index)
@@ -422,18 +620,10 @@ const std::string& Control::GetText() const noexcept
 
 Control* Control::GetPreviousControl() noexcept
 {
-	if (const auto& root = dynamic_cast<Control*>(GetWindow()))
+	if (auto window = GetWindow())
 	{
-		auto searchIndex = m_TabIndex == 0 ? m_IncrementalTabIndex - 1 : m_TabIndex - 1;
-
-		for (auto i = searchIndex; i >= 0; --i)
-		{
-			const auto& ret = root->GetByTabIndex(i);
-			if (ret != nullptr && ret->IsEnabled() && ret->IsTabStop())
-			{
-				return ret;
-			}
-		}
+		// Only the controls of disabled containers are left to skip, the chain has no other control that can't be focused
+		return window->m_TabOrder.GetPrevious(this, [](Control* c) { return c->IsEnabled(); });
 	}
 
 	// Returning nullptr is extremely important, otherwise it will be a trash pointer and will launch an exception trying to process it
@@ -447,37 +637,23 @@ bool Control::HasChildren() const noexcept
 
 Control* Control::GetNextControl() noexcept
 {
-	if (const auto& root = dynamic_cast<Control*>(GetWindow()))
+	if (auto window = GetWindow())
 	{
-		auto searchIndex = m_TabIndex >= m_IncrementalTabIndex - 1 ? 0 : m_TabIndex + 1;
-
-		for (auto i = searchIndex; i < m_IncrementalTabIndex; ++i)
-		{
-			const auto& ret = root->GetByTabIndex(i);
-			if (ret != nullptr && ret->IsEnabled() && ret->IsTabStop())
-			{
-				return ret;
-			}
-		}
+		return window->m_TabOrder.GetNext(this, [](Control* c) { return c->IsEnabled(); });
 	}
 
 	// Returning nullptr is extremely important, otherwise it will be a trash pointer and will launch an exception trying to process it
 	return nullptr;
 }
 
-Control* Control::GetByHandle(const IntPtr p) noexcept
+Control* Control::GetDescendant(Control* control) noexcept
 {
-	if (Handle == p)
+	// Only walks up the parents of the control found, not the tree below this one
+	for (auto c = control; c != nullptr; c = c->Parent)
 	{
-		return this;
-	}
-
-	for (const auto& c : Controls)
-	{
-		Control* ret = c->GetByHandle(p);
-		if (ret != nullptr)
+		if (c == this)
 		{
-			return ret;
+			return control;
 		}
 	}
 
@@ -485,24 +661,14 @@ Control* Control::GetByHandle(const IntPtr p) noexcept
 	return nullptr;
 }
 
-Control* Control::GetById(unsigned int id) noexcept
+Control* Control::GetByHandle(const IntPtr p) noexcept
 {
-	if (GetId() == id)
-	{
-		return this;
-	}
-
-	for (const auto& c : Controls)
-	{
-		Control* ret = c->GetById(id);
-		if (ret != nullptr)
-		{
-			return ret;
-		}
-	}
+	return GetDescendant(m_Registry.FindByHandle(p.ToPointer()));
+}
 
-	// Returning nullptr is extremely important, otherwise it will be a trash pointer and will launch an exception trying to process it
-	return nullptr;
+Control* Control::GetById(unsigned int id) noexcept
+{
+	return GetDescendant(m_Registry.FindById(id));
 }
 
 int Control::GetTabIndex() const noexcept
@@ -512,15 +678,20 @@ int Control::GetTabIndex() const noexcept
 
 void Control::SetTabIndex(const int& index) noexcept
 {
-	// Don't let the user use a higher Tab Index than the number of current controls
-	if (index > m_IncrementalTabIndex)
+	auto window = GetWindow();
+	const auto count = window != nullptr && window != this ? window->m_TabOrder.GetNextIndex() : 0;
+
+	// Don't let the user use a higher Tab Index than the number of controls of the window
+	if (index > count)
 	{
-		m_TabIndex = m_IncrementalTabIndex;
+		m_TabIndex = count;
 	}
 	else
 	{
 		m_TabIndex = index;
 	}
+
+	UpdateTabOrder();
 }
 
 Size Control::CalculateSizeByFont() noexcept
@@ -552,12 +723,7 @@ Size Control::CalculateSizeByFont() noexcept
 
 	if (m_Size.Width == 0)
 	{
-		SIZE s;
-		HDC hdc = GetDC(static_cast<HWND>(GetWindow()->Handle.ToPointer()));
-		GetTextExtentPoint32(hdc, Text.c_str(), static_cast<int>(Text.length()), &s);
-		ReleaseDC(static_cast<HWND>(GetWindow()->Handle.ToPointer()), hdc);
-		DeleteDC(hdc);
-		r.Width = s.cx;
+		r.Width = MeasureText(Text).Width;
 
 		// Adjust width margin
 		r.Width += m_Margin.Left + m_Margin.Right;
@@ -16,6 +16,8 @@
 #include "OnClosingEventArgs.h"
 #include "PaintEventArgs.h"
 #include "ControlException.h"
+#include "Layout.h"
+#include "ControlRegistry.h"
 
 #include <list>
 #include <memory>
@@ -35,15 +37,39 @@ private:
 	bool m_IsTabSelected;
 	bool m_IsTabStop;
 	int m_TabIndex;
-	static int m_IncrementalTabIndex;
+
+	// Every control of the application by id and handle
+	static ControlRegistry<Control> m_Registry;
+
+	// Layout fields
+	Layout::Node m_LayoutNode;
+	int m_LayoutSuspendCount;
+	bool m_IsApplyingLayout;
 
 	std::string Name;
 
+	void ApplyLayout(const Layout::Rect& bounds);
+
+	// The control when it's this one or one of its descendants, nullptr otherwise
+	Control* GetDescendant(Control* control) noexcept;
+
+	// Keeps the tab chain of the window in sync with the tab index, tab stop and enabled state
+	void UpdateTabOrder();
+
+	// Removes the control from the registry and the indexes of its window
+	void Unregister();
+
 	void OnFocusEnter_Impl(HWND hwnd, HWND hwndOldFocus) override;
 	void OnFocusLeave_Impl(HWND hwnd, HWND hwndNewFocus) override;
 	void OnKeyDown_Impl(HWND hwnd, unsigned int vk, int cRepeat, unsigned int flags) override;
 	void OnMouseLeftDown_Impl(HWND hwnd, int x, int y, unsigned int keyFlags) override;
 	void OnNextDialogControl_Impl(HWND hwnd, HWND hwndSetFocus, bool fNext) override;
+	void OnBoundsChanged() override;
+	const WinAPI* GetAmbientParent() const noexcept override;
+	void OnHandleCreated(HWND hwnd) override;
+	void OnHandleDestroyed(HWND hwnd) override;
+	void OnEnabledChanged() override;
+	WinAPI* GetMouseWheelTarget(int x, int y) noexcept override;
 
 	EventHandler* OnActivate;
 	EventHandler* OnClick;
@@ -79,6 +105,9 @@ protected:
 	// ALL DERIVED CLASSES MUST CALL THIS METHOD ON ITS CONSTRUCTOR
 	virtual void Initialize() = 0;
 
+	// False when the control invalidates what a click changes by itself instead of being repainted whole
+	virtual bool IsRepaintedOnClick() const noexcept;
+
 	template<typename T, typename... Args>
 	T* Create(Args... a)
 	{
@@ -130,17 +159,27 @@ public:
 	bool IsEnabled() const noexcept override;
 	Window* GetWindow() noexcept;
 	Padding GetMargin() const noexcept;
+	void SetMargin(const Padding& margin);
+	Padding GetPadding() const noexcept;
+	void SetPadding(const Padding& padding);
+	DockStyle GetDockStyle() const noexcept;
+	void SetDockStyle(DockStyle style);
+	AnchorStyles GetAnchor() const noexcept;
+	void SetAnchor(AnchorStyles anchor);
+	Layout::Node& GetLayoutNode() noexcept;
+	void SuspendLayout() noexcept;
+	void ResumeLayout(bool performLayout = true);
+	void PerformLayout();
 	Control* GetByTabIndex(const int& index) noexcept;
 	bool IsTabSelected() const noexcept;
-	const std::string& GetText() const noexcept;
-	void SetText(const std::string& text) noexcept;
+	virtual const std::string& GetText() const noexcept;
+	virtual void SetText(const std::string& text) noexcept;
 	Control* GetPreviousControl() noexcept;
 	Control* GetNextControl() noexcept;
 	Control* GetById(unsigned int id) noexcept;
 	Control* GetByHandle(const IntPtr p) noexcept;
 	int GetTabIndex() const noexcept;
 	void SetTabIndex(const int& index) noexcept;
-	void SetFont(Font font) noexcept override;
 	void EnableTabStop() noexcept;
 	void DisableTabStop() noexcept;
 	bool IsTabStop() const noexcept;
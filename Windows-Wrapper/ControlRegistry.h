@@ -0,0 +1,81 @@
+#pragma once
+
+#include <unordered_map>
+#include <cstddef>
+
+/*
+Index of the controls of the application by id and by native handle.
+
+Looking up a control used to search the whole tree of controls, which is done for almost every focus change and
+mouse click. Controls are added to the registry once created (the id in their constructor, the handle as soon as the
+system assigns it) and removed when destroyed (the handle on WM_NCDESTROY, both in the destructor of the control), so
+a lookup is a single hash probe whatever the number of controls and no entry outlives its control.
+
+The system may reuse the handle of a destroyed window, so removing only erases the entries still pointing to the
+control being removed.
+*/
+template<typename T>
+class ControlRegistry
+{
+private:
+
+	std::unordered_map<unsigned int, T*> m_ById;
+	std::unordered_map<const void*, T*> m_ByHandle;
+
+public:
+
+	size_t GetCount() const noexcept
+	{
+		return m_ById.size();
+	}
+
+	void AddId(unsigned int id, T* control)
+	{
+		m_ById[id] = control;
+	}
+
+	void AddHandle(const void* handle, T* control)
+	{
+		if (handle != nullptr)
+		{
+			m_ByHandle[handle] = control;
+		}
+	}
+
+	void Remove(T* control, unsigned int id, const void* handle) noexcept
+	{
+		if (auto it = m_ById.find(id); it != m_ById.end() && it->second == control)
+		{
+			m_ById.erase(it);
+		}
+
+		RemoveHandle(control, handle);
+	}
+
+	void RemoveHandle(T* control, const void* handle) noexcept
+	{
+		if (auto it = m_ByHandle.find(handle); it != m_ByHandle.end() && it->second == control)
+		{
+			m_ByHandle.erase(it);
+		}
+	}
+
+	// nullptr when no control is registered with the id or handle
+	T* FindById(unsigned int id) const noexcept
+	{
+		const auto it = m_ById.find(id);
+		return it != m_ById.end() ? it->second : nullptr;
+	}
+
+	T* FindByHandle(const void* handle) const noexcept
+	{
+		const auto it = m_ByHandle.find(handle);
+		return it != m_ByHandle.end() ? it->second : nullptr;
+	}
+
+	void Clear() noexcept
+	{
+		m_ById.clear();
+		m_ByHandle.clear();
+	}
+};
\ No newline at end of file
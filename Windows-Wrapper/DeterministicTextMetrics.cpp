@@ -0,0 +1,80 @@
+#include "DeterministicTextMetrics.h"
+
+#include <cstring>
+
+DeterministicTextMetrics::DeterministicTextMetrics(bool hasKerning) noexcept
+	:
+	m_HasKerning(hasKerning)
+{
+
+}
+
+int DeterministicTextMetrics::GetAdvance(const FontDescriptor& font, unsigned char c) noexcept
+{
+	const int size = font.SizeInPixels;
+
+	// Control characters have no glyph
+	if (c < 32 || c == 127) return 0;
+
+	int ret;
+
+	if (std::strchr(" il.,:;'!|`", c) != nullptr) ret = size * 3 / 10;
+	else if (std::strchr("mwMW@%", c) != nullptr) ret = size * 9 / 10;
+	else if (c >= 'A' && c <= 'Z') ret = size * 7 / 10;
+	else if (c >= '0' && c <= '9') ret = size * 6 / 10;
+	else ret = size * 11 / 20;
+
+	if (font.IsBold) ret += 1;
+
+	return ret > 0 ? ret : 1;
+}
+
+int DeterministicTextMetrics::GetKerning(const FontDescriptor& font, unsigned char left, unsigned char right) noexcept
+{
+	// A few classic pairs are enough to make the string width differ from the sum of advances
+	if ((left == 'A' && right == 'V') || (left == 'V' && right == 'A') || (left == 'T' && right == 'o') || (left == 'L' && right == 'T'))
+	{
+		return -(font.SizeInPixels / 10 + 1);
+	}
+
+	return 0;
+}
+
+FontMetrics DeterministicTextMetrics::GetFontMetrics(const FontDescriptor& font)
+{
+	FontMetrics ret;
+	ret.Height = font.SizeInPixels + (font.SizeInPixels + 3) / 4;
+	ret.Ascent = font.SizeInPixels * 4 / 5;
+	ret.Descent = ret.Height - ret.Ascent;
+	return ret;
+}
+
+void DeterministicTextMetrics::GetAdvances(const FontDescriptor& font, int (&advances)[256])
+{
+	for (int i = 0; i < 256; ++i)
+	{
+		advances[i] = GetAdvance(font, static_cast<unsigned char>(i));
+	}
+}
+
+bool DeterministicTextMetrics::HasKerning(const FontDescriptor&)
+{
+	return m_HasKerning;
+}
+
+int DeterministicTextMetrics::MeasureWidth(const FontDescriptor& font, std::string_view text)
+{
+	int ret = 0;
+
+	for (size_t i = 0; i < text.size(); ++i)
+	{
+		ret += GetAdvance(font, static_cast<unsigned char>(text[i]));
+
+		if (m_HasKerning && i > 0)
+		{
+			ret += GetKerning(font, static_cast<unsigned char>(text[i - 1]), static_cast<unsigned char>(text[i]));
+		}
+	}
+
+	return ret;
+}
\ No newline at end of file
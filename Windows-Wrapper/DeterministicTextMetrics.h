@@ -0,0 +1,27 @@
+#pragma once
+
+#include "ITextMetrics.h"
+
+/*
+Built-in synthetic proportional font. Advances only depend on the character class and the font size, so results are
+identical on every platform. Used to run and benchmark the text measurement (and everything built on top of it)
+without a real font rasterizer. Kerning can be enabled to exercise the slow path of the measurement cache.
+*/
+class DeterministicTextMetrics final : public ITextMetrics
+{
+private:
+
+	bool m_HasKerning;
+
+	static int GetAdvance(const FontDescriptor& font, unsigned char c) noexcept;
+	static int GetKerning(const FontDescriptor& font, unsigned char left, unsigned char right) noexcept;
+
+public:
+
+	explicit DeterministicTextMetrics(bool hasKerning = false) noexcept;
+
+	FontMetrics GetFontMetrics(const FontDescriptor& font) override;
+	void GetAdvances(const FontDescriptor& font, int (&advances)[256]) override;
+	bool HasKerning(const FontDescriptor& font) override;
+	int MeasureWidth(const FontDescriptor& font, std::string_view text) override;
+};
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "Direct2D.h"
 #include "WinAPI.h"
 #include "Exceptions.h"
+#include "Mathlib.h"
 
 ID2D1Factory* Direct2D::m_pDirect2dFactory = nullptr;
 IDWriteFactory* Direct2D::m_pDWriteFactory = nullptr;
@@ -94,7 +95,7 @@ const IntPtr Direct2D::CreateSolidBrush(Color c)
 		return brush;
 	}
 
-	auto hr = m_pRenderTarget->CreateSolidColorBrush(c.ToD3DColor(), &brush);
+	auto hr = m_pRenderTarget->CreateSolidColorBrush(Math::ToColorValue(c), &brush);
 
 	if (!SUCCEEDED(hr)) throw ExternalException("Could not create solid color brush", hr);
 
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "EventArgs.h"
+#include "IntPtr.h"
+#include "Rectangle.h"
+
+class DrawItemEventArgs : public EventArgs
+{
+public:
+
+	// Device context of the back buffer, the background of the row is already filled
+	IntPtr DCHandle;
+	Drawing::Rectangle Bounds;
+	int Index;
+	bool Selected;
+
+	DrawItemEventArgs(IntPtr dcHandle, Drawing::Rectangle bounds, int index, bool selected)
+		:
+		DCHandle(dcHandle),
+		Bounds(bounds),
+		Index(index),
+		Selected(selected)
+	{	}
+};
\ No newline at end of file
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "Event.h"
+#include "DrawItemEventArgs.h"
+
+class DrawItemEventHandler : public Event<DrawItemEventArgs*>
+{
+public:
+
+	DrawItemEventHandler(const std::string& name, const std::function<void(Object*, DrawItemEventArgs*)>& callback)
+		:
+		Event(name, callback)
+	{
+
+	}
+};
\ No newline at end of file
@@ -244,4 +244,100 @@ enum class SelectionMode
 	Single,
 	MultiSimple,
 	MultiExtended
+};
+
+enum class DrawMode
+{
+	//
+	// Summary:
+	//     The control draws its items, every row has the item height.
+	Normal,
+	//
+	// Summary:
+	//     The items are drawn by the DrawItem event, every row has the item height.
+	OwnerDrawFixed,
+	//
+	// Summary:
+	//     The items are drawn by the DrawItem event, the height of each row is given by the MeasureItem event.
+	OwnerDrawVariable
+};
+
+enum class ListChangedType
+{
+	//
+	// Summary:
+	//     Items were inserted in the list.
+	ItemAdded,
+	//
+	// Summary:
+	//     Items were removed from the list.
+	ItemDeleted,
+	//
+	// Summary:
+	//     An item of the list was replaced.
+	ItemChanged
+};
+
+enum class AnchorStyles
+{
+	//
+	// Summary:
+	//     The control is not anchored to any edges of its container.
+	None = 0,
+	//
+	// Summary:
+	//     The control is anchored to the top edge of its container.
+	Top = 1,
+	//
+	// Summary:
+	//     The control is anchored to the bottom edge of its container.
+	Bottom = 2,
+	//
+	// Summary:
+	//     The control is anchored to the left edge of its container.
+	Left = 4,
+	//
+	// Summary:
+	//     The control is anchored to the right edge of its container.
+	Right = 8
+};
+
+constexpr AnchorStyles operator|(AnchorStyles lhs, AnchorStyles rhs) noexcept { return static_cast<AnchorStyles>(static_cast<int>(lhs) | static_cast<int>(rhs)); }
+constexpr AnchorStyles operator&(AnchorStyles lhs, AnchorStyles rhs) noexcept { return static_cast<AnchorStyles>(static_cast<int>(lhs) & static_cast<int>(rhs)); }
+constexpr bool HasFlag(AnchorStyles value, AnchorStyles flag) noexcept { return (value & flag) == flag; }
+
+enum class FlowDirection
+{
+	//
+	// Summary:
+	//     Elements flow from the left edge of the design surface to the right.
+	LeftToRight,
+	//
+	// Summary:
+	//     Elements flow from the top of the design surface to the bottom.
+	TopDown,
+	//
+	// Summary:
+	//     Elements flow from the right edge of the design surface to the left.
+	RightToLeft,
+	//
+	// Summary:
+	//     Elements flow from the bottom of the design surface to the top.
+	BottomUp
+};
+
+enum class SizeType
+{
+	//
+	// Summary:
+	//     The row or column should be automatically sized to share space with its peers.
+	AutoSize,
+	//
+	// Summary:
+	//     The row or column should be sized to an exact number of pixels.
+	Absolute,
+	//
+	// Summary:
+	//     The row or column should be sized as a percentage of the parent container.
+	Percent
 };
\ No newline at end of file
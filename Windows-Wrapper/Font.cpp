@@ -1,23 +1,29 @@
 #include "Font.h"
 #include "Exceptions.h"
 
+int Font::GetScreenDpi() noexcept
+{
+	// Creating a DC on every size conversion was the most expensive part of measuring text, so read it once
+	static const int dpi = []
+	{
+		HDC hdc = CreateCompatibleDC(nullptr);
+		int value = GetDeviceCaps(hdc, LOGPIXELSY);
+		DeleteDC(hdc);
+		return value;
+	}();
+
+	return dpi;
+}
+
 int Font::PixelToPoint(int sizeInPixels) noexcept
 {
-	HDC hdc = CreateCompatibleDC(nullptr);
-	int value = std::abs(MulDiv(sizeInPixels, 72, GetDeviceCaps(hdc, LOGPIXELSY)));
-	DeleteDC(hdc);
-	return value;
+	return std::abs(MulDiv(sizeInPixels, 72, GetScreenDpi()));
 }
 
 int Font::PointToPixel(int sizeInPoints) noexcept
 {
-	HDC hdc = CreateCompatibleDC(nullptr);
 	int pointPerInch = 72;
-	int deviceCaps = GetDeviceCaps(hdc, LOGPIXELSY);
-	int fntSize;
-	fntSize = -MulDiv(sizeInPoints, deviceCaps, pointPerInch);
-	DeleteDC(hdc);
-	return std::abs(fntSize);
+	return std::abs(MulDiv(sizeInPoints, GetScreenDpi(), pointPerInch));
 }
 
 Font::Font(const std::string& name, int size, bool isBold, bool isItalic, bool isUnderline, bool isStrikeout, GraphicsUnit unit)
@@ -196,6 +202,11 @@ void Font::SetStyle(FontStyle style) noexcept
 	}
 }
 
+FontDescriptor Font::GetDescriptor() const
+{
+	return FontDescriptor{ m_Name, GetSizeInPixels(), m_IsBold, m_IsItalic };
+}
+
 const std::string Font::ToString() const noexcept
 {
 	std::ostringstream oss;
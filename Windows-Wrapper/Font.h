@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CommonObject.h"
+#include "ITextMetrics.h"
 
 class Font : public Object
 {
@@ -16,6 +17,7 @@ private:
 	byte m_GdiCharSet;
 	bool m_GdiVerticalFont;
 
+	static int GetScreenDpi() noexcept;
 	static int PixelToPoint(int sizeInPixels) noexcept;
 	static int PointToPixel(int sizeInPoints) noexcept;
 
@@ -37,6 +39,6 @@ public:
 	GraphicsUnit GetUnit() const noexcept;
 	void SetUnit(GraphicsUnit unit) noexcept;
 	void SetStyle(FontStyle style) noexcept;
+	FontDescriptor GetDescriptor() const;
 	const std::string ToString() const noexcept override;
 };
-
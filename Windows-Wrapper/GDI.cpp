@@ -33,8 +33,22 @@ void GDI::BeginDraw()
 void GDI::EndDraw()
 {
 	// Perform the bit-block transfer between the memory Device Context which has the next bitmap
-	// with the current image to avoid flickering
-	BitBlt(static_cast<HDC>(DCHandle.ToPointer()), 0, 0, WindowSize.Width, WindowSize.Height, m_MemoryDC, 0, 0, SRCCOPY);
+	// with the current image to avoid flickering.
+	// Only the damaged rectangles are transferred when the control invalidated part of its area
+	if (UpdateRegion.IsEmpty())
+	{
+		BitBlt(static_cast<HDC>(DCHandle.ToPointer()), 0, 0, WindowSize.Width, WindowSize.Height, m_MemoryDC, 0, 0, SRCCOPY);
+	}
+	else
+	{
+		UpdateRegion.ForEach([&](int x, int y, int width, int height)
+			{
+				BitBlt(static_cast<HDC>(DCHandle.ToPointer()), x, y, width, height, m_MemoryDC, x, y, SRCCOPY);
+			});
+
+		UpdateRegion.MakeEmpty();
+	}
+
 	SelectObject(m_MemoryDC, m_OldBitmap);
 	ReleaseDC(static_cast<HWND>(WindowHandle.ToPointer()), m_MemoryDC);
 	DeleteDC(m_MemoryDC);
@@ -0,0 +1,84 @@
+#include "GdiTextMetrics.h"
+#include "Exceptions.h"
+
+GdiTextMetrics::GdiTextMetrics()
+	:
+	m_DC(CreateCompatibleDC(nullptr))
+{
+	if (!m_DC) throw ExternalException("Could not create measurement DC", GetLastError());
+}
+
+GdiTextMetrics::~GdiTextMetrics()
+{
+	// Unselect any cached font before deleting them
+	SelectObject(m_DC, GetStockObject(SYSTEM_FONT));
+
+	for (auto& [descriptor, font] : m_Fonts)
+	{
+		DeleteObject(font);
+	}
+
+	DeleteDC(m_DC);
+}
+
+void GdiTextMetrics::Select(const FontDescriptor& font)
+{
+	auto it = m_Fonts.find(font);
+
+	if (it == m_Fonts.end())
+	{
+		// Same parameters from GDI::CreateFontObject so the measured glyphs are the drawn ones
+		HFONT f = ::CreateFont(
+			font.SizeInPixels,
+			0,
+			0,
+			0,
+			font.IsBold ? FW_BOLD : FW_NORMAL,
+			font.IsItalic,
+			false,
+			false,
+			ANSI_CHARSET,
+			OUT_TT_PRECIS,
+			CLIP_DEFAULT_PRECIS, DEFAULT_QUALITY,
+			DEFAULT_PITCH | FF_DONTCARE,
+			font.Name.c_str());
+
+		if (!f) throw ExternalException("Could not create font", GetLastError());
+
+		it = m_Fonts.emplace(font, f).first;
+	}
+
+	SelectObject(m_DC, it->second);
+}
+
+FontMetrics GdiTextMetrics::GetFontMetrics(const FontDescriptor& font)
+{
+	Select(font);
+
+	TEXTMETRIC tm;
+	GetTextMetrics(m_DC, &tm);
+
+	return FontMetrics{ tm.tmHeight, tm.tmAscent, tm.tmDescent };
+}
+
+void GdiTextMetrics::GetAdvances(const FontDescriptor& font, int (&advances)[256])
+{
+	Select(font);
+
+	if (!GetCharWidth32A(m_DC, 0, 255, advances)) throw ExternalException("Could not read the character widths", GetLastError());
+}
+
+bool GdiTextMetrics::HasKerning(const FontDescriptor& font)
+{
+	// GetTextExtentPoint32 and ExtTextOut without ETO_PDY/GCP don't apply kerning pairs, the extent is the sum of the advances
+	return false;
+}
+
+int GdiTextMetrics::MeasureWidth(const FontDescriptor& font, std::string_view text)
+{
+	Select(font);
+
+	SIZE s;
+	GetTextExtentPoint32A(m_DC, text.data(), static_cast<int>(text.length()), &s);
+	return s.cx;
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "CommonObject.h"
+#include "ITextMetrics.h"
+
+#include <unordered_map>
+
+// Text metrics read from GDI through a memory DC owned by the backend, so measuring never needs a window DC
+class GdiTextMetrics final : public ITextMetrics
+{
+private:
+
+	HDC m_DC;
+	std::unordered_map<FontDescriptor, HFONT, FontDescriptorHash> m_Fonts;
+
+	void Select(const FontDescriptor& font);
+
+public:
+
+	GdiTextMetrics();
+	GdiTextMetrics(const GdiTextMetrics&) = delete;
+	GdiTextMetrics& operator=(const GdiTextMetrics&) = delete;
+	~GdiTextMetrics();
+
+	FontMetrics GetFontMetrics(const FontDescriptor& font) override;
+	void GetAdvances(const FontDescriptor& font, int (&advances)[256]) override;
+	bool HasKerning(const FontDescriptor& font) override;
+	int MeasureWidth(const FontDescriptor& font, std::string_view text) override;
+};
\ No newline at end of file
@@ -0,0 +1,442 @@
+#include "GraphemeIndex.h"
+
+#include <bit>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define GRAPHEMEINDEX_SSE2
+#endif
+
+namespace
+{
+	constexpr char32_t Invalid = 0xFFFFFFFF;
+
+	// Decodes the code point at text (Invalid for a malformed byte, which is skipped alone)
+	size_t Decode(const unsigned char* text, size_t length, char32_t& cp) noexcept
+	{
+		const unsigned char c = text[0];
+
+		if (c < 0x80)
+		{
+			cp = c;
+			return 1;
+		}
+
+		size_t size;
+		char32_t minimum;
+
+		if ((c & 0xE0) == 0xC0) { size = 2; cp = c & 0x1F; minimum = 0x80; }
+		else if ((c & 0xF0) == 0xE0) { size = 3; cp = c & 0x0F; minimum = 0x800; }
+		else if ((c & 0xF8) == 0xF0) { size = 4; cp = c & 0x07; minimum = 0x10000; }
+		else { cp = Invalid; return 1; }
+
+		if (size > length)
+		{
+			cp = Invalid;
+			return 1;
+		}
+
+		for (size_t i = 1; i < size; ++i)
+		{
+			if ((text[i] & 0xC0) != 0x80)
+			{
+				cp = Invalid;
+				return 1;
+			}
+
+			cp = (cp << 6) | (text[i] & 0x3F);
+		}
+
+		// Overlong forms, surrogates and values past the last plane
+		if (cp < minimum || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF))
+		{
+			cp = Invalid;
+			return 1;
+		}
+
+		return size;
+	}
+
+	bool IsControl(char32_t cp) noexcept
+	{
+		return cp == Invalid || cp < 0x20 || (cp >= 0x7F && cp <= 0x9F) || cp == 0x2028 || cp == 0x2029;
+	}
+
+	bool IsExtend(char32_t cp) noexcept
+	{
+		return (cp >= 0x0300 && cp <= 0x036F) || (cp >= 0x0483 && cp <= 0x0489) || (cp >= 0x0591 && cp <= 0x05BD) ||
+			(cp >= 0x0610 && cp <= 0x061A) || (cp >= 0x064B && cp <= 0x065F) || cp == 0x0670 ||
+			(cp >= 0x0900 && cp <= 0x0903) || (cp >= 0x093A && cp <= 0x094F) || (cp >= 0x0951 && cp <= 0x0957) ||
+			cp == 0x0E31 || (cp >= 0x0E34 && cp <= 0x0E3A) || (cp >= 0x0E47 && cp <= 0x0E4E) ||
+			(cp >= 0x1AB0 && cp <= 0x1AFF) || (cp >= 0x1DC0 && cp <= 0x1DFF) || cp == 0x200C || cp == 0x200D ||
+			(cp >= 0x20D0 && cp <= 0x20FF) || (cp >= 0x3099 && cp <= 0x309A) || (cp >= 0xFE00 && cp <= 0xFE0F) ||
+			(cp >= 0xFE20 && cp <= 0xFE2F) || (cp >= 0x1F3FB && cp <= 0x1F3FF) || (cp >= 0xE0020 && cp <= 0xE007F) ||
+			(cp >= 0xE0100 && cp <= 0xE01EF);
+	}
+
+	bool IsRegionalIndicator(char32_t cp) noexcept
+	{
+		return cp >= 0x1F1E6 && cp <= 0x1F1FF;
+	}
+
+	bool IsPictographic(char32_t cp) noexcept
+	{
+		return cp == 0x00A9 || cp == 0x00AE || cp == 0x203C || cp == 0x2049 || cp == 0x2122 || cp == 0x2139 ||
+			(cp >= 0x2190 && cp <= 0x21FF) || (cp >= 0x2300 && cp <= 0x23FF) || (cp >= 0x2600 && cp <= 0x27BF) ||
+			(cp >= 0x2B00 && cp <= 0x2BFF) || (cp >= 0x1F000 && cp <= 0x1FAFF && !IsRegionalIndicator(cp));
+	}
+
+	enum class Hangul { None, L, V, T, LV, LVT };
+
+	Hangul GetHangul(char32_t cp) noexcept
+	{
+		if ((cp >= 0x1100 && cp <= 0x115F) || (cp >= 0xA960 && cp <= 0xA97C)) return Hangul::L;
+		if ((cp >= 0x1160 && cp <= 0x11A7) || (cp >= 0xD7B0 && cp <= 0xD7C6)) return Hangul::V;
+		if ((cp >= 0x11A8 && cp <= 0x11FF) || (cp >= 0xD7CB && cp <= 0xD7FB)) return Hangul::T;
+		if (cp >= 0xAC00 && cp <= 0xD7A3) return (cp - 0xAC00) % 28 == 0 ? Hangul::LV : Hangul::LVT;
+		return Hangul::None;
+	}
+
+	// Whether a cluster starts between previous and cp. regionalCount is the number of regional indicators ending at previous
+	bool IsBreak(char32_t previous, char32_t cp, size_t regionalCount) noexcept
+	{
+		if (previous == '\r' && cp == '\n') return false;
+
+		// Nothing below the combining marks joins the previous character (except a pictograph after a ZWJ)
+		if (cp < 0x0300 && previous != 0x200D) return true;
+		if (IsControl(previous) || IsControl(cp)) return true;
+
+		const auto a = GetHangul(previous);
+		const auto b = GetHangul(cp);
+
+		if (a == Hangul::L && (b == Hangul::L || b == Hangul::V || b == Hangul::LV || b == Hangul::LVT)) return false;
+		if ((a == Hangul::LV || a == Hangul::V) && (b == Hangul::V || b == Hangul::T)) return false;
+		if ((a == Hangul::LVT || a == Hangul::T) && b == Hangul::T) return false;
+
+		if (IsExtend(cp)) return false;
+		if (previous == 0x200D && IsPictographic(cp)) return false;
+
+		// Flags are pairs of regional indicators
+		if (IsRegionalIndicator(previous) && IsRegionalIndicator(cp)) return regionalCount % 2 == 0;
+
+		return true;
+	}
+
+	// Regional indicators are encoded as F0 9F 87 A6-BF
+	bool IsRegionalIndicatorAt(const PieceTable& document, size_t offset) noexcept
+	{
+		return static_cast<unsigned char>(document.GetChar(offset)) == 0xF0 && static_cast<unsigned char>(document.GetChar(offset + 1)) == 0x9F &&
+			static_cast<unsigned char>(document.GetChar(offset + 2)) == 0x87 && static_cast<unsigned char>(document.GetChar(offset + 3)) >= 0xA6 &&
+			static_cast<unsigned char>(document.GetChar(offset + 3)) <= 0xBF;
+	}
+
+	bool IsAscii(const char* text, size_t length) noexcept
+	{
+		size_t i = 0;
+
+#ifdef GRAPHEMEINDEX_SSE2
+		__m128i bits = _mm_setzero_si128();
+
+		for (; i + 16 <= length; i += 16)
+		{
+			bits = _mm_or_si128(bits, _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i)));
+		}
+
+		if (_mm_movemask_epi8(bits) != 0) return false;
+#endif
+
+		for (; i < length; ++i)
+		{
+			if (static_cast<unsigned char>(text[i]) >= 0x80) return false;
+		}
+
+		return true;
+	}
+}
+
+GraphemeIndex::GraphemeIndex(const PieceTable& document)
+	:
+	m_Document(document),
+	m_IsValid(false),
+	m_Block(0),
+	m_BlockStart(0)
+{
+
+}
+
+void GraphemeIndex::Create()
+{
+	const size_t length = m_Document.GetLength();
+
+	m_Blocks.assign((std::max)(size_t(1), (length + BlockSize - 1) / BlockSize), Block());
+
+	for (size_t i = 0; i < m_Blocks.size(); ++i)
+	{
+		m_Blocks[i].Length = (std::min)(BlockSize, length - i * BlockSize);
+	}
+
+	if (length == 0) m_Blocks.front().Length = 0;
+
+	m_Block = 0;
+	m_BlockStart = 0;
+	m_IsValid = true;
+}
+
+size_t GraphemeIndex::Locate(size_t offset)
+{
+	if (!m_IsValid) Create();
+
+	// Walks from the last block found, caret moves are almost always inside it or next to it
+	while (offset < m_BlockStart)
+	{
+		--m_Block;
+		m_BlockStart -= m_Blocks[m_Block].Length;
+	}
+
+	while (offset >= m_BlockStart + m_Blocks[m_Block].Length && m_Block + 1 < m_Blocks.size())
+	{
+		m_BlockStart += m_Blocks[m_Block].Length;
+		++m_Block;
+	}
+
+	return m_Block;
+}
+
+void GraphemeIndex::Build(Block& block, size_t start)
+{
+	const size_t end = start + block.Length;
+	const size_t length = m_Document.GetLength();
+
+	// Starts decoding a few characters before the block (at the start of a character), so the clusters crossing its
+	// start are known. A run of regional indicators is followed backwards to know which ones are pairs
+	size_t from = start > 16 ? start - 16 : 0;
+
+	while (from > 0 && start - from < 19 && (static_cast<unsigned char>(m_Document.GetChar(from)) & 0xC0) == 0x80) --from;
+	while (from >= 4 && IsRegionalIndicatorAt(m_Document, from - 4)) from -= 4;
+
+	const size_t to = (std::min)(end + 3, length);
+
+	m_Buffer.clear();
+	m_Document.ForEachChunk(from, to - from, [&](std::string_view chunk) { m_Buffer.append(chunk); });
+
+	const char* text = m_Buffer.data() + (start - from);
+
+	block.IsBuilt = true;
+	block.Stops.clear();
+
+	// Every byte is a stop unless a CR (maybe the previous byte) is followed by a LF
+	if (IsAscii(text, block.Length) && std::memchr(m_Buffer.data() + (start > from ? start - from - 1 : 0), '\r', block.Length + (start > from ? 1 : 0)) == nullptr)
+	{
+		block.IsAscii = true;
+		block.Clusters = block.Length;
+		return;
+	}
+
+	block.IsAscii = false;
+	block.Stops.assign((block.Length + 63) / 64, 0);
+	block.Clusters = 0;
+
+	const auto data = reinterpret_cast<const unsigned char*>(m_Buffer.data());
+	char32_t previous = Invalid;
+	size_t regionalCount = 0;
+
+	// Skips the continuation bytes of a character starting before the decoding window
+	size_t i = 0;
+
+	while (from > 0 && i < 3 && from + i < start && (data[i] & 0xC0) == 0x80) ++i;
+
+	while (from + i < end)
+	{
+		char32_t cp;
+		const size_t size = Decode(data + i, m_Buffer.length() - i, cp);
+		const size_t offset = from + i;
+
+		if (offset >= start && (offset == 0 || IsBreak(previous, cp, regionalCount)))
+		{
+			block.Stops[(offset - start) / 64] |= uint64_t(1) << ((offset - start) % 64);
+			++block.Clusters;
+		}
+
+		regionalCount = IsRegionalIndicator(cp) ? regionalCount + 1 : 0;
+		previous = cp;
+		i += size;
+	}
+}
+
+void GraphemeIndex::UnbuildRange(size_t from, size_t to)
+{
+	// A character (or a cluster) can cross the edges of the edited range, so the blocks right around it are dropped too
+	size_t b = Locate(from > 4 ? from - 4 : 0);
+
+	for (size_t start = m_BlockStart; b < m_Blocks.size() && start <= to + 4; start += m_Blocks[b++].Length)
+	{
+		m_Blocks[b].IsBuilt = false;
+		m_Blocks[b].Stops.clear();
+		m_Blocks[b].Stops.shrink_to_fit();
+	}
+}
+
+void GraphemeIndex::Split(size_t block)
+{
+	while (m_Blocks[block].Length > 2 * BlockSize)
+	{
+		Block tail;
+		tail.Length = m_Blocks[block].Length - BlockSize;
+		m_Blocks[block].Length = BlockSize;
+		m_Blocks[block].IsBuilt = false;
+		m_Blocks.insert(m_Blocks.begin() + block + 1, std::move(tail));
+		++block;
+	}
+}
+
+void GraphemeIndex::OnInsert(size_t offset, size_t count)
+{
+	if (!m_IsValid || count == 0) return;
+
+	const size_t b = Locate(offset);
+
+	m_Blocks[b].Length += count;
+	Split(b);
+	UnbuildRange(offset, offset + count);
+}
+
+void GraphemeIndex::OnErase(size_t offset, size_t count)
+{
+	if (!m_IsValid || count == 0) return;
+
+	const size_t b = Locate(offset);
+	size_t position = m_BlockStart;
+	size_t remaining = count;
+	size_t last = b;
+
+	for (; remaining > 0 && last < m_Blocks.size(); ++last)
+	{
+		auto& block = m_Blocks[last];
+		const size_t erased = (std::min)(remaining, block.Length - (offset > position ? offset - position : 0));
+
+		position += block.Length;
+		block.Length -= erased;
+		remaining -= erased;
+	}
+
+	// Emptied blocks are dropped and a small one is merged with the next, so erasing never leaves many tiny blocks
+	m_Blocks.erase(std::remove_if(m_Blocks.begin() + b, m_Blocks.begin() + last, [](const Block& block) { return block.Length == 0; }), m_Blocks.begin() + last);
+
+	if (m_Blocks.empty()) m_Blocks.emplace_back();
+
+	// The block found starts at the same offset, unless it was the last one and it's gone
+	if (b >= m_Blocks.size())
+	{
+		m_Block = m_Blocks.size() - 1;
+		m_BlockStart -= m_Blocks[m_Block].Length;
+	}
+
+	if (m_Block + 1 < m_Blocks.size() && m_Blocks[m_Block].Length + m_Blocks[m_Block + 1].Length <= BlockSize)
+	{
+		m_Blocks[m_Block].Length += m_Blocks[m_Block + 1].Length;
+		m_Blocks.erase(m_Blocks.begin() + m_Block + 1);
+	}
+
+	UnbuildRange(offset, offset);
+}
+
+void GraphemeIndex::Invalidate() noexcept
+{
+	m_Blocks.clear();
+	m_IsValid = false;
+	m_Block = 0;
+	m_BlockStart = 0;
+}
+
+bool GraphemeIndex::IsStop(size_t offset)
+{
+	if (offset == 0 || offset >= m_Document.GetLength()) return true;
+
+	auto& block = m_Blocks[Locate(offset)];
+
+	if (!block.IsBuilt) Build(block, m_BlockStart);
+	if (block.IsAscii) return true;
+
+	const size_t i = offset - m_BlockStart;
+	return (block.Stops[i / 64] >> (i % 64)) & 1;
+}
+
+size_t GraphemeIndex::GetNextStop(size_t offset)
+{
+	const size_t length = m_Document.GetLength();
+
+	for (size_t position = offset + 1; position < length;)
+	{
+		auto& block = m_Blocks[Locate(position)];
+
+		if (!block.IsBuilt) Build(block, m_BlockStart);
+		if (block.IsAscii) return position;
+
+		// First bit set at or after the position, a word at a time
+		size_t i = position - m_BlockStart;
+		uint64_t word = block.Stops[i / 64] & (~uint64_t(0) << (i % 64));
+
+		for (size_t w = i / 64;;)
+		{
+			if (word != 0) return m_BlockStart + w * 64 + std::countr_zero(word);
+			if (++w >= block.Stops.size()) break;
+			word = block.Stops[w];
+		}
+
+		position = m_BlockStart + block.Length;
+	}
+
+	return length;
+}
+
+size_t GraphemeIndex::GetPreviousStop(size_t offset)
+{
+	offset = (std::min)(offset, m_Document.GetLength());
+
+	for (size_t position = offset; position > 0;)
+	{
+		auto& block = m_Blocks[Locate(position - 1)];
+
+		if (!block.IsBuilt) Build(block, m_BlockStart);
+		if (block.IsAscii) return position - 1;
+
+		// Last bit set before the position
+		size_t i = position - 1 - m_BlockStart;
+		uint64_t word = block.Stops[i / 64] & (~uint64_t(0) >> (63 - i % 64));
+
+		for (size_t w = i / 64;;)
+		{
+			if (word != 0) return m_BlockStart + w * 64 + 63 - std::countl_zero(word);
+			if (w-- == 0) break;
+			word = block.Stops[w];
+		}
+
+		position = m_BlockStart;
+	}
+
+	return 0;
+}
+
+size_t GraphemeIndex::Snap(size_t offset)
+{
+	return IsStop(offset) ? (std::min)(offset, m_Document.GetLength()) : GetPreviousStop(offset);
+}
+
+size_t GraphemeIndex::GetClusterCount()
+{
+	if (!m_IsValid) Create();
+
+	size_t count = 0;
+	size_t start = 0;
+
+	for (auto& block : m_Blocks)
+	{
+		if (!block.IsBuilt) Build(block, start);
+
+		count += block.Clusters;
+		start += block.Length;
+	}
+
+	return count;
+}
\ No newline at end of file
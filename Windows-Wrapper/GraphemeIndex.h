@@ -0,0 +1,66 @@
+#pragma once
+
+#include "PieceTable.h"
+
+/*
+Grapheme cluster boundaries (caret stops) of the UTF-8 text of a PieceTable.
+
+The document is split in blocks of about BlockSize bytes which only know their length until a query lands in them.
+Then the block is scanned once: a block with only ASCII characters (checked 16 bytes at a time) and no CR keeps no
+storage since every byte is a stop, the others keep one bit per byte. Edits resize the edited block and only drop
+the boundaries around the edit, so nothing is scanned again from the start of the document. The last block found is
+remembered, so moving the caret around is O(1) amortized.
+
+Clusters follow the rules of UAX #29 that matter while editing: CR LF, combining marks and variation selectors (the
+common ranges), emoji modifiers, ZWJ sequences, flags (regional indicator pairs) and Hangul syllables. Bytes that
+aren't valid UTF-8 (ex: text in the ANSI code page) are clusters of their own, so they keep moving one by one.
+Line boundaries come from the line index of the PieceTable, the index only guarantees a CR LF is never split.
+*/
+class GraphemeIndex
+{
+private:
+
+	static constexpr size_t BlockSize = 1024;
+
+	struct Block
+	{
+		size_t Length = 0;
+		size_t Clusters = 0;
+		bool IsBuilt = false;
+		bool IsAscii = false;
+		std::vector<uint64_t> Stops;	// Bit i is set when a cluster starts at the byte i of the block
+	};
+
+	const PieceTable& m_Document;
+	std::vector<Block> m_Blocks;
+	bool m_IsValid;
+	size_t m_Block;					// Last block found and its offset
+	size_t m_BlockStart;
+	std::string m_Buffer;
+
+	void Create();
+	size_t Locate(size_t offset);
+	void Build(Block& block, size_t start);
+	void UnbuildRange(size_t from, size_t to);
+	void Split(size_t block);
+
+public:
+
+	explicit GraphemeIndex(const PieceTable& document);
+
+	// Must be called after each edit of the document
+	void OnInsert(size_t offset, size_t count);
+	void OnErase(size_t offset, size_t count);
+	void Invalidate() noexcept;
+
+	bool IsStop(size_t offset);
+
+	// Nearest stop after (before) the offset. The end (start) of the document when there's none
+	size_t GetNextStop(size_t offset);
+	size_t GetPreviousStop(size_t offset);
+
+	// The offset itself when it's a stop, otherwise the previous stop
+	size_t Snap(size_t offset);
+
+	size_t GetClusterCount();
+};
\ No newline at end of file
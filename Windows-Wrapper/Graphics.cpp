@@ -20,4 +20,52 @@ Graphics* Graphics::Create(IntPtr window, Size size)
 	default:
 		throw std::runtime_error("Invalid graphics type format");
 	}
+}
+
+Drawing::Region Graphics::GetRegion(IntPtr region)
+{
+	const auto hrgn = static_cast<HRGN>(region.ToPointer());
+	Drawing::Region ret;
+
+	std::vector<BYTE> data(GetRegionData(hrgn, 0, nullptr));
+	if (data.empty() || GetRegionData(hrgn, static_cast<DWORD>(data.size()), reinterpret_cast<RGNDATA*>(data.data())) == 0) return ret;
+
+	const auto header = reinterpret_cast<const RGNDATAHEADER*>(data.data());
+	const auto rects = reinterpret_cast<const RECT*>(data.data() + header->dwSize);
+
+	for (DWORD i = 0; i < header->nCount; ++i)
+	{
+		ret.Union(Drawing::Region(rects[i].left, rects[i].top, rects[i].right - rects[i].left, rects[i].bottom - rects[i].top));
+	}
+
+	return ret;
+}
+
+void Graphics::ClipToUpdateRegion(IntPtr hdc) const
+{
+	if (UpdateRegion.IsEmpty()) return;
+
+	std::vector<BYTE> data(sizeof(RGNDATAHEADER) + UpdateRegion.GetRectangleCount() * sizeof(RECT));
+	auto header = reinterpret_cast<RGNDATAHEADER*>(data.data());
+	auto rects = reinterpret_cast<RECT*>(data.data() + sizeof(RGNDATAHEADER));
+	size_t count = 0;
+
+	UpdateRegion.ForEach([&](int x, int y, int width, int height)
+		{
+			rects[count++] = RECT{ x, y, x + width, y + height };
+		});
+
+	header->dwSize = sizeof(RGNDATAHEADER);
+	header->iType = RDH_RECTANGLES;
+	header->nCount = static_cast<DWORD>(count);
+	header->nRgnSize = static_cast<DWORD>(count * sizeof(RECT));
+
+	const auto bounds = UpdateRegion.GetBounds<Drawing::Rectangle>();
+	header->rcBound = RECT{ bounds.X, bounds.Y, bounds.X + bounds.Width, bounds.Y + bounds.Height };
+
+	if (HRGN clip = ExtCreateRegion(nullptr, static_cast<DWORD>(data.size()), reinterpret_cast<RGNDATA*>(data.data())))
+	{
+		SelectClipRgn(static_cast<HDC>(hdc.ToPointer()), clip);
+		DeleteObject(clip);
+	}
 }
\ No newline at end of file
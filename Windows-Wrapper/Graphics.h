@@ -5,6 +5,7 @@
 #include "Rectangle.h"
 #include "IDisposable.h"
 #include "Font.h"
+#include "Region.h"
 
 class Graphics : public IDisposable
 {
@@ -20,14 +21,29 @@ public:
 	Size WindowSize;
 	std::map<std::string, void*> Elements;
 
+	// Damaged area of the window for the current frame. When empty the whole window is presented
+	Drawing::Region UpdateRegion;
+
 	Graphics(IntPtr window, Size size);
 	virtual ~Graphics() { }
 	IntPtr GetHDC() const noexcept { return DCHandle; }
 
 	static Graphics* Create(IntPtr window, Size size);
 
+	// Rectangles of a native region (HRGN)
+	static Drawing::Region GetRegion(IntPtr region);
+
+	// Clips a device context to the damaged area, nothing is clipped when the whole window is presented
+	void ClipToUpdateRegion(IntPtr hdc) const;
+
 	void UpdateSize(Size size) { WindowSize = size; }
 
+	// False when the rectangle is outside the damaged area, so the caller can skip drawing it
+	bool IsVisible(const Drawing::Rectangle& rect) const noexcept
+	{
+		return UpdateRegion.IsEmpty() || UpdateRegion.IntersectsWith(rect);
+	}
+
 	void* GetElement(const std::string& name) const
 	{
 		for (auto& p : Elements)
@@ -25,7 +25,7 @@ void HorizontalScrollBar::OnHorizontalScrolling_Impl(HWND hwnd, HWND hwndCtl, un
 	case SB_LINERIGHT:       nPos = si.nPos + 1; break;
 	case SB_PAGELEFT:         nPos = si.nPos - Owner->GetHorizontalPage(); break;
 	case SB_PAGERIGHT:       nPos = si.nPos + Owner->GetHorizontalPage(); break;
-	case SB_THUMBTRACK:     nPos = pos; break;
+	case SB_THUMBTRACK:     nPos = si.nTrackPos; break;	// pos only has 16 bits
 	default:
 	case SB_THUMBPOSITION:  nPos = si.nPos; break;
 	}
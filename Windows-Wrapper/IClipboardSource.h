@@ -0,0 +1,19 @@
+#pragma once
+
+#include <string_view>
+#include <cstddef>
+
+// Text to be pasted (the Win32 clipboard, an in memory string for tests, etc...).
+// Sources are read in chunks so a huge clipboard never has to be copied at once
+class IClipboardSource
+{
+public:
+
+	virtual ~IClipboardSource() = default;
+
+	// Number of characters available, without reading them
+	virtual size_t GetLength() = 0;
+
+	// Characters [offset, offset + count). The view is only valid until the next call
+	virtual std::string_view Read(size_t offset, size_t count) = 0;
+};
\ No newline at end of file
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <string>
+#include <span>
+#include <cstddef>
+
+// Items of a list control in virtual mode (a database cursor, a generated sequence, etc...).
+// The control never copies the items, it only asks for the text of the rows it is about to draw
+class IListDataProvider
+{
+public:
+
+	virtual ~IListDataProvider() = default;
+
+	virtual size_t GetCount() const = 0;
+
+	// Fills text with the items [first, first + text.size()). The strings are reused between calls
+	virtual void GetText(size_t first, std::span<std::string> text) const = 0;
+
+	// Called by the control on its thread before each paint. Providers whose items change on other threads take the
+	// new ones here and return true, the control then reads the count and the rows again
+	virtual bool Refresh() { return false; }
+};
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <functional>
+#include <cstddef>
+
+// Identifies a font for measurement purposes (underline and strike out don't change the glyphs advance)
+struct FontDescriptor
+{
+	std::string Name;
+	int SizeInPixels = 0;
+	bool IsBold = false;
+	bool IsItalic = false;
+
+	bool operator==(const FontDescriptor& f) const noexcept = default;
+};
+
+struct FontDescriptorHash
+{
+	size_t operator()(const FontDescriptor& f) const noexcept
+	{
+		size_t h = std::hash<std::string>()(f.Name);
+		h ^= static_cast<size_t>(f.SizeInPixels) * 0x9E3779B97F4A7C15ull;
+		h ^= (static_cast<size_t>(f.IsBold) << 1) | static_cast<size_t>(f.IsItalic);
+		return h;
+	}
+};
+
+struct FontMetrics
+{
+	int Height = 0;
+	int Ascent = 0;
+	int Descent = 0;
+};
+
+struct TextExtent
+{
+	int Width = 0;
+	int Height = 0;
+
+	constexpr bool operator==(const TextExtent& e) const noexcept = default;
+};
+
+// Backend providing the real font metrics (GDI, DirectWrite, a synthetic font for tests, etc...).
+// Strings are single byte characters like the rest of the library (std::string with the ANSI APIs)
+class ITextMetrics
+{
+public:
+
+	virtual ~ITextMetrics() = default;
+
+	virtual FontMetrics GetFontMetrics(const FontDescriptor& font) = 0;
+
+	// Advance width of every single byte character, so the whole table of a font is filled with a single call
+	virtual void GetAdvances(const FontDescriptor& font, int (&advances)[256]) = 0;
+
+	// Kerning (or any shaping) makes the width of a string different from the sum of its advances
+	virtual bool HasKerning(const FontDescriptor& font) = 0;
+
+	virtual int MeasureWidth(const FontDescriptor& font, std::string_view text) = 0;
+};
\ No newline at end of file
@@ -1,9 +1,8 @@
 #pragma once
 
-#include "IEquatable.h"
-#include "IComparable.h"
+#include "ValueType.h"
 
-class IntPtr : public IComparable<IntPtr>, public IEquatable<IntPtr>
+class IntPtr
 {
 private:
 
@@ -107,16 +106,25 @@ public:
 #endif
 	}
 
-	int GetHashCode() const override;
-	int CompareTo(const Object* const obj) const override;
-	int CompareTo(const IntPtr* const b) const override;
-	bool Equals(const Object* const obj) const override;
-	bool Equals(const IntPtr* const p) const override;
-	//OVERRIDE OBJECT TO STRING inline virtual const std::string ToString() const noexcept;
+	constexpr int GetHashCode() const noexcept { return static_cast<int>(m_Ptr); }
+	constexpr bool Equals(const IntPtr* const p) const noexcept { return p != nullptr && *this == *p; }
+
+	constexpr int CompareTo(const IntPtr* const b) const noexcept
+	{
+		if (b == nullptr) return 1;
+
+		if (m_Ptr < b->m_Ptr) return -1;
+		if (m_Ptr > b->m_Ptr) return 1;
+
+		return 0;
+	}
 
 #if _WIN64
 	static constexpr IntPtr Zero() { return IntPtr(static_cast<uint64_t>(0UL)); }
 #else
 	static constexpr IntPtr Zero() { return IntPtr(static_cast<uint32_t>(0U)); }
 #endif
-};
\ No newline at end of file
+};
+
+static_assert(ComparableValue<IntPtr>);
+static_assert(sizeof(IntPtr) == sizeof(void*), "IntPtr must have the same size of a native pointer");
\ No newline at end of file
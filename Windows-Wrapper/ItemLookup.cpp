@@ -0,0 +1,409 @@
+#include "ItemLookup.h"
+
+#include <functional>
+#include <algorithm>
+#include <bit>
+
+size_t ItemLookup::Table::GetSlot(uint64_t key) const noexcept
+{
+	// Fibonacci hashing spreads close ids over the whole table
+	return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> (64 - std::countr_zero(Slots.size())));
+}
+
+void ItemLookup::Table::Rehash(size_t size)
+{
+	Slots.assign(size, 0);
+
+	for (size_t i = 0; i < Chains.size(); ++i)
+	{
+		size_t slot = GetSlot(Chains[i].Key);
+
+		while (Slots[slot] != 0)
+		{
+			slot = (slot + 1) & (Slots.size() - 1);
+		}
+
+		Slots[slot] = static_cast<uint32_t>(i + 1);
+	}
+}
+
+void ItemLookup::Table::Reserve(size_t count)
+{
+	Chains.reserve(count);
+	Grow(count);
+}
+
+void ItemLookup::Table::Grow(size_t count)
+{
+	// At most half of the slots are used
+	if (count * 2 > Slots.size())
+	{
+		Rehash(std::bit_ceil((std::max)(count * 2, size_t{ 16 })));
+	}
+}
+
+ItemLookup::Chain* ItemLookup::Table::Find(uint64_t key) noexcept
+{
+	if (Slots.empty()) return nullptr;
+
+	for (size_t slot = GetSlot(key); Slots[slot] != 0; slot = (slot + 1) & (Slots.size() - 1))
+	{
+		auto& chain = Chains[Slots[slot] - 1];
+
+		if (chain.Key == key) return &chain;
+	}
+
+	return nullptr;
+}
+
+ItemLookup::Chain& ItemLookup::Table::Emplace(uint64_t key)
+{
+	Grow(Chains.size() + 1);
+
+	size_t slot = GetSlot(key);
+
+	for (; Slots[slot] != 0; slot = (slot + 1) & (Slots.size() - 1))
+	{
+		auto& chain = Chains[Slots[slot] - 1];
+
+		if (chain.Key == key) return chain;
+	}
+
+	Chains.push_back({ key, NotFound, NotFound, 0 });
+	Slots[slot] = static_cast<uint32_t>(Chains.size());
+
+	return Chains.back();
+}
+
+uint64_t ItemLookup::GetKey(int id) noexcept
+{
+	return static_cast<uint64_t>(static_cast<uint32_t>(id));
+}
+
+uint64_t ItemLookup::GetKey(std::string_view value) noexcept
+{
+	return static_cast<uint64_t>(std::hash<std::string_view>{}(value));
+}
+
+void ItemLookup::Link(Table& table, std::vector<size_t>& next, uint64_t key, size_t index)
+{
+	auto& chain = table.Emplace(key);
+
+	next[index] = NotFound;
+
+	if (chain.Count++ == 0)
+	{
+		chain.First = chain.Last = index;
+		return;
+	}
+
+	// Appended items go at the end of their chain, changed ones are placed in order among the duplicates
+	if (index > chain.Last)
+	{
+		next[chain.Last] = index;
+		chain.Last = index;
+	}
+	else if (index < chain.First)
+	{
+		next[index] = chain.First;
+		chain.First = index;
+	}
+	else
+	{
+		size_t previous = chain.First;
+
+		while (next[previous] < index)
+		{
+			previous = next[previous];
+		}
+
+		next[index] = next[previous];
+		next[previous] = index;
+	}
+}
+
+void ItemLookup::Unlink(Table& table, std::vector<size_t>& next, uint64_t key, size_t index)
+{
+	auto* chain = table.Find(key);
+
+	if (chain == nullptr || chain->Count == 0) return;
+
+	if (--chain->Count == 0)
+	{
+		chain->First = chain->Last = NotFound;
+		return;
+	}
+
+	if (chain->First == index)
+	{
+		chain->First = next[index];
+		return;
+	}
+
+	size_t previous = chain->First;
+
+	while (next[previous] != index)
+	{
+		previous = next[previous];
+	}
+
+	next[previous] = next[index];
+
+	if (chain->Last == index) chain->Last = previous;
+}
+
+void ItemLookup::Open(Table& table, std::vector<size_t>& next, size_t index, size_t count)
+{
+	auto shift = [index, count](size_t& position)
+		{
+			if (position != NotFound && position >= index) position += count;
+		};
+
+	for (auto& chain : table.Chains)
+	{
+		shift(chain.First);
+		shift(chain.Last);
+	}
+
+	for (auto& position : next)
+	{
+		shift(position);
+	}
+
+	next.insert(next.begin() + static_cast<std::ptrdiff_t>(index), count, NotFound);
+}
+
+void ItemLookup::Remove(Table& table, std::vector<size_t>& next, size_t index, size_t count)
+{
+	const size_t end = index + count;
+	auto isRemoved = [index, end](size_t position) { return position >= index && position < end; };
+	auto shift = [end, count](size_t& position)
+		{
+			if (position != NotFound && position >= end) position -= count;
+		};
+
+	// The chains and links skip the removed positions (read through their links, left as they were) and every position
+	// after them is shifted, in one pass each
+	for (auto& chain : table.Chains)
+	{
+		if (chain.Count == 0)
+		{
+			chain.First = chain.Last = NotFound;
+			continue;
+		}
+
+		while (isRemoved(chain.First))
+		{
+			chain.First = next[chain.First];
+		}
+
+		if (isRemoved(chain.Last))
+		{
+			for (size_t i = chain.First; i != NotFound; i = next[i])
+			{
+				if (!isRemoved(i)) chain.Last = i;
+			}
+		}
+
+		shift(chain.First);
+		shift(chain.Last);
+	}
+
+	for (size_t i = 0; i < next.size(); ++i)
+	{
+		if (isRemoved(i)) continue;
+
+		while (isRemoved(next[i]))
+		{
+			next[i] = next[next[i]];
+		}
+
+		shift(next[i]);
+	}
+
+	next.erase(next.begin() + static_cast<std::ptrdiff_t>(index), next.begin() + static_cast<std::ptrdiff_t>(end));
+}
+
+void ItemLookup::Build()
+{
+	const size_t count = m_Items.GetCount();
+
+	m_Ids = Table();
+	m_Values = Table();
+	m_Ids.Reserve(count);
+	m_Values.Reserve(count);
+	m_NextId.assign(count, NotFound);
+	m_NextValue.assign(count, NotFound);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		Link(m_Ids, m_NextId, GetKey(m_Items.GetId(i)), i);
+		Link(m_Values, m_NextValue, GetKey(m_Items.GetValue(i)), i);
+	}
+
+	m_IsBuilt = true;
+}
+
+ItemLookup::ItemLookup(const ItemStore& items) noexcept
+	:
+	m_Items(items),
+	m_IsBuilt(false)
+{
+
+}
+
+void ItemLookup::Clear() noexcept
+{
+	m_IsBuilt = false;
+	m_Ids = Table();
+	m_Values = Table();
+	m_NextId = {};
+	m_NextValue = {};
+}
+
+void ItemLookup::OnInsert(size_t index, size_t count)
+{
+	if (!m_IsBuilt || count == 0) return;
+
+	// Appended items keep the positions of the others
+	if (index + count != m_Items.GetCount())
+	{
+		if (count * 2 > m_Items.GetCount())
+		{
+			Clear();
+			return;
+		}
+
+		Open(m_Ids, m_NextId, index, count);
+		Open(m_Values, m_NextValue, index, count);
+	}
+	else
+	{
+		m_NextId.resize(m_Items.GetCount(), NotFound);
+		m_NextValue.resize(m_Items.GetCount(), NotFound);
+	}
+
+	for (size_t i = index; i < index + count; ++i)
+	{
+		Link(m_Ids, m_NextId, GetKey(m_Items.GetId(i)), i);
+		Link(m_Values, m_NextValue, GetKey(m_Items.GetValue(i)), i);
+	}
+}
+
+void ItemLookup::OnErasing(size_t index, size_t count)
+{
+	if (!m_IsBuilt || count == 0) return;
+
+	if (count * 2 > m_Items.GetCount())
+	{
+		Clear();
+		return;
+	}
+
+	for (size_t i = index; i < index + count; ++i)
+	{
+		--m_Ids.Find(GetKey(m_Items.GetId(i)))->Count;
+		--m_Values.Find(GetKey(m_Items.GetValue(i)))->Count;
+	}
+
+	Remove(m_Ids, m_NextId, index, count);
+	Remove(m_Values, m_NextValue, index, count);
+}
+
+void ItemLookup::OnUpdating(size_t index)
+{
+	if (!m_IsBuilt) return;
+
+	Unlink(m_Ids, m_NextId, GetKey(m_Items.GetId(index)), index);
+	Unlink(m_Values, m_NextValue, GetKey(m_Items.GetValue(index)), index);
+}
+
+void ItemLookup::OnUpdated(size_t index)
+{
+	if (!m_IsBuilt) return;
+
+	Link(m_Ids, m_NextId, GetKey(m_Items.GetId(index)), index);
+	Link(m_Values, m_NextValue, GetKey(m_Items.GetValue(index)), index);
+}
+
+size_t ItemLookup::FindId(int id)
+{
+	if (!m_IsBuilt) Build();
+
+	const auto* chain = m_Ids.Find(GetKey(id));
+
+	return chain != nullptr ? chain->First : NotFound;
+}
+
+size_t ItemLookup::FindValue(std::string_view value)
+{
+	if (!m_IsBuilt) Build();
+
+	const auto* chain = m_Values.Find(GetKey(value));
+
+	if (chain == nullptr) return NotFound;
+
+	for (size_t i = chain->First; i != NotFound; i = m_NextValue[i])
+	{
+		if (m_Items.GetValue(i) == value) return i;
+	}
+
+	return NotFound;
+}
+
+size_t ItemLookup::Find(int id, std::string_view value)
+{
+	if (!m_IsBuilt) Build();
+
+	const auto* ids = m_Ids.Find(GetKey(id));
+	const auto* values = m_Values.Find(GetKey(value));
+
+	if (ids == nullptr || values == nullptr) return NotFound;
+
+	// Walks the shorter chain, checking the other key on each position
+	if (ids->Count <= values->Count)
+	{
+		for (size_t i = ids->First; i != NotFound; i = m_NextId[i])
+		{
+			if (m_Items.GetValue(i) == value) return i;
+		}
+	}
+	else
+	{
+		for (size_t i = values->First; i != NotFound; i = m_NextValue[i])
+		{
+			if (m_Items.GetId(i) == id && m_Items.GetValue(i) == value) return i;
+		}
+	}
+
+	return NotFound;
+}
+
+std::vector<size_t> ItemLookup::FindAll(int id, std::string_view value)
+{
+	if (!m_IsBuilt) Build();
+
+	std::vector<size_t> matches;
+
+	const auto* ids = m_Ids.Find(GetKey(id));
+	const auto* values = m_Values.Find(GetKey(value));
+
+	if (ids == nullptr || values == nullptr) return matches;
+
+	if (ids->Count <= values->Count)
+	{
+		for (size_t i = ids->First; i != NotFound; i = m_NextId[i])
+		{
+			if (m_Items.GetValue(i) == value) matches.push_back(i);
+		}
+	}
+	else
+	{
+		for (size_t i = values->First; i != NotFound; i = m_NextValue[i])
+		{
+			if (m_Items.GetId(i) == id && m_Items.GetValue(i) == value) matches.push_back(i);
+		}
+	}
+
+	return matches;
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "ItemStore.h"
+#include <vector>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+/*
+Hash index from the id and from the value of the items of an ItemStore to their positions.
+
+Each distinct id (and each value hash) maps to a chain of the positions holding it, in ascending order: the table keeps
+the first and last position of the chain and a next array links each position to the following one. Finding the first
+item with an id, a value or both is a hash lookup followed by a walk over the duplicates only, instead of comparing
+every item. The chains are stored in one array and found through an open addressing table of their indices, so a
+million items are a few allocations instead of one node each.
+
+The index is built on the first lookup and kept up to date while items change. Items inserted before the end or removed
+shift the positions after them: the chains and links are shifted in one pass over the integers, without hashing the
+values again. A change of more than half of the items drops the index instead, built again at the next lookup.
+*/
+class ItemLookup
+{
+public:
+
+	static constexpr size_t NotFound = static_cast<size_t>(-1);
+
+private:
+
+	struct Chain
+	{
+		uint64_t Key;
+		size_t First;
+		size_t Last;
+		size_t Count;		// Chains left empty by changed items are kept until the next build
+	};
+
+	struct Table
+	{
+		std::vector<Chain> Chains;
+		std::vector<uint32_t> Slots;		// Index + 1 of a chain, 0 when the slot is free (linear probing)
+
+		size_t GetSlot(uint64_t key) const noexcept;
+		void Rehash(size_t size);
+		void Reserve(size_t count);
+		void Grow(size_t count);
+		Chain* Find(uint64_t key) noexcept;
+		Chain& Emplace(uint64_t key);
+	};
+
+	const ItemStore& m_Items;
+	bool m_IsBuilt;
+	Table m_Ids;
+	Table m_Values;		// By hash of the value, different values may share a chain
+	std::vector<size_t> m_NextId;
+	std::vector<size_t> m_NextValue;
+
+	static uint64_t GetKey(int id) noexcept;
+	static uint64_t GetKey(std::string_view value) noexcept;
+	static void Link(Table& table, std::vector<size_t>& next, uint64_t key, size_t index);
+	static void Unlink(Table& table, std::vector<size_t>& next, uint64_t key, size_t index);
+	static void Open(Table& table, std::vector<size_t>& next, size_t index, size_t count);
+	static void Remove(Table& table, std::vector<size_t>& next, size_t index, size_t count);
+
+	void Build();
+
+public:
+
+	explicit ItemLookup(const ItemStore& items) noexcept;
+
+	// Drops the index (and its memory), built again at the next lookup
+	void Clear() noexcept;
+
+	// Must be called after items are inserted in the store
+	void OnInsert(size_t index, size_t count);
+
+	// Must be called before items are removed from the store, their keys are needed to unlink them
+	void OnErasing(size_t index, size_t count);
+
+	// Must be called before and after the item at index is changed in the store
+	void OnUpdating(size_t index);
+	void OnUpdated(size_t index);
+
+	// First position holding the id, the value or both (NotFound when there's none)
+	size_t FindId(int id);
+	size_t FindValue(std::string_view value);
+	size_t Find(int id, std::string_view value);
+
+	// Every position holding both, in ascending order
+	std::vector<size_t> FindAll(int id, std::string_view value);
+};
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include "ItemSnapshot.h"
+
+ItemSnapshot::ItemSnapshot() noexcept
+	:
+	m_Count(0)
+{
+
+}
+
+size_t ItemSnapshot::GetCount() const noexcept
+{
+	return m_Count;
+}
+
+ItemStore::Item ItemSnapshot::operator[](size_t index) const noexcept
+{
+	return (*m_Chunks[index / ChunkSize])[index % ChunkSize];
+}
+
+int ItemSnapshot::GetId(size_t index) const noexcept
+{
+	return m_Chunks[index / ChunkSize]->GetId(index % ChunkSize);
+}
+
+std::string_view ItemSnapshot::GetValue(size_t index) const noexcept
+{
+	return m_Chunks[index / ChunkSize]->GetValue(index % ChunkSize);
+}
+
+size_t ItemSnapshot::GetSharedCount(const ItemSnapshot& other) const noexcept
+{
+	size_t count = 0;
+
+	for (size_t i = 0; i < (std::min)(m_Chunks.size(), other.m_Chunks.size()); ++i)
+	{
+		if (m_Chunks[i] == other.m_Chunks[i]) count += m_Chunks[i]->GetCount();
+	}
+
+	return count;
+}
+
+ItemSnapshot::Builder::Builder() noexcept
+{
+
+}
+
+ItemSnapshot::Builder::Builder(const ItemSnapshot& base, size_t count)
+{
+	count = (std::min)(count, base.m_Count);
+
+	m_Chunks.assign(base.m_Chunks.begin(), base.m_Chunks.begin() + count / ChunkSize);
+
+	// The items of a partial chunk are copied, the chunk itself stays as it is in the base
+	for (size_t i = m_Chunks.size() * ChunkSize; i < count; ++i)
+	{
+		Add(base[i]);
+	}
+}
+
+void ItemSnapshot::Builder::Seal()
+{
+	m_Chunks.push_back(std::make_shared<const ItemStore>(std::move(m_Tail)));
+	m_Tail = ItemStore();
+}
+
+size_t ItemSnapshot::Builder::GetCount() const noexcept
+{
+	return m_Chunks.size() * ChunkSize + m_Tail.GetCount();
+}
+
+std::shared_ptr<const ItemSnapshot> ItemSnapshot::Builder::Build()
+{
+	std::shared_ptr<ItemSnapshot> snapshot(new ItemSnapshot());
+
+	snapshot->m_Count = GetCount();
+
+	if (!m_Tail.IsEmpty()) Seal();
+
+	snapshot->m_Chunks = std::move(m_Chunks);
+	m_Chunks = {};
+
+	return snapshot;
+}
\ No newline at end of file
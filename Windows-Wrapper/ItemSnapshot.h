@@ -0,0 +1,87 @@
+#pragma once
+
+#include "ItemStore.h"
+#include <vector>
+#include <memory>
+#include <iterator>
+#include <algorithm>
+#include <cstddef>
+
+/*
+Immutable list of items, shared between threads by reference counting.
+
+Items are kept in chunks of ChunkSize items (an ItemStore each). A snapshot is made by a Builder, which can start from
+the first items of another snapshot: the full chunks of that prefix are shared instead of copied, so appending to a
+million items only copies the last partial chunk. A published snapshot is never changed, so any thread can read it
+while new ones are built.
+*/
+class ItemSnapshot
+{
+public:
+
+	static constexpr size_t ChunkSize = 4096;
+
+	class Builder;
+
+private:
+
+	std::vector<std::shared_ptr<const ItemStore>> m_Chunks;		// Every chunk but the last one is full
+	size_t m_Count;
+
+	ItemSnapshot() noexcept;
+
+public:
+
+	size_t GetCount() const noexcept;
+	ItemStore::Item operator[](size_t index) const noexcept;
+	int GetId(size_t index) const noexcept;
+	std::string_view GetValue(size_t index) const noexcept;
+
+	// Items of this snapshot stored in chunks shared with the other one
+	size_t GetSharedCount(const ItemSnapshot& other) const noexcept;
+};
+
+class ItemSnapshot::Builder
+{
+private:
+
+	std::vector<std::shared_ptr<const ItemStore>> m_Chunks;
+	ItemStore m_Tail;		// Chunk being filled
+
+	void Seal();
+
+public:
+
+	Builder() noexcept;
+
+	// Starts from the first count items of the snapshot, sharing its full chunks
+	Builder(const ItemSnapshot& base, size_t count);
+
+	size_t GetCount() const noexcept;
+
+	// T is any type with the members of ListItem (ListItem itself, ItemStore::Item)
+	template<typename T>
+	void Add(const T& item)
+	{
+		Add(&item, &item + 1);
+	}
+
+	template<typename It>
+	void Add(It first, It last)
+	{
+		while (first != last)
+		{
+			// Fills the tail up to a full chunk at a time
+			const auto room = static_cast<std::ptrdiff_t>(ChunkSize - m_Tail.GetCount());
+			const auto next = std::next(first, (std::min)(room, static_cast<std::ptrdiff_t>(std::distance(first, last))));
+
+			m_Tail.Insert(m_Tail.GetCount(), first, next);
+			first = next;
+
+			if (m_Tail.GetCount() == ChunkSize) Seal();
+		}
+	}
+
+	// The builder is empty afterwards
+	std::shared_ptr<const ItemSnapshot> Build();
+};
\ No newline at end of file
@@ -0,0 +1,168 @@
+#include "ItemStore.h"
+
+ItemStore::ItemStore() noexcept
+	:
+	m_Garbage(0)
+{
+
+}
+
+void ItemStore::Open(size_t index, size_t count)
+{
+	// Opened items have an empty value, so writing them only appends to the arena
+	m_Ids.insert(m_Ids.begin() + index, count, 0);
+	m_Offsets.insert(m_Offsets.begin() + index, count, m_Text.size());
+	m_Lengths.insert(m_Lengths.begin() + index, count, 0);
+	m_IsTabulated.insert(m_IsTabulated.begin() + index, count, false);
+	m_IsVisible.insert(m_IsVisible.begin() + index, count, true);
+	m_IsSelected.insert(m_IsSelected.begin() + index, count, false);
+}
+
+void ItemStore::Write(size_t index, int id, std::string_view value, bool isTabulated, bool isVisible, bool isSelected)
+{
+	const size_t length = m_Lengths[index];
+
+	if (value.size() <= length)
+	{
+		value.copy(m_Text.data() + m_Offsets[index], value.size());
+		m_Garbage += length - value.size();
+	}
+	else
+	{
+		m_Offsets[index] = m_Text.size();
+		m_Text.append(value);
+		m_Garbage += length;
+	}
+
+	m_Ids[index] = id;
+	m_Lengths[index] = static_cast<uint32_t>(value.size());
+	m_IsTabulated[index] = isTabulated;
+	m_IsVisible[index] = isVisible;
+	m_IsSelected[index] = isSelected;
+
+	if (m_Garbage > m_Text.size() / 2)
+	{
+		Compact();
+	}
+}
+
+void ItemStore::Compact()
+{
+	std::string text;
+	text.reserve(m_Text.size() - m_Garbage);
+
+	for (size_t i = 0; i < m_Ids.size(); ++i)
+	{
+		const size_t offset = text.size();
+
+		text.append(m_Text, m_Offsets[i], m_Lengths[i]);
+		m_Offsets[i] = offset;
+	}
+
+	m_Text = std::move(text);
+	m_Garbage = 0;
+}
+
+size_t ItemStore::GetCount() const noexcept
+{
+	return m_Ids.size();
+}
+
+bool ItemStore::IsEmpty() const noexcept
+{
+	return m_Ids.empty();
+}
+
+size_t ItemStore::GetTextCapacity() const noexcept
+{
+	return m_Text.capacity();
+}
+
+ItemStore::Item ItemStore::operator[](size_t index) const noexcept
+{
+	return { m_Ids[index], GetValue(index), m_IsTabulated[index], m_IsVisible[index], m_IsSelected[index] };
+}
+
+ItemStore::Iterator ItemStore::begin() const noexcept
+{
+	return { this, 0 };
+}
+
+ItemStore::Iterator ItemStore::end() const noexcept
+{
+	return { this, GetCount() };
+}
+
+int ItemStore::GetId(size_t index) const noexcept
+{
+	return m_Ids[index];
+}
+
+std::string_view ItemStore::GetValue(size_t index) const noexcept
+{
+	return { m_Text.data() + m_Offsets[index], m_Lengths[index] };
+}
+
+bool ItemStore::IsTabulated(size_t index) const noexcept
+{
+	return m_IsTabulated[index];
+}
+
+bool ItemStore::IsVisible(size_t index) const noexcept
+{
+	return m_IsVisible[index];
+}
+
+bool ItemStore::IsSelected(size_t index) const noexcept
+{
+	return m_IsSelected[index];
+}
+
+void ItemStore::SetTabulated(size_t index, bool value)
+{
+	m_IsTabulated[index] = value;
+}
+
+void ItemStore::SetVisible(size_t index, bool value)
+{
+	m_IsVisible[index] = value;
+}
+
+void ItemStore::SetSelected(size_t index, bool value)
+{
+	m_IsSelected[index] = value;
+}
+
+void ItemStore::Clear() noexcept
+{
+	m_Ids.clear();
+	m_Offsets.clear();
+	m_Lengths.clear();
+	m_Text.clear();
+	m_Garbage = 0;
+	m_IsTabulated.clear();
+	m_IsVisible.clear();
+	m_IsSelected.clear();
+}
+
+void ItemStore::Erase(size_t index, size_t count)
+{
+	if (count == 0) return;
+
+	for (size_t i = index; i < index + count; ++i)
+	{
+		m_Garbage += m_Lengths[i];
+	}
+
+	m_Ids.erase(m_Ids.begin() + index, m_Ids.begin() + index + count);
+	m_Offsets.erase(m_Offsets.begin() + index, m_Offsets.begin() + index + count);
+	m_Lengths.erase(m_Lengths.begin() + index, m_Lengths.begin() + index + count);
+	m_IsTabulated.erase(m_IsTabulated.begin() + index, m_IsTabulated.begin() + index + count);
+	m_IsVisible.erase(m_IsVisible.begin() + index, m_IsVisible.begin() + index + count);
+	m_IsSelected.erase(m_IsSelected.begin() + index, m_IsSelected.begin() + index + count);
+
+	if (m_Garbage > m_Text.size() / 2)
+	{
+		Compact();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <iterator>
+#include <cstdint>
+#include <cstddef>
+
+/*
+Compact storage of the items of a list, one array per member instead of one object per item.
+
+Ids are kept in one array, every value is written back to back in a single text arena (each item keeping its offset
+and length) and the flags are packed in bitsets. A million items are a handful of allocations instead of one object
+(and one string) each, and walking the values of the drawn rows reads contiguous memory.
+
+The arena is never moved when items are inserted or removed: new values are appended and the bytes of the removed
+ones are reclaimed once they are more than half of the arena. A value shorter than the old one is written in place.
+*/
+class ItemStore
+{
+public:
+
+	// Copy of an item with the members of ListItem. Value points into the arena, so it's only valid until the next
+	// change of the store
+	struct Item
+	{
+		int Id;
+		std::string_view Value;
+		bool Tabulated;
+		bool Visible;
+		bool Selected;
+	};
+
+	// Walks the items by index, dereferencing gives an Item
+	class Iterator
+	{
+	private:
+
+		const ItemStore* m_Store;
+		size_t m_Index;
+
+	public:
+
+		using iterator_category = std::input_iterator_tag;
+		using value_type = Item;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = Item;
+
+		Iterator(const ItemStore* store, size_t index) noexcept : m_Store(store), m_Index(index) {}
+
+		Item operator*() const noexcept { return (*m_Store)[m_Index]; }
+		Iterator& operator++() noexcept { ++m_Index; return *this; }
+		Iterator operator++(int) noexcept { auto ret = *this; ++m_Index; return ret; }
+		bool operator==(const Iterator& other) const noexcept { return m_Index == other.m_Index; }
+	};
+
+private:
+
+	std::vector<int> m_Ids;
+	std::vector<size_t> m_Offsets;
+	std::vector<uint32_t> m_Lengths;
+	std::string m_Text;					// Every value, back to back
+	size_t m_Garbage;					// Bytes of m_Text no value uses anymore
+	std::vector<bool> m_IsTabulated;
+	std::vector<bool> m_IsVisible;
+	std::vector<bool> m_IsSelected;
+
+	void Open(size_t index, size_t count);
+	void Write(size_t index, int id, std::string_view value, bool isTabulated, bool isVisible, bool isSelected);
+	void Compact();
+
+public:
+
+	ItemStore() noexcept;
+
+	size_t GetCount() const noexcept;
+	bool IsEmpty() const noexcept;
+
+	// Bytes used by the arena, the reclaimable ones included
+	size_t GetTextCapacity() const noexcept;
+
+	Item operator[](size_t index) const noexcept;
+	Iterator begin() const noexcept;
+	Iterator end() const noexcept;
+	int GetId(size_t index) const noexcept;
+	std::string_view GetValue(size_t index) const noexcept;
+	bool IsTabulated(size_t index) const noexcept;
+	bool IsVisible(size_t index) const noexcept;
+	bool IsSelected(size_t index) const noexcept;
+	void SetTabulated(size_t index, bool value);
+	void SetVisible(size_t index, bool value);
+	void SetSelected(size_t index, bool value);
+
+	void Clear() noexcept;
+	void Erase(size_t index, size_t count);
+
+	// T is any type with the members of ListItem (ListItem itself, Item)
+	template<typename T>
+	void Set(size_t index, const T& item)
+	{
+		Write(index, item.Id, item.Value, item.Tabulated, item.Visible, item.Selected);
+	}
+
+	template<typename It>
+	void Insert(size_t index, It first, It last)
+	{
+		size_t length = 0;
+
+		for (auto it = first; it != last; ++it)
+		{
+			length += std::string_view(it->Value).size();
+		}
+
+		m_Text.reserve(m_Text.size() + length);
+		Open(index, static_cast<size_t>(std::distance(first, last)));
+
+		for (; first != last; ++first)
+		{
+			Set(index++, *first);
+		}
+	}
+
+	template<typename It>
+	void Assign(It first, It last)
+	{
+		Clear();
+		Insert(0, first, last);
+	}
+};
\ No newline at end of file
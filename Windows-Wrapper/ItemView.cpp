@@ -0,0 +1,444 @@
+#include "ItemView.h"
+
+#include <algorithm>
+#include <numeric>
+#include <thread>
+
+ItemView::ItemView() noexcept
+	:
+	m_SourceCount(0),
+	m_UpdatingOrder(NotFound),
+	m_UpdatingRow(NotFound)
+{
+
+}
+
+void ItemView::SortOrder()
+{
+	m_Order.resize(m_SourceCount);
+	std::iota(m_Order.begin(), m_Order.end(), size_t{ 0 });
+
+	const auto begin = m_Order.begin();
+	const size_t threads = m_SourceCount < ParallelSortMinimumCount ? 1 : std::clamp<size_t>(std::thread::hardware_concurrency(), 1, 16);
+
+	if (threads == 1)
+	{
+		std::stable_sort(m_Order.begin(), m_Order.end(), m_Comparer);
+		return;
+	}
+
+	// Each thread sorts a chunk, then neighbour chunks are merged two by two (also in parallel) until one is left
+	std::vector<size_t> bounds(threads + 1);
+
+	for (size_t i = 0; i <= threads; ++i)
+	{
+		bounds[i] = m_SourceCount * i / threads;
+	}
+
+	std::vector<std::thread> workers;
+
+	for (size_t i = 0; i < threads; ++i)
+	{
+		workers.emplace_back([&, i]() { std::stable_sort(begin + bounds[i], begin + bounds[i + 1], m_Comparer); });
+	}
+
+	for (auto& worker : workers) worker.join();
+
+	for (size_t width = 1; width < threads; width *= 2)
+	{
+		workers.clear();
+
+		for (size_t i = 0; i + width < threads; i += 2 * width)
+		{
+			const size_t first = bounds[i];
+			const size_t middle = bounds[i + width];
+			const size_t last = bounds[(std::min)(i + 2 * width, threads)];
+
+			workers.emplace_back([&, first, middle, last]() { std::inplace_merge(begin + first, begin + middle, begin + last, m_Comparer); });
+		}
+
+		for (auto& worker : workers) worker.join();
+	}
+}
+
+void ItemView::Match()
+{
+	m_IsMatch.assign(m_SourceCount, false);
+
+	for (size_t index = 0; index < m_SourceCount; ++index)
+	{
+		m_IsMatch[index] = m_Predicate(index);
+	}
+}
+
+void ItemView::Rebuild()
+{
+	m_Rows.clear();
+
+	if (!IsFiltered()) return;
+
+	if (IsSorted())
+	{
+		for (const size_t index : m_Order)
+		{
+			if (m_IsMatch[index]) m_Rows.push_back(index);
+		}
+	}
+	else
+	{
+		for (size_t index = 0; index < m_SourceCount; ++index)
+		{
+			if (m_IsMatch[index]) m_Rows.push_back(index);
+		}
+	}
+}
+
+bool ItemView::IsBefore(size_t a, size_t b) const
+{
+	if (!IsSorted()) return a < b;
+
+	return m_Comparer(a, b) || (!m_Comparer(b, a) && a < b);
+}
+
+size_t ItemView::Locate(const std::vector<size_t>& indices, size_t index, size_t skip) const
+{
+	auto search = [&](auto first, auto last)
+		{
+			return static_cast<size_t>(std::lower_bound(first, last, index, [this](size_t a, size_t b) { return IsBefore(a, b); }) - indices.begin());
+		};
+
+	if (skip == NotFound) return search(indices.begin(), indices.end());
+
+	const size_t position = search(indices.begin(), indices.begin() + skip);
+
+	return position < skip ? position : search(indices.begin() + skip + 1, indices.end()) - 1;
+}
+
+void ItemView::Move(std::vector<size_t>& indices, size_t from, size_t to)
+{
+	const auto begin = indices.begin();
+
+	if (from < to)
+	{
+		std::rotate(begin + from, begin + from + 1, begin + to + 1);
+	}
+	else if (to < from)
+	{
+		std::rotate(begin + to, begin + from, begin + from + 1);
+	}
+}
+
+void ItemView::AddRow(std::vector<RowRange>& ranges, size_t row)
+{
+	if (!ranges.empty() && ranges.back().First + ranges.back().Count == row)
+	{
+		++ranges.back().Count;
+	}
+	else
+	{
+		ranges.push_back({ row, 1 });
+	}
+}
+
+void ItemView::Reset(size_t count)
+{
+	m_SourceCount = count;
+
+	if (IsSorted())
+	{
+		SortOrder();
+	}
+
+	if (IsFiltered())
+	{
+		Match();
+	}
+
+	Rebuild();
+}
+
+size_t ItemView::GetCount() const noexcept
+{
+	return IsFiltered() ? m_Rows.size() : m_SourceCount;
+}
+
+size_t ItemView::GetSourceCount() const noexcept
+{
+	return m_SourceCount;
+}
+
+bool ItemView::IsSorted() const noexcept
+{
+	return static_cast<bool>(m_Comparer);
+}
+
+bool ItemView::IsFiltered() const noexcept
+{
+	return static_cast<bool>(m_Predicate);
+}
+
+bool ItemView::IsIdentity() const noexcept
+{
+	return !IsSorted() && !IsFiltered();
+}
+
+size_t ItemView::GetSourceIndex(size_t row) const noexcept
+{
+	if (IsFiltered()) return m_Rows[row];
+	if (IsSorted()) return m_Order[row];
+
+	return row;
+}
+
+size_t ItemView::GetRow(size_t index) const
+{
+	if (IsFiltered()) return m_IsMatch[index] ? Locate(m_Rows, index, NotFound) : NotFound;
+	if (IsSorted()) return Locate(m_Order, index, NotFound);
+
+	return index;
+}
+
+std::vector<size_t> ItemView::GetRows() const
+{
+	std::vector<size_t> rows(m_SourceCount, NotFound);
+
+	for (size_t row = 0; row < GetCount(); ++row)
+	{
+		rows[GetSourceIndex(row)] = row;
+	}
+
+	return rows;
+}
+
+void ItemView::Sort(Comparer comparer)
+{
+	m_Comparer = std::move(comparer);
+	SortOrder();
+	Rebuild();
+}
+
+void ItemView::ClearSort()
+{
+	m_Comparer = nullptr;
+	m_Order.clear();
+	Rebuild();
+}
+
+void ItemView::Filter(Predicate predicate)
+{
+	m_Predicate = std::move(predicate);
+	Match();
+	Rebuild();
+}
+
+void ItemView::Narrow(Predicate predicate)
+{
+	if (!IsFiltered())
+	{
+		Filter(std::move(predicate));
+		return;
+	}
+
+	m_Predicate = std::move(predicate);
+
+	// Items already filtered out can't match a narrower predicate, only the rows are checked again
+	std::erase_if(m_Rows, [&](size_t index)
+		{
+			if (m_Predicate(index)) return false;
+
+			m_IsMatch[index] = false;
+			return true;
+		});
+}
+
+void ItemView::ClearFilter()
+{
+	m_Predicate = nullptr;
+	m_IsMatch.clear();
+	Rebuild();
+}
+
+std::vector<ItemView::RowRange> ItemView::OnInsert(size_t index, size_t count)
+{
+	if (count == 0) return {};
+
+	m_SourceCount += count;
+
+	if (IsIdentity()) return { { index, count } };
+
+	// Appended items don't move any other
+	for (auto* indices : { &m_Order, &m_Rows })
+	{
+		if (index + count == m_SourceCount) break;
+
+		for (auto& i : *indices)
+		{
+			if (i >= index) i += count;
+		}
+	}
+
+	if (IsFiltered())
+	{
+		m_IsMatch.insert(m_IsMatch.begin() + index, count, false);
+
+		for (size_t i = index; i < index + count; ++i)
+		{
+			m_IsMatch[i] = m_Predicate(i);
+		}
+	}
+
+	std::vector<RowRange> ranges;
+
+	// A few items are placed one by one, many are sorted on their own and merged with the current order
+	if (count < 16)
+	{
+		for (size_t i = index; i < index + count; ++i)
+		{
+			if (IsSorted()) m_Order.insert(m_Order.begin() + Locate(m_Order, i, NotFound), i);
+			if (IsFiltered() && m_IsMatch[i]) m_Rows.insert(m_Rows.begin() + Locate(m_Rows, i, NotFound), i);
+		}
+
+		std::vector<size_t> rows;
+
+		for (size_t i = index; i < index + count; ++i)
+		{
+			const size_t row = GetRow(i);
+			if (row != NotFound) rows.push_back(row);
+		}
+
+		std::sort(rows.begin(), rows.end());
+
+		for (const size_t row : rows) AddRow(ranges, row);
+
+		return ranges;
+	}
+
+	if (IsSorted())
+	{
+		auto less = [this](size_t a, size_t b) { return IsBefore(a, b); };
+		const auto middle = static_cast<std::ptrdiff_t>(m_Order.size());
+
+		for (size_t i = index; i < index + count; ++i)
+		{
+			m_Order.push_back(i);
+		}
+
+		std::sort(m_Order.begin() + middle, m_Order.end(), less);
+		std::inplace_merge(m_Order.begin(), m_Order.begin() + middle, m_Order.end(), less);
+	}
+
+	Rebuild();
+
+	const auto& shown = IsFiltered() ? m_Rows : m_Order;
+
+	for (size_t row = 0; row < shown.size(); ++row)
+	{
+		if (shown[row] >= index && shown[row] < index + count) AddRow(ranges, row);
+	}
+
+	return ranges;
+}
+
+std::vector<ItemView::RowRange> ItemView::OnErase(size_t index, size_t count)
+{
+	if (count == 0) return {};
+
+	m_SourceCount -= count;
+
+	if (IsIdentity()) return { { index, count } };
+
+	std::vector<RowRange> ranges;
+	const auto& shown = IsFiltered() ? m_Rows : m_Order;
+
+	for (size_t row = 0; row < shown.size(); ++row)
+	{
+		if (shown[row] >= index && shown[row] < index + count) AddRow(ranges, row);
+	}
+
+	for (auto* indices : { &m_Order, &m_Rows })
+	{
+		std::erase_if(*indices, [&](size_t i) { return i >= index && i < index + count; });
+
+		for (auto& i : *indices)
+		{
+			if (i >= index + count) i -= count;
+		}
+	}
+
+	if (IsFiltered())
+	{
+		m_IsMatch.erase(m_IsMatch.begin() + index, m_IsMatch.begin() + index + count);
+	}
+
+	return ranges;
+}
+
+size_t ItemView::OnUpdating(size_t index)
+{
+	// Found while the comparer still sees the old value
+	m_UpdatingOrder = IsSorted() ? Locate(m_Order, index, NotFound) : NotFound;
+	m_UpdatingRow = GetRow(index);
+
+	return m_UpdatingRow;
+}
+
+size_t ItemView::OnUpdated(size_t index)
+{
+	if (IsSorted())
+	{
+		Move(m_Order, m_UpdatingOrder, Locate(m_Order, index, m_UpdatingOrder));
+	}
+
+	if (!IsFiltered()) return GetRow(index);
+
+	m_IsMatch[index] = m_Predicate(index);
+
+	if (!m_IsMatch[index])
+	{
+		if (m_UpdatingRow != NotFound) m_Rows.erase(m_Rows.begin() + m_UpdatingRow);
+
+		return NotFound;
+	}
+
+	const size_t row = Locate(m_Rows, index, m_UpdatingRow);
+
+	if (m_UpdatingRow == NotFound)
+	{
+		m_Rows.insert(m_Rows.begin() + row, index);
+	}
+	else
+	{
+		Move(m_Rows, m_UpdatingRow, row);
+	}
+
+	return row;
+}
+
+std::vector<size_t> ItemView::GetRowMap(const std::vector<RowRange>& ranges, size_t oldCount, bool isInsert)
+{
+	std::vector<size_t> rows(oldCount);
+	auto range = ranges.begin();
+	size_t shift = 0;
+
+	for (size_t row = 0; row < oldCount; ++row)
+	{
+		// Inserted ranges are counted in new rows, removed ones in old rows
+		if (isInsert)
+		{
+			for (; range != ranges.end() && range->First <= row + shift; ++range) shift += range->Count;
+
+			rows[row] = row + shift;
+			continue;
+		}
+
+		if (range != ranges.end() && row == range->First + range->Count)
+		{
+			shift += range->Count;
+			++range;
+		}
+
+		rows[row] = range != ranges.end() && row >= range->First ? NotFound : row - shift;
+	}
+
+	return rows;
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+#include <cstddef>
+
+/*
+Sorted and filtered view over the items of a list, without copying them.
+
+The view only keeps source indices: the sort order (a permutation of every item), one match flag per item and the
+rows shown (source index of each row). Comparer and Predicate receive source indices, so the caller reads its own
+items. Large lists are sorted in chunks on several threads and merged, the sort is stable.
+
+Narrow filters the rows already shown again instead of every item, for type-ahead filters where each character can
+only remove matches. Inserted and removed items are placed in the view (binary search on the sort order) without
+sorting or filtering the whole list again, and an updated item only moves the rows between its old and new places.
+Each change returns the rows it touched, so the control keeps its selection and row state around them.
+*/
+class ItemView
+{
+public:
+
+	static constexpr size_t NotFound = static_cast<size_t>(-1);
+	static constexpr size_t ParallelSortMinimumCount = 64 * 1024;
+
+	using Comparer = std::function<bool(size_t, size_t)>;
+	using Predicate = std::function<bool(size_t)>;
+
+	struct RowRange
+	{
+		size_t First;
+		size_t Count;
+	};
+
+private:
+
+	size_t m_SourceCount;
+	Comparer m_Comparer;
+	Predicate m_Predicate;
+	std::vector<size_t> m_Order;		// Every source index, sorted (empty when unsorted)
+	std::vector<bool> m_IsMatch;		// Filter result of each source index (empty when unfiltered)
+	std::vector<size_t> m_Rows;			// Source index of each row (empty when unfiltered, the sort order is used)
+	size_t m_UpdatingOrder;				// Places of the item between OnUpdating and OnUpdated (NotFound when none)
+	size_t m_UpdatingRow;
+
+	void SortOrder();
+	void Match();
+	void Rebuild();
+
+	// Equal items stay in source order, like the stable sort left them
+	bool IsBefore(size_t a, size_t b) const;
+
+	// Place of index in indices (ordered like the view), the one at skip is left out (NotFound to keep every one)
+	size_t Locate(const std::vector<size_t>& indices, size_t index, size_t skip) const;
+	static void Move(std::vector<size_t>& indices, size_t from, size_t to);
+	static void AddRow(std::vector<RowRange>& ranges, size_t row);
+
+public:
+
+	ItemView() noexcept;
+
+	// New items, the current sort and filter are applied to them
+	void Reset(size_t count);
+
+	size_t GetCount() const noexcept;
+	size_t GetSourceCount() const noexcept;
+	bool IsSorted() const noexcept;
+	bool IsFiltered() const noexcept;
+
+	// Rows are the source items in the same order
+	bool IsIdentity() const noexcept;
+
+	size_t GetSourceIndex(size_t row) const noexcept;
+
+	// Row of the source index, O(log n) (NotFound when it's filtered out)
+	size_t GetRow(size_t index) const;
+
+	// Row of each source index (NotFound when it's filtered out)
+	std::vector<size_t> GetRows() const;
+
+	// The comparer is called from several threads for large lists, so it must only read the items
+	void Sort(Comparer comparer);
+	void ClearSort();
+
+	void Filter(Predicate predicate);
+
+	// The predicate must only reject more items than the current one (ex: a longer prefix)
+	void Narrow(Predicate predicate);
+	void ClearFilter();
+
+	// Must be called after items are inserted or removed from the source. They return the rows of the new items and the
+	// rows the removed ones had, in increasing order
+	std::vector<RowRange> OnInsert(size_t index, size_t count);
+	std::vector<RowRange> OnErase(size_t index, size_t count);
+
+	// Must be called before and after an item of the source changes, both return its row (NotFound when it's filtered
+	// out). The item moves to the place of its new value in O(log n) plus the rows between the two places
+	size_t OnUpdating(size_t index);
+	size_t OnUpdated(size_t index);
+
+	// New row of each old one after the rows returned by OnInsert or OnErase were inserted or removed (NotFound for
+	// the removed ones)
+	static std::vector<size_t> GetRowMap(const std::vector<RowRange>& ranges, size_t oldCount, bool isInsert);
+};
\ No newline at end of file
@@ -5,9 +5,11 @@ void Label::Draw(Graphics* const graphics, Drawing::Rectangle rectangle)
 	auto hwnd = static_cast<HWND>(Handle.ToPointer());
 	auto hdc = static_cast<HDC>(graphics->GetHDC().ToPointer());
 
-	SIZE s;
-	GetTextExtentPoint32(hdc, Text.c_str(), static_cast<int>(Text.length()), &s);
-	Resize(Size(s.cx + m_Margin.Left + m_Margin.Right + 8, s.cy + m_Margin.Top + m_Margin.Bottom + 2));
+	const auto s = MeasureText(Text);
+	const Size size(s.Width + m_Margin.Left + m_Margin.Right + 8, s.Height + m_Margin.Top + m_Margin.Bottom + 2);
+
+	// Resizing on every paint would post a new WM_SIZE (and a layout pass) even when the text didn't change
+	if (size != m_Size) Resize(size);
 
 	RECT r;
 	GetClientRect(hwnd, &r);
@@ -0,0 +1,828 @@
+#include "Layout.h"
+
+#include <algorithm>
+
+namespace Layout
+{
+	Node::Node()
+		:
+		m_Parent(nullptr),
+		m_PanelType(PanelType::Default),
+		m_Dock(DockStyle::None),
+		m_Anchor(AnchorStyles::Top | AnchorStyles::Left),
+		m_X(0),
+		m_Y(0),
+		m_AnchorReference({ -1, -1 }),
+		m_IsAutoSize(false),
+		m_IsVisible(true),
+		m_FlowDirection(FlowDirection::LeftToRight),
+		m_IsWrapContents(true),
+		m_Row(0),
+		m_Column(0),
+		m_RowSpan(1),
+		m_ColumnSpan(1),
+		m_IsMeasureDirty(true),
+		m_IsArrangeDirty(true),
+		m_HasDirtyDescendant(false),
+		m_LastAvailable({ -1, -1 }),
+		m_IsArranged(false)
+	{
+
+	}
+
+	Node::~Node()
+	{
+		if (m_Parent != nullptr)
+		{
+			m_Parent->Remove(this);
+		}
+
+		for (auto c : m_Children)
+		{
+			c->m_Parent = nullptr;
+		}
+	}
+
+	Node* Node::GetParent() const noexcept
+	{
+		return m_Parent;
+	}
+
+	const std::vector<Node*>& Node::GetChildren() const noexcept
+	{
+		return m_Children;
+	}
+
+	void Node::Add(Node* child)
+	{
+		if (child == nullptr || child->m_Parent == this) return;
+
+		if (child->m_Parent != nullptr)
+		{
+			child->m_Parent->Remove(child);
+		}
+
+		m_Children.push_back(child);
+		child->m_Parent = this;
+		InvalidateContent();
+	}
+
+	void Node::Remove(Node* child)
+	{
+		auto it = std::find(m_Children.begin(), m_Children.end(), child);
+
+		if (it == m_Children.end()) return;
+
+		m_Children.erase(it);
+		child->m_Parent = nullptr;
+		InvalidateContent();
+	}
+
+	// Content of the node changed (children, padding, panel settings, etc...).
+	// The parent only needs to know when the node size depends on its content
+	void Node::InvalidateContent()
+	{
+		if (m_IsAutoSize)
+		{
+			InvalidateMeasure();
+			return;
+		}
+
+		m_IsArrangeDirty = true;
+		MarkAncestors();
+	}
+
+	void Node::MarkAncestors()
+	{
+		for (auto p = m_Parent; p != nullptr; p = p->m_Parent)
+		{
+			p->m_HasDirtyDescendant = true;
+		}
+	}
+
+	// Anchored edges may have moved or stretched the node since its location and size were set.
+	// Take its current bounds as the new design values before changing them so the node doesn't jump back
+	void Node::RebaseAnchor()
+	{
+		if (!m_IsArranged || m_Dock != DockStyle::None || m_Parent == nullptr || m_Parent->m_PanelType != PanelType::Default) return;
+
+		const bool isLeft = HasFlag(m_Anchor, AnchorStyles::Left);
+		const bool isRight = HasFlag(m_Anchor, AnchorStyles::Right);
+		const bool isTop = HasFlag(m_Anchor, AnchorStyles::Top);
+		const bool isBottom = HasFlag(m_Anchor, AnchorStyles::Bottom);
+
+		if (isLeft && isRight) m_Size.Width = m_Bounds.Width;
+		else if (!isLeft) m_X = m_Bounds.X;
+
+		if (isTop && isBottom) m_Size.Height = m_Bounds.Height;
+		else if (!isTop) m_Y = m_Bounds.Y;
+	}
+
+	void Node::CaptureAnchorReference()
+	{
+		// When the parent was not laid out yet the reference is taken on its first arrange
+		if (m_Parent != nullptr && m_Parent->m_IsArranged)
+		{
+			m_AnchorReference = Extent{ m_Parent->m_Bounds.Width, m_Parent->m_Bounds.Height };
+		}
+		else
+		{
+			m_AnchorReference = Extent{ -1, -1 };
+		}
+	}
+
+	void Node::InvalidateMeasure()
+	{
+		m_IsMeasureDirty = true;
+		m_IsArrangeDirty = true;
+
+		if (m_Parent != nullptr)
+		{
+			m_Parent->InvalidateContent();
+		}
+	}
+
+	void Node::InvalidateArrange()
+	{
+		m_IsArrangeDirty = true;
+		MarkAncestors();
+	}
+
+	bool Node::IsLayoutValid() const noexcept
+	{
+		return !m_IsMeasureDirty && !m_IsArrangeDirty && !m_HasDirtyDescendant;
+	}
+
+	PanelType Node::GetPanelType() const noexcept
+	{
+		return m_PanelType;
+	}
+
+	void Node::SetPanelType(PanelType type)
+	{
+		if (m_PanelType == type) return;
+
+		m_PanelType = type;
+		InvalidateContent();
+	}
+
+	DockStyle Node::GetDock() const noexcept
+	{
+		return m_Dock;
+	}
+
+	void Node::SetDock(DockStyle dock)
+	{
+		if (m_Dock == dock) return;
+
+		m_Dock = dock;
+		if (m_Parent != nullptr) m_Parent->InvalidateContent();
+	}
+
+	AnchorStyles Node::GetAnchor() const noexcept
+	{
+		return m_Anchor;
+	}
+
+	void Node::SetAnchor(AnchorStyles anchor)
+	{
+		if (m_Anchor == anchor) return;
+
+		RebaseAnchor();
+		m_Anchor = anchor;
+		CaptureAnchorReference();
+		if (m_Parent != nullptr) m_Parent->InvalidateContent();
+	}
+
+	const Thickness& Node::GetMargin() const noexcept
+	{
+		return m_Margin;
+	}
+
+	void Node::SetMargin(const Thickness& margin)
+	{
+		if (m_Margin == margin) return;
+
+		m_Margin = margin;
+		if (m_Parent != nullptr) m_Parent->InvalidateContent();
+	}
+
+	const Thickness& Node::GetPadding() const noexcept
+	{
+		return m_Padding;
+	}
+
+	void Node::SetPadding(const Thickness& padding)
+	{
+		if (m_Padding == padding) return;
+
+		m_Padding = padding;
+		InvalidateContent();
+	}
+
+	void Node::SetLocation(int x, int y)
+	{
+		if (m_X == x && m_Y == y) return;
+
+		RebaseAnchor();
+		m_X = x;
+		m_Y = y;
+		CaptureAnchorReference();
+		if (m_Parent != nullptr) m_Parent->InvalidateContent();
+	}
+
+	Extent Node::GetSize() const noexcept
+	{
+		return m_Size;
+	}
+
+	void Node::SetSize(int width, int height)
+	{
+		if (m_Size.Width == width && m_Size.Height == height) return;
+
+		RebaseAnchor();
+		m_Size = Extent{ width, height };
+		CaptureAnchorReference();
+		InvalidateMeasure();
+	}
+
+	void Node::SetMinimumSize(int width, int height)
+	{
+		m_MinimumSize = Extent{ width, height };
+		InvalidateMeasure();
+	}
+
+	void Node::SetMaximumSize(int width, int height)
+	{
+		m_MaximumSize = Extent{ width, height };
+		InvalidateMeasure();
+	}
+
+	bool Node::IsAutoSize() const noexcept
+	{
+		return m_IsAutoSize;
+	}
+
+	void Node::SetAutoSize(bool isAutoSize)
+	{
+		if (m_IsAutoSize == isAutoSize) return;
+
+		m_IsAutoSize = isAutoSize;
+		InvalidateMeasure();
+	}
+
+	bool Node::IsVisible() const noexcept
+	{
+		return m_IsVisible;
+	}
+
+	void Node::SetVisible(bool isVisible)
+	{
+		if (m_IsVisible == isVisible) return;
+
+		m_IsVisible = isVisible;
+		if (m_Parent != nullptr) m_Parent->InvalidateContent();
+	}
+
+	void Node::SetFlowDirection(FlowDirection direction)
+	{
+		if (m_FlowDirection == direction) return;
+
+		m_FlowDirection = direction;
+		InvalidateContent();
+	}
+
+	void Node::SetWrapContents(bool isWrapContents)
+	{
+		if (m_IsWrapContents == isWrapContents) return;
+
+		m_IsWrapContents = isWrapContents;
+		InvalidateContent();
+	}
+
+	void Node::SetColumns(std::vector<TrackStyle> columns)
+	{
+		m_Columns = std::move(columns);
+		InvalidateContent();
+	}
+
+	void Node::SetRows(std::vector<TrackStyle> rows)
+	{
+		m_Rows = std::move(rows);
+		InvalidateContent();
+	}
+
+	void Node::SetCell(int row, int column, int rowSpan, int columnSpan)
+	{
+		m_Row = (std::max)(0, row);
+		m_Column = (std::max)(0, column);
+		m_RowSpan = (std::max)(1, rowSpan);
+		m_ColumnSpan = (std::max)(1, columnSpan);
+		if (m_Parent != nullptr) m_Parent->InvalidateContent();
+	}
+
+	void Node::SetMeasureFunction(std::function<Extent(Extent)> function)
+	{
+		m_MeasureFunction = std::move(function);
+		InvalidateContent();
+	}
+
+	Extent Node::Clamp(Extent e) const noexcept
+	{
+		e.Width = (std::max)(e.Width, m_MinimumSize.Width);
+		e.Height = (std::max)(e.Height, m_MinimumSize.Height);
+
+		// Zero means no limit (same as MaximumSize of a Control)
+		if (m_MaximumSize.Width > 0) e.Width = (std::min)(e.Width, m_MaximumSize.Width);
+		if (m_MaximumSize.Height > 0) e.Height = (std::min)(e.Height, m_MaximumSize.Height);
+
+		return Extent{ (std::max)(0, e.Width), (std::max)(0, e.Height) };
+	}
+
+	Extent Node::Measure(Extent available)
+	{
+		// A fixed size node always wants the same size so the available space is irrelevant
+		if (!m_IsMeasureDirty && (!m_IsAutoSize || available == m_LastAvailable))
+		{
+			return m_DesiredSize;
+		}
+
+		Extent size = m_Size;
+
+		if (m_IsAutoSize)
+		{
+			const Extent inner{ (std::max)(0, available.Width - m_Padding.GetHorizontal()), (std::max)(0, available.Height - m_Padding.GetVertical()) };
+			const Extent content = MeasureContent(inner);
+			size = Extent{ content.Width + m_Padding.GetHorizontal(), content.Height + m_Padding.GetVertical() };
+		}
+
+		m_DesiredSize = Clamp(size);
+		m_LastAvailable = available;
+		m_IsMeasureDirty = false;
+
+		return m_DesiredSize;
+	}
+
+	Extent Node::MeasureContent(Extent available)
+	{
+		Extent ret = m_MeasureFunction ? m_MeasureFunction(available) : Extent{};
+		Extent children;
+
+		switch (m_PanelType)
+		{
+			case PanelType::Default: children = MeasureDefault(available); break;
+			case PanelType::Flow: children = MeasureFlow(available); break;
+			case PanelType::Grid: children = MeasureGrid(available); break;
+		}
+
+		return Extent{ (std::max)(ret.Width, children.Width), (std::max)(ret.Height, children.Height) };
+	}
+
+	Extent Node::MeasureDefault(Extent available)
+	{
+		Extent used;
+		Extent ret;
+
+		// Fill children are measured after the other docked ones because they take the remaining space
+		for (const bool isFill : { false, true })
+		{
+			for (auto c : m_Children)
+			{
+				if (!c->m_IsVisible || c->m_Dock == DockStyle::None || (c->m_Dock == DockStyle::Fill) != isFill) continue;
+
+				const auto& m = c->m_Margin;
+				const Extent remaining{ (std::max)(0, available.Width - used.Width - m.GetHorizontal()), (std::max)(0, available.Height - used.Height - m.GetVertical()) };
+				const auto d = c->Measure(remaining);
+				const int width = d.Width + m.GetHorizontal();
+				const int height = d.Height + m.GetVertical();
+
+				switch (c->m_Dock)
+				{
+					case DockStyle::Top:
+					case DockStyle::Bottom:
+						ret.Width = (std::max)(ret.Width, used.Width + width);
+						used.Height += height;
+						break;
+					case DockStyle::Left:
+					case DockStyle::Right:
+						ret.Height = (std::max)(ret.Height, used.Height + height);
+						used.Width += width;
+						break;
+					default:
+						ret.Width = (std::max)(ret.Width, used.Width + width);
+						ret.Height = (std::max)(ret.Height, used.Height + height);
+						break;
+				}
+			}
+		}
+
+		// Positioned children must fit entirely
+		for (auto c : m_Children)
+		{
+			if (!c->m_IsVisible || c->m_Dock != DockStyle::None) continue;
+
+			const auto d = c->Measure(available);
+			ret.Width = (std::max)(ret.Width, c->m_X + d.Width);
+			ret.Height = (std::max)(ret.Height, c->m_Y + d.Height);
+		}
+
+		return Extent{ (std::max)(ret.Width, used.Width), (std::max)(ret.Height, used.Height) };
+	}
+
+	Extent Node::MeasureFlow(Extent available)
+	{
+		const bool isHorizontal = m_FlowDirection == FlowDirection::LeftToRight || m_FlowDirection == FlowDirection::RightToLeft;
+		const int availableMain = isHorizontal ? available.Width : available.Height;
+
+		int lineMain = 0;
+		int lineCross = 0;
+		int totalMain = 0;
+		int totalCross = 0;
+
+		for (auto c : m_Children)
+		{
+			if (!c->m_IsVisible) continue;
+
+			const auto& m = c->m_Margin;
+			const auto d = c->Measure(Extent{ (std::max)(0, available.Width - m.GetHorizontal()), (std::max)(0, available.Height - m.GetVertical()) });
+			const int main = isHorizontal ? d.Width + m.GetHorizontal() : d.Height + m.GetVertical();
+			const int cross = isHorizontal ? d.Height + m.GetVertical() : d.Width + m.GetHorizontal();
+
+			if (m_IsWrapContents && lineMain > 0 && lineMain + main > availableMain)
+			{
+				totalMain = (std::max)(totalMain, lineMain);
+				totalCross += lineCross;
+				lineMain = 0;
+				lineCross = 0;
+			}
+
+			lineMain += main;
+			lineCross = (std::max)(lineCross, cross);
+		}
+
+		totalMain = (std::max)(totalMain, lineMain);
+		totalCross += lineCross;
+
+		return isHorizontal ? Extent{ totalMain, totalCross } : Extent{ totalCross, totalMain };
+	}
+
+	Extent Node::MeasureGrid(Extent available)
+	{
+		const auto columns = CalculateTracks(m_Columns, true, available, true);
+		const auto rows = CalculateTracks(m_Rows, false, available, true);
+
+		Extent ret;
+		for (const auto w : columns) ret.Width += w;
+		for (const auto h : rows) ret.Height += h;
+
+		return ret;
+	}
+
+	// Calculates the size of each column (or row). Percent tracks share the space left by the others when arranging
+	// and behave like AutoSize when measuring because the final size of the container is not known yet.
+	// Only children spanning a single track contribute to the AutoSize tracks
+	std::vector<int> Node::CalculateTracks(const std::vector<TrackStyle>& tracks, bool isColumn, Extent available, bool isMeasuring)
+	{
+		static const std::vector<TrackStyle> defaultTracks = { TrackStyle{ SizeType::Percent, 100.0f } };
+
+		const auto& styles = tracks.empty() ? defaultTracks : tracks;
+		const int count = static_cast<int>(styles.size());
+		std::vector<int> ret(count, 0);
+
+		for (int i = 0; i < count; ++i)
+		{
+			if (styles[i].Type == SizeType::Absolute) ret[i] = static_cast<int>(styles[i].Value);
+		}
+
+		for (auto c : m_Children)
+		{
+			if (!c->m_IsVisible || (isColumn ? c->m_ColumnSpan : c->m_RowSpan) != 1) continue;
+
+			const int index = (std::min)(isColumn ? c->m_Column : c->m_Row, count - 1);
+			const auto type = styles[index].Type;
+
+			if (type == SizeType::Absolute || (type == SizeType::Percent && !isMeasuring)) continue;
+
+			const auto& m = c->m_Margin;
+			const auto d = c->Measure(Extent{ (std::max)(0, available.Width - m.GetHorizontal()), (std::max)(0, available.Height - m.GetVertical()) });
+			ret[index] = (std::max)(ret[index], isColumn ? d.Width + m.GetHorizontal() : d.Height + m.GetVertical());
+		}
+
+		if (isMeasuring) return ret;
+
+		int used = 0;
+		float totalPercent = 0.0f;
+		int percentTracks = 0;
+
+		for (int i = 0; i < count; ++i)
+		{
+			if (styles[i].Type == SizeType::Percent)
+			{
+				totalPercent += styles[i].Value;
+				++percentTracks;
+			}
+			else
+			{
+				used += ret[i];
+			}
+		}
+
+		if (percentTracks == 0) return ret;
+
+		const int remaining = (std::max)(0, (isColumn ? available.Width : available.Height) - used);
+		int distributed = 0;
+		int last = -1;
+
+		for (int i = 0; i < count; ++i)
+		{
+			if (styles[i].Type != SizeType::Percent) continue;
+
+			ret[i] = totalPercent > 0.0f
+				? static_cast<int>(remaining * (styles[i].Value / totalPercent))
+				: remaining / percentTracks;
+
+			distributed += ret[i];
+			last = i;
+		}
+
+		// Rounding leftovers go to the last percent track so the tracks always fill the container
+		ret[last] += remaining - distributed;
+
+		return ret;
+	}
+
+	void Node::Arrange(const Rect& bounds)
+	{
+		const bool isResized = !m_IsArranged || bounds.Width != m_Bounds.Width || bounds.Height != m_Bounds.Height;
+		const bool isMoved = !m_IsArranged || bounds.X != m_Bounds.X || bounds.Y != m_Bounds.Y;
+
+		m_Bounds = bounds;
+		m_IsArranged = true;
+
+		if ((isResized || isMoved) && OnArranged)
+		{
+			OnArranged(m_Bounds);
+		}
+
+		// Children bounds are relative so moving the node alone doesn't affect them
+		if (isResized || m_IsArrangeDirty)
+		{
+			ArrangeContent();
+		}
+		else if (m_HasDirtyDescendant)
+		{
+			ArrangeDirtyChildren();
+		}
+
+		m_IsArrangeDirty = false;
+		m_HasDirtyDescendant = false;
+	}
+
+	void Node::ArrangeContent()
+	{
+		const Rect content
+		{
+			m_Padding.Left,
+			m_Padding.Top,
+			(std::max)(0, m_Bounds.Width - m_Padding.GetHorizontal()),
+			(std::max)(0, m_Bounds.Height - m_Padding.GetVertical())
+		};
+
+		switch (m_PanelType)
+		{
+			case PanelType::Default: ArrangeDefault(content); break;
+			case PanelType::Flow: ArrangeFlow(content); break;
+			case PanelType::Grid: ArrangeGrid(content); break;
+		}
+	}
+
+	void Node::ArrangeDirtyChildren()
+	{
+		for (auto c : m_Children)
+		{
+			if (!c->m_IsVisible || !(c->m_IsArrangeDirty || c->m_HasDirtyDescendant)) continue;
+
+			// Never laid out so its bounds must be calculated by this container
+			if (!c->m_IsArranged)
+			{
+				ArrangeContent();
+				return;
+			}
+
+			c->Arrange(c->m_Bounds);
+		}
+	}
+
+	void Node::ArrangeDefault(const Rect& content)
+	{
+		Rect remaining = content;
+
+		for (const bool isFill : { false, true })
+		{
+			for (auto c : m_Children)
+			{
+				if (!c->m_IsVisible || c->m_Dock == DockStyle::None || (c->m_Dock == DockStyle::Fill) != isFill) continue;
+
+				const auto& m = c->m_Margin;
+				const Extent available{ (std::max)(0, remaining.Width - m.GetHorizontal()), (std::max)(0, remaining.Height - m.GetVertical()) };
+				const auto d = c->Measure(available);
+				const int width = (std::min)(d.Width, available.Width);
+				const int height = (std::min)(d.Height, available.Height);
+
+				switch (c->m_Dock)
+				{
+					case DockStyle::Top:
+					{
+						c->Arrange(Rect{ remaining.X + m.Left, remaining.Y + m.Top, available.Width, height });
+						remaining.Y += height + m.GetVertical();
+						remaining.Height = (std::max)(0, remaining.Height - height - m.GetVertical());
+						break;
+					}
+					case DockStyle::Bottom:
+					{
+						c->Arrange(Rect{ remaining.X + m.Left, remaining.Y + remaining.Height - m.Bottom - height, available.Width, height });
+						remaining.Height = (std::max)(0, remaining.Height - height - m.GetVertical());
+						break;
+					}
+					case DockStyle::Left:
+					{
+						c->Arrange(Rect{ remaining.X + m.Left, remaining.Y + m.Top, width, available.Height });
+						remaining.X += width + m.GetHorizontal();
+						remaining.Width = (std::max)(0, remaining.Width - width - m.GetHorizontal());
+						break;
+					}
+					case DockStyle::Right:
+					{
+						c->Arrange(Rect{ remaining.X + remaining.Width - m.Right - width, remaining.Y + m.Top, width, available.Height });
+						remaining.Width = (std::max)(0, remaining.Width - width - m.GetHorizontal());
+						break;
+					}
+					default:
+					{
+						c->Arrange(Rect{ remaining.X + m.Left, remaining.Y + m.Top, available.Width, available.Height });
+						break;
+					}
+				}
+			}
+		}
+
+		// Positioned children are relative to the client area (padding doesn't apply) and keep the distance of
+		// their anchored edges to the same edges of the container
+		const Extent client{ m_Bounds.Width, m_Bounds.Height };
+
+		for (auto c : m_Children)
+		{
+			if (!c->m_IsVisible || c->m_Dock != DockStyle::None) continue;
+
+			if (c->m_AnchorReference.Width < 0)
+			{
+				c->m_AnchorReference = client;
+			}
+
+			const auto d = c->Measure(client);
+			const int dx = client.Width - c->m_AnchorReference.Width;
+			const int dy = client.Height - c->m_AnchorReference.Height;
+
+			Rect r{ c->m_X, c->m_Y, d.Width, d.Height };
+
+			const bool isLeft = HasFlag(c->m_Anchor, AnchorStyles::Left);
+			const bool isRight = HasFlag(c->m_Anchor, AnchorStyles::Right);
+			const bool isTop = HasFlag(c->m_Anchor, AnchorStyles::Top);
+			const bool isBottom = HasFlag(c->m_Anchor, AnchorStyles::Bottom);
+
+			if (isLeft && isRight) r.Width = (std::max)(0, d.Width + dx);
+			else if (isRight) r.X += dx;
+			else if (!isLeft) r.X += dx / 2;
+
+			if (isTop && isBottom) r.Height = (std::max)(0, d.Height + dy);
+			else if (isBottom) r.Y += dy;
+			else if (!isTop) r.Y += dy / 2;
+
+			c->Arrange(r);
+		}
+	}
+
+	void Node::ArrangeFlow(const Rect& content)
+	{
+		const bool isHorizontal = m_FlowDirection == FlowDirection::LeftToRight || m_FlowDirection == FlowDirection::RightToLeft;
+		const bool isReversed = m_FlowDirection == FlowDirection::RightToLeft || m_FlowDirection == FlowDirection::BottomUp;
+		const int contentMain = isHorizontal ? content.Width : content.Height;
+
+		int cursor = 0;
+		int cross = 0;
+		int lineCross = 0;
+
+		for (auto c : m_Children)
+		{
+			if (!c->m_IsVisible) continue;
+
+			const auto& m = c->m_Margin;
+			const auto d = c->Measure(Extent{ (std::max)(0, content.Width - m.GetHorizontal()), (std::max)(0, content.Height - m.GetVertical()) });
+			const int main = isHorizontal ? d.Width + m.GetHorizontal() : d.Height + m.GetVertical();
+
+			if (m_IsWrapContents && cursor > 0 && cursor + main > contentMain)
+			{
+				cross += lineCross;
+				cursor = 0;
+				lineCross = 0;
+			}
+
+			const int position = isReversed ? contentMain - cursor - main : cursor;
+
+			if (isHorizontal)
+			{
+				c->Arrange(Rect{ content.X + position + m.Left, content.Y + cross + m.Top, d.Width, d.Height });
+				lineCross = (std::max)(lineCross, d.Height + m.GetVertical());
+			}
+			else
+			{
+				c->Arrange(Rect{ content.X + cross + m.Left, content.Y + position + m.Top, d.Width, d.Height });
+				lineCross = (std::max)(lineCross, d.Width + m.GetHorizontal());
+			}
+
+			cursor += main;
+		}
+	}
+
+	void Node::ArrangeGrid(const Rect& content)
+	{
+		const Extent available{ content.Width, content.Height };
+		const auto columns = CalculateTracks(m_Columns, true, available, false);
+		const auto rows = CalculateTracks(m_Rows, false, available, false);
+
+		// Prefix sums to get the start of each track in O(1)
+		std::vector<int> columnStart(columns.size() + 1, content.X);
+		std::vector<int> rowStart(rows.size() + 1, content.Y);
+		for (size_t i = 0; i < columns.size(); ++i) columnStart[i + 1] = columnStart[i] + columns[i];
+		for (size_t i = 0; i < rows.size(); ++i) rowStart[i + 1] = rowStart[i] + rows[i];
+
+		for (auto c : m_Children)
+		{
+			if (!c->m_IsVisible) continue;
+
+			const int column = (std::min)(c->m_Column, static_cast<int>(columns.size()) - 1);
+			const int row = (std::min)(c->m_Row, static_cast<int>(rows.size()) - 1);
+			const int columnEnd = (std::min)(column + c->m_ColumnSpan, static_cast<int>(columns.size()));
+			const int rowEnd = (std::min)(row + c->m_RowSpan, static_cast<int>(rows.size()));
+
+			const auto& m = c->m_Margin;
+			const Rect cell
+			{
+				columnStart[column] + m.Left,
+				rowStart[row] + m.Top,
+				(std::max)(0, columnStart[columnEnd] - columnStart[column] - m.GetHorizontal()),
+				(std::max)(0, rowStart[rowEnd] - rowStart[row] - m.GetVertical())
+			};
+
+			const auto d = c->Measure(Extent{ cell.Width, cell.Height });
+
+			if (c->m_Dock == DockStyle::Fill)
+			{
+				c->Arrange(cell);
+				continue;
+			}
+
+			// Inside a cell the anchors align the control: both edges stretch it, one edge sticks it to that side
+			// and no edge centers it
+			Rect r{ cell.X, cell.Y, (std::min)(d.Width, cell.Width), (std::min)(d.Height, cell.Height) };
+
+			const bool isLeft = HasFlag(c->m_Anchor, AnchorStyles::Left);
+			const bool isRight = HasFlag(c->m_Anchor, AnchorStyles::Right);
+			const bool isTop = HasFlag(c->m_Anchor, AnchorStyles::Top);
+			const bool isBottom = HasFlag(c->m_Anchor, AnchorStyles::Bottom);
+
+			if (isLeft && isRight) r.Width = cell.Width;
+			else if (isRight) r.X = cell.X + cell.Width - r.Width;
+			else if (!isLeft) r.X = cell.X + (cell.Width - r.Width) / 2;
+
+			if (isTop && isBottom) r.Height = cell.Height;
+			else if (isBottom) r.Y = cell.Y + cell.Height - r.Height;
+			else if (!isTop) r.Y = cell.Y + (cell.Height - r.Height) / 2;
+
+			c->Arrange(r);
+		}
+	}
+
+	void Node::UpdateLayout()
+	{
+		// Inner node already laid out by its container: only refresh its dirty subtree inside the same bounds
+		if (m_Parent != nullptr && m_IsArranged)
+		{
+			Arrange(m_Bounds);
+			return;
+		}
+
+		const auto desired = Measure(m_Size);
+		Arrange(Rect{ m_X, m_Y, desired.Width, desired.Height });
+	}
+
+	Extent Node::GetDesiredSize() const noexcept
+	{
+		return m_DesiredSize;
+	}
+
+	Rect Node::GetBounds() const noexcept
+	{
+		return m_Bounds;
+	}
+}
\ No newline at end of file
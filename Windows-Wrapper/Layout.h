@@ -0,0 +1,182 @@
+#pragma once
+
+#include "Enums.h"
+
+#include <vector>
+#include <functional>
+#include <cstddef>
+
+namespace Layout
+{
+	struct Thickness
+	{
+		int Left = 0;
+		int Top = 0;
+		int Right = 0;
+		int Bottom = 0;
+
+		constexpr int GetHorizontal() const noexcept { return Left + Right; }
+		constexpr int GetVertical() const noexcept { return Top + Bottom; }
+		constexpr bool operator==(const Thickness& t) const noexcept = default;
+	};
+
+	struct Extent
+	{
+		int Width = 0;
+		int Height = 0;
+
+		constexpr bool operator==(const Extent& e) const noexcept = default;
+	};
+
+	struct Rect
+	{
+		int X = 0;
+		int Y = 0;
+		int Width = 0;
+		int Height = 0;
+
+		constexpr bool operator==(const Rect& r) const noexcept = default;
+	};
+
+	// Column or row definition of a Grid panel (same meaning of ColumnStyle/RowStyle from a TableLayoutPanel)
+	struct TrackStyle
+	{
+		SizeType Type = SizeType::AutoSize;
+		float Value = 0.0f;
+	};
+
+	enum class PanelType
+	{
+		Default,	// Docked children take the container edges and the others are positioned by Location and Anchor
+		Flow,		// Children are stacked following FlowDirection and wrapped when they don't fit
+		Grid,		// Children are placed in the cells defined by the columns and rows
+	};
+
+	/*
+	Retained two pass (measure/arrange) layout tree.
+
+	Measure computes the desired size of a node for an available size and Arrange assigns its final bounds (relative to
+	the parent client area). Both results are cached per node and the dirty flags only travel upwards until a node whose
+	size doesn't depend on its children (not AutoSize), so UpdateLayout only visits the dirty paths and the nodes whose
+	bounds actually changed. Moving a node doesn't touch its subtree because children bounds are relative.
+
+	Docked children are laid out in the order they were added: the first one takes the outermost edge and Fill
+	children get whatever is left after every other docked sibling.
+	*/
+	class Node
+	{
+	private:
+
+		Node* m_Parent;
+		std::vector<Node*> m_Children;
+
+		// Properties
+		PanelType m_PanelType;
+		DockStyle m_Dock;
+		AnchorStyles m_Anchor;
+		Thickness m_Margin;
+		Thickness m_Padding;
+		int m_X;
+		int m_Y;
+		Extent m_Size;
+		Extent m_MinimumSize;
+		Extent m_MaximumSize;
+		Extent m_AnchorReference;	// Parent client size when the location was set. Anchored edges keep their distance from it
+		bool m_IsAutoSize;
+		bool m_IsVisible;
+		FlowDirection m_FlowDirection;
+		bool m_IsWrapContents;
+		std::vector<TrackStyle> m_Columns;
+		std::vector<TrackStyle> m_Rows;
+		int m_Row;
+		int m_Column;
+		int m_RowSpan;
+		int m_ColumnSpan;
+		std::function<Extent(Extent)> m_MeasureFunction;
+
+		// Cached results
+		bool m_IsMeasureDirty;
+		bool m_IsArrangeDirty;
+		bool m_HasDirtyDescendant;
+		Extent m_LastAvailable;
+		Extent m_DesiredSize;
+		Rect m_Bounds;
+		bool m_IsArranged;
+
+		void InvalidateContent();
+		void MarkAncestors();
+		void RebaseAnchor();
+		void CaptureAnchorReference();
+
+		Extent Clamp(Extent e) const noexcept;
+		Extent MeasureContent(Extent available);
+		void ArrangeContent();
+		void ArrangeDirtyChildren();
+
+		void ArrangeDefault(const Rect& content);
+		void ArrangeFlow(const Rect& content);
+		void ArrangeGrid(const Rect& content);
+
+		Extent MeasureDefault(Extent available);
+		Extent MeasureFlow(Extent available);
+		Extent MeasureGrid(Extent available);
+
+		std::vector<int> CalculateTracks(const std::vector<TrackStyle>& tracks, bool isColumn, Extent available, bool isMeasuring);
+
+	public:
+
+		// Called each time Arrange changes the bounds of the node
+		std::function<void(const Rect&)> OnArranged;
+
+		Node();
+		~Node();
+		Node(const Node&) = delete;
+		Node& operator=(const Node&) = delete;
+
+		Node* GetParent() const noexcept;
+		const std::vector<Node*>& GetChildren() const noexcept;
+		void Add(Node* child);
+		void Remove(Node* child);
+
+		PanelType GetPanelType() const noexcept;
+		void SetPanelType(PanelType type);
+		DockStyle GetDock() const noexcept;
+		void SetDock(DockStyle dock);
+		AnchorStyles GetAnchor() const noexcept;
+		void SetAnchor(AnchorStyles anchor);
+		const Thickness& GetMargin() const noexcept;
+		void SetMargin(const Thickness& margin);
+		const Thickness& GetPadding() const noexcept;
+		void SetPadding(const Thickness& padding);
+		void SetLocation(int x, int y);
+		Extent GetSize() const noexcept;
+		void SetSize(int width, int height);
+		void SetMinimumSize(int width, int height);
+		void SetMaximumSize(int width, int height);
+		bool IsAutoSize() const noexcept;
+		void SetAutoSize(bool isAutoSize);
+		bool IsVisible() const noexcept;
+		void SetVisible(bool isVisible);
+		void SetFlowDirection(FlowDirection direction);
+		void SetWrapContents(bool isWrapContents);
+		void SetColumns(std::vector<TrackStyle> columns);
+		void SetRows(std::vector<TrackStyle> rows);
+		void SetCell(int row, int column, int rowSpan = 1, int columnSpan = 1);
+
+		// Content size of leaf nodes (text, images, etc...) for the given available size. Only used when AutoSize is set
+		void SetMeasureFunction(std::function<Extent(Extent)> function);
+
+		void InvalidateMeasure();
+		void InvalidateArrange();
+		bool IsLayoutValid() const noexcept;
+
+		Extent Measure(Extent available);
+		void Arrange(const Rect& bounds);
+
+		// Lays out the whole tree from this node (usually the root) visiting only the dirty parts
+		void UpdateLayout();
+
+		Extent GetDesiredSize() const noexcept;
+		Rect GetBounds() const noexcept;
+	};
+}
\ No newline at end of file
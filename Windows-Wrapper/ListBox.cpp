@@ -1,18 +1,46 @@
 #include "ListBox.h"
 #include "ComboBox.h"
 
+#include <cstring>
+
+namespace
+{
+	// 32 bits top-down rows, the layout of RowCache surfaces
+	BITMAPINFO GetRowBitmapInfo(int width, int height) noexcept
+	{
+		BITMAPINFO info = {};
+		info.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+		info.bmiHeader.biWidth = width;
+		info.bmiHeader.biHeight = -height;
+		info.bmiHeader.biPlanes = 1;
+		info.bmiHeader.biBitCount = 32;
+		info.bmiHeader.biCompression = BI_RGB;
+
+		return info;
+	}
+}
+
 void ListBox::PreDraw(Graphics* const graphics)
 {
 	// Load current font from default PreDraw function
 	WinAPI::PreDraw(graphics);
 
+	// Items published by other threads are taken before the layout, so they don't change while the list is drawn
+	if (IsVirtualMode())
+	{
+		const int oldCount = GetItemCount();
+
+		if (m_DataProvider->Refresh()) OnDataRefreshed(oldCount);
+	}
+
 	if (m_IsRebinding || m_IsFormatChanged)
 	{
+		// Items or their layout changed, the rows are rendered again
+		m_RowCache.Clear();
+
 		// Example test draw with the desired font to calculate each ListBox item size
-		SIZE m_SingleSize;
-		const char* verifier = "A";
-		GetTextExtentPoint32(static_cast<HDC>(graphics->GetHDC().ToPointer()), verifier, 2, &m_SingleSize);
-		SetMinimumItemWidth(m_SingleSize.cx);
+		const auto m_SingleSize = MeasureItemSample();
+		SetMinimumItemWidth(m_SingleSize.Width);
 
 		m_BorderSize = 0;
 		switch (m_BorderStyle)
@@ -30,33 +58,14 @@ void ListBox::PreDraw(Graphics* const graphics)
 		drawableArea->bottom -= m_Margin.Bottom + m_BorderSize;
 
 		SetItemWidth(m_IsMultiColumn ? m_ColumnWidth : static_cast<int>(drawableArea->right - drawableArea->left));
-		SetItemHeight(m_SingleSize.cy);
-
-		const auto& dataSource = GetDataSource();
+		SetItemHeight(m_SingleSize.Height);
 
-		int itemsNumber = static_cast<int>(dataSource.size());
+		int itemsNumber = GetItemCount();
 
-		if (m_IsRebinding)
+		// Rows are measured again when their items changed, not on each layout
+		if (IsVariableHeight() && (m_IsRebinding || m_RowHeights.GetCount() != static_cast<size_t>(itemsNumber)))
 		{
-			// This block will only be executed once after resize
-			m_RowPosition.clear();
-
-			if (m_SelectionMode == SelectionMode::MultiSimple || m_SelectionMode == SelectionMode::MultiExtended)
-			{
-				m_SelectedIndices.clear();
-				m_SelectedItems.clear();
-			}
-
-			if (static_cast<int>(m_RowPosition.size()) < itemsNumber)
-			{
-				m_RowPosition.resize(itemsNumber);
-
-				/*if (m_SelectionMode == SelectionMode::MultiSimple || m_SelectionMode == SelectionMode::MultiExtended)
-				{
-					m_SelectedIndices.resize(itemsNumber);
-					m_SelectedItems.resize(itemsNumber);
-				}*/
-			}
+			MeasureRows();
 		}
 
 		// Reset the amount of items in drawable area for recalculation
@@ -130,7 +139,9 @@ void ListBox::PreDraw(Graphics* const graphics)
 		}
 		else
 		{
-			if (oldHeight > (GetItemHeight() * itemsNumber))
+			const long long contentHeight = IsVariableHeight() ? m_RowHeights.GetTotal() : static_cast<long long>(GetItemHeight()) * itemsNumber;
+
+			if (oldHeight > contentHeight)
 			{
 				VerticalScrollBar.SetMaximumValue(0);
 				VerticalScrollBar.Hide();
@@ -171,6 +182,12 @@ void ListBox::PreDraw(Graphics* const graphics)
 					++m_TotalItemsInDrawableArea;
 				}
 
+				// The page of variable rows is the number of rows fitting at the end of the list
+				if (IsVariableHeight())
+				{
+					m_TotalItemsInDrawableArea = itemsNumber - GetScrollingToBottom(itemsNumber - 1);
+				}
+
 				HandleMessageForwarder(static_cast<HWND>(VerticalScrollBar.Handle.ToPointer()), WM_SIZE, MAKEWPARAM(0, 0), MAKELPARAM(0, m_TotalItemsInDrawableArea));
 			}
 		}
@@ -194,6 +211,9 @@ void ListBox::Draw(Graphics* const graphics, Drawing::Rectangle rectangle)
 	hbmMem = CreateCompatibleBitmap(hdc, m_Size.Width, m_Size.Height);
 	hbmOld = (HBITMAP)SelectObject(hdcMem, hbmMem);
 
+	// Only the damaged area is drawn
+	graphics->ClipToUpdateRegion(hdcMem);
+
 	// Select current font
 	//auto hFont = Fonts->find(m_Font.ToString());
 	//SelectObject(hdcMem, hFont->second);
@@ -305,120 +325,64 @@ void ListBox::Draw(Graphics* const graphics, Drawing::Rectangle rectangle)
 		}
 	}
 
-	const auto& dataSource = GetDataSource();
+	// Only the rows inside the drawable area are visited, so the cost of a paint doesn't depend on the number of items
+	const auto& viewport = UpdateViewport();
+	const auto [first, last] = viewport.GetVisibleRange();
+
+	if (IsVirtualMode())
+	{
+		m_VisibleText.resize(last - first);
+		m_DataProvider->GetText(first, m_VisibleText);
+	}
 
-	/* Logic to draw only visible entries. However, it's much harder to track the selected index
-	because it position cannot be tracked to be handled.
+	// Rows rendered with the same item, state, font and size are copied from the cache instead of being drawn again
+	const bool isOwnerDrawn = m_DrawMode != DrawMode::Normal && OnDrawItem != nullptr;
+	const bool isCached = !IsVirtualMode() && m_RowCache.GetBudget() > 0 && (!isOwnerDrawn || m_IsOwnerDrawCached);
 
-	for (auto [i, r, c, a] =
-		std::tuple{
-		IsMultiColumn() ? HorizontalScrollBar.GetScrolling() * m_RowNumber : VerticalScrollBar.GetScrolling() * m_ColumnNumber,
-		0,
-		0,
-		0 };
-		a < m_RowNumber * m_ColumnNumber;
-		++i, ++r, ++a)
+	for (size_t index = first; index < last; ++index)
 	{
-		if (i >= dataSource->GetCount())
-		{
-			break;
-		}
-		RECT cr;
-		CopyRect(&cr, drawableArea);
-		cr.top = drawableArea->top + (GetItemHeight() * r);
-		cr.bottom = (cr.top + GetItemHeight());
-		cr.left = drawableArea->left + (GetItemWidth() * c);
-		cr.right = cr.left + GetItemWidth() - m_Margin.Right;
-		if (r == m_RowNumber - 1)
-		{
-			r = -1;
-			++c;
-		}
-		if (m_SelectedIndex == i)
-		{
-			SetBkColor(hdcMem, RGB(0, 120, 215));
-			SetTextColor(hdcMem, RGB(255, 255, 255));
-			HBRUSH brush = CreateSolidBrush(RGB(0, 120, 215));
-			FillRect(hdcMem, &cr, brush);
-			SelectObject(hdcMem, brush);
-			DeleteObject(brush);
-		}
-		else
+		if (!viewport.IsVisible(index))
 		{
-			SetBkColor(hdcMem, RGB(m_BackgroundColor.GetR(), m_BackgroundColor.GetG(), m_BackgroundColor.GetB()));
-			SetTextColor(hdcMem, RGB(m_ForeColor.GetR(), m_ForeColor.GetG(), m_ForeColor.GetB()));
+			continue;
 		}
-		DrawText(hdcMem, (*dataSource)[i]->Value.c_str(), -1, &cr, DT_LEFT | DT_VCENTER);
-		DrawText(hdcMem, Text.c_str(), static_cast<int>((*dataSource)[i]->Value.length()), &cr, DT_LEFT | DT_VCENTER | DT_CALCRECT);
-	}*/
 
-	for (auto [i, rw, c] = std::tuple{ 0, 0, 0 }; i < static_cast<int>(dataSource.size()); ++i, ++rw)
-	{
-		RECT cr;
-		CopyRect(&cr, drawableArea);
-
-		cr.top = drawableArea->top - (GetItemHeight() * VerticalScrollBar.GetScrolling()) + (GetItemHeight() * rw);
-		cr.bottom = (cr.top + GetItemHeight());
-		cr.left = drawableArea->left - (HorizontalScrollBar.GetScrolling() * GetItemWidth()) + (GetItemWidth() * c);
-		cr.right = cr.left + GetItemWidth() - m_Margin.Right;
+		const int i = static_cast<int>(index);
+		const std::string_view value = IsVirtualMode() ? std::string_view(m_VisibleText[index - first]) : Items.GetValue(m_View.GetSourceIndex(index));
+		const auto bounds = viewport.GetBounds(index);
+		const RECT cr = { bounds.Left, bounds.Top, bounds.Right, bounds.Bottom };
 
-		if (rw == m_RowNumber - 1)
+		// Rows outside the damaged area keep their pixels on screen
+		if (!graphics->IsVisible(Drawing::Rectangle(cr.left, cr.top, cr.right - cr.left, cr.bottom - cr.top)))
 		{
-			rw = -1;
-			++c;
+			continue;
 		}
 
-		m_RowPosition[i] = cr;
+		const bool isSelected = (m_SelectionMode == SelectionMode::Single && m_SelectedIndex == i) ||
+			(m_SelectionMode == SelectionMode::MultiSimple || m_SelectionMode == SelectionMode::MultiExtended) && m_Selection.IsSelected(index);
+		const bool isFocused = i == m_Tabulation && IsTabSelected() && m_SelectionMode == SelectionMode::MultiSimple;
+		const RowCache::Surface* surface = nullptr;
 
-		if (cr.left >= drawableArea->left &&
-			cr.top >= drawableArea->top &&
-			cr.right <= drawableArea->right &&
-			cr.bottom <= drawableArea->bottom)
+		if (isCached)
 		{
-			if (dataSource[i].Tabulated && IsTabSelected() && m_SelectionMode == SelectionMode::MultiSimple)
-			{
-				HPEN pen = CreatePen(PS_DOT, 0, RGB(0, 0, 0));
-				HGDIOBJ old_pen = SelectObject(hdcMem, pen);
-				SetBkColor(hdcMem, RGB(m_BackgroundColor.GetR(), m_BackgroundColor.GetG(), m_BackgroundColor.GetG()));
-				Rectangle(hdcMem, cr.left, cr.top, cr.right, cr.bottom);
+			const RowCache::Key key{ m_View.GetSourceIndex(index), GetRowState(isSelected, isFocused), GetFontVersion(), cr.right - cr.left, cr.bottom - cr.top };
 
-				SelectObject(hdcMem, old_pen);
-				DeleteObject(old_pen);
-				SelectObject(hdcMem, pen);
-				DeleteObject(pen);
-			}
-
-			// To draw tabulation dot
-			cr.left += 1;
-			cr.top += 1;
-			cr.right -= 1;
-			cr.bottom -= 1;
+			surface = m_RowCache.Find(key);
 
-			HBRUSH brush = 0;
-
-			if ((m_SelectionMode == SelectionMode::Single && m_SelectedIndex == i) ||
-				(m_SelectionMode == SelectionMode::MultiSimple || m_SelectionMode == SelectionMode::MultiExtended) && std::find(m_SelectedIndices.begin(), m_SelectedIndices.end(), i) != m_SelectedIndices.end())
-			{
-				auto clr = Color::SelectionBackground().ToRGB();
-				SetBkColor(hdcMem, clr);
-				SetTextColor(hdcMem, Color::SelectionForeground().ToRGB());
-				brush = CreateSolidBrush(clr);
-			}
-			else
+			if (surface == nullptr)
 			{
-				auto clr = GetBackgroundColor().ToRGB();
-				SetBkColor(hdcMem, clr);
-				SetTextColor(hdcMem, GetForeColor().ToRGB());
-				brush = CreateSolidBrush(clr);
+				surface = CacheRow(hdcMem, key, i, value, isSelected, isFocused);
 			}
+		}
 
-			FillRect(hdcMem, &cr, brush);
-			SelectObject(hdcMem, brush);
-			DeleteObject(brush);
-
-			DrawText(hdcMem, dataSource[i].Value.c_str(), -1, &cr, DT_LEFT | DT_VCENTER);
-			DrawText(hdcMem, Text.c_str(), static_cast<int>(dataSource[i].Value.length()), &cr, DT_LEFT | DT_VCENTER | DT_CALCRECT);
+		// Rows larger than the budget are drawn in place
+		if (surface == nullptr)
+		{
+			DrawRow(hdcMem, cr, i, value, isSelected, isFocused);
+			continue;
 		}
+
+		const auto info = GetRowBitmapInfo(surface->Width, surface->Height);
+		SetDIBitsToDevice(hdcMem, cr.left, cr.top, surface->Width, surface->Height, 0, 0, 0, surface->Height, surface->Pixels.data(), &info, DIB_RGB_COLORS);
 	}
 
 	// Perform the bit-block transfer between the memory Device Context which has the next bitmap
@@ -435,12 +399,11 @@ void ListBox::Draw(Graphics* const graphics, Drawing::Rectangle rectangle)
 
 void ListBox::OnKeyDown_Impl(HWND hwnd, unsigned int vk, int cRepeat, unsigned int flags) noexcept
 {
-	if (m_SelectionMode != SelectionMode::None)
+	if (m_SelectionMode != SelectionMode::None && GetItemCount() > 0)
 	{
 		if (m_Tabulation == -1)
 		{
-			m_Tabulation = 0;
-			Items[0].Tabulated = true;
+			SetTabulation(0);
 
 			if (m_SelectionMode == SelectionMode::Single || m_SelectionMode == SelectionMode::MultiExtended)
 			{
@@ -449,11 +412,11 @@ void ListBox::OnKeyDown_Impl(HWND hwnd, unsigned int vk, int cRepeat, unsigned i
 
 			if (IsVerticalScrollEnabled())
 			{
-				HandleMessageForwarder(static_cast<HWND>(VerticalScrollBar.Handle.ToPointer()), WM_VSCROLL, MAKEWPARAM(SB_THUMBTRACK, m_Tabulation), 0);
+				ScrollVertically(m_Tabulation);
 			}
 			else if (IsHorizontalScrollEnabled())
 			{
-				HandleMessageForwarder(static_cast<HWND>(HorizontalScrollBar.Handle.ToPointer()), WM_HSCROLL, MAKEWPARAM(SB_THUMBTRACK, m_Tabulation), 0);
+				ScrollHorizontally(m_Tabulation);
 			}
 		}
 		else
@@ -462,26 +425,18 @@ void ListBox::OnKeyDown_Impl(HWND hwnd, unsigned int vk, int cRepeat, unsigned i
 			{
 				case VK_DOWN:
 				{
-					if (m_Tabulation < static_cast<int>(GetDataSource().size()) - 1)
+					if (m_Tabulation < GetItemCount() - 1)
 					{
-						Items[m_Tabulation++].Tabulated = false;
-						Items[m_Tabulation].Tabulated = true;
+						SetTabulation(m_Tabulation + 1);
 
-						if (m_SelectionMode == SelectionMode::Single) m_SelectedIndex = m_Tabulation;
+						if (m_SelectionMode == SelectionMode::Single) SelectTabulated();
 						else if (m_SelectionMode == SelectionMode::MultiExtended)
 						{
 							if (0x8000 & GetKeyState(VK_SHIFT))
 							{
 								m_SelectionEnd = m_Tabulation;
 
-								int start = (std::min)(m_SelectionStart, m_SelectionEnd);
-								int end = (std::max)(m_SelectionStart, m_SelectionEnd);
-
-								ClearSelected();
-								for (; start <= end; ++start)
-								{
-									SetSelectedIndex(start, true);
-								}
+								SelectRange(m_SelectionStart, m_SelectionEnd);
 							}
 							else
 							{
@@ -494,27 +449,31 @@ void ListBox::OnKeyDown_Impl(HWND hwnd, unsigned int vk, int cRepeat, unsigned i
 						if (IsVerticalScrollEnabled())
 						{
 							auto drawableArea = GetDrawableArea();
-							if (m_RowPosition[m_Tabulation].bottom > drawableArea->bottom)
+							const auto bounds = UpdateViewport().GetBounds(m_Tabulation);
+
+							if (bounds.Bottom > drawableArea->bottom)
 							{
-								HandleMessageForwarder(static_cast<HWND>(VerticalScrollBar.Handle.ToPointer()), WM_VSCROLL, MAKEWPARAM(SB_THUMBTRACK, m_Tabulation - m_TotalItemsInDrawableArea + 1), 0);
+								ScrollVertically(GetScrollingToBottom(m_Tabulation));
 							}
 
-							if (m_RowPosition[m_Tabulation].top < drawableArea->top)
+							if (bounds.Top < drawableArea->top)
 							{
-								HandleMessageForwarder(static_cast<HWND>(VerticalScrollBar.Handle.ToPointer()), WM_VSCROLL, MAKEWPARAM(SB_THUMBTRACK, m_Tabulation), 0);
+								ScrollVertically(m_Tabulation);
 							}
 						}
 						else if (IsHorizontalScrollEnabled())
 						{
 							auto drawableArea = GetDrawableArea();
-							if (m_RowPosition[m_Tabulation].right > drawableArea->right)
+							const auto bounds = UpdateViewport().GetBounds(m_Tabulation);
+
+							if (bounds.Right > drawableArea->right)
 							{
-								HandleMessageForwarder(static_cast<HWND>(HorizontalScrollBar.Handle.ToPointer()), WM_HSCROLL, MAKEWPARAM(SB_THUMBTRACK, (m_Tabulation / m_RowNumber) - (m_ColumnNumber - 1)), 0);
+								ScrollHorizontally((m_Tabulation / m_RowNumber) - (m_ColumnNumber - 1));
 							}
 
-							if (m_RowPosition[m_Tabulation].left < drawableArea->left)
+							if (bounds.Left < drawableArea->left)
 							{
-								HandleMessageForwarder(static_cast<HWND>(HorizontalScrollBar.Handle.ToPointer()), WM_HSCROLL, MAKEWPARAM(SB_THUMBTRACK, m_Tabulation / m_RowNumber), 0);
+								ScrollHorizontally(m_Tabulation / m_RowNumber);
 							}
 						}
 					}
@@ -522,11 +481,11 @@ void ListBox::OnKeyDown_Impl(HWND hwnd, unsigned int vk, int cRepeat, unsigned i
 					{
 						if (IsVerticalScrollEnabled())
 						{
-							HandleMessageForwarder(static_cast<HWND>(VerticalScrollBar.Handle.ToPointer()), WM_VSCROLL, MAKEWPARAM(SB_THUMBTRACK, m_Tabulation), 0);
+							ScrollVertically(m_Tabulation);
 						}
 						else if (IsHorizontalScrollEnabled())
 						{
-							HandleMessageForwarder(static_cast<HWND>(HorizontalScrollBar.Handle.ToPointer()), WM_HSCROLL, MAKEWPARAM(SB_THUMBTRACK, m_Tabulation / m_RowNumber), 0);
+							ScrollHorizontally(m_Tabulation / m_RowNumber);
 						}
 					}
 
@@ -536,24 +495,16 @@ void ListBox::OnKeyDown_Impl(HWND hwnd, unsigned int vk, int cRepeat, unsigned i
 				{
 					if (m_Tabulation > 0)
 					{
-						Items[m_Tabulation--].Tabulated = false;
-						Items[m_Tabulation].Tabulated = true;
+						SetTabulation(m_Tabulation - 1);
 
-						if (m_SelectionMode == SelectionMode::Single) m_SelectedIndex = m_Tabulation;
+						if (m_SelectionMode == SelectionMode::Single) SelectTabulated();
 						else if (m_SelectionMode == SelectionMode::MultiExtended)
 						{
 							if (0x8000 & GetKeyState(VK_SHIFT))
 							{
 								m_SelectionEnd = m_Tabulation;
 
-								int start = (std::min)(m_SelectionStart, m_SelectionEnd);
-								int end = (std::max)(m_SelectionStart, m_SelectionEnd);
-
-								ClearSelected();
-								for (; start <= end; ++start)
-								{
-									SetSelectedIndex(start, true);
-								}
+								SelectRange(m_SelectionStart, m_SelectionEnd);
 							}
 							else
 							{
@@ -566,27 +517,31 @@ void ListBox::OnKeyDown_Impl(HWND hwnd, unsigned int vk, int cRepeat, unsigned i
 						if (IsVerticalScrollEnabled())
 						{
 							auto drawableArea = GetDrawableArea();
-							if (m_RowPosition[m_Tabulation].bottom > drawableArea->bottom)
+							const auto bounds = UpdateViewport().GetBounds(m_Tabulation);
+
+							if (bounds.Bottom > drawableArea->bottom)
 							{
-								HandleMessageForwarder(static_cast<HWND>(VerticalScrollBar.Handle.ToPointer()), WM_VSCROLL, MAKEWPARAM(SB_THUMBTRACK, m_Tabulation - m_TotalItemsInDrawableArea + 1), 0);
+								ScrollVertically(GetScrollingToBottom(m_Tabulation));
 							}
 
-							if (m_RowPosition[m_Tabulation].top < drawableArea->top)
+							if (bounds.Top < drawableArea->top)
 							{
-								HandleMessageForwarder(static_cast<HWND>(VerticalScrollBar.Handle.ToPointer()), WM_VSCROLL, MAKEWPARAM(SB_THUMBTRACK, m_Tabulation), 0);
+								ScrollVertically(m_Tabulation);
 							}
 						}
 						else if (IsHorizontalScrollEnabled())
 						{
 							auto drawableArea = GetDrawableArea();
-							if (m_RowPosition[m_Tabulation].right > drawableArea->right)
+							const auto bounds = UpdateViewport().GetBounds(m_Tabulation);
+
+							if (bounds.Right > drawableArea->right)
 							{
-								HandleMessageForwarder(static_cast<HWND>(HorizontalScrollBar.Handle.ToPointer()), WM_HSCROLL, MAKEWPARAM(SB_THUMBTRACK, (m_Tabulation / m_RowNumber) - (m_ColumnNumber - 1)), 0);
+								ScrollHorizontally((m_Tabulation / m_RowNumber) - (m_ColumnNumber - 1));
 							}
 
-							if (m_RowPosition[m_Tabulation].left < drawableArea->left)
+							if (bounds.Left < drawableArea->left)
 							{
-								HandleMessageForwarder(static_cast<HWND>(HorizontalScrollBar.Handle.ToPointer()), WM_HSCROLL, MAKEWPARAM(SB_THUMBTRACK, m_Tabulation / m_RowNumber), 0);
+								ScrollHorizontally(m_Tabulation / m_RowNumber);
 							}
 						}
 					}
@@ -594,11 +549,11 @@ void ListBox::OnKeyDown_Impl(HWND hwnd, unsigned int vk, int cRepeat, unsigned i
 					{
 						if (IsVerticalScrollEnabled())
 						{
-							HandleMessageForwarder(static_cast<HWND>(VerticalScrollBar.Handle.ToPointer()), WM_VSCROLL, MAKEWPARAM(SB_THUMBTRACK, 0), 0);
+							ScrollVertically(0);
 						}
 						else if (IsHorizontalScrollEnabled())
 						{
-							HandleMessageForwarder(static_cast<HWND>(HorizontalScrollBar.Handle.ToPointer()), WM_HSCROLL, MAKEWPARAM(SB_THUMBTRACK, 0), 0);
+							ScrollHorizontally(0);
 						}
 					}
 
@@ -613,25 +568,16 @@ void ListBox::OnKeyDown_Impl(HWND hwnd, unsigned int vk, int cRepeat, unsigned i
 
 					if (m_Tabulation > m_RowNumber - 1)
 					{
-						Items[m_Tabulation].Tabulated = false;
-						m_Tabulation -= m_RowNumber;
-						Items[m_Tabulation].Tabulated = true;
+						SetTabulation(m_Tabulation - m_RowNumber);
 
-						if (m_SelectionMode == SelectionMode::Single) m_SelectedIndex = m_Tabulation;
+						if (m_SelectionMode == SelectionMode::Single) SelectTabulated();
 						else if (m_SelectionMode == SelectionMode::MultiExtended)
 						{
 							if (0x8000 & GetKeyState(VK_SHIFT))
 							{
 								m_SelectionEnd = m_Tabulation;
 
-								int start = (std::min)(m_SelectionStart, m_SelectionEnd);
-								int end = (std::max)(m_SelectionStart, m_SelectionEnd);
-
-								ClearSelected();
-								for (; start <= end; ++start)
-								{
-									SetSelectedIndex(start, true);
-								}
+								SelectRange(m_SelectionStart, m_SelectionEnd);
 							}
 							else
 							{
@@ -644,14 +590,16 @@ void ListBox::OnKeyDown_Impl(HWND hwnd, unsigned int vk, int cRepeat, unsigned i
 						if (IsHorizontalScrollEnabled())
 						{
 							auto drawableArea = GetDrawableArea();
-							if (m_RowPosition[m_Tabulation].right > drawableArea->right)
+							const auto bounds = UpdateViewport().GetBounds(m_Tabulation);
+
+							if (bounds.Right > drawableArea->right)
 							{
-								HandleMessageForwarder(static_cast<HWND>(HorizontalScrollBar.Handle.ToPointer()), WM_HSCROLL, MAKEWPARAM(SB_THUMBTRACK, m_Tabulation / m_RowNumber - m_TotalItemsInDrawableArea + 1), 0);
+								ScrollHorizontally(m_Tabulation / m_RowNumber - m_TotalItemsInDrawableArea + 1);
 							}
 
-							if (m_RowPosition[m_Tabulation].left < drawableArea->left)
+							if (bounds.Left < drawableArea->left)
 							{
-								HandleMessageForwarder(static_cast<HWND>(HorizontalScrollBar.Handle.ToPointer()), WM_HSCROLL, MAKEWPARAM(SB_THUMBTRACK, m_Tabulation / m_RowNumber), 0);
+								ScrollHorizontally(m_Tabulation / m_RowNumber);
 							}
 						}
 					}
@@ -659,7 +607,7 @@ void ListBox::OnKeyDown_Impl(HWND hwnd, unsigned int vk, int cRepeat, unsigned i
 					{
 						if (IsHorizontalScrollEnabled())
 						{
-							HandleMessageForwarder(static_cast<HWND>(HorizontalScrollBar.Handle.ToPointer()), WM_HSCROLL, MAKEWPARAM(SB_THUMBTRACK, 0), 0);
+							ScrollHorizontally(0);
 						}
 					}
 
@@ -672,28 +620,18 @@ void ListBox::OnKeyDown_Impl(HWND hwnd, unsigned int vk, int cRepeat, unsigned i
 						break;
 					}
 
-					if (m_Tabulation < static_cast<int>(GetDataSource().size()) - m_RowNumber)
+					if (m_Tabulation < GetItemCount() - m_RowNumber)
 					{
-						Items[m_Tabulation].Tabulated = false;
-						m_Tabulation += m_RowNumber;
-						Items[m_Tabulation].Tabulated = true;
+						SetTabulation(m_Tabulation + m_RowNumber);
 
-
-						if (m_SelectionMode == SelectionMode::Single) m_SelectedIndex = m_Tabulation;
+						if (m_SelectionMode == SelectionMode::Single) SelectTabulated();
 						else if (m_SelectionMode == SelectionMode::MultiExtended)
 						{
 							if (0x8000 & GetKeyState(VK_SHIFT))
 							{
 								m_SelectionEnd = m_Tabulation;
 
-								int start = (std::min)(m_SelectionStart, m_SelectionEnd);
-								int end = (std::max)(m_SelectionStart, m_SelectionEnd);
-
-								ClearSelected();
-								for (; start <= end; ++start)
-								{
-									SetSelectedIndex(start, true);
-								}
+								SelectRange(m_SelectionStart, m_SelectionEnd);
 							}
 							else
 							{
@@ -706,14 +644,16 @@ void ListBox::OnKeyDown_Impl(HWND hwnd, unsigned int vk, int cRepeat, unsigned i
 						if (IsHorizontalScrollEnabled())
 						{
 							auto drawableArea = GetDrawableArea();
-							if (m_RowPosition[m_Tabulation].right > drawableArea->right)
+							const auto bounds = UpdateViewport().GetBounds(m_Tabulation);
+
+							if (bounds.Right > drawableArea->right)
 							{
-								HandleMessageForwarder(static_cast<HWND>(HorizontalScrollBar.Handle.ToPointer()), WM_HSCROLL, MAKEWPARAM(SB_THUMBTRACK, m_Tabulation / m_RowNumber - m_TotalItemsInDrawableArea + 1), 0);
+								ScrollHorizontally(m_Tabulation / m_RowNumber - m_TotalItemsInDrawableArea + 1);
 							}
 
-							if (m_RowPosition[m_Tabulation].left < drawableArea->left)
+							if (bounds.Left < drawableArea->left)
 							{
-								HandleMessageForwarder(static_cast<HWND>(HorizontalScrollBar.Handle.ToPointer()), WM_HSCROLL, MAKEWPARAM(SB_THUMBTRACK, m_Tabulation / m_RowNumber), 0);
+								ScrollHorizontally(m_Tabulation / m_RowNumber);
 							}
 						}
 					}
@@ -721,7 +661,7 @@ void ListBox::OnKeyDown_Impl(HWND hwnd, unsigned int vk, int cRepeat, unsigned i
 					{
 						if (IsHorizontalScrollEnabled())
 						{
-							HandleMessageForwarder(static_cast<HWND>(HorizontalScrollBar.Handle.ToPointer()), WM_HSCROLL, MAKEWPARAM(SB_THUMBTRACK, m_Tabulation / m_RowNumber), 0);
+							ScrollHorizontally(m_Tabulation / m_RowNumber);
 						}
 					}
 
@@ -782,7 +722,6 @@ void ListBox::OnKeyDown_Impl(HWND hwnd, unsigned int vk, int cRepeat, unsigned i
 		}
 	}
 
-	Update();
 	Control::OnKeyDown_Impl(hwnd, vk, cRepeat, flags);
 }
 
@@ -790,332 +729,1047 @@ void ListBox::OnMouseLeftDown_Impl(HWND hwnd, int x, int y, unsigned int keyFlag
 {
 	if (m_SelectionMode != SelectionMode::None)
 	{
+		const size_t index = UpdateViewport().GetIndexFromPoint(x, y);
 
-		int i = 0;
-
-		const auto drawableArea = GetDrawableArea();
-		if (y >= drawableArea->top && y <= drawableArea->bottom && x >= drawableArea->left && x <= drawableArea->right)
+		if (index != ListViewport::NotFound)
 		{
-			for (auto it = m_RowPosition.begin(); it != m_RowPosition.end(); ++it, ++i)
+			const int i = static_cast<int>(index);
+
+			SetTabulation(i);
+
+			if (m_SelectionMode == SelectionMode::MultiExtended)
 			{
-				if (y >= it->top && y <= it->bottom && x >= it->left && x <= it->right)
+				if (keyFlags & MK_SHIFT)
 				{
-					if (m_Tabulation > -1)
-					{
-						int oldTab = m_Tabulation;
-						Items[oldTab].Tabulated = false;
-					}
+					m_SelectionEnd = i;
 
-					m_Tabulation = i;
-					Items[m_Tabulation].Tabulated = true;
+					SelectRange(m_SelectionStart, m_SelectionEnd);
+				}
+				else
+				{
+					m_SelectionStart = m_SelectionEnd = i;
 
-					if (m_SelectionMode == SelectionMode::MultiExtended)
+					if ((keyFlags & MK_CONTROL))
 					{
-						if (keyFlags & MK_SHIFT)
-						{
-							m_SelectionEnd = i;
-
-							int start = (std::min)(m_SelectionStart, m_SelectionEnd);
-							int end = (std::max)(m_SelectionStart, m_SelectionEnd);
-
-							ClearSelected();
-							for (; start <= end; ++start)
-							{
-								SetSelectedIndex(start, true);
-							}
-						}
-						else
-						{
-							m_SelectionStart = m_SelectionEnd = i;
-
-							if ((keyFlags & MK_CONTROL))
-							{
-								SetSelectedIndex(i, !Items[i].Selected);
-							}
-							else
-							{
-								ClearSelected();
-								SetSelectedIndex(i, true);
-
-							}
-						}
+						SetSelectedIndex(i, !IsSelected(i));
 					}
 					else
 					{
+						ClearSelected();
 						SetSelectedIndex(i, true);
-					}
 
-					break;
+					}
 				}
 			}
+			else
+			{
+				SetSelectedIndex(i, true);
+			}
 		}
 	}
 
 	Control::OnMouseLeftDown_Impl(hwnd, x, y, keyFlags);
 }
 
-ListBox::ListBox(Control* parent, int width, int height, int x, int y)
-	:
-	ListControl(parent, "", width, height, x, y),
-	m_IsMultiColumn(false),
-	m_IsHorizontalScrollVisible(false),
-	m_IsScrollAlwaysVisible(false),
-	m_SelectionMode(SelectionMode::Single),
-	m_DockStyle(DockStyle::None),
-	m_BorderStyle(BorderStyle::Fixed3D),
-	m_TotalItemsInDrawableArea(0),
-	m_ColumnWidth(120),
-	m_ColumnNumber(1),
-	m_RowNumber(1),
-	m_IsFormatChanged(false),
-	m_SelectedItem(nullptr),
-	m_Tabulation(-1),
-	m_SelectionStart(-1),
-	m_SelectionEnd(-1)
+bool ListBox::IsRepaintedOnClick() const noexcept
 {
-
+	return false;
 }
 
-ListBox::~ListBox()
+const ListViewport& ListBox::UpdateViewport()
 {
+	const auto drawableArea = GetDrawableArea();
 
+	m_Viewport.SetArea(drawableArea->left, drawableArea->top, drawableArea->right, drawableArea->bottom);
+	m_Viewport.SetItemSize(GetItemWidth(), GetItemHeight(), m_Margin.Right);
+	m_Viewport.SetRowNumber(static_cast<size_t>((std::max)(m_RowNumber, 0)));
+	m_Viewport.SetCount(static_cast<size_t>(GetItemCount()));
+	m_Viewport.SetRowHeights(IsVariableHeight() ? &m_RowHeights : nullptr);
+	m_Viewport.SetScrolling(static_cast<size_t>((std::max)(VerticalScrollBar.GetScrolling(), 0)), static_cast<size_t>((std::max)(HorizontalScrollBar.GetScrolling(), 0)));
+
+	return m_Viewport;
 }
 
-void ListBox::SetSelectedIndex(int index, bool value)
+bool ListBox::IsVariableHeight() const noexcept
 {
-	if (Items.size() == 0) return;
+	return m_DrawMode == DrawMode::OwnerDrawVariable && !m_IsMultiColumn;
+}
 
-	switch (m_SelectionMode)
-	{
-		case SelectionMode::None: throw ArgumentException("Cannot set index with in a ListBox with SelectionMode set as None"); break;
-		case SelectionMode::Single:
-		{
-			if (index < -1 || index >= Items.size()) throw ArgumentOutOfRangeException("index");
+int ListBox::MeasureRow(int row)
+{
+	MeasureItemEventArgs args(row, GetItemHeight());
+	Dispatch("OnMeasureItem", &args);
 
-			if (index == -1)
-			{
-				m_SelectedValue = "";
-			}
-			else
-			{
-				if (!value)
-				{
-					if (!Items[index].Selected) break;
+	return (std::max)(args.ItemHeight, 0);
+}
 
-					Items[index].Selected = false;
-					m_SelectedValue = -1;
-				}
-				else
-				{
-					Items[index].Selected = true;
-					m_SelectedValue = Items[index].Value;
+void ListBox::MeasureRows()
+{
+	const int count = GetItemCount();
+	std::vector<int> heights(static_cast<size_t>(count), GetItemHeight());
 
-					// Clear old selection
-					Items[index].Selected = false;
-					m_SelectedIndex = index;
-				}
-			}
-			break;
-		}
-		case SelectionMode::MultiSimple:
-		case SelectionMode::MultiExtended:
+	// Without a handler every row keeps the item height
+	if (OnMeasureItem != nullptr)
+	{
+		for (int row = 0; row < count; ++row)
 		{
-			if (index < -1 || index >= Items.size()) throw ArgumentOutOfRangeException("index");
+			heights[row] = MeasureRow(row);
+		}
+	}
 
-			// Clear the list if the passed index is equal -1
-			if (index == -1)
-			{
-				for (auto& it : m_SelectedItems)
-				{
-					it->Selected = false;
-				}
+	m_RowHeights.Reset(std::move(heights));
+}
 
-				m_SelectedIndices.clear();
-				m_SelectedItems.clear();
-			}
-			else
-			{
-				if (Items[index].Selected && !value)
-				{
-					Items[index].Selected = false;
-					m_SelectedIndices.erase(std::remove_if(m_SelectedIndices.begin(), m_SelectedIndices.end(), [&](int i) { return i == index; }));
-					m_SelectedItems.erase(std::remove_if(m_SelectedItems.begin(), m_SelectedItems.end(), [&](ListItem* it) { return it->Equals(&Items[index]); }));
+int ListBox::GetScrollingToBottom(int index)
+{
+	// Rows of the item height keep the page computed by PreDraw
+	if (!IsVariableHeight())
+	{
+		return index - m_TotalItemsInDrawableArea + 1;
+	}
 
-					if (m_SelectedItems.size() == 0)
-					{
-						m_SelectedItem = nullptr;
-						m_SelectedValue = "";
-					}
-					else
-					{
-						m_SelectedItem = m_SelectedItems.back();
-						m_SelectedValue = m_SelectedItems.back()->Value;
-					}
+	return static_cast<int>(UpdateViewport().GetScrollingToBottom(static_cast<size_t>((std::max)(index, 0))));
+}
 
-					if (m_SelectedIndices.size() == 0) m_SelectedIndex = -1;
-					else m_SelectedIndex = m_SelectedIndices.back();
-				}
-				else if (!Items[index].Selected && value)
-				{
-					Items[index].Selected = true;
-					// Select this item while keeping any previously selected items selected.
-					m_SelectedIndices.push_back(index);
-					m_SelectedItems.push_back(&Items[index]);
-					m_SelectedValue = Items[index].Value;
-					m_SelectedIndex = index;
-				}
-			}
-		}
-	}
+uint64_t ListBox::GetRowState(bool isSelected, bool isFocused) const noexcept
+{
+	// Flags in the low byte, then the colors the row is drawn with
+	const bool isOwnerDrawn = m_DrawMode != DrawMode::Normal && OnDrawItem != nullptr;
 
-	Dispatch("OnSelectedIndexChanged", &ArgsDefault);
-	Update();
+	return static_cast<uint64_t>(isSelected) | static_cast<uint64_t>(isFocused) << 1 | static_cast<uint64_t>(isOwnerDrawn) << 2 |
+		static_cast<uint64_t>(GetBackgroundColor().ToRGB()) << 8 | static_cast<uint64_t>(GetForeColor().ToRGB()) << 32;
 }
 
-void ListBox::SetSelectedValue(const ListItem& item)
+void ListBox::DrawRow(HDC hdc, RECT cr, int row, std::string_view value, bool isSelected, bool isFocused)
 {
-	if (Items.size() == 0) return;
+	if (isFocused)
+	{
+		HPEN pen = CreatePen(PS_DOT, 0, RGB(0, 0, 0));
+		HGDIOBJ old_pen = SelectObject(hdc, pen);
+		SetBkColor(hdc, RGB(m_BackgroundColor.GetR(), m_BackgroundColor.GetG(), m_BackgroundColor.GetG()));
+		Rectangle(hdc, cr.left, cr.top, cr.right, cr.bottom);
+
+		SelectObject(hdc, old_pen);
+		DeleteObject(old_pen);
+		SelectObject(hdc, pen);
+		DeleteObject(pen);
+	}
 
-	bool err = true;
+	// To draw tabulation dot
+	cr.left += 1;
+	cr.top += 1;
+	cr.right -= 1;
+	cr.bottom -= 1;
 
-	for (size_t i = 0; i < Items.size(); ++i)
+	HBRUSH brush = 0;
+
+	if (isSelected)
 	{
-		if (Items[i].Id == item.Id && Items[i].Value == item.Value)
-		{
-			SetSelectedIndex(static_cast<int>(i), true);
-			err = false;
-			break;
-		}
+		auto clr = Color::SelectionBackground().ToRGB();
+		SetBkColor(hdc, clr);
+		SetTextColor(hdc, Color::SelectionForeground().ToRGB());
+		brush = CreateSolidBrush(clr);
+	}
+	else
+	{
+		auto clr = GetBackgroundColor().ToRGB();
+		SetBkColor(hdc, clr);
+		SetTextColor(hdc, GetForeColor().ToRGB());
+		brush = CreateSolidBrush(clr);
 	}
 
-	if (err)
+	FillRect(hdc, &cr, brush);
+	SelectObject(hdc, brush);
+	DeleteObject(brush);
+
+	if (m_DrawMode != DrawMode::Normal && OnDrawItem != nullptr)
 	{
-		throw ArgumentOutOfRangeException("The selected value is not in the list of available values");
+		DrawItemEventArgs args(hdc, Drawing::Rectangle(cr.left, cr.top, cr.right - cr.left, cr.bottom - cr.top), row, isSelected);
+		Dispatch("OnDrawItem", &args);
+		return;
 	}
-}
 
-bool ListBox::IsMultiColumn() const noexcept
-{
-	return m_IsMultiColumn;
+	DrawText(hdc, value.data(), static_cast<int>(value.length()), &cr, DT_LEFT | DT_VCENTER);
+	DrawText(hdc, Text.c_str(), static_cast<int>(value.length()), &cr, DT_LEFT | DT_VCENTER | DT_CALCRECT);
 }
 
-void ListBox::EnableMultiColumn() noexcept
+const RowCache::Surface* ListBox::CacheRow(HDC hdc, const RowCache::Key& key, int row, std::string_view value, bool isSelected, bool isFocused)
 {
-	if (!m_IsMultiColumn)
+	if (key.Width <= 0 || key.Height <= 0 || static_cast<size_t>(key.Width) * static_cast<size_t>(key.Height) > m_RowCache.GetBudget())
 	{
-		m_IsMultiColumn = true;
-		m_IsFormatChanged = true;
-		Update();
+		return nullptr;
 	}
-}
 
-void ListBox::DisableMultiColumn() noexcept
-{
-	if (m_IsMultiColumn)
+	// The row is drawn at the origin of the shared DIB section, only created again when a row doesn't fit in it
+	if (key.Width > m_RowBitmap.Width || key.Height > m_RowBitmap.Height)
 	{
-		m_IsMultiColumn = false;
-		m_IsFormatChanged = true;
-		Update();
+		const int width = (std::max)(key.Width, m_RowBitmap.Width);
+		const int height = (std::max)(key.Height, m_RowBitmap.Height);
+
+		ReleaseRowBitmap();
+
+		const auto info = GetRowBitmapInfo(width, height);
+		void* bits = nullptr;
+		HBITMAP bitmap = CreateDIBSection(hdc, &info, DIB_RGB_COLORS, &bits, nullptr, 0);
+
+		if (bitmap == nullptr) return nullptr;
+
+		m_RowBitmap.DC = CreateCompatibleDC(hdc);
+		m_RowBitmap.Bitmap = bitmap;
+		m_RowBitmap.OldBitmap = SelectObject(m_RowBitmap.DC, bitmap);
+		m_RowBitmap.Bits = static_cast<const uint32_t*>(bits);
+		m_RowBitmap.Width = width;
+		m_RowBitmap.Height = height;
 	}
-}
 
-int ListBox::GetColumnWidth() noexcept
-{
-	return m_ColumnWidth;
-}
+	// Same font as the rows drawn in place
+	SelectObject(m_RowBitmap.DC, GetCurrentObject(hdc, OBJ_FONT));
+	DrawRow(m_RowBitmap.DC, { 0, 0, key.Width, key.Height }, row, value, isSelected, isFocused);
+	GdiFlush();
 
-void ListBox::SetColumnWidth(const int& width) noexcept
-{
-	if (m_IsMultiColumn)
+	auto* surface = m_RowCache.Add(key);
+
+	if (surface != nullptr)
 	{
-		m_ColumnWidth = width;
-		Update();
+		for (int y = 0; y < key.Height; ++y)
+		{
+			std::memcpy(surface->Pixels.data() + static_cast<size_t>(y) * key.Width, m_RowBitmap.Bits + static_cast<size_t>(y) * m_RowBitmap.Width, key.Width * sizeof(uint32_t));
+		}
 	}
-}
 
-BorderStyle ListBox::GetBorderStyle() const noexcept
-{
-	return m_BorderStyle;
+	return surface;
 }
 
-void ListBox::SetBorderStyle(BorderStyle style) noexcept
+void ListBox::ReleaseRowBitmap() noexcept
 {
-	m_BorderStyle = style;
-	Update();
+	if (m_RowBitmap.DC == nullptr) return;
+
+	SelectObject(m_RowBitmap.DC, m_RowBitmap.OldBitmap);
+	DeleteObject(m_RowBitmap.Bitmap);
+	DeleteDC(m_RowBitmap.DC);
+	m_RowBitmap = RowBitmap();
 }
 
-SelectionMode ListBox::GetSelectionMode() const noexcept
+void ListBox::SelectRange(int from, int to)
 {
-	return m_SelectionMode;
+	const int start = (std::max)((std::min)(from, to), 0);
+	const int end = (std::max)(from, to);
+
+	ClearSelected();
+
+	if (end < 0) return;
+
+	// The whole span is a single range of the selection, whatever its length
+	m_Selection.SelectRange(static_cast<size_t>(start), static_cast<size_t>(end) + 1, true);
+	m_SelectedIndex = end;
+	m_SelectedValue = GetItemText(end);
+	InvalidateRows(start, end);
+
+	Dispatch("OnSelectedIndexChanged", &ArgsDefault);
 }
 
-void ListBox::SetSelectionMode(SelectionMode mode) noexcept
+void ListBox::SetTabulation(int index) noexcept
 {
-	if (m_SelectionMode == mode)
-	{
-		return;
-	}
-
-	if (m_SelectedIndices.size() > 1)
+	if (!IsVirtualMode())
 	{
-		m_SelectedIndices.clear();
+		if (m_Tabulation > -1 && m_Tabulation < GetItemCount()) Items.SetTabulated(m_View.GetSourceIndex(m_Tabulation), false);
+		Items.SetTabulated(m_View.GetSourceIndex(index), true);
 	}
 
-	m_SelectionMode = mode;
+	InvalidateRow(m_Tabulation);
+	m_Tabulation = index;
+	InvalidateRow(m_Tabulation);
 }
 
-void ListBox::SelectAll()
+void ListBox::InvalidateRows(int first, int last)
 {
-	if (Items.size() == 0) return;
+	first = (std::max)(first, 0);
+	last = (std::min)(last, GetItemCount() - 1);
 
-	if (m_SelectionMode == SelectionMode::Single)
-	{
-		throw NotSupportedException("ListBox with Single selection cannot select all elements");
-	}
+	if (first > last) return;
 
-	// Clear the SelectedIndices before to add it already ordered
-	ClearSelected();
+	const auto& viewport = UpdateViewport();
+	const auto [begin, end] = viewport.GetVisibleRange();
 
-	for (size_t i = 0; i < Items.size(); ++i)
+	for (size_t row = (std::max)(begin, static_cast<size_t>(first)); row < (std::min)(end, static_cast<size_t>(last) + 1); ++row)
 	{
-		SetSelectedIndex(static_cast<int>(i), true);
-	}
+		if (!viewport.IsVisible(row)) continue;
 
-	m_SelectedValue = m_SelectedItems.back()->Value;
-	m_SelectedIndex = m_SelectedIndices.back();
-	Dispatch("OnSelectedIndexChanged", &ArgsDefault);
+		const auto bounds = viewport.GetBounds(row);
+		Invalidate(Drawing::Rectangle(bounds.Left, bounds.Top, bounds.Right - bounds.Left, bounds.Bottom - bounds.Top));
+	}
 }
 
-void ListBox::ClearSelected() noexcept
+void ListBox::InvalidateRow(int row)
 {
-	if (Items.size() == 0) return;
+	InvalidateRows(row, row);
+}
 
-	// In case no elements is selected
-	if (m_SelectedIndex == -1) return;
+void ListBox::SelectTabulated()
+{
+	InvalidateRow(m_SelectedIndex);
+	m_SelectedIndex = m_Tabulation;
+}
+
+void ListBox::ScrollVertically(int position) noexcept
+{
+	const auto handle = static_cast<HWND>(VerticalScrollBar.Handle.ToPointer());
+
+	// WM_VSCROLL only carries 16 bits of the position, so it's set first and the scroll bar reads it back
+	SetScrollPos(handle, SB_VERT, (std::max)(position, 0), false);
+	HandleMessageForwarder(handle, WM_VSCROLL, MAKEWPARAM(SB_THUMBPOSITION, 0), 0);
+}
+
+void ListBox::ScrollHorizontally(int position) noexcept
+{
+	const auto handle = static_cast<HWND>(HorizontalScrollBar.Handle.ToPointer());
+
+	SetScrollPos(handle, SB_HORZ, (std::max)(position, 0), false);
+	HandleMessageForwarder(handle, WM_HSCROLL, MAKEWPARAM(SB_THUMBPOSITION, 0), 0);
+}
+
+void ListBox::UpdateScrollRange()
+{
+	const int count = GetItemCount();
+
+	if (!m_IsMultiColumn)
+	{
+		m_RowNumber = count;
+	}
+
+	// Only the range of a scroll bar that stays visible moves, showing or hiding one changes the whole layout
+	if (m_IsMultiColumn)
+	{
+		if (HorizontalScrollBar.IsShown() && m_RowNumber * m_ColumnNumber <= count)
+		{
+			HorizontalScrollBar.SetMaximumValue(static_cast<int>(std::ceil(static_cast<float>(count) / (m_RowNumber))));
+			HandleMessageForwarder(static_cast<HWND>(HorizontalScrollBar.Handle.ToPointer()), WM_SIZE, MAKEWPARAM(0, 0), MAKELPARAM(m_TotalItemsInDrawableArea, 0));
+			return;
+		}
+	}
+	else if (!IsVariableHeight() && VerticalScrollBar.IsShown() && count > m_TotalItemsInDrawableArea)
+	{
+		VerticalScrollBar.SetMaximumValue(count);
+		HandleMessageForwarder(static_cast<HWND>(VerticalScrollBar.Handle.ToPointer()), WM_SIZE, MAKEWPARAM(0, 0), MAKELPARAM(0, m_TotalItemsInDrawableArea));
+		return;
+	}
+
+	m_IsFormatChanged = true;
+	Update();
+}
+
+void ListBox::OnSourceChanged_Impl(ListChangedType type, size_t index, size_t count)
+{
+	// Cached rows are keyed by source index, they don't move with the view
+	switch (type)
+	{
+		case ListChangedType::ItemAdded: m_RowCache.OnInsert(index, count); break;
+		case ListChangedType::ItemDeleted: m_RowCache.OnErase(index, count); break;
+		case ListChangedType::ItemChanged: m_RowCache.Invalidate(index); break;
+		default: break;
+	}
+}
+
+void ListBox::OnItemsInserted_Impl(int index, int count)
+{
+	// Checked before the rows move, inserting after the last visible row doesn't change any pixel of the list
+	const bool isVisible = index <= static_cast<int>(UpdateViewport().GetVisibleRange().second);
+	const int scrolling = VerticalScrollBar.GetScrolling();
+
+	m_Selection.Insert(static_cast<size_t>(index), static_cast<size_t>(count));
+
+	// Only the new rows are measured, the others keep their height
+	if (IsVariableHeight() && m_RowHeights.GetCount() + count == static_cast<size_t>(GetItemCount()))
+	{
+		std::vector<int> heights;
+
+		for (int row = index; row < index + count; ++row)
+		{
+			heights.push_back(MeasureRow(row));
+		}
+
+		m_RowHeights.Insert(static_cast<size_t>(index), heights);
+	}
+
+	for (int* i : { &m_SelectedIndex, &m_Tabulation, &m_SelectionStart, &m_SelectionEnd })
+	{
+		if (*i >= index) *i += count;
+	}
+
+	UpdateScrollRange();
+
+	// Rows inserted above the viewport keep the visible rows in place
+	if (!m_IsMultiColumn && VerticalScrollBar.IsShown() && index < scrolling)
+	{
+		ScrollVertically(scrolling + count);
+	}
+	else if (isVisible)
+	{
+		Update();
+	}
+}
+
+void ListBox::OnItemsRemoved_Impl(int index, int count)
+{
+	const bool isVisible = index <= static_cast<int>(UpdateViewport().GetVisibleRange().second);
+	const int scrolling = VerticalScrollBar.GetScrolling();
+	const int selectedIndex = m_SelectedIndex;
+
+	m_Selection.Erase(static_cast<size_t>(index), static_cast<size_t>(count));
+
+	if (IsVariableHeight() && m_RowHeights.GetCount() == static_cast<size_t>(GetItemCount() + count))
+	{
+		m_RowHeights.Erase(static_cast<size_t>(index), static_cast<size_t>(count));
+	}
+
+	for (int* i : { &m_SelectedIndex, &m_Tabulation, &m_SelectionStart, &m_SelectionEnd })
+	{
+		if (*i >= index + count) *i -= count;
+		else if (*i >= index) *i = -1;
+	}
+
+	// The selected item was removed, the highest selected index left takes over
+	if (selectedIndex >= index && m_SelectedIndex == -1)
+	{
+		const size_t last = m_Selection.GetLast();
+
+		m_SelectedIndex = last == SelectionModel::NotFound ? -1 : static_cast<int>(last);
+		m_SelectedValue = m_SelectedIndex == -1 ? "" : GetItemText(m_SelectedIndex);
+		Dispatch("OnSelectedIndexChanged", &ArgsDefault);
+	}
+
+	UpdateScrollRange();
+
+	if (!m_IsMultiColumn && VerticalScrollBar.IsShown() && index < scrolling)
+	{
+		ScrollVertically(scrolling - (std::min)(count, scrolling - index));
+	}
+	else if (isVisible)
+	{
+		Update();
+	}
+}
+
+void ListBox::OnItemUpdated_Impl(int index)
+{
+	if (m_SelectedIndex == index) m_SelectedValue = GetItemText(index);
+
+	RefreshRowHeight(index);
+
+	if (UpdateViewport().IsVisible(static_cast<size_t>(index)))
+	{
+		Update();
+	}
+}
+
+void ListBox::OnItemMoved_Impl(int from, int to)
+{
+	const bool isSelected = m_Selection.IsSelected(static_cast<size_t>(from));
+
+	m_Selection.Erase(static_cast<size_t>(from), 1);
+	m_Selection.Insert(static_cast<size_t>(to), 1);
+	m_Selection.Select(static_cast<size_t>(to), isSelected);
+
+	for (int* i : { &m_SelectedIndex, &m_Tabulation, &m_SelectionStart, &m_SelectionEnd })
+	{
+		*i = GetMovedRow(*i, from, to);
+	}
+
+	if (m_SelectedIndex == to) m_SelectedValue = GetItemText(to);
+
+	// The height moves with its item, then it's measured for the new value
+	if (IsVariableHeight() && m_RowHeights.GetCount() == static_cast<size_t>(GetItemCount()))
+	{
+		m_RowHeights.Move(static_cast<size_t>(from), static_cast<size_t>(to));
+		RefreshRowHeight(to);
+	}
+
+	Update();
+}
+
+void ListBox::OnViewChanged_Impl(const std::vector<size_t>& rows)
+{
+	const int selectedIndex = m_SelectedIndex;
+
+	// The selection follows its items, rows landing next to each other stay one range
+	SelectionModel selection;
+
+	m_Selection.ForEachRange([&](size_t first, size_t last)
+		{
+			size_t start = 0;
+			size_t end = 0;
+
+			for (size_t row = first; row < last; ++row)
+			{
+				if (rows[row] == ItemView::NotFound) continue;
+
+				if (rows[row] != end)
+				{
+					selection.SelectRange(start, end, true);
+					start = rows[row];
+				}
+
+				end = rows[row] + 1;
+			}
+
+			selection.SelectRange(start, end, true);
+		});
+
+	m_Selection = std::move(selection);
+
+	for (int* i : { &m_SelectedIndex, &m_Tabulation, &m_SelectionStart, &m_SelectionEnd })
+	{
+		*i = GetMovedRow(*i, rows);
+	}
+
+	// The selected item is gone, the highest selected row left takes over
+	if (selectedIndex != -1 && m_SelectedIndex == -1)
+	{
+		const size_t last = m_Selection.GetLast();
+
+		m_SelectedIndex = last == SelectionModel::NotFound ? -1 : static_cast<int>(last);
+		m_SelectedValue = m_SelectedIndex == -1 ? "" : GetItemText(m_SelectedIndex);
+		Dispatch("OnSelectedIndexChanged", &ArgsDefault);
+	}
+
+	// Heights move with their items, only the new rows are measured
+	if (IsVariableHeight() && m_RowHeights.GetCount() == rows.size())
+	{
+		std::vector<int> heights(static_cast<size_t>(GetItemCount()), -1);
+
+		for (size_t row = 0; row < rows.size(); ++row)
+		{
+			if (rows[row] != ItemView::NotFound) heights[rows[row]] = m_RowHeights.GetHeight(row);
+		}
+
+		for (size_t row = 0; row < heights.size(); ++row)
+		{
+			if (heights[row] < 0) heights[row] = MeasureRow(static_cast<int>(row));
+		}
+
+		m_RowHeights.Reset(std::move(heights));
+	}
+	else
+	{
+		m_RowHeights.Reset({});
+	}
+
+	UpdateScrollRange();
+	Update();
+}
+
+void ListBox::ApplyView(const std::function<void()>& change)
+{
+	if (IsVirtualMode())
+	{
+		throw InvalidOperationException("A ListBox in virtual mode is sorted and filtered by its data provider");
+	}
+
+	// Rows move, so everything kept by row follows its item. Selected items filtered out are unselected
+	std::vector<size_t> rows(m_View.GetCount());
+
+	for (size_t row = 0; row < rows.size(); ++row)
+	{
+		rows[row] = m_View.GetSourceIndex(row);
+	}
+
+	const size_t tabulation = m_Tabulation < 0 ? ItemView::NotFound : rows[m_Tabulation];
+
+	change();
+
+	const auto sourceRows = m_View.GetRows();
+
+	for (auto& row : rows)
+	{
+		row = sourceRows[row];
+	}
+
+	OnViewChanged_Impl(rows);
+
+	if (tabulation != ItemView::NotFound && m_Tabulation == -1) Items.SetTabulated(tabulation, false);
+}
+
+ListBox::ListBox(Control* parent, int width, int height, int x, int y)
+	:
+	ListControl(parent, "", width, height, x, y),
+	m_IsMultiColumn(false),
+	m_IsHorizontalScrollVisible(false),
+	m_IsScrollAlwaysVisible(false),
+	m_SelectionMode(SelectionMode::Single),
+	m_BorderStyle(BorderStyle::Fixed3D),
+	m_DrawMode(DrawMode::Normal),
+	m_TotalItemsInDrawableArea(0),
+	m_ColumnWidth(120),
+	m_ColumnNumber(1),
+	m_RowNumber(1),
+	m_IsFormatChanged(false),
+	m_Tabulation(-1),
+	m_SelectionStart(-1),
+	m_SelectionEnd(-1),
+	m_IsOwnerDrawCached(false),
+	OnMeasureItem(nullptr),
+	OnDrawItem(nullptr)
+{
+
+}
+
+ListBox::~ListBox()
+{
+	ReleaseRowBitmap();
+	if (OnMeasureItem != nullptr) { delete OnMeasureItem; OnMeasureItem = nullptr; }
+	if (OnDrawItem != nullptr) { delete OnDrawItem; OnDrawItem = nullptr; }
+}
+
+void ListBox::OnMeasureItemSet(const std::function<void(Object*, MeasureItemEventArgs*)>& callback) noexcept
+{
+	OnMeasureItem = new MeasureItemEventHandler("OnMeasureItem", callback);
+	Events.Register(OnMeasureItem);
+}
+
+void ListBox::OnDrawItemSet(const std::function<void(Object*, DrawItemEventArgs*)>& callback) noexcept
+{
+	OnDrawItem = new DrawItemEventHandler("OnDrawItem", callback);
+	Events.Register(OnDrawItem);
+}
+
+void ListBox::SetSelectedIndex(int index, bool value)
+{
+	const int count = GetItemCount();
+	const int oldIndex = m_SelectedIndex;
+
+	if (count == 0) return;
 
 	switch (m_SelectionMode)
 	{
-		case SelectionMode::None: break;
+		case SelectionMode::None: throw ArgumentException("Cannot set index with in a ListBox with SelectionMode set as None"); break;
 		case SelectionMode::Single:
 		{
-			Items[m_SelectedIndex].Selected = false;
+			if (index < -1 || index >= count) throw ArgumentOutOfRangeException("index");
+
+			if (index == -1)
+			{
+				m_SelectedValue = "";
+			}
+			else
+			{
+				if (!value)
+				{
+					if (m_SelectedIndex != index) break;
+
+					m_SelectedValue = "";
+					m_SelectedIndex = -1;
+				}
+				else
+				{
+					m_SelectedValue = GetItemText(index);
+					m_SelectedIndex = index;
+				}
+			}
 			break;
 		}
 		case SelectionMode::MultiSimple:
 		case SelectionMode::MultiExtended:
 		{
-			for (auto& it : m_SelectedItems)
+			if (index < -1 || index >= count) throw ArgumentOutOfRangeException("index");
+
+			// Clear the list if the passed index is equal -1
+			if (index == -1)
 			{
-				it->Selected = false;
+				m_Selection.Clear();
+				InvalidateRows(0, count - 1);
 			}
+			else if (m_Selection.IsSelected(static_cast<size_t>(index)) != value)
+			{
+				m_Selection.Select(static_cast<size_t>(index), value);
+				InvalidateRow(index);
 
-			m_SelectedIndices.clear();
-			m_SelectedItems.clear();
-			break;
+				if (value)
+				{
+					m_SelectedIndex = index;
+				}
+				else
+				{
+					// Selected ranges don't keep the order of the clicks, the highest index takes over
+					m_SelectedIndex = m_Selection.GetCount() == 0 ? -1 : static_cast<int>(m_Selection.GetLast());
+				}
+
+				m_SelectedValue = m_SelectedIndex == -1 ? "" : GetItemText(m_SelectedIndex);
+			}
 		}
 	}
 
+	if (m_SelectionMode == SelectionMode::Single && m_SelectedIndex != oldIndex)
+	{
+		InvalidateRow(oldIndex);
+		InvalidateRow(m_SelectedIndex);
+	}
+
+	Dispatch("OnSelectedIndexChanged", &ArgsDefault);
+}
+
+bool ListBox::IsSelected(int index) const noexcept
+{
+	if (m_SelectionMode == SelectionMode::Single) return index != -1 && m_SelectedIndex == index;
+
+	return index >= 0 && m_Selection.IsSelected(static_cast<size_t>(index));
+}
+
+const SelectionModel& ListBox::GetSelection() const noexcept
+{
+	return m_Selection;
+}
+
+void ListBox::SetSelectedValue(const ListItem& item)
+{
+	const int count = GetItemCount();
+
+	if (count == 0) return;
+
+	if (IsVirtualMode())
+	{
+		// Virtual items only have a text. They are read a page at a time, never all at once
+		std::vector<std::string> page(256);
+
+		for (int first = 0; first < count; first += static_cast<int>(page.size()))
+		{
+			const size_t length = (std::min)(page.size(), static_cast<size_t>(count - first));
+			m_DataProvider->GetText(static_cast<size_t>(first), { page.data(), length });
+
+			for (size_t i = 0; i < length; ++i)
+			{
+				if (page[i] == item.Value)
+				{
+					SetSelectedIndex(first + static_cast<int>(i), true);
+					return;
+				}
+			}
+		}
+
+		throw ArgumentOutOfRangeException("The selected value is not in the list of available values");
+	}
+
+	int selection = -1;
+
+	if (m_View.IsIdentity())
+	{
+		const size_t index = FindItem(item);
+
+		if (index != ItemLookup::NotFound) selection = static_cast<int>(index);
+	}
+	else if (IsItemLookupEnabled())
+	{
+		// The first matching row is the one shown first, whatever its position in the data source
+		for (size_t index : m_Lookup.FindAll(item.Id, item.Value))
+		{
+			const size_t row = m_View.GetRow(index);
+
+			if (row != ItemView::NotFound && (selection == -1 || row < static_cast<size_t>(selection))) selection = static_cast<int>(row);
+		}
+	}
+	else
+	{
+		for (int row = 0; row < count && selection == -1; ++row)
+		{
+			const auto i = Items[m_View.GetSourceIndex(row)];
+
+			if (i.Id == item.Id && i.Value == item.Value) selection = row;
+		}
+	}
+
+	if (selection == -1)
+	{
+		throw ArgumentOutOfRangeException("The selected value is not in the list of available values");
+	}
+
+	SetSelectedIndex(selection, true);
+}
+
+bool ListBox::IsMultiColumn() const noexcept
+{
+	return m_IsMultiColumn;
+}
+
+void ListBox::EnableMultiColumn() noexcept
+{
+	if (!m_IsMultiColumn)
+	{
+		m_IsMultiColumn = true;
+		m_IsFormatChanged = true;
+		Update();
+	}
+}
+
+void ListBox::DisableMultiColumn() noexcept
+{
+	if (m_IsMultiColumn)
+	{
+		m_IsMultiColumn = false;
+		m_IsFormatChanged = true;
+		Update();
+	}
+}
+
+int ListBox::GetColumnWidth() noexcept
+{
+	return m_ColumnWidth;
+}
+
+void ListBox::SetColumnWidth(const int& width) noexcept
+{
+	if (m_IsMultiColumn)
+	{
+		m_ColumnWidth = width;
+		Update();
+	}
+}
+
+BorderStyle ListBox::GetBorderStyle() const noexcept
+{
+	return m_BorderStyle;
+}
+
+void ListBox::SetBorderStyle(BorderStyle style) noexcept
+{
+	m_BorderStyle = style;
+	Update();
+}
+
+SelectionMode ListBox::GetSelectionMode() const noexcept
+{
+	return m_SelectionMode;
+}
+
+void ListBox::SetSelectionMode(SelectionMode mode) noexcept
+{
+	if (m_SelectionMode == mode)
+	{
+		return;
+	}
+
+	if (m_Selection.GetCount() > 1)
+	{
+		m_Selection.Clear();
+	}
+
+	m_SelectionMode = mode;
+}
+
+void ListBox::SelectAll()
+{
+	const int count = GetItemCount();
+
+	if (count == 0) return;
+
+	if (m_SelectionMode == SelectionMode::Single)
+	{
+		throw NotSupportedException("ListBox with Single selection cannot select all elements");
+	}
+
+	// A single range covers every item
+	m_Selection.SelectAll(static_cast<size_t>(count));
+	m_SelectedIndex = count - 1;
+	m_SelectedValue = GetItemText(m_SelectedIndex);
+	InvalidateRows(0, count - 1);
+	Dispatch("OnSelectedIndexChanged", &ArgsDefault);
+}
+
+void ListBox::ClearSelected() noexcept
+{
+	if (GetItemCount() == 0) return;
+
+	// In case no elements is selected
+	if (m_SelectedIndex == -1) return;
+
+	if (m_SelectionMode == SelectionMode::Single) InvalidateRow(m_SelectedIndex);
+	else InvalidateRows(0, GetItemCount() - 1);
+
+	m_Selection.Clear();
 	m_SelectedIndex = -1;
 	m_SelectedValue = "";
-	m_SelectedItem = nullptr;
+}
+
+IListDataProvider* ListBox::GetDataProvider() const noexcept
+{
+	return m_DataProvider;
+}
+
+void ListBox::SetDataProvider(IListDataProvider* provider)
+{
+	ClearSelected();
+	m_Tabulation = -1;
+	m_SelectionStart = m_SelectionEnd = -1;
+
+	Items.Clear();
+	m_View.Reset(0);
+	m_Lookup.Clear();
+	m_DataProvider = provider;
+	m_VisibleText.clear();
+
+	if (m_DataProvider != nullptr) m_DataProvider->Refresh();
+
+	Dispatch("OnDataSourceChanged", &ArgsDefault);
+	m_IsRebinding = true;
+	Update();
+}
+
+void ListBox::Sort(const std::function<bool(const ItemStore::Item&, const ItemStore::Item&)>& comparer)
+{
+	ApplyView([&]() { m_View.Sort([this, comparer](size_t a, size_t b) { return comparer(Items[a], Items[b]); }); });
+}
+
+void ListBox::ClearSort()
+{
+	ApplyView([&]() { m_View.ClearSort(); });
+}
+
+void ListBox::Filter(const std::function<bool(const ItemStore::Item&)>& predicate)
+{
+	ApplyView([&]() { m_View.Filter([this, predicate](size_t index) { return predicate(Items[index]); }); });
+}
+
+void ListBox::NarrowFilter(const std::function<bool(const ItemStore::Item&)>& predicate)
+{
+	ApplyView([&]() { m_View.Narrow([this, predicate](size_t index) { return predicate(Items[index]); }); });
+}
+
+void ListBox::ClearFilter()
+{
+	ApplyView([&]() { m_View.ClearFilter(); });
+}
+
+int ListBox::GetSourceIndex(int row) const
+{
+	if (row < 0 || row >= GetItemCount())
+	{
+		throw ArgumentOutOfRangeException("row");
+	}
+
+	return IsVirtualMode() ? row : static_cast<int>(m_View.GetSourceIndex(static_cast<size_t>(row)));
+}
+
+DrawMode ListBox::GetDrawMode() const noexcept
+{
+	return m_DrawMode;
+}
+
+void ListBox::SetDrawMode(DrawMode mode) noexcept
+{
+	if (m_DrawMode == mode) return;
+
+	m_DrawMode = mode;
+	m_RowHeights.Reset({});
+	m_IsFormatChanged = true;
+	Update();
+}
+
+void ListBox::RefreshRowHeight(int row)
+{
+	if (row < 0 || row >= GetItemCount())
+	{
+		throw ArgumentOutOfRangeException("row");
+	}
+
+	// Rows not measured yet are measured at the next paint
+	if (!IsVariableHeight() || m_RowHeights.GetCount() != static_cast<size_t>(GetItemCount())) return;
+
+	const int height = MeasureRow(row);
+
+	if (height == m_RowHeights.GetHeight(row)) return;
+
+	m_RowHeights.SetHeight(static_cast<size_t>(row), height);
+	m_IsFormatChanged = true;
+	Update();
+}
+
+size_t ListBox::GetRowCacheBudget() const noexcept
+{
+	return m_RowCache.GetBudget();
+}
+
+void ListBox::SetRowCacheBudget(size_t pixels)
+{
+	m_RowCache.SetBudget(pixels);
+
+	if (pixels == 0) ReleaseRowBitmap();
+}
+
+void ListBox::ClearRowCache() noexcept
+{
+	m_RowCache.Clear();
+	Update();
+}
+
+bool ListBox::IsOwnerDrawCacheEnabled() const noexcept
+{
+	return m_IsOwnerDrawCached;
+}
+
+void ListBox::EnableOwnerDrawCache() noexcept
+{
+	if (m_IsOwnerDrawCached) return;
+
+	m_IsOwnerDrawCached = true;
+	Update();
+}
+
+void ListBox::DisableOwnerDrawCache() noexcept
+{
+	if (!m_IsOwnerDrawCached) return;
+
+	m_IsOwnerDrawCached = false;
+	m_RowCache.Clear();
+	Update();
+}
+
+void ListBox::ClampToItems()
+{
+	const int count = GetItemCount();
+
+	if (m_Tabulation >= count) m_Tabulation = -1;
+
+	if (m_SelectedIndex >= count)
+	{
+		m_SelectedIndex = -1;
+		m_SelectedValue = "";
+	}
+
+	const size_t last = m_Selection.GetLast();
+
+	if (last != SelectionModel::NotFound && last >= static_cast<size_t>(count))
+	{
+		m_Selection.SelectRange(static_cast<size_t>(count), last + 1, false);
+	}
+}
+
+void ListBox::Rebind()
+{
+	ClampToItems();
+	m_IsRebinding = true;
+}
+
+void ListBox::OnDataRefreshed(int oldCount)
+{
+	ClampToItems();
+
+	// The selected row may show another item now
+	if (m_SelectedIndex != -1) m_SelectedValue = GetItemText(m_SelectedIndex);
+
+	if (GetItemCount() == oldCount) return;
+
+	// Variable rows are measured again with the layout
+	if (IsVariableHeight())
+	{
+		m_IsFormatChanged = true;
+	}
+	else
+	{
+		UpdateScrollRange();
+	}
+}
+
+void ListBox::RefreshItems()
+{
+	// The selection is kept, only clamped to the items left
+	Rebind();
+	Update();
 }
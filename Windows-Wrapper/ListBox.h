@@ -1,6 +1,12 @@
 #pragma once
 
 #include "ListControl.h"
+#include "ListViewport.h"
+#include "SelectionModel.h"
+#include "RowHeightIndex.h"
+#include "RowCache.h"
+#include "MeasureItemEventHandler.h"
+#include "DrawItemEventHandler.h"
 
 class ComboBox;
 
@@ -16,25 +22,78 @@ private:
 	bool m_IsScrollAlwaysVisible;
 	bool m_IsFormatChanged;
 	SelectionMode m_SelectionMode;
-	DockStyle m_DockStyle;
 	BorderStyle m_BorderStyle;
-	std::vector<RECT> m_RowPosition;
+	DrawMode m_DrawMode;
+	ListViewport m_Viewport;
+	RowHeightIndex m_RowHeights;				// OwnerDrawVariable single column lists only, measured again when emptied
+	RowCache m_RowCache;						// Rendered rows by source index, unused in virtual mode
+	bool m_IsOwnerDrawCached;
+
+	// DIB section the rows missing from m_RowCache are rendered in, kept between paints and grown to the largest row
+	struct RowBitmap
+	{
+		HDC DC = nullptr;
+		HBITMAP Bitmap = nullptr;
+		HGDIOBJ OldBitmap = nullptr;
+		const uint32_t* Bits = nullptr;
+		int Width = 0;
+		int Height = 0;
+	};
+
+	RowBitmap m_RowBitmap;
+	std::vector<std::string> m_VisibleText;		// Text of the drawn rows in virtual mode
 	int m_TotalItemsInDrawableArea;
 	int m_ColumnWidth;
 	int m_RowNumber;
 	int m_ColumnNumber;
-	ListItem* m_SelectedItem;
-	std::vector<int> m_SelectedIndices;
-	std::vector<ListItem*> m_SelectedItems;
+	SelectionModel m_Selection;		// Multiple selection modes only, Single keeps m_SelectedIndex
 	int m_Tabulation;
 
 	int m_SelectionStart;
 	int m_SelectionEnd;
 
+	MeasureItemEventHandler* OnMeasureItem;
+	DrawItemEventHandler* OnDrawItem;
+
+	const ListViewport& UpdateViewport();
+	bool IsVariableHeight() const noexcept;
+	int MeasureRow(int row);
+	void MeasureRows();
+	int GetScrollingToBottom(int index);
+	uint64_t GetRowState(bool isSelected, bool isFocused) const noexcept;
+	void DrawRow(HDC hdc, RECT cr, int row, std::string_view value, bool isSelected, bool isFocused);
+	const RowCache::Surface* CacheRow(HDC hdc, const RowCache::Key& key, int row, std::string_view value, bool isSelected, bool isFocused);
+	void ReleaseRowBitmap() noexcept;
+	void SelectRange(int from, int to);
+	// Keeps the tabulation and the selection inside the items
+	void ClampToItems();
+	// Same, then lays the list out again at the next paint
+	void Rebind();
+	// Items taken from the data provider before a paint. The rows kept keep their selection, only a count change
+	// moves the scroll range
+	void OnDataRefreshed(int oldCount);
+	void SetTabulation(int index) noexcept;
+	// Repaints the rows [first, last] which are on screen, the other ones are painted when scrolled to
+	void InvalidateRows(int first, int last);
+	void InvalidateRow(int row);
+	void SelectTabulated();
+	void ScrollVertically(int position) noexcept;
+	void ScrollHorizontally(int position) noexcept;
+	void UpdateScrollRange();
+	void ApplyView(const std::function<void()>& change);
+
+	void OnSourceChanged_Impl(ListChangedType type, size_t index, size_t count) override;
+	void OnItemsInserted_Impl(int index, int count) override;
+	void OnItemsRemoved_Impl(int index, int count) override;
+	void OnItemUpdated_Impl(int index) override;
+	void OnItemMoved_Impl(int from, int to) override;
+	void OnViewChanged_Impl(const std::vector<size_t>& rows) override;
+
 	void PreDraw(Graphics* const graphics) override;
 	void Draw(Graphics* const graphics, Drawing::Rectangle rectangle) override;
 	void OnKeyDown_Impl(HWND hwnd, unsigned int vk, int cRepeat, unsigned int flags) noexcept override;
 	void OnMouseLeftDown_Impl(HWND hwnd, int x, int y, unsigned int keyFlags) noexcept override;
+	bool IsRepaintedOnClick() const noexcept override;
 
 	ListBox(Control* parent, int width, int height, int x, int y);
 
@@ -43,8 +102,54 @@ public:
 
 	virtual ~ListBox();
 
+	void OnMeasureItemSet(const std::function<void(Object*, MeasureItemEventArgs*)>& callback) noexcept;
+	void OnDrawItemSet(const std::function<void(Object*, DrawItemEventArgs*)>& callback) noexcept;
+
 	void SetSelectedIndex(int index, bool value) override;
 	void SetSelectedValue(const ListItem& item) override;
+	bool IsSelected(int index) const noexcept;
+	const SelectionModel& GetSelection() const noexcept;
+
+	// Virtual mode: items come from the provider (which must outlive the binding) and only the visible rows are read.
+	// SetDataSource or a null provider leaves it
+	IListDataProvider* GetDataProvider() const noexcept;
+	void SetDataProvider(IListDataProvider* provider);
+
+	// Must be called when the count or the items of the provider change
+	void RefreshItems();
+
+	// Rows are shown sorted and filtered without moving the data source, every row index (selection, tabulation)
+	// follows the view. Not available in virtual mode
+	void Sort(const std::function<bool(const ItemStore::Item&, const ItemStore::Item&)>& comparer);
+	void ClearSort();
+	void Filter(const std::function<bool(const ItemStore::Item&)>& predicate);
+
+	// The predicate must only reject more items than the current filter (ex: type-ahead with a longer prefix), only
+	// the rows shown are checked again
+	void NarrowFilter(const std::function<bool(const ItemStore::Item&)>& predicate);
+	void ClearFilter();
+
+	// Index in the data source of the item shown at the row
+	int GetSourceIndex(int row) const;
+
+	// OwnerDrawVariable only applies to a single column list, a multi column one keeps the item height
+	DrawMode GetDrawMode() const noexcept;
+	void SetDrawMode(DrawMode mode) noexcept;
+
+	// Measures the row again when its content changed. Only the rows after it move, in O(log n)
+	void RefreshRowHeight(int row);
+
+	// Rendered rows are copied on the next paints while their item, state, font and size don't change, up to a budget
+	// of pixels (0 disables the cache)
+	size_t GetRowCacheBudget() const noexcept;
+	void SetRowCacheBudget(size_t pixels);
+	void ClearRowCache() noexcept;
+
+	// Owner drawn rows are only cached when enabled, the list must then clear the cache when OnDrawItem would draw
+	// its rows differently
+	bool IsOwnerDrawCacheEnabled() const noexcept;
+	void EnableOwnerDrawCache() noexcept;
+	void DisableOwnerDrawCache() noexcept;
 
 	bool IsMultiColumn() const noexcept;
 	void EnableMultiColumn() noexcept;
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "EventArgs.h"
+#include "Enums.h"
+
+class ListChangedEventArgs : public EventArgs
+{
+public:
+
+	ListChangedType Type;
+
+	// First changed item and the number of items (indices before the change for removed items).
+	int Index;
+	int Count;
+
+	ListChangedEventArgs(ListChangedType type, int index, int count)
+		:
+		Type(type),
+		Index(index),
+		Count(count)
+	{	}
+};
\ No newline at end of file
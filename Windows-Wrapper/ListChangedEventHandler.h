@@ -0,0 +1,16 @@
+#pragma once
+
+#include "Event.h"
+#include "ListChangedEventArgs.h"
+
+class ListChangedEventHandler : public Event<ListChangedEventArgs*>
+{
+public:
+
+	ListChangedEventHandler(const std::string& name, const std::function<void(Object*, ListChangedEventArgs*)>& callback)
+		:
+		Event(name, callback)
+	{
+
+	}
+};
\ No newline at end of file
@@ -6,6 +6,82 @@ int ListControl::OnEraseBackground_Impl(HWND hwnd, HDC hdc)
 	return 1;	// To avoid flickering
 }
 
+void ListControl::OnDataSourceChanged_Impl()
+{
+
+}
+
+void ListControl::OnSourceChanged_Impl(ListChangedType type, size_t index, size_t count)
+{
+
+}
+
+void ListControl::OnItemsInserted_Impl(int index, int count)
+{
+	if (m_SelectedIndex >= index) m_SelectedIndex += count;
+
+	m_IsRebinding = true;
+	Update();
+}
+
+void ListControl::OnItemsRemoved_Impl(int index, int count)
+{
+	if (m_SelectedIndex >= index + count)
+	{
+		m_SelectedIndex -= count;
+	}
+	else if (m_SelectedIndex >= index)
+	{
+		m_SelectedIndex = -1;
+		m_SelectedValue = "";
+	}
+
+	m_IsRebinding = true;
+	Update();
+}
+
+void ListControl::OnItemUpdated_Impl(int index)
+{
+	if (m_SelectedIndex == index) m_SelectedValue = GetItemText(index);
+
+	Update();
+}
+
+void ListControl::OnItemMoved_Impl(int from, int to)
+{
+	m_SelectedIndex = GetMovedRow(m_SelectedIndex, from, to);
+
+	if (m_SelectedIndex == to) m_SelectedValue = GetItemText(to);
+
+	Update();
+}
+
+void ListControl::OnViewChanged_Impl(const std::vector<size_t>& rows)
+{
+	m_SelectedIndex = GetMovedRow(m_SelectedIndex, rows);
+
+	if (m_SelectedIndex == -1) m_SelectedValue = "";
+
+	m_IsRebinding = true;
+	Update();
+}
+
+int ListControl::GetMovedRow(int row, int from, int to) noexcept
+{
+	if (row == from) return to;
+	if (from < to && row > from && row <= to) return row - 1;
+	if (to < from && row >= to && row < from) return row + 1;
+
+	return row;
+}
+
+int ListControl::GetMovedRow(int row, const std::vector<size_t>& rows) noexcept
+{
+	if (row < 0 || static_cast<size_t>(row) >= rows.size() || rows[row] == ItemView::NotFound) return -1;
+
+	return static_cast<int>(rows[row]);
+}
+
 ListControl::ListControl(Control* parent, const std::string& name, int width, int x, int y)
 	:
 	ListControl(parent, name, width, 0, x, y)	// Default control size without font is 9
@@ -17,17 +93,21 @@ ListControl::ListControl(Control* parent, const std::string& name, int width, in
 	:
 	ScrollableControl(parent, name, width, height, x, y),	// Default control size without font is 9
 	m_AllowSelection(true),
+	m_IsLookupEnabled(false),
 	OnDataSourceChanged(nullptr),
 	OnDisplayMemberChanged(nullptr),
 	OnFormat(nullptr),
 	OnFormatInfoChanged(nullptr),
 	OnFormatStringChanged(nullptr),
 	OnFormattingEnabledChanged(nullptr),
+	OnItemsChanged(nullptr),
 	OnSelectedValueChanged(nullptr),
 	OnValueMemberChanged(nullptr),
 	m_SelectedIndex(-1),	// Negative value because positive implies a valid selection
 	m_SelectedValue(""),
-	m_IsRebinding(false)
+	m_IsRebinding(false),
+	m_DataProvider(nullptr),
+	m_Lookup(Items)
 {
 	Initialize();
 }
@@ -40,6 +120,7 @@ ListControl::~ListControl()
 	if (OnFormatInfoChanged != nullptr) { delete OnFormatInfoChanged; OnFormatInfoChanged = nullptr; }
 	if (OnFormatStringChanged != nullptr) { delete OnFormatStringChanged; OnFormatStringChanged = nullptr; }
 	if (OnFormattingEnabledChanged != nullptr) { delete OnFormattingEnabledChanged; OnFormattingEnabledChanged = nullptr; }
+	if (OnItemsChanged != nullptr) { delete OnItemsChanged; OnItemsChanged = nullptr; }
 	if (OnSelectedValueChanged != nullptr) { delete OnSelectedValueChanged; OnSelectedValueChanged = nullptr; }
 	if (OnValueMemberChanged != nullptr) { delete OnValueMemberChanged; OnValueMemberChanged = nullptr; }
 }
@@ -80,6 +161,12 @@ void ListControl::OnFormattingEnabledChangedSet(const std::function<void(Object*
 	Events.Register(OnFormattingEnabledChanged);
 }
 
+void ListControl::OnItemsChangedSet(const std::function<void(Object*, ListChangedEventArgs*)>& callback) noexcept
+{
+	OnItemsChanged = new ListChangedEventHandler("OnItemsChanged", callback);
+	Events.Register(OnItemsChanged);
+}
+
 void ListControl::OnSelectedValueChangedSet(const std::function<void(Object*, EventArgs*)>& callback) noexcept
 {
 	OnSelectedValueChanged = new EventHandler("OnSelectedValueChanged", callback);
@@ -136,28 +223,237 @@ void ListControl::DisableSelection() noexcept
 	m_AllowSelection = false;
 }
 
-const std::vector<ListItem>& ListControl::GetDataSource() const noexcept
+bool ListControl::IsItemLookupEnabled() const noexcept
 {
-	return Items;
+	return m_IsLookupEnabled;
 }
 
-void ListControl::SetDataSource(const std::vector<ListItem>& dataSource)
+void ListControl::EnableItemLookup() noexcept
+{
+	// Built at the first lookup
+	m_IsLookupEnabled = true;
+}
+
+void ListControl::DisableItemLookup() noexcept
+{
+	m_IsLookupEnabled = false;
+	m_Lookup.Clear();
+}
+
+size_t ListControl::FindItem(const ListItem& item)
+{
+	if (m_IsLookupEnabled) return m_Lookup.Find(item.Id, item.Value);
+
+	for (size_t i = 0; i < Items.GetCount(); ++i)
+	{
+		if (Items.GetId(i) == item.Id && Items.GetValue(i) == item.Value) return i;
+	}
+
+	return ItemLookup::NotFound;
+}
+
+int ListControl::FindItemById(int id)
+{
+	if (IsVirtualMode())
+	{
+		throw InvalidOperationException("Items of a ListControl in virtual mode belong to its data provider");
+	}
+
+	size_t index = ItemLookup::NotFound;
+
+	if (m_IsLookupEnabled)
+	{
+		index = m_Lookup.FindId(id);
+	}
+	else
+	{
+		for (size_t i = 0; i < Items.GetCount() && index == ItemLookup::NotFound; ++i)
+		{
+			if (Items.GetId(i) == id) index = i;
+		}
+	}
+
+	return index == ItemLookup::NotFound ? -1 : static_cast<int>(index);
+}
+
+int ListControl::FindItemByValue(const std::string& value)
 {
-	if (dataSource.size() > 32767)
+	if (IsVirtualMode())
+	{
+		throw InvalidOperationException("Items of a ListControl in virtual mode belong to its data provider");
+	}
+
+	size_t index = ItemLookup::NotFound;
+
+	if (m_IsLookupEnabled)
 	{
-		throw ArgumentException("Maximum ListBox items allowed is 32767");
+		index = m_Lookup.FindValue(value);
 	}
+	else
+	{
+		for (size_t i = 0; i < Items.GetCount() && index == ItemLookup::NotFound; ++i)
+		{
+			if (Items.GetValue(i) == value) index = i;
+		}
+	}
+
+	return index == ItemLookup::NotFound ? -1 : static_cast<int>(index);
+}
+
+const ItemStore& ListControl::GetDataSource() const noexcept
+{
+	return Items;
+}
 
+void ListControl::SetDataSource(const std::vector<ListItem>& dataSource)
+{
 	// Destroy the old DataSource to avoid memory leak
-	Items.clear();
+	Items.Clear();
+	m_DataProvider = nullptr;
 	SetSelectedIndex(-1, false);
 
-	Items = dataSource;
+	Items.Assign(dataSource.begin(), dataSource.end());
+	m_View.Reset(Items.GetCount());
+	m_Lookup.Clear();
+	OnDataSourceChanged_Impl();
 	Dispatch("OnDataSourceChanged", &ArgsDefault);
 	m_IsRebinding = true;
 	Update();
 }
 
+void ListControl::InsertItems(int index, const std::vector<ListItem>& items)
+{
+	if (IsVirtualMode())
+	{
+		throw InvalidOperationException("Items of a ListControl in virtual mode belong to its data provider");
+	}
+
+	if (index < 0 || index > static_cast<int>(Items.GetCount()))
+	{
+		throw ArgumentOutOfRangeException("index");
+	}
+
+	if (items.empty()) return;
+
+	const int count = static_cast<int>(items.size());
+	const size_t rowCount = m_View.GetCount();
+
+	Items.Insert(static_cast<size_t>(index), items.begin(), items.end());
+	const auto rows = m_View.OnInsert(static_cast<size_t>(index), items.size());
+	m_Lookup.OnInsert(static_cast<size_t>(index), items.size());
+	OnSourceChanged_Impl(ListChangedType::ItemAdded, static_cast<size_t>(index), items.size());
+
+	// Rows inserted in one place only shift the ones after them, a sorted or filtered view can spread them
+	if (rows.size() == 1)
+	{
+		OnItemsInserted_Impl(static_cast<int>(rows[0].First), static_cast<int>(rows[0].Count));
+	}
+	else if (rows.size() > 1)
+	{
+		OnViewChanged_Impl(ItemView::GetRowMap(rows, rowCount, true));
+	}
+
+	ListChangedEventArgs args(ListChangedType::ItemAdded, index, count);
+	Dispatch("OnItemsChanged", &args);
+}
+
+void ListControl::RemoveRange(int index, int count)
+{
+	if (IsVirtualMode())
+	{
+		throw InvalidOperationException("Items of a ListControl in virtual mode belong to its data provider");
+	}
+
+	if (index < 0 || count < 0 || index > static_cast<int>(Items.GetCount()) - count)
+	{
+		throw ArgumentOutOfRangeException("index");
+	}
+
+	if (count == 0) return;
+
+	const size_t rowCount = m_View.GetCount();
+
+	m_Lookup.OnErasing(static_cast<size_t>(index), static_cast<size_t>(count));
+	Items.Erase(static_cast<size_t>(index), static_cast<size_t>(count));
+	const auto rows = m_View.OnErase(static_cast<size_t>(index), static_cast<size_t>(count));
+	OnSourceChanged_Impl(ListChangedType::ItemDeleted, static_cast<size_t>(index), static_cast<size_t>(count));
+
+	if (rows.size() == 1)
+	{
+		OnItemsRemoved_Impl(static_cast<int>(rows[0].First), static_cast<int>(rows[0].Count));
+	}
+	else if (rows.size() > 1)
+	{
+		OnViewChanged_Impl(ItemView::GetRowMap(rows, rowCount, false));
+	}
+
+	ListChangedEventArgs args(ListChangedType::ItemDeleted, index, count);
+	Dispatch("OnItemsChanged", &args);
+}
+
+void ListControl::UpdateItem(int index, const ListItem& item)
+{
+	if (IsVirtualMode())
+	{
+		throw InvalidOperationException("Items of a ListControl in virtual mode belong to its data provider");
+	}
+
+	if (index < 0 || index >= static_cast<int>(Items.GetCount()))
+	{
+		throw ArgumentOutOfRangeException("index");
+	}
+
+	m_Lookup.OnUpdating(static_cast<size_t>(index));
+	const size_t oldRow = m_View.OnUpdating(static_cast<size_t>(index));
+	Items.Set(static_cast<size_t>(index), item);
+	m_Lookup.OnUpdated(static_cast<size_t>(index));
+	const size_t row = m_View.OnUpdated(static_cast<size_t>(index));
+	OnSourceChanged_Impl(ListChangedType::ItemChanged, static_cast<size_t>(index), 1);
+
+	// The new value may sort or filter differently
+	if (oldRow == row)
+	{
+		if (row != ItemView::NotFound) OnItemUpdated_Impl(static_cast<int>(row));
+	}
+	else if (oldRow == ItemView::NotFound)
+	{
+		OnItemsInserted_Impl(static_cast<int>(row), 1);
+	}
+	else if (row == ItemView::NotFound)
+	{
+		OnItemsRemoved_Impl(static_cast<int>(oldRow), 1);
+	}
+	else
+	{
+		OnItemMoved_Impl(static_cast<int>(oldRow), static_cast<int>(row));
+	}
+
+	ListChangedEventArgs args(ListChangedType::ItemChanged, index, 1);
+	Dispatch("OnItemsChanged", &args);
+}
+
+bool ListControl::IsVirtualMode() const noexcept
+{
+	return m_DataProvider != nullptr;
+}
+
+int ListControl::GetItemCount() const
+{
+	if (m_DataProvider == nullptr) return static_cast<int>(m_View.GetCount());
+
+	// Scroll bars and indices are int
+	return static_cast<int>((std::min)(m_DataProvider->GetCount(), static_cast<size_t>((std::numeric_limits<int>::max)())));
+}
+
+std::string ListControl::GetItemText(int index) const
+{
+	if (m_DataProvider == nullptr) return std::string(Items.GetValue(m_View.GetSourceIndex(static_cast<size_t>(index))));
+
+	std::string text;
+	m_DataProvider->GetText(static_cast<size_t>(index), { &text, 1 });
+	return text;
+}
+
 int ListControl::GetSelectedIndex() const noexcept
 {
 	return m_SelectedIndex;
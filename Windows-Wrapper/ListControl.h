@@ -2,13 +2,19 @@
 
 #include "ScrollableControl.h"
 #include "ListItem.h"
+#include "IListDataProvider.h"
+#include "ItemView.h"
+#include "ItemStore.h"
+#include "ItemLookup.h"
 #include "ListControlConvertEventHandler.h"
+#include "ListChangedEventHandler.h"
 
 class ListControl : public ScrollableControl
 {
 private:
 
 	bool m_AllowSelection;
+	bool m_IsLookupEnabled;
 
 	EventHandler* OnDataSourceChanged;
 	EventHandler* OnDisplayMemberChanged;
@@ -16,6 +22,7 @@ private:
 	EventHandler* OnFormatInfoChanged;
 	EventHandler* OnFormatStringChanged;
 	EventHandler* OnFormattingEnabledChanged;
+	ListChangedEventHandler* OnItemsChanged;
 	EventHandler* OnSelectedValueChanged;
 	EventHandler* OnValueMemberChanged;
 
@@ -25,7 +32,39 @@ protected:
 	int m_SelectedIndex;
 	std::string m_SelectedValue;
 	bool m_IsRebinding;
-	std::vector<ListItem> Items;
+	ItemStore Items;
+	IListDataProvider* m_DataProvider;		// Replaces Items in virtual mode, not owned
+	ItemView m_View;						// Rows shown over Items (sorted, filtered), unused in virtual mode
+	ItemLookup m_Lookup;					// Positions of the ids and values of Items, only used when enabled
+
+	std::string GetItemText(int index) const;
+
+	// Index in Items of the first item with the id and the value of item (ItemLookup::NotFound when there's none)
+	size_t FindItem(const ListItem& item);
+
+	// Called after SetDataSource replaced Items, before OnDataSourceChanged is dispatched
+	virtual void OnDataSourceChanged_Impl();
+
+	// Called when Items changed, before the rows are notified below. Indices are the ones of Items, whatever the view
+	virtual void OnSourceChanged_Impl(ListChangedType type, size_t index, size_t count);
+
+	// Called after Items changed, before OnItemsChanged is dispatched, with the rows of the view. The default
+	// implementation rebinds the whole list
+	virtual void OnItemsInserted_Impl(int index, int count);
+	virtual void OnItemsRemoved_Impl(int index, int count);
+	virtual void OnItemUpdated_Impl(int index);
+
+	// An updated item sorts at another row, the rows between shift by one
+	virtual void OnItemMoved_Impl(int from, int to);
+
+	// Called instead of the ones above when rows moved in several places (sort, filter, items inserted or removed in a
+	// sorted or filtered view). rows holds the new row of each old one (ItemView::NotFound when it's gone), the new rows
+	// left are new items
+	virtual void OnViewChanged_Impl(const std::vector<size_t>& rows);
+
+	// Row after a move or a view change (-1 when it's gone)
+	static int GetMovedRow(int row, int from, int to) noexcept;
+	static int GetMovedRow(int row, const std::vector<size_t>& rows) noexcept;
 
 	int OnEraseBackground_Impl(HWND hwnd, HDC hdc) override;
 
@@ -41,6 +80,7 @@ public:
 	void OnFormatInfoChangedSet(const std::function<void(Object*, EventArgs*)>& callback) noexcept;
 	void OnFormatStringChangedSet(const std::function<void(Object*, EventArgs*)>& callback) noexcept;
 	void OnFormattingEnabledChangedSet(const std::function<void(Object*, EventArgs*)>& callback) noexcept;
+	void OnItemsChangedSet(const std::function<void(Object*, ListChangedEventArgs*)>& callback) noexcept;
 	void OnSelectedValueChangedSet(const std::function<void(Object*, EventArgs*)>& callback) noexcept;
 	void OnValueMemberChangedSet(const std::function<void(Object*, EventArgs*)>& callback) noexcept;
 
@@ -48,8 +88,29 @@ public:
 	bool IsSelectionAllowed();
 	void EnableSelection() noexcept;
 	void DisableSelection() noexcept;
-	const std::vector<ListItem>& GetDataSource() const noexcept;
+
+	// Hash index of the ids and values making the lookups below and SetSelectedValue O(1) instead of comparing every
+	// item. Off by default, it takes memory in the order of the items themselves
+	bool IsItemLookupEnabled() const noexcept;
+	void EnableItemLookup() noexcept;
+	void DisableItemLookup() noexcept;
+
+	// Index in the data source of the first item with the id or the value (-1 when there's none)
+	int FindItemById(int id);
+	int FindItemByValue(const std::string& value);
+
+	// Items as the control keeps them, without copying. Values point into the store, so they are only valid until the
+	// next change of the items
+	const ItemStore& GetDataSource() const noexcept;
 	void SetDataSource(const std::vector<ListItem>& dataSource);
+
+	// Changes only the given items of the data source, without rebinding the list
+	void InsertItems(int index, const std::vector<ListItem>& items);
+	void RemoveRange(int index, int count);
+	void UpdateItem(int index, const ListItem& item);
+
+	bool IsVirtualMode() const noexcept;
+	int GetItemCount() const;
 	virtual int GetSelectedIndex() const noexcept;
 	virtual void SetSelectedIndex(int index, bool value) = 0;
 	std::string GetSelectedValue() const noexcept;
@@ -0,0 +1,169 @@
+#include "ListViewport.h"
+
+#include <algorithm>
+#include <climits>
+
+ListViewport::ListViewport()
+	:
+	m_Area{ 0, 0, 0, 0 },
+	m_ItemWidth(0),
+	m_ItemHeight(0),
+	m_ItemSpacing(0),
+	m_RowNumber(0),
+	m_Count(0),
+	m_RowScrolling(0),
+	m_ColumnScrolling(0),
+	m_RowHeights(nullptr)
+{
+
+}
+
+bool ListViewport::IsVariable() const noexcept
+{
+	return m_RowHeights != nullptr && m_RowNumber == m_Count && m_RowHeights->GetCount() == m_Count;
+}
+
+size_t ListViewport::GetVisibleRows() const noexcept
+{
+	if (m_ItemHeight <= 0 || m_RowScrolling >= m_RowNumber || m_Area.Bottom <= m_Area.Top) return 0;
+
+	// Rows ending inside the area
+	if (IsVariable())
+	{
+		const size_t last = m_RowHeights->GetRow(m_RowHeights->GetOffset(m_RowScrolling) + (m_Area.Bottom - m_Area.Top));
+
+		return (std::min)(last, m_Count) - m_RowScrolling;
+	}
+
+	const auto rows = static_cast<size_t>((m_Area.Bottom - m_Area.Top) / m_ItemHeight);
+
+	return (std::min)(rows, m_RowNumber - m_RowScrolling);
+}
+
+size_t ListViewport::GetVisibleColumns() const noexcept
+{
+	if (m_ItemWidth <= 0) return 0;
+
+	// The first column only needs the item itself, without its spacing
+	const int room = m_Area.Right - m_Area.Left - (m_ItemWidth - m_ItemSpacing);
+
+	return room < 0 ? 0 : static_cast<size_t>(room / m_ItemWidth) + 1;
+}
+
+void ListViewport::SetArea(int left, int top, int right, int bottom) noexcept
+{
+	m_Area = { left, top, right, bottom };
+}
+
+void ListViewport::SetItemSize(int width, int height, int spacing) noexcept
+{
+	m_ItemWidth = width;
+	m_ItemHeight = height;
+	m_ItemSpacing = spacing;
+}
+
+void ListViewport::SetRowNumber(size_t rows) noexcept
+{
+	m_RowNumber = rows;
+}
+
+void ListViewport::SetCount(size_t count) noexcept
+{
+	m_Count = count;
+}
+
+void ListViewport::SetScrolling(size_t row, size_t column) noexcept
+{
+	m_RowScrolling = row;
+	m_ColumnScrolling = column;
+}
+
+void ListViewport::SetRowHeights(const RowHeightIndex* heights) noexcept
+{
+	m_RowHeights = heights;
+}
+
+ListViewport::Bounds ListViewport::GetBounds(size_t index) const noexcept
+{
+	if (m_RowNumber == 0) return { INT_MIN, INT_MIN, INT_MIN, INT_MIN };
+
+	auto clamp = [](long long value) { return static_cast<int>(std::clamp<long long>(value, INT_MIN, INT_MAX)); };
+
+	const auto row = static_cast<long long>(index % m_RowNumber) - static_cast<long long>(m_RowScrolling);
+	const auto column = static_cast<long long>(index / m_RowNumber) - static_cast<long long>(m_ColumnScrolling);
+	const long long left = m_Area.Left + column * m_ItemWidth;
+
+	if (IsVariable() && index < m_Count)
+	{
+		const long long top = m_Area.Top + m_RowHeights->GetOffset(index) - m_RowHeights->GetOffset(m_RowScrolling);
+
+		return { clamp(left), clamp(top), clamp(left + m_ItemWidth - m_ItemSpacing), clamp(top + m_RowHeights->GetHeight(index)) };
+	}
+
+	const long long top = m_Area.Top + row * m_ItemHeight;
+
+	return { clamp(left), clamp(top), clamp(left + m_ItemWidth - m_ItemSpacing), clamp(top + m_ItemHeight) };
+}
+
+bool ListViewport::IsVisible(size_t index) const noexcept
+{
+	if (index >= m_Count) return false;
+
+	const auto b = GetBounds(index);
+
+	return b.Left >= m_Area.Left && b.Top >= m_Area.Top && b.Right <= m_Area.Right && b.Bottom <= m_Area.Bottom;
+}
+
+std::pair<size_t, size_t> ListViewport::GetVisibleRange() const noexcept
+{
+	const size_t rows = GetVisibleRows();
+	const size_t columns = GetVisibleColumns();
+
+	if (rows == 0 || columns == 0) return { 0, 0 };
+
+	const size_t first = (std::min)(m_ColumnScrolling * m_RowNumber + m_RowScrolling, m_Count);
+	const size_t last = (std::min)((m_ColumnScrolling + columns - 1) * m_RowNumber + m_RowScrolling + rows, m_Count);
+
+	return { first, last };
+}
+
+size_t ListViewport::GetIndexFromPoint(int x, int y) const noexcept
+{
+	if (m_ItemWidth <= 0 || m_ItemHeight <= 0) return NotFound;
+	if (x < m_Area.Left || x > m_Area.Right || y < m_Area.Top || y > m_Area.Bottom) return NotFound;
+
+	const int dx = x - m_Area.Left;
+	const int dy = y - m_Area.Top;
+
+	// Spacing between the columns doesn't belong to any item
+	if (dx % m_ItemWidth > m_ItemWidth - m_ItemSpacing) return NotFound;
+
+	const size_t row = IsVariable() ? m_RowHeights->GetRow(m_RowHeights->GetOffset(m_RowScrolling) + dy) : m_RowScrolling + static_cast<size_t>(dy / m_ItemHeight);
+	const size_t column = m_ColumnScrolling + static_cast<size_t>(dx / m_ItemWidth);
+
+	if (row >= m_RowNumber) return NotFound;
+
+	const size_t index = column * m_RowNumber + row;
+
+	return index < m_Count ? index : NotFound;
+}
+
+size_t ListViewport::GetScrollingToBottom(size_t index) const noexcept
+{
+	const int height = m_Area.Bottom - m_Area.Top;
+
+	if (!IsVariable())
+	{
+		const size_t rows = m_ItemHeight <= 0 ? 1 : (std::max)(static_cast<size_t>(height / m_ItemHeight), size_t{ 1 });
+
+		return index + 1 < rows ? 0 : index + 1 - rows;
+	}
+
+	// First row whose top is at most the height of the area above the bottom of the item
+	const long long top = m_RowHeights->GetOffset(index + 1) - height;
+	size_t row = m_RowHeights->GetRow(top);
+
+	if (row < m_Count && m_RowHeights->GetOffset(row) < top) ++row;
+
+	return (std::min)(row, index);
+}
\ No newline at end of file
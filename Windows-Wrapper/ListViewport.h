@@ -0,0 +1,76 @@
+#pragma once
+
+#include "RowHeightIndex.h"
+#include <utility>
+#include <cstddef>
+
+/*
+Maps the items of a list control to the cells of its drawable area.
+
+Items fill the rows of a column before moving to the next one (a single column list has as many rows as items) and
+the scroll positions are counted in rows and columns. Nothing is stored per item, so the bounds of an item, the
+visible range and the hit test are O(1) whatever the number of items.
+
+A single column list can have variable row heights: the tops of the rows then come from a RowHeightIndex and the same
+queries are O(log n).
+*/
+class ListViewport
+{
+public:
+
+	static constexpr size_t NotFound = static_cast<size_t>(-1);
+
+	struct Bounds
+	{
+		int Left;
+		int Top;
+		int Right;
+		int Bottom;
+	};
+
+private:
+
+	Bounds m_Area;
+	int m_ItemWidth;
+	int m_ItemHeight;
+	int m_ItemSpacing;		// Pixels at the right of each item which don't belong to it
+	size_t m_RowNumber;
+	size_t m_Count;
+	size_t m_RowScrolling;
+	size_t m_ColumnScrolling;
+	const RowHeightIndex* m_RowHeights;		// Not owned, null when every row has the item height
+
+	bool IsVariable() const noexcept;
+	size_t GetVisibleRows() const noexcept;
+	size_t GetVisibleColumns() const noexcept;
+
+public:
+
+	ListViewport();
+
+	void SetArea(int left, int top, int right, int bottom) noexcept;
+	void SetItemSize(int width, int height, int spacing) noexcept;
+
+	// Rows of each column
+	void SetRowNumber(size_t rows) noexcept;
+	void SetCount(size_t count) noexcept;
+	void SetScrolling(size_t row, size_t column) noexcept;
+
+	// Only used by a single column list with one height per item
+	void SetRowHeights(const RowHeightIndex* heights) noexcept;
+
+	// Far away items are clamped to the int range, they stay outside of the area
+	Bounds GetBounds(size_t index) const noexcept;
+
+	// Item entirely inside the area
+	bool IsVisible(size_t index) const noexcept;
+
+	// Items [first, last) drawn in the area
+	std::pair<size_t, size_t> GetVisibleRange() const noexcept;
+
+	// Item under the point (NotFound when there's none)
+	size_t GetIndexFromPoint(int x, int y) const noexcept;
+
+	// Row scrolling showing the item of a single column list on the last visible row
+	size_t GetScrollingToBottom(size_t index) const noexcept;
+};
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Common.h"
+#include "Color.h"
 
 #define Saturate(x) (std::min)((std::max)(x, 0.0f), 1.0f)	// std::min and std::max between brackets to avoid default minmax macro call
 
@@ -225,6 +226,32 @@ namespace Math
 	// Returns an element of a precomputed halton sequence. Specify which iteration to get with index >= 0
 	const XMFLOAT4& GetHaltonSequence(int index);
 
+	// Color channels as floats in [0, 1]
+	inline constexpr XMFLOAT3 ToFloat3(Color c)
+	{
+		return XMFLOAT3(c.GetR() / 255.0f, c.GetG() / 255.0f, c.GetB() / 255.0f);
+	}
+
+	inline constexpr XMFLOAT4 ToFloat4(Color c)
+	{
+		return XMFLOAT4(c.GetR() / 255.0f, c.GetG() / 255.0f, c.GetB() / 255.0f, c.GetA() / 255.0f);
+	}
+
+	inline constexpr D3DCOLORVALUE ToColorValue(Color c)
+	{
+		return D3DCOLORVALUE(c.GetR() / 255.0f, c.GetG() / 255.0f, c.GetB() / 255.0f, c.GetA() / 255.0f);
+	}
+
+	inline constexpr Color FromFloat3(const XMFLOAT3& value)
+	{
+		return Color(static_cast<uint8_t>(value.x * 255), static_cast<uint8_t>(value.y * 255), static_cast<uint8_t>(value.z * 255));
+	}
+
+	inline constexpr Color FromFloat4(const XMFLOAT4& value)
+	{
+		return Color(static_cast<uint8_t>(value.x * 255), static_cast<uint8_t>(value.y * 255), static_cast<uint8_t>(value.z * 255), static_cast<uint8_t>(value.w * 255));
+	}
+
 	uint32_t CompressNormal(const XMFLOAT3& normal);
 	uint32_t CompressColor(const XMFLOAT3& color);
 	uint32_t CompressColor(const XMFLOAT4& color);
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "EventArgs.h"
+
+class MeasureItemEventArgs : public EventArgs
+{
+public:
+
+	int Index;
+
+	// Starts at the item height of the control, the handler sets the height of the row
+	int ItemHeight;
+
+	MeasureItemEventArgs(int index, int itemHeight)
+		:
+		Index(index),
+		ItemHeight(itemHeight)
+	{	}
+};
\ No newline at end of file
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "Event.h"
+#include "MeasureItemEventArgs.h"
+
+class MeasureItemEventHandler : public Event<MeasureItemEventArgs*>
+{
+public:
+
+	MeasureItemEventHandler(const std::string& name, const std::function<void(Object*, MeasureItemEventArgs*)>& callback)
+		:
+		Event(name, callback)
+	{
+
+	}
+};
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "CancelEventArgs.h"
+
+class PasteProgressEventArgs : public CancelEventArgs
+{
+public:
+
+	// Characters already inserted.
+	size_t Pasted;
+
+	// Characters of the whole paste, already limited by the maximum length.
+	size_t Total;
+
+	PasteProgressEventArgs(size_t pasted, size_t total)
+		:
+		CancelEventArgs(false),
+		Pasted(pasted),
+		Total(total)
+	{	}
+};
\ No newline at end of file
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "Event.h"
+#include "PasteProgressEventArgs.h"
+
+class PasteProgressEventHandler : public Event<PasteProgressEventArgs*>
+{
+public:
+
+	PasteProgressEventHandler(const std::string& name, const std::function<void(Object*, PasteProgressEventArgs*)>& callback)
+		:
+		Event(name, callback)
+	{
+
+	}
+};
\ No newline at end of file
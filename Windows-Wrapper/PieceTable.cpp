@@ -0,0 +1,342 @@
+#include "PieceTable.h"
+
+PieceTable::PieceTable()
+	:
+	m_Root(Nil),
+	m_Seed(2463534242u)
+{
+
+}
+
+PieceTable::PieceTable(std::string text)
+	:
+	PieceTable()
+{
+	Assign(std::move(text));
+}
+
+const char* PieceTable::GetBuffer(const Node& n) const noexcept
+{
+	return n.IsAdded ? m_Added.data() : m_Original.data();
+}
+
+size_t PieceTable::CountLineBreaks(bool isAdded, size_t start, size_t length) const noexcept
+{
+	const auto& breaks = isAdded ? m_AddedLineBreaks : m_OriginalLineBreaks;
+	const auto first = std::lower_bound(breaks.begin(), breaks.end(), start);
+	const auto last = std::lower_bound(first, breaks.end(), start + length);
+	return static_cast<size_t>(last - first);
+}
+
+uint32_t PieceTable::CreateNode(bool isAdded, size_t start, size_t length)
+{
+	// Xorshift is enough to keep the treap balanced
+	m_Seed ^= m_Seed << 13;
+	m_Seed ^= m_Seed >> 17;
+	m_Seed ^= m_Seed << 5;
+
+	const size_t lineBreaks = CountLineBreaks(isAdded, start, length);
+	const Node n{ start, length, lineBreaks, length, lineBreaks, Nil, Nil, m_Seed, isAdded };
+
+	if (!m_FreeNodes.empty())
+	{
+		const uint32_t node = m_FreeNodes.back();
+		m_FreeNodes.pop_back();
+		m_Nodes[node] = n;
+		return node;
+	}
+
+	m_Nodes.push_back(n);
+	return static_cast<uint32_t>(m_Nodes.size() - 1);
+}
+
+void PieceTable::FreeNodes(uint32_t node)
+{
+	if (node == Nil) return;
+
+	FreeNodes(m_Nodes[node].Left);
+	FreeNodes(m_Nodes[node].Right);
+	m_FreeNodes.push_back(node);
+}
+
+void PieceTable::Update(uint32_t node) noexcept
+{
+	auto& n = m_Nodes[node];
+	n.SubtreeLength = n.Length;
+	n.SubtreeLineBreaks = n.LineBreaks;
+
+	if (n.Left != Nil)
+	{
+		n.SubtreeLength += m_Nodes[n.Left].SubtreeLength;
+		n.SubtreeLineBreaks += m_Nodes[n.Left].SubtreeLineBreaks;
+	}
+
+	if (n.Right != Nil)
+	{
+		n.SubtreeLength += m_Nodes[n.Right].SubtreeLength;
+		n.SubtreeLineBreaks += m_Nodes[n.Right].SubtreeLineBreaks;
+	}
+}
+
+uint32_t PieceTable::Merge(uint32_t left, uint32_t right) noexcept
+{
+	if (left == Nil) return right;
+	if (right == Nil) return left;
+
+	if (m_Nodes[left].Priority > m_Nodes[right].Priority)
+	{
+		m_Nodes[left].Right = Merge(m_Nodes[left].Right, right);
+		Update(left);
+		return left;
+	}
+
+	m_Nodes[right].Left = Merge(left, m_Nodes[right].Left);
+	Update(right);
+	return right;
+}
+
+void PieceTable::Split(uint32_t node, size_t offset, uint32_t& left, uint32_t& right)
+{
+	if (node == Nil)
+	{
+		left = right = Nil;
+		return;
+	}
+
+	const size_t leftLength = m_Nodes[node].Left == Nil ? 0 : m_Nodes[m_Nodes[node].Left].SubtreeLength;
+	const size_t length = m_Nodes[node].Length;
+
+	if (offset <= leftLength)
+	{
+		uint32_t l;
+		Split(m_Nodes[node].Left, offset, left, l);
+		m_Nodes[node].Left = l;
+		Update(node);
+		right = node;
+	}
+	else if (offset >= leftLength + length)
+	{
+		uint32_t r;
+		Split(m_Nodes[node].Right, offset - leftLength - length, r, right);
+		m_Nodes[node].Right = r;
+		Update(node);
+		left = node;
+	}
+	else
+	{
+		// Offset falls inside the piece so it's cut in two. The second half goes to the right tree
+		const size_t cut = offset - leftLength;
+		const uint32_t tail = CreateNode(m_Nodes[node].IsAdded, m_Nodes[node].Start + cut, length - cut);
+		auto& n = m_Nodes[node];
+		n.Length = cut;
+		n.LineBreaks -= m_Nodes[tail].LineBreaks;
+
+		const uint32_t r = n.Right;
+		n.Right = Nil;
+		Update(node);
+		left = node;
+		right = Merge(tail, r);
+	}
+}
+
+void PieceTable::Assign(std::string text)
+{
+	m_Original = std::move(text);
+	m_Added.clear();
+	m_OriginalLineBreaks.clear();
+	m_AddedLineBreaks.clear();
+	m_Nodes.clear();
+	m_FreeNodes.clear();
+	m_Root = Nil;
+
+	for (size_t i = m_Original.find('\n'); i != std::string::npos; i = m_Original.find('\n', i + 1))
+	{
+		m_OriginalLineBreaks.push_back(i);
+	}
+
+	if (!m_Original.empty()) m_Root = CreateNode(false, 0, m_Original.length());
+}
+
+void PieceTable::Insert(size_t offset, std::string_view text)
+{
+	if (text.empty()) return;
+
+	offset = (std::min)(offset, GetLength());
+
+	const size_t start = m_Added.length();
+	m_Added.append(text);
+
+	for (size_t i = 0; i < text.length(); ++i)
+	{
+		if (text[i] == '\n') m_AddedLineBreaks.push_back(start + i);
+	}
+
+	uint32_t left, right;
+	Split(m_Root, offset, left, right);
+
+	// Typing right after the last inserted text only grows the last piece of the left tree (and its ancestors)
+	uint32_t last = left;
+	while (last != Nil && m_Nodes[last].Right != Nil) last = m_Nodes[last].Right;
+
+	if (last != Nil && m_Nodes[last].IsAdded && m_Nodes[last].Start + m_Nodes[last].Length == start)
+	{
+		const size_t lineBreaks = CountLineBreaks(true, start, text.length());
+		m_Nodes[last].Length += text.length();
+		m_Nodes[last].LineBreaks += lineBreaks;
+
+		for (uint32_t node = left; node != Nil; node = m_Nodes[node].Right)
+		{
+			m_Nodes[node].SubtreeLength += text.length();
+			m_Nodes[node].SubtreeLineBreaks += lineBreaks;
+		}
+
+		m_Root = Merge(left, right);
+		return;
+	}
+
+	m_Root = Merge(Merge(left, CreateNode(true, start, text.length())), right);
+}
+
+void PieceTable::Erase(size_t offset, size_t count)
+{
+	const size_t length = GetLength();
+
+	if (offset >= length || count == 0) return;
+
+	count = (std::min)(count, length - offset);
+
+	uint32_t left, middle, right;
+	Split(m_Root, offset, left, right);
+	Split(right, count, middle, right);
+	FreeNodes(middle);
+	m_Root = Merge(left, right);
+}
+
+void PieceTable::Reserve(size_t count)
+{
+	m_Added.reserve(m_Added.length() + count);
+}
+
+size_t PieceTable::GetLength() const noexcept
+{
+	return m_Root == Nil ? 0 : m_Nodes[m_Root].SubtreeLength;
+}
+
+size_t PieceTable::GetLineCount() const noexcept
+{
+	return (m_Root == Nil ? 0 : m_Nodes[m_Root].SubtreeLineBreaks) + 1;
+}
+
+size_t PieceTable::GetPieceCount() const noexcept
+{
+	return m_Nodes.size() - m_FreeNodes.size();
+}
+
+char PieceTable::GetChar(size_t offset) const noexcept
+{
+	uint32_t node = m_Root;
+
+	while (node != Nil)
+	{
+		const auto& n = m_Nodes[node];
+		const size_t left = n.Left == Nil ? 0 : m_Nodes[n.Left].SubtreeLength;
+
+		if (offset < left)
+		{
+			node = n.Left;
+		}
+		else if (offset < left + n.Length)
+		{
+			return GetBuffer(n)[n.Start + offset - left];
+		}
+		else
+		{
+			offset -= left + n.Length;
+			node = n.Right;
+		}
+	}
+
+	return '\0';
+}
+
+std::string PieceTable::GetText() const
+{
+	return GetText(0, GetLength());
+}
+
+std::string PieceTable::GetText(size_t offset, size_t count) const
+{
+	std::string ret;
+	ret.reserve((std::min)(count, GetLength()));
+	ForEachChunk(offset, count, [&](std::string_view chunk) { ret.append(chunk); });
+	return ret;
+}
+
+size_t PieceTable::GetLineFromOffset(size_t offset) const noexcept
+{
+	size_t ret = 0;
+	uint32_t node = m_Root;
+
+	while (node != Nil)
+	{
+		const auto& n = m_Nodes[node];
+		const size_t left = n.Left == Nil ? 0 : m_Nodes[n.Left].SubtreeLength;
+
+		if (offset < left)
+		{
+			node = n.Left;
+			continue;
+		}
+
+		if (n.Left != Nil) ret += m_Nodes[n.Left].SubtreeLineBreaks;
+
+		if (offset < left + n.Length)
+		{
+			return ret + CountLineBreaks(n.IsAdded, n.Start, offset - left);
+		}
+
+		ret += n.LineBreaks;
+		offset -= left + n.Length;
+		node = n.Right;
+	}
+
+	return ret;
+}
+
+size_t PieceTable::GetLineStart(size_t line) const noexcept
+{
+	if (line == 0) return 0;
+	if (line >= GetLineCount()) return GetLength();
+
+	// Looks for the line-th line break, the line starts right after it
+	size_t ret = 0;
+	uint32_t node = m_Root;
+
+	while (node != Nil)
+	{
+		const auto& n = m_Nodes[node];
+		const size_t leftBreaks = n.Left == Nil ? 0 : m_Nodes[n.Left].SubtreeLineBreaks;
+
+		if (line <= leftBreaks)
+		{
+			node = n.Left;
+			continue;
+		}
+
+		line -= leftBreaks;
+		ret += n.Left == Nil ? 0 : m_Nodes[n.Left].SubtreeLength;
+
+		if (line <= n.LineBreaks)
+		{
+			const auto& breaks = n.IsAdded ? m_AddedLineBreaks : m_OriginalLineBreaks;
+			const auto first = std::lower_bound(breaks.begin(), breaks.end(), n.Start);
+			return ret + *(first + (line - 1)) - n.Start + 1;
+		}
+
+		line -= n.LineBreaks;
+		ret += n.Length;
+		node = n.Right;
+	}
+
+	return ret;
+}
\ No newline at end of file
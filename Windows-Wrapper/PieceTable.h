@@ -0,0 +1,114 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+/*
+Text storage made of pieces pointing to two buffers: the original text (never modified) and an append only buffer
+receiving every inserted text. Editing never moves the existing characters, it only splits and links pieces.
+
+		Original:	"Hello world"			Added: "big "
+
+		Pieces:		[Original 0, 6) [Added 0, 4) [Original 6, 11)		=	"Hello big world"
+
+The pieces are kept in a treap ordered by their position in the document, and each node caches the length and the
+line breaks of its subtree. So inserting, erasing, finding the line of an offset (or the offset of a line) are all
+O(log n) on the number of pieces. Typing at the end of the last inserted text extends the same piece instead of
+creating a new one.
+*/
+class PieceTable
+{
+private:
+
+	static constexpr uint32_t Nil = UINT32_MAX;
+
+	struct Node
+	{
+		size_t Start;
+		size_t Length;
+		size_t LineBreaks;
+		size_t SubtreeLength;
+		size_t SubtreeLineBreaks;
+		uint32_t Left;
+		uint32_t Right;
+		uint32_t Priority;
+		bool IsAdded;
+	};
+
+	std::string m_Original;
+	std::string m_Added;
+	std::vector<size_t> m_OriginalLineBreaks;	// Offsets of every '\n' inside each buffer
+	std::vector<size_t> m_AddedLineBreaks;
+	std::vector<Node> m_Nodes;
+	std::vector<uint32_t> m_FreeNodes;
+	uint32_t m_Root;
+	uint32_t m_Seed;
+
+	const char* GetBuffer(const Node& n) const noexcept;
+	size_t CountLineBreaks(bool isAdded, size_t start, size_t length) const noexcept;
+	uint32_t CreateNode(bool isAdded, size_t start, size_t length);
+	void FreeNodes(uint32_t node);
+	void Update(uint32_t node) noexcept;
+	uint32_t Merge(uint32_t left, uint32_t right) noexcept;
+	void Split(uint32_t node, size_t offset, uint32_t& left, uint32_t& right);
+
+	template<typename F>
+	void ForEachChunk(uint32_t node, size_t offset, size_t& count, F& function) const
+	{
+		if (node == Nil || count == 0) return;
+
+		const auto& n = m_Nodes[node];
+		const size_t left = n.Left == Nil ? 0 : m_Nodes[n.Left].SubtreeLength;
+
+		if (offset < left) ForEachChunk(n.Left, offset, count, function);
+
+		if (count == 0) return;
+
+		const size_t start = offset > left ? offset - left : 0;
+
+		if (start < n.Length)
+		{
+			const size_t length = (std::min)(count, n.Length - start);
+			function(std::string_view(GetBuffer(n) + n.Start + start, length));
+			count -= length;
+		}
+
+		ForEachChunk(n.Right, offset > left + n.Length ? offset - left - n.Length : 0, count, function);
+	}
+
+public:
+
+	PieceTable();
+	explicit PieceTable(std::string text);
+
+	void Assign(std::string text);
+	void Insert(size_t offset, std::string_view text);
+	void Erase(size_t offset, size_t count);
+
+	// Makes room for count inserted characters, so a sequence of inserts (ex: a paste in chunks) never moves the buffer
+	void Reserve(size_t count);
+
+	size_t GetLength() const noexcept;
+	size_t GetLineCount() const noexcept;
+	size_t GetPieceCount() const noexcept;
+	char GetChar(size_t offset) const noexcept;
+	std::string GetText() const;
+	std::string GetText(size_t offset, size_t count) const;
+
+	// Line (zero based) containing the character at the offset
+	size_t GetLineFromOffset(size_t offset) const noexcept;
+
+	// Offset of the first character of the line (length of the document when the line doesn't exist)
+	size_t GetLineStart(size_t line) const noexcept;
+
+	// Calls function(std::string_view) for each contiguous chunk of the range, in order and without copying
+	template<typename F>
+	void ForEachChunk(size_t offset, size_t count, F&& function) const
+	{
+		ForEachChunk(m_Root, offset, count, function);
+	}
+};
\ No newline at end of file
@@ -1,7 +1,6 @@
 #include "Point.h"
 #include "PointF.h"
 #include "Size.h"
-#include "Exceptions.h"
 
 Point::Point(Size size) 
 	: 
@@ -44,27 +43,4 @@ inline Point Point::Subtract(Point p, Size s) noexcept
 inline Point Point::Truncate(PointF p) noexcept
 {
 	return Point(static_cast<int>(trunc(p.X)), static_cast<int>(trunc(p.Y)));
-}
-
-int Point::GetHashCode() const noexcept
-{
-	return X ^ Y;
-}
-
-bool Point::Equals(const Object* const p) const
-{
-	if (p == nullptr) return false;
-
-	if (const auto pt = dynamic_cast<const Point*>(p))
-	{
-		return *this == *pt;
-	}
-
-	throw ArgumentException("Arg_MustBePoint");
-}
-
-bool Point::Equals(const Point* const p) const
-{
-	if (p == nullptr) return false;
-	return *this == *p;
 }
\ No newline at end of file
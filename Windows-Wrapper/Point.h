@@ -1,18 +1,18 @@
 #pragma once
 
-#include "IEquatable.h"
+#include "ValueType.h"
 
 struct PointF;
 struct Size;
 
-struct Point : public IEquatable<Point>
+struct Point
 {
 public:
 
 	int X;
 	int Y;
 
-	constexpr Point(int word) : X(LOWORD(word)), Y(HIWORD(word)) { }
+	constexpr Point(int word) : X(static_cast<uint16_t>(word)), Y(static_cast<uint16_t>(static_cast<uint32_t>(word) >> 16)) { }
 	constexpr Point(int x, int y) : X(x), Y(y) { }
 	Point(Size size);
 
@@ -33,9 +33,11 @@ public:
 	static constexpr Point Add(Point lhs, Point rhs) noexcept { return Point(lhs.X + rhs.X, lhs.Y + rhs.Y); }
 	static constexpr Point Subtract(Point lhs, Point rhs) noexcept { return Point(lhs.X - rhs.X, lhs.Y - rhs.Y); }
 
-	int GetHashCode() const noexcept override;
-	inline bool Equals(const Object* const obj) const override;
-	inline bool Equals(const Point* const p) const override;
+	constexpr int GetHashCode() const noexcept { return X ^ Y; }
+	constexpr bool Equals(const Point* const p) const noexcept { return p != nullptr && *this == *p; }
 
 	static constexpr Point Empty() { return Point(0, 0); }
-};
\ No newline at end of file
+};
+
+static_assert(EquatableValue<Point>);
+static_assert(sizeof(Point) == 2 * sizeof(int), "Point must stay a pair of integers");
\ No newline at end of file
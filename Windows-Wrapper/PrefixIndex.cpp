@@ -0,0 +1,411 @@
+#include "PrefixIndex.h"
+
+#include <algorithm>
+#include <tuple>
+
+namespace
+{
+	constexpr uint64_t LabelSpacing = uint64_t{ 1 } << 32;
+
+	char ToLower(char c) noexcept
+	{
+		return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+	}
+}
+
+std::string_view PrefixIndex::Table::GetKey(uint32_t slot) const noexcept
+{
+	return { Text.data() + Slots[slot].Offset, Slots[slot].Length };
+}
+
+bool PrefixIndex::Table::IsBefore(uint32_t a, uint32_t b) const noexcept
+{
+	const int result = GetKey(a).compare(GetKey(b));
+
+	return result < 0 || (result == 0 && Slots[a].Label < Slots[b].Label);
+}
+
+size_t PrefixIndex::Table::GetIndex(uint32_t slot) const noexcept
+{
+	const uint64_t label = Slots[slot].Label;
+
+	return static_cast<size_t>(std::lower_bound(Sources.begin(), Sources.end(), label, [this](uint32_t source, uint64_t value) { return Slots[source].Label < value; }) - Sources.begin());
+}
+
+uint32_t PrefixIndex::Table::Add(std::string_view value)
+{
+	const Slot slot{ Text.size(), static_cast<uint32_t>(value.size()), 0 };
+
+	Text.append(value);
+	std::transform(Text.begin() + slot.Offset, Text.end(), Text.begin() + slot.Offset, ToLower);
+
+	if (FreeSlots.empty())
+	{
+		Slots.push_back(slot);
+		return static_cast<uint32_t>(Slots.size() - 1);
+	}
+
+	const uint32_t ret = FreeSlots.back();
+	FreeSlots.pop_back();
+	Slots[ret] = slot;
+
+	return ret;
+}
+
+void PrefixIndex::Table::Relabel() noexcept
+{
+	// Spacing the labels keeps the order of the entries
+	for (size_t i = 0; i < Sources.size(); ++i)
+	{
+		Slots[Sources[i]].Label = (i + 1) * LabelSpacing;
+	}
+}
+
+void PrefixIndex::Table::Compact()
+{
+	std::string text;
+	text.reserve(Text.size() - Garbage);
+
+	for (const uint32_t slot : Sources)
+	{
+		const size_t offset = text.size();
+
+		text.append(Text, Slots[slot].Offset, Slots[slot].Length);
+		Slots[slot].Offset = offset;
+	}
+
+	Text = std::move(text);
+	Garbage = 0;
+}
+
+void PrefixIndex::Table::Sort()
+{
+	// The keys are copied next to the slots so the comparisons don't go through Slots
+	struct Key
+	{
+		size_t Offset;
+		uint32_t Length;
+		uint32_t Slot;
+	};
+
+	std::vector<Key> keys;
+	keys.reserve(Sources.size());
+
+	for (const uint32_t slot : Sources)
+	{
+		keys.push_back({ Slots[slot].Offset, Slots[slot].Length, slot });
+	}
+
+	std::sort(keys.begin(), keys.end(), [this](const Key& a, const Key& b)
+		{
+			const int result = std::string_view(Text.data() + a.Offset, a.Length).compare({ Text.data() + b.Offset, b.Length });
+
+			return result < 0 || (result == 0 && Slots[a.Slot].Label < Slots[b.Slot].Label);
+		});
+
+	Entries.resize(keys.size());
+
+	for (size_t i = 0; i < keys.size(); ++i)
+	{
+		Entries[i] = keys[i].Slot;
+	}
+
+	IsSorted = true;
+}
+
+void PrefixIndex::Table::Insert(size_t index, const std::vector<std::string>& values)
+{
+	auto getStep = [&]()
+		{
+			const uint64_t low = index > 0 ? Slots[Sources[index - 1]].Label : 0;
+			const uint64_t high = index < Sources.size() ? Slots[Sources[index]].Label : UINT64_MAX;
+
+			return std::make_pair(low, (std::min)(LabelSpacing, (high - low) / (values.size() + 1)));
+		};
+
+	auto [low, step] = getStep();
+
+	if (step == 0)
+	{
+		Relabel();
+		std::tie(low, step) = getStep();
+	}
+
+	std::vector<uint32_t> slots;
+	slots.reserve(values.size());
+
+	for (size_t i = 0; i < values.size(); ++i)
+	{
+		slots.push_back(Add(values[i]));
+		Slots[slots.back()].Label = low + step * (i + 1);
+	}
+
+	Sources.insert(Sources.begin() + index, slots.begin(), slots.end());
+
+	if (!IsSorted) return;
+
+	auto isBefore = [this](uint32_t a, uint32_t b) { return IsBefore(a, b); };
+
+	// A few values are placed one by one, many are sorted on their own and merged with the entries
+	if (slots.size() < 16)
+	{
+		for (const uint32_t slot : slots)
+		{
+			Entries.insert(std::upper_bound(Entries.begin(), Entries.end(), slot, isBefore), slot);
+		}
+
+		return;
+	}
+
+	const auto middle = static_cast<std::ptrdiff_t>(Entries.size());
+
+	Entries.insert(Entries.end(), slots.begin(), slots.end());
+	std::sort(Entries.begin() + middle, Entries.end(), isBefore);
+	std::inplace_merge(Entries.begin(), Entries.begin() + middle, Entries.end(), isBefore);
+}
+
+void PrefixIndex::Table::Erase(size_t index, size_t count)
+{
+	auto isBefore = [this](uint32_t a, uint32_t b) { return IsBefore(a, b); };
+	const bool isFew = count < 16;
+
+	for (size_t i = index; i < index + count; ++i)
+	{
+		const uint32_t slot = Sources[i];
+
+		if (IsSorted && isFew)
+		{
+			Entries.erase(std::lower_bound(Entries.begin(), Entries.end(), slot, isBefore));
+		}
+
+		Garbage += Slots[slot].Length;
+		Slots[slot] = {};
+		FreeSlots.push_back(slot);
+	}
+
+	if (IsSorted && !isFew)
+	{
+		std::erase_if(Entries, [this](uint32_t slot) { return Slots[slot].Label == 0; });
+	}
+
+	Sources.erase(Sources.begin() + index, Sources.begin() + index + count);
+
+	if (Garbage > Text.size() / 2)
+	{
+		Compact();
+	}
+}
+
+void PrefixIndex::Table::Update(size_t index, std::string_view value)
+{
+	auto isBefore = [this](uint32_t a, uint32_t b) { return IsBefore(a, b); };
+	const uint32_t slot = Sources[index];
+
+	if (IsSorted)
+	{
+		Entries.erase(std::lower_bound(Entries.begin(), Entries.end(), slot, isBefore));
+	}
+
+	Garbage += Slots[slot].Length;
+	Slots[slot].Offset = Text.size();
+	Slots[slot].Length = static_cast<uint32_t>(value.size());
+	Text.append(value);
+	std::transform(Text.begin() + Slots[slot].Offset, Text.end(), Text.begin() + Slots[slot].Offset, ToLower);
+
+	if (IsSorted)
+	{
+		Entries.insert(std::upper_bound(Entries.begin(), Entries.end(), slot, isBefore), slot);
+	}
+
+	if (Garbage > Text.size() / 2)
+	{
+		Compact();
+	}
+}
+
+size_t PrefixIndex::Table::Find(std::string_view prefix, std::span<size_t> matches) const
+{
+	auto it = std::lower_bound(Entries.begin(), Entries.end(), prefix, [this](uint32_t slot, std::string_view value) { return GetKey(slot) < value; });
+	size_t count = 0;
+
+	for (; it != Entries.end() && count < matches.size() && GetKey(*it).starts_with(prefix); ++it)
+	{
+		matches[count++] = GetIndex(*it);
+	}
+
+	return count;
+}
+
+size_t PrefixIndex::Table::Scan(std::string_view prefix, std::span<size_t> matches) const
+{
+	if (matches.empty()) return 0;
+
+	// Heap of the first matches found so far, the last of them on top
+	auto isBefore = [this](size_t a, size_t b) { return IsBefore(Sources[a], Sources[b]); };
+	std::vector<size_t> best;
+
+	for (size_t i = 0; i < Sources.size(); ++i)
+	{
+		if (!GetKey(Sources[i]).starts_with(prefix)) continue;
+
+		if (best.size() < matches.size())
+		{
+			best.push_back(i);
+			std::push_heap(best.begin(), best.end(), isBefore);
+		}
+		else if (isBefore(i, best.front()))
+		{
+			std::pop_heap(best.begin(), best.end(), isBefore);
+			best.back() = i;
+			std::push_heap(best.begin(), best.end(), isBefore);
+		}
+	}
+
+	std::sort_heap(best.begin(), best.end(), isBefore);
+	std::copy(best.begin(), best.end(), matches.begin());
+
+	return best.size();
+}
+
+std::string PrefixIndex::Normalize(std::string_view value)
+{
+	std::string key(value);
+	std::transform(key.begin(), key.end(), key.begin(), ToLower);
+
+	return key;
+}
+
+PrefixIndex::PrefixIndex() noexcept
+	:
+	m_IsReady(true),
+	m_IsCanceled(false)
+{
+
+}
+
+PrefixIndex::~PrefixIndex()
+{
+	Cancel();
+}
+
+void PrefixIndex::Cancel()
+{
+	if (m_Builder.joinable())
+	{
+		m_IsCanceled = true;
+		m_Builder.join();
+	}
+}
+
+void PrefixIndex::Apply(std::function<void(Table&)> change)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	// During a build the unsorted table is kept up to date for the scans and the change is replayed on the new index
+	change(m_Table);
+
+	if (!m_IsReady)
+	{
+		m_Journal.push_back(std::move(change));
+	}
+}
+
+void PrefixIndex::Build(Table table)
+{
+	Cancel();
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	m_Journal.clear();
+	m_IsCanceled = false;
+	table.Relabel();
+
+	if (table.Sources.size() < BackgroundBuildMinimumCount)
+	{
+		table.Sort();
+		m_Table = std::move(table);
+		m_IsReady = true;
+		return;
+	}
+
+	m_Table = std::move(table);
+	m_IsReady = false;
+	m_Builder = std::thread([this]()
+		{
+			Table table;
+
+			// The table is copied here rather than on the calling thread. The changes made until then are already in it
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+
+				table = m_Table;
+				m_Journal.clear();
+			}
+
+			if (m_IsCanceled) return;
+
+			table.Sort();
+
+			// A build replaced by a new one is dropped
+			if (m_IsCanceled) return;
+
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
+			for (auto& change : m_Journal)
+			{
+				change(table);
+			}
+
+			m_Journal.clear();
+			m_Table = std::move(table);
+			m_IsReady = true;
+		});
+}
+
+void PrefixIndex::Build(const std::vector<std::string>& values)
+{
+	Build(values.size(), [&values](size_t i) -> std::string_view { return values[i]; });
+}
+
+bool PrefixIndex::IsReady() const
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	return m_IsReady;
+}
+
+void PrefixIndex::WaitForBuild()
+{
+	if (m_Builder.joinable())
+	{
+		m_Builder.join();
+	}
+}
+
+void PrefixIndex::Insert(size_t index, const std::vector<std::string>& values)
+{
+	if (values.empty()) return;
+
+	Apply([index, values](Table& table) { table.Insert(index, values); });
+}
+
+void PrefixIndex::Erase(size_t index, size_t count)
+{
+	if (count == 0) return;
+
+	Apply([index, count](Table& table) { table.Erase(index, count); });
+}
+
+void PrefixIndex::Update(size_t index, std::string_view value)
+{
+	Apply([index, value = std::string(value)](Table& table) { table.Update(index, value); });
+}
+
+size_t PrefixIndex::Find(std::string_view prefix, std::span<size_t> matches) const
+{
+	const auto key = Normalize(prefix);
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	return m_IsReady ? m_Table.Find(key, matches) : m_Table.Scan(key, matches);
+}
\ No newline at end of file
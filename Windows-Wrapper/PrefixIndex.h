@@ -0,0 +1,126 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <span>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+/*
+Sorted prefix index over the values of a list, for autocomplete.
+
+Keys are the values in lower case (ASCII only, other bytes are kept as they are) written back to back in a text arena,
+and the entries are sorted by key. The items starting with a prefix are a contiguous run of the entries, so a query is
+a binary search followed by reading the first matches, whatever the number of items.
+
+Entries don't hold source indices, which would all have to be shifted by every insertion or removal. Each item has a
+slot that never changes and a label that grows with its source index (new items take labels in the gap between their
+neighbours, all are spaced again once a gap is used up). The slot of a source index is read from an array in source
+order, and the source index of a slot is the rank of its label in that array.
+
+Large lists are sorted on a background thread. Until the build is done queries are answered by scanning the keys,
+and the changes made in the meantime are recorded and replayed on the new index.
+*/
+class PrefixIndex
+{
+public:
+
+	static constexpr size_t BackgroundBuildMinimumCount = 64 * 1024;
+
+private:
+
+	struct Slot
+	{
+		size_t Offset;
+		uint32_t Length;
+		uint64_t Label;					// 0 when the slot is free
+	};
+
+	struct Table
+	{
+		std::vector<uint32_t> Entries;		// Slots sorted by key, then by label (source order)
+		std::vector<uint32_t> Sources;		// Slot of each source index
+		std::vector<Slot> Slots;
+		std::vector<uint32_t> FreeSlots;
+		std::string Text;					// Every key, back to back
+		size_t Garbage = 0;					// Bytes of Text no key uses anymore
+		bool IsSorted = false;				// Entries are only kept once sorted
+
+		std::string_view GetKey(uint32_t slot) const noexcept;
+		bool IsBefore(uint32_t a, uint32_t b) const noexcept;
+		size_t GetIndex(uint32_t slot) const noexcept;
+		uint32_t Add(std::string_view value);
+		void Relabel() noexcept;
+		void Compact();
+		void Sort();
+		void Insert(size_t index, const std::vector<std::string>& values);
+		void Erase(size_t index, size_t count);
+		void Update(size_t index, std::string_view value);
+		size_t Find(std::string_view prefix, std::span<size_t> matches) const;
+		size_t Scan(std::string_view prefix, std::span<size_t> matches) const;
+	};
+
+	Table m_Table;
+	bool m_IsReady;
+	std::vector<std::function<void(Table&)>> m_Journal;		// Changes made during a background build
+	std::thread m_Builder;
+	std::atomic<bool> m_IsCanceled;
+	mutable std::mutex m_Mutex;
+
+	static std::string Normalize(std::string_view value);
+
+	void Cancel();
+	void Apply(std::function<void(Table&)> change);
+	void Build(Table table);
+
+public:
+
+	PrefixIndex() noexcept;
+	PrefixIndex(const PrefixIndex&) = delete;
+	PrefixIndex& operator=(const PrefixIndex&) = delete;
+	~PrefixIndex();
+
+	// Replaces the indexed values. getValue(i) gives the value of the item i, it's only called before Build returns
+	// (the keys are written in a single arena, the values aren't copied). Returns once the keys are written when the
+	// index is sorted in the background
+	template<typename F>
+	void Build(size_t count, F&& getValue)
+	{
+		Table table;
+		size_t length = 0;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			length += std::string_view(getValue(i)).size();
+		}
+
+		table.Text.reserve(length);
+		table.Sources.reserve(count);
+		table.Slots.reserve(count);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			table.Sources.push_back(table.Add(getValue(i)));
+		}
+
+		Build(std::move(table));
+	}
+
+	void Build(const std::vector<std::string>& values);
+	bool IsReady() const;
+	void WaitForBuild();
+
+	// Must be called when values are inserted, removed or changed in the source
+	void Insert(size_t index, const std::vector<std::string>& values);
+	void Erase(size_t index, size_t count);
+	void Update(size_t index, std::string_view value);
+
+	// Fills matches with the source indices of the first values (in alphabetical order) starting with the prefix,
+	// ignoring the case. Returns the number of matches written
+	size_t Find(std::string_view prefix, std::span<size_t> matches) const;
+};
\ No newline at end of file
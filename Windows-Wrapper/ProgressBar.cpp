@@ -36,8 +36,7 @@ void ProgressBar::Draw(Graphics* const graphics, Drawing::Rectangle rectangle)
 
 		char buff[100];
 		wsprintf(buff, "%d%% Finished", m_Value);
-		SIZE size;
-		GetTextExtentPoint32(hdcMem, buff, ::lstrlen(buff), &size);
+		const auto size = MeasureText(buff);
 
 		// Draw the value amount region
 		LONG right = rt.right;
@@ -53,7 +52,7 @@ void ProgressBar::Draw(Graphics* const graphics, Drawing::Rectangle rectangle)
 
 			SetTextColor(hdcMem, RGB(m_ForeColor.GetR(), m_ForeColor.GetG(), m_ForeColor.GetB()));
 			SetBkColor(hdcMem, RGB(m_BackgroundColor.GetR(), m_BackgroundColor.GetG(), m_BackgroundColor.GetB()));
-			ExtTextOut(hdcMem, (right - size.cx) / 2, (rt.bottom - size.cy) / 2, ETO_CLIPPED | ETO_OPAQUE, &rt, buff, lstrlen(buff), NULL);
+			ExtTextOut(hdcMem, (right - size.Width) / 2, (rt.bottom - size.Height) / 2, ETO_CLIPPED | ETO_OPAQUE, &rt, buff, lstrlen(buff), NULL);
 		}
 
 		// Draw the remaining amount region
@@ -63,7 +62,7 @@ void ProgressBar::Draw(Graphics* const graphics, Drawing::Rectangle rectangle)
 			SetBkColor(hdcMem, RGB(230, 230, 230));
 			rt.left = rt.right;
 			rt.right = right;
-			ExtTextOut(hdcMem, (right - size.cx) / 2, (rt.bottom - size.cy) / 2, ETO_CLIPPED | ETO_OPAQUE, &rt, buff, lstrlen(buff), NULL);
+			ExtTextOut(hdcMem, (right - size.Width) / 2, (rt.bottom - size.Height) / 2, ETO_CLIPPED | ETO_OPAQUE, &rt, buff, lstrlen(buff), NULL);
 		}
 
 		break;
@@ -269,8 +268,8 @@ void ProgressBar::Initialize()
 		throw CTL_LAST_EXCEPT();
 	}
 
-	m_BackgroundColor = Color(75, 154, 255);
-	m_ForeColor = Color::Foreground();
+	m_LocalBackgroundColor.SetDefault(Color(75, 154, 255));
+	m_LocalForeColor.SetDefault(Color::Foreground());
 	DisableTabStop();
 }
 
@@ -2,11 +2,14 @@
 
 #include "Point.h"
 #include "Size.h"
-#include "RectangleF.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
 
 namespace Drawing
 {
-	struct Rectangle : public IEquatable<Drawing::Rectangle>
+	struct Rectangle
 	{
 	public:
 
@@ -103,15 +106,28 @@ namespace Drawing
 			return Rectangle(x1, y1, x2 - x1, y2 - y1);
 		}
 
-		static constexpr Rectangle Ceiling(RectangleF r) noexcept { return Rectangle(static_cast<int>(std::ceil(r.X)), static_cast<int>(std::ceil(r.Y)), static_cast<int>(std::ceil(r.Width)), static_cast<int>(std::ceil(r.Height))); }
-		static constexpr Rectangle Truncate(RectangleF r) noexcept { return Rectangle(static_cast<int>(r.X), static_cast<int>(r.Y), static_cast<int>(r.Width), static_cast<int>(r.Height)); }
-		static constexpr Rectangle Round(RectangleF r) noexcept { return Rectangle(static_cast<int>(std::round(r.X)), static_cast<int>(std::round(r.Y)), static_cast<int>(std::round(r.Width)), static_cast<int>(std::round(r.Height))); }
+		// From a RectangleF, or any rectangle of floats
+		template<typename T>
+		static constexpr Rectangle Ceiling(const T& r) noexcept { return Rectangle(static_cast<int>(std::ceil(r.X)), static_cast<int>(std::ceil(r.Y)), static_cast<int>(std::ceil(r.Width)), static_cast<int>(std::ceil(r.Height))); }
+		template<typename T>
+		static constexpr Rectangle Truncate(const T& r) noexcept { return Rectangle(static_cast<int>(r.X), static_cast<int>(r.Y), static_cast<int>(r.Width), static_cast<int>(r.Height)); }
+		template<typename T>
+		static constexpr Rectangle Round(const T& r) noexcept { return Rectangle(static_cast<int>(std::round(r.X)), static_cast<int>(std::round(r.Y)), static_cast<int>(std::round(r.Width)), static_cast<int>(std::round(r.Height))); }
 
-		int GetHashCode() const override;
-		bool Equals(const Object* const obj) const override;
-		bool Equals(const Rectangle* const b) const override;
-		const std::string ToString() const noexcept override;
+		constexpr int GetHashCode() const noexcept
+		{
+			return ((int)((uint32_t)X ^
+				(((uint32_t)Y << 13) | ((uint32_t)Y >> 19)) ^
+				(((uint32_t)Width << 26) | ((uint32_t)Width >> 6)) ^
+				(((uint32_t)Height << 7) | ((uint32_t)Height >> 25))));
+		}
+
+		constexpr bool Equals(const Rectangle* const b) const noexcept { return b != nullptr && *this == *b; }
+		const std::string ToString() const noexcept;
 
 		static constexpr Rectangle Empty() { return Rectangle(0, 0, 0, 0); }
 	};
+
+	static_assert(EquatableValue<Rectangle>);
+	static_assert(sizeof(Rectangle) == 4 * sizeof(int), "Rectangle must stay four packed integers");
 }
\ No newline at end of file
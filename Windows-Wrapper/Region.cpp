@@ -0,0 +1,321 @@
+#include "Region.h"
+
+#include <limits>
+
+namespace Drawing
+{
+	void Region::AppendBand(int top, int bottom, const std::vector<Span>& spans)
+	{
+		if (spans.empty() || top >= bottom) return;
+
+		// Coalesce with the previous band when it touches this one and has exactly the same spans
+		if (!m_Bands.empty())
+		{
+			auto& last = m_Bands.back();
+
+			if (last.Bottom == top && last.Count == spans.size() && std::equal(spans.begin(), spans.end(), m_Spans.begin() + last.First))
+			{
+				last.Bottom = bottom;
+				return;
+			}
+		}
+
+		m_Bands.push_back({ top, bottom, m_Spans.size(), spans.size() });
+		m_Spans.insert(m_Spans.end(), spans.begin(), spans.end());
+	}
+
+	void Region::CombineSpans(const Span* a, size_t aCount, const Span* b, size_t bCount, Operation op, std::vector<Span>& result)
+	{
+		result.clear();
+
+		// Sweep every x boundary of both span lists (Left and Right of each span) tracking if the current
+		// position is inside a and/or b. Boundaries at the same x are consumed together so touching spans are merged.
+		constexpr int Infinite = (std::numeric_limits<int>::max)();
+		const size_t aBoundaries = aCount * 2;
+		const size_t bBoundaries = bCount * 2;
+		size_t i = 0;
+		size_t j = 0;
+		bool inA = false;
+		bool inB = false;
+		bool open = false;
+		int start = 0;
+
+		while (i < aBoundaries || j < bBoundaries)
+		{
+			const int ax = i < aBoundaries ? ((i & 1) == 0 ? a[i >> 1].Left : a[i >> 1].Right) : Infinite;
+			const int bx = j < bBoundaries ? ((j & 1) == 0 ? b[j >> 1].Left : b[j >> 1].Right) : Infinite;
+			const int x = (std::min)(ax, bx);
+
+			while (i < aBoundaries && ((i & 1) == 0 ? a[i >> 1].Left : a[i >> 1].Right) == x)
+			{
+				inA = !inA;
+				++i;
+			}
+
+			while (j < bBoundaries && ((j & 1) == 0 ? b[j >> 1].Left : b[j >> 1].Right) == x)
+			{
+				inB = !inB;
+				++j;
+			}
+
+			bool inside = false;
+			switch (op)
+			{
+				case Operation::Union: inside = inA || inB; break;
+				case Operation::Intersect: inside = inA && inB; break;
+				case Operation::Subtract: inside = inA && !inB; break;
+			}
+
+			if (inside && !open)
+			{
+				start = x;
+				open = true;
+			}
+			else if (!inside && open)
+			{
+				result.push_back({ start, x });
+				open = false;
+			}
+		}
+	}
+
+	Region Region::Combine(const Region& a, const Region& b, Operation op)
+	{
+		Region ret;
+		std::vector<Span> spans;
+
+		constexpr int Infinite = (std::numeric_limits<int>::max)();
+		const size_t aCount = a.m_Bands.size();
+		const size_t bCount = b.m_Bands.size();
+		size_t i = 0;
+		size_t j = 0;
+
+		int y = (std::min)(aCount > 0 ? a.m_Bands.front().Top : Infinite, bCount > 0 ? b.m_Bands.front().Top : Infinite);
+
+		// Walk both band lists at once. Each iteration produces the slab [y, bottom) where neither region
+		// changes its spans, so the result spans of the slab only depend on the two current bands.
+		while (true)
+		{
+			while (i < aCount && a.m_Bands[i].Bottom <= y) ++i;
+			while (j < bCount && b.m_Bands[j].Bottom <= y) ++j;
+
+			if (i == aCount && j == bCount) break;
+
+			// Nothing else can be produced once the left operand is over (or the right one for intersections)
+			if (op != Operation::Union && i == aCount) break;
+			if (op == Operation::Intersect && j == bCount) break;
+
+			const bool inA = i < aCount && a.m_Bands[i].Top <= y;
+			const bool inB = j < bCount && b.m_Bands[j].Top <= y;
+
+			if (!inA && !inB)
+			{
+				// Skip the vertical gap up to the next band
+				y = (std::min)(i < aCount ? a.m_Bands[i].Top : Infinite, j < bCount ? b.m_Bands[j].Top : Infinite);
+				continue;
+			}
+
+			int bottom = Infinite;
+			if (i < aCount) bottom = (std::min)(bottom, inA ? a.m_Bands[i].Bottom : a.m_Bands[i].Top);
+			if (j < bCount) bottom = (std::min)(bottom, inB ? b.m_Bands[j].Bottom : b.m_Bands[j].Top);
+
+			CombineSpans(
+				inA ? &a.m_Spans[a.m_Bands[i].First] : nullptr, inA ? a.m_Bands[i].Count : 0,
+				inB ? &b.m_Spans[b.m_Bands[j].First] : nullptr, inB ? b.m_Bands[j].Count : 0,
+				op, spans);
+
+			ret.AppendBand(y, bottom, spans);
+			y = bottom;
+		}
+
+		return ret;
+	}
+
+	Region::Region(int x, int y, int width, int height)
+	{
+		if (width <= 0 || height <= 0) return;
+
+		m_Bands.push_back({ y, y + height, 0, 1 });
+		m_Spans.push_back({ x, x + width });
+	}
+
+	bool Region::operator==(const Region& r) const noexcept
+	{
+		if (m_Bands.size() != r.m_Bands.size() || m_Spans != r.m_Spans) return false;
+
+		for (size_t i = 0; i < m_Bands.size(); ++i)
+		{
+			if (m_Bands[i].Top != r.m_Bands[i].Top || m_Bands[i].Bottom != r.m_Bands[i].Bottom || m_Bands[i].Count != r.m_Bands[i].Count)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool Region::IsEmpty() const noexcept
+	{
+		return m_Bands.empty();
+	}
+
+	void Region::MakeEmpty() noexcept
+	{
+		m_Bands.clear();
+		m_Spans.clear();
+	}
+
+	bool Region::Contains(int x, int y) const noexcept
+	{
+		const auto band = std::partition_point(m_Bands.begin(), m_Bands.end(), [&](const Band& b) { return b.Bottom <= y; });
+
+		if (band == m_Bands.end() || band->Top > y) return false;
+
+		const auto first = m_Spans.begin() + band->First;
+		const auto last = first + band->Count;
+		const auto span = std::partition_point(first, last, [&](const Span& s) { return s.Right <= x; });
+
+		return span != last && span->Left <= x;
+	}
+
+	bool Region::IntersectsWith(int x, int y, int width, int height) const noexcept
+	{
+		if (width <= 0 || height <= 0) return false;
+
+		auto band = std::partition_point(m_Bands.begin(), m_Bands.end(), [&](const Band& b) { return b.Bottom <= y; });
+
+		for (; band != m_Bands.end() && band->Top < y + height; ++band)
+		{
+			const auto first = m_Spans.begin() + band->First;
+			const auto last = first + band->Count;
+			const auto span = std::partition_point(first, last, [&](const Span& s) { return s.Right <= x; });
+
+			if (span != last && span->Left < x + width) return true;
+		}
+
+		return false;
+	}
+
+	size_t Region::GetBandCount() const noexcept
+	{
+		return m_Bands.size();
+	}
+
+	size_t Region::GetRectangleCount() const noexcept
+	{
+		return m_Spans.size();
+	}
+
+	void Region::Offset(int x, int y) noexcept
+	{
+		for (auto& b : m_Bands)
+		{
+			b.Top += y;
+			b.Bottom += y;
+		}
+
+		for (auto& s : m_Spans)
+		{
+			s.Left += x;
+			s.Right += x;
+		}
+	}
+
+	void Region::Union(const Region& region)
+	{
+		if (region.IsEmpty()) return;
+
+		if (IsEmpty())
+		{
+			*this = region;
+			return;
+		}
+
+		*this = Combine(*this, region, Operation::Union);
+	}
+
+	void Region::Intersect(const Region& region)
+	{
+		if (IsEmpty()) return;
+
+		if (region.IsEmpty())
+		{
+			MakeEmpty();
+			return;
+		}
+
+		*this = Combine(*this, region, Operation::Intersect);
+	}
+
+	void Region::Subtract(const Region& region)
+	{
+		if (IsEmpty() || region.IsEmpty()) return;
+
+		*this = Combine(*this, region, Operation::Subtract);
+	}
+
+	void Region::Simplify(size_t maximumRectangles)
+	{
+		if (maximumRectangles == 0) maximumRectangles = 1;
+		if (GetRectangleCount() <= maximumRectangles) return;
+
+		// First pass: each band becomes its horizontal hull. Bands which end up with the same hull are coalesced.
+		Region hull;
+		std::vector<Span> spans(1);
+
+		for (const auto& b : m_Bands)
+		{
+			spans[0] = { m_Spans[b.First].Left, m_Spans[b.First + b.Count - 1].Right };
+			hull.AppendBand(b.Top, b.Bottom, spans);
+		}
+
+		// Second pass: if there are still too many bands, split them in maximumRectangles groups of consecutive
+		// bands and replace each group by its bounding box
+		if (hull.m_Bands.size() > maximumRectangles)
+		{
+			Region grouped;
+			const size_t count = hull.m_Bands.size();
+			const size_t groupSize = (count + maximumRectangles - 1) / maximumRectangles;
+
+			for (size_t first = 0; first < count; first += groupSize)
+			{
+				const size_t last = (std::min)(first + groupSize, count);
+
+				spans[0] = hull.m_Spans[hull.m_Bands[first].First];
+				for (size_t i = first + 1; i < last; ++i)
+				{
+					const auto& s = hull.m_Spans[hull.m_Bands[i].First];
+					spans[0].Left = (std::min)(spans[0].Left, s.Left);
+					spans[0].Right = (std::max)(spans[0].Right, s.Right);
+				}
+
+				grouped.AppendBand(hull.m_Bands[first].Top, hull.m_Bands[last - 1].Bottom, spans);
+			}
+
+			hull = std::move(grouped);
+		}
+
+		*this = std::move(hull);
+	}
+
+	Region Region::Union(const Region& lhs, const Region& rhs)
+	{
+		Region ret = lhs;
+		ret.Union(rhs);
+		return ret;
+	}
+
+	Region Region::Intersect(const Region& lhs, const Region& rhs)
+	{
+		Region ret = lhs;
+		ret.Intersect(rhs);
+		return ret;
+	}
+
+	Region Region::Subtract(const Region& lhs, const Region& rhs)
+	{
+		Region ret = lhs;
+		ret.Subtract(rhs);
+		return ret;
+	}
+}
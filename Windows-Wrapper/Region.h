@@ -0,0 +1,156 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+
+namespace Drawing
+{
+	// Any rectangle type exposing X, Y, Width and Height (Drawing::Rectangle, RectangleF, etc...)
+	template<typename T>
+	concept RectangleLike = requires(const T& r)
+	{
+		{ r.X } -> std::convertible_to<int>;
+		{ r.Y } -> std::convertible_to<int>;
+		{ r.Width } -> std::convertible_to<int>;
+		{ r.Height } -> std::convertible_to<int>;
+	};
+
+	/*
+	Y-banded region (same representation used by X11 and pixman).
+	The area is split in horizontal bands sorted from top to bottom and each band holds a sorted list of non
+	overlapping [Left, Right) spans. Two bands never overlap and vertically adjacent bands with the same spans are
+	always coalesced, so the representation is canonical and two equal areas always have the same bands.
+
+		Rectangles:			Bands:
+
+		+-----+				+-----+			Band 0: [0, 6)
+		|  +--+--+			+-----+--+		Band 1: [0, 9)
+		+--+--+  |			   +-----+		Band 2: [3, 9)
+		   +-----+
+	*/
+	class Region
+	{
+	public:
+
+		struct Span
+		{
+			int Left;
+			int Right;
+
+			constexpr bool operator==(const Span& s) const noexcept { return Left == s.Left && Right == s.Right; }
+		};
+
+		struct Band
+		{
+			int Top;
+			int Bottom;
+			size_t First;	// Index of the first span of the band inside m_Spans
+			size_t Count;	// Number of spans of the band
+		};
+
+	private:
+
+		enum class Operation
+		{
+			Union,
+			Intersect,
+			Subtract,
+		};
+
+		std::vector<Band> m_Bands;
+		std::vector<Span> m_Spans;
+
+		void AppendBand(int top, int bottom, const std::vector<Span>& spans);
+		static void CombineSpans(const Span* a, size_t aCount, const Span* b, size_t bCount, Operation op, std::vector<Span>& result);
+		static Region Combine(const Region& a, const Region& b, Operation op);
+
+	public:
+
+		Region() = default;
+		Region(int x, int y, int width, int height);
+
+		template<RectangleLike T>
+		Region(const T& rectangle)
+			:
+			Region(static_cast<int>(rectangle.X), static_cast<int>(rectangle.Y), static_cast<int>(rectangle.Width), static_cast<int>(rectangle.Height))
+		{
+
+		}
+
+		bool operator==(const Region& r) const noexcept;
+
+		bool IsEmpty() const noexcept;
+		void MakeEmpty() noexcept;
+		bool Contains(int x, int y) const noexcept;
+		bool IntersectsWith(int x, int y, int width, int height) const noexcept;
+		size_t GetBandCount() const noexcept;
+		size_t GetRectangleCount() const noexcept;
+		void Offset(int x, int y) noexcept;
+
+		void Union(const Region& region);
+		void Intersect(const Region& region);
+		void Subtract(const Region& region);
+
+		// Reduces the region to at most maximumRectangles rectangles covering (at least) the same area.
+		// Used by the paint path to avoid issuing hundreds of tiny blits when the damage gets too fragmented.
+		void Simplify(size_t maximumRectangles);
+
+		template<RectangleLike T>
+		void Union(const T& rectangle) { Union(Region(rectangle)); }
+
+		template<RectangleLike T>
+		void Intersect(const T& rectangle) { Intersect(Region(rectangle)); }
+
+		template<RectangleLike T>
+		void Subtract(const T& rectangle) { Subtract(Region(rectangle)); }
+
+		template<RectangleLike T>
+		bool IntersectsWith(const T& r) const noexcept { return IntersectsWith(static_cast<int>(r.X), static_cast<int>(r.Y), static_cast<int>(r.Width), static_cast<int>(r.Height)); }
+
+		// Bounding box of the whole region. Returns T(0, 0, 0, 0) when the region is empty
+		template<typename T>
+		T GetBounds() const
+		{
+			if (IsEmpty()) return T(0, 0, 0, 0);
+
+			int left = m_Spans[m_Bands.front().First].Left;
+			int right = m_Spans[m_Bands.front().First + m_Bands.front().Count - 1].Right;
+
+			for (const auto& b : m_Bands)
+			{
+				left = (std::min)(left, m_Spans[b.First].Left);
+				right = (std::max)(right, m_Spans[b.First + b.Count - 1].Right);
+			}
+
+			return T(left, m_Bands.front().Top, right - left, m_Bands.back().Bottom - m_Bands.front().Top);
+		}
+
+		// Calls function(x, y, width, height) for each rectangle of the region, from top to bottom and left to right
+		template<typename F>
+		void ForEach(F&& function) const
+		{
+			for (const auto& b : m_Bands)
+			{
+				for (size_t i = b.First; i < b.First + b.Count; ++i)
+				{
+					function(m_Spans[i].Left, b.Top, m_Spans[i].Right - m_Spans[i].Left, b.Bottom - b.Top);
+				}
+			}
+		}
+
+		template<typename T>
+		std::vector<T> GetRectangles() const
+		{
+			std::vector<T> ret;
+			ret.reserve(GetRectangleCount());
+			ForEach([&](int x, int y, int width, int height) { ret.emplace_back(x, y, width, height); });
+			return ret;
+		}
+
+		static Region Union(const Region& lhs, const Region& rhs);
+		static Region Intersect(const Region& lhs, const Region& rhs);
+		static Region Subtract(const Region& lhs, const Region& rhs);
+	};
+}
\ No newline at end of file
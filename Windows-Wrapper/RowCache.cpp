@@ -0,0 +1,170 @@
+#include "RowCache.h"
+
+#include <iterator>
+
+bool RowCache::Key::operator==(const Key& other) const noexcept
+{
+	return Item == other.Item && State == other.State && Font == other.Font && Width == other.Width && Height == other.Height;
+}
+
+size_t RowCache::KeyHash::operator()(const Key& key) const noexcept
+{
+	uint64_t hash = key.Item * 0x9E3779B97F4A7C15ull;
+
+	hash ^= key.State + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+	hash ^= key.Font + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+	hash ^= (static_cast<uint64_t>(static_cast<uint32_t>(key.Width)) << 32 | static_cast<uint32_t>(key.Height)) + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+
+	return static_cast<size_t>(hash);
+}
+
+RowCache::RowCache(size_t budget)
+	:
+	m_Budget(budget),
+	m_PixelCount(0)
+{
+
+}
+
+void RowCache::Remove(std::list<Entry>::iterator it)
+{
+	m_PixelCount -= it->second.Pixels.size();
+	m_Index.erase(it->first);
+
+	if (it->second.Pixels.capacity() > m_Spare.capacity())
+	{
+		m_Spare = std::move(it->second.Pixels);
+	}
+
+	m_Entries.erase(it);
+}
+
+void RowCache::Evict(size_t budget)
+{
+	while (!m_Entries.empty() && m_PixelCount > budget)
+	{
+		Remove(std::prev(m_Entries.end()));
+	}
+}
+
+void RowCache::Reindex()
+{
+	m_Index.clear();
+
+	for (auto it = m_Entries.begin(); it != m_Entries.end(); ++it)
+	{
+		m_Index.emplace(it->first, it);
+	}
+}
+
+size_t RowCache::GetBudget() const noexcept
+{
+	return m_Budget;
+}
+
+void RowCache::SetBudget(size_t pixels)
+{
+	m_Budget = pixels;
+	Evict(m_Budget);
+
+	if (m_Budget == 0) m_Spare = {};
+}
+
+size_t RowCache::GetPixelCount() const noexcept
+{
+	return m_PixelCount;
+}
+
+size_t RowCache::GetCount() const noexcept
+{
+	return m_Entries.size();
+}
+
+const RowCache::Surface* RowCache::Find(const Key& key)
+{
+	const auto it = m_Index.find(key);
+
+	if (it == m_Index.end()) return nullptr;
+
+	m_Entries.splice(m_Entries.begin(), m_Entries, it->second);
+
+	return &it->second->second;
+}
+
+RowCache::Surface* RowCache::Add(const Key& key)
+{
+	if (key.Width <= 0 || key.Height <= 0) return nullptr;
+
+	const size_t pixels = static_cast<size_t>(key.Width) * static_cast<size_t>(key.Height);
+
+	if (pixels > m_Budget) return nullptr;
+
+	if (const auto it = m_Index.find(key); it != m_Index.end())
+	{
+		Remove(it->second);
+	}
+
+	Evict(m_Budget - pixels);
+
+	std::vector<uint32_t> buffer = std::move(m_Spare);
+	buffer.resize(pixels);
+	m_Spare = {};
+
+	m_Entries.push_front({ key, Surface{ key.Width, key.Height, std::move(buffer) } });
+	m_Index.emplace(key, m_Entries.begin());
+	m_PixelCount += pixels;
+
+	return &m_Entries.front().second;
+}
+
+void RowCache::Invalidate(size_t item)
+{
+	for (auto it = m_Entries.begin(); it != m_Entries.end();)
+	{
+		const auto next = std::next(it);
+
+		if (it->first.Item == item) Remove(it);
+
+		it = next;
+	}
+}
+
+void RowCache::OnInsert(size_t index, size_t count)
+{
+	if (count == 0 || m_Entries.empty()) return;
+
+	for (auto& entry : m_Entries)
+	{
+		if (entry.first.Item >= index) entry.first.Item += count;
+	}
+
+	Reindex();
+}
+
+void RowCache::OnErase(size_t index, size_t count)
+{
+	if (count == 0 || m_Entries.empty()) return;
+
+	for (auto it = m_Entries.begin(); it != m_Entries.end();)
+	{
+		const auto next = std::next(it);
+
+		if (it->first.Item >= index && it->first.Item < index + count) Remove(it);
+
+		it = next;
+	}
+
+	for (auto& entry : m_Entries)
+	{
+		if (entry.first.Item >= index + count) entry.first.Item -= count;
+	}
+
+	Reindex();
+}
+
+void RowCache::Clear() noexcept
+{
+	m_Entries.clear();
+	m_Index.clear();
+	m_PixelCount = 0;
+}
\ No newline at end of file
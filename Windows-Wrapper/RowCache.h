@@ -0,0 +1,85 @@
+#pragma once
+
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+/*
+Rendered rows of a list control, kept as software surfaces (32 bits pixels, top-down) to be copied instead of drawn again.
+
+A row is keyed by its item, its visual state (selection, focus, colors...), its font and its size, so a paint only renders
+the rows whose key changed and copies the others. The cache holds at most a budget of pixels: the least recently used rows are
+evicted first and their pixels are recycled for the new ones.
+
+Items are identified by their index in the data source. Inserted and removed items shift the keys of the rows after
+them instead of emptying the cache.
+*/
+class RowCache
+{
+public:
+
+	static constexpr size_t DefaultBudget = 1024 * 1024;
+
+	struct Key
+	{
+		size_t Item;
+		uint64_t State;
+		uint64_t Font;			// Version of the font the row is drawn with
+		int Width;
+		int Height;
+
+		bool operator==(const Key& other) const noexcept;
+	};
+
+	struct Surface
+	{
+		int Width;
+		int Height;
+		std::vector<uint32_t> Pixels;
+	};
+
+private:
+
+	struct KeyHash
+	{
+		size_t operator()(const Key& key) const noexcept;
+	};
+
+	using Entry = std::pair<Key, Surface>;
+
+	size_t m_Budget;
+	size_t m_PixelCount;
+	std::list<Entry> m_Entries;		// Most recently used first
+	std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> m_Index;
+	std::vector<uint32_t> m_Spare;	// Pixels of the last evicted row, reused by the next one
+
+	void Remove(std::list<Entry>::iterator it);
+	void Evict(size_t budget);
+	void Reindex();
+
+public:
+
+	explicit RowCache(size_t budget = DefaultBudget);
+
+	// A budget of 0 disables the cache
+	size_t GetBudget() const noexcept;
+	void SetBudget(size_t pixels);
+	size_t GetPixelCount() const noexcept;
+	size_t GetCount() const noexcept;
+
+	// Rendered row, marked as the most recently used (nullptr when it's not cached)
+	const Surface* Find(const Key& key);
+
+	// Surface of the size of the key to render the row in, its pixels are undefined. Returns nullptr when the row
+	// doesn't fit in the budget
+	Surface* Add(const Key& key);
+
+	// Must be called when an item changes, is inserted or removed
+	void Invalidate(size_t item);
+	void OnInsert(size_t index, size_t count);
+	void OnErase(size_t index, size_t count);
+
+	void Clear() noexcept;
+};
\ No newline at end of file
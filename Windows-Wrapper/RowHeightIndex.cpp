@@ -0,0 +1,142 @@
+#include "RowHeightIndex.h"
+
+#include <algorithm>
+#include <bit>
+
+RowHeightIndex::RowHeightIndex() noexcept
+	:
+	m_Total(0)
+{
+
+}
+
+void RowHeightIndex::Build()
+{
+	// Each node adds itself to its parent once, so the tree is built in O(n)
+	m_Tree.assign(m_Heights.size() + 1, 0);
+	m_Total = 0;
+
+	for (size_t i = 1; i < m_Tree.size(); ++i)
+	{
+		m_Tree[i] += m_Heights[i - 1];
+		m_Total += m_Heights[i - 1];
+
+		const size_t parent = i + (i & (~i + 1));
+
+		if (parent < m_Tree.size())
+		{
+			m_Tree[parent] += m_Tree[i];
+		}
+	}
+}
+
+void RowHeightIndex::Reset(std::vector<int> heights)
+{
+	m_Heights = std::move(heights);
+	Build();
+}
+
+size_t RowHeightIndex::GetCount() const noexcept
+{
+	return m_Heights.size();
+}
+
+int RowHeightIndex::GetHeight(size_t row) const noexcept
+{
+	return m_Heights[row];
+}
+
+void RowHeightIndex::SetHeight(size_t row, int height)
+{
+	const long long delta = static_cast<long long>(height) - m_Heights[row];
+
+	m_Heights[row] = height;
+	m_Total += delta;
+
+	for (size_t i = row + 1; i < m_Tree.size(); i += i & (~i + 1))
+	{
+		m_Tree[i] += delta;
+	}
+}
+
+long long RowHeightIndex::GetOffset(size_t row) const noexcept
+{
+	long long offset = 0;
+
+	for (size_t i = row; i > 0; i -= i & (~i + 1))
+	{
+		offset += m_Tree[i];
+	}
+
+	return offset;
+}
+
+long long RowHeightIndex::GetTotal() const noexcept
+{
+	return m_Total;
+}
+
+size_t RowHeightIndex::GetRow(long long offset) const noexcept
+{
+	if (offset < 0) return 0;
+
+	// Walks down the tree from the largest node, skipping every node ending at or before the offset
+	size_t row = 0;
+
+	for (size_t step = std::bit_floor(m_Heights.size()); step > 0; step >>= 1)
+	{
+		if (row + step < m_Tree.size() && m_Tree[row + step] <= offset)
+		{
+			row += step;
+			offset -= m_Tree[row];
+		}
+	}
+
+	return row;
+}
+
+void RowHeightIndex::Insert(size_t row, const std::vector<int>& heights)
+{
+	if (heights.empty()) return;
+
+	m_Heights.insert(m_Heights.begin() + row, heights.begin(), heights.end());
+	Build();
+}
+
+void RowHeightIndex::Erase(size_t row, size_t count)
+{
+	if (count == 0) return;
+
+	m_Heights.erase(m_Heights.begin() + row, m_Heights.begin() + row + count);
+	Build();
+}
+
+void RowHeightIndex::Move(size_t from, size_t to)
+{
+	if (from == to) return;
+
+	const size_t first = (std::min)(from, to);
+	const size_t last = (std::max)(from, to) + 1;
+
+	// Each row updated in the tree costs O(log n), a far move builds it again
+	if (last - first > m_Heights.size() / 64)
+	{
+		const auto begin = m_Heights.begin();
+
+		if (from < to) std::rotate(begin + first, begin + first + 1, begin + last);
+		else std::rotate(begin + first, begin + last - 1, begin + last);
+
+		Build();
+		return;
+	}
+
+	std::vector<int> heights(m_Heights.begin() + first, m_Heights.begin() + last);
+
+	if (from < to) std::rotate(heights.begin(), heights.begin() + 1, heights.end());
+	else std::rotate(heights.begin(), heights.end() - 1, heights.end());
+
+	for (size_t i = 0; i < heights.size(); ++i)
+	{
+		SetHeight(first + i, heights[i]);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+/*
+Heights of the rows of a list with variable row heights, indexed by a Fenwick tree.
+
+Each node of the tree holds the sum of the heights of a power of two of rows, so the top of a row (the sum of the
+heights before it), the row under a pixel offset and changing the height of a row are O(log n) instead of a prefix
+array rebuilt on each change. Inserting or removing rows shifts the heights after them and builds the tree again in
+O(n), moving a row only updates the rows between its two places when there are few of them.
+*/
+class RowHeightIndex
+{
+private:
+
+	std::vector<int> m_Heights;
+	std::vector<long long> m_Tree;		// 1-based, node i sums the heights of the rows (i - lowest bit of i, i]
+	long long m_Total;
+
+	void Build();
+
+public:
+
+	RowHeightIndex() noexcept;
+
+	void Reset(std::vector<int> heights);
+
+	size_t GetCount() const noexcept;
+	int GetHeight(size_t row) const noexcept;
+	void SetHeight(size_t row, int height);
+
+	// Top of the row from the top of the first one. The count gives the total height
+	long long GetOffset(size_t row) const noexcept;
+	long long GetTotal() const noexcept;
+
+	// Row covering the offset (the count when it's past the last row)
+	size_t GetRow(long long offset) const noexcept;
+
+	void Insert(size_t row, const std::vector<int>& heights);
+	void Erase(size_t row, size_t count);
+
+	// The row takes the place to, the rows between shift by one
+	void Move(size_t from, size_t to);
+};
\ No newline at end of file
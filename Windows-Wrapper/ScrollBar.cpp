@@ -13,7 +13,8 @@ ScrollBar::ScrollBar(ScrollableControl* parent, int width, int height, int x, in
 	Scrolling(0),
 	MaximumValue(100)
 {
-	// ScrollBar Initialize() is called from the control which handles it
+	// ScrollBar Initialize() is called from the control which handles it, the tab order must not wait for it
+	DisableTabStop();
 }
 
 ScrollBar::~ScrollBar()
@@ -41,8 +42,6 @@ void ScrollBar::Initialize()
 	{
 		throw CTL_LAST_EXCEPT();
 	}
-
-	DisableTabStop();
 }
 
 int ScrollBar::GetScrolling() const noexcept
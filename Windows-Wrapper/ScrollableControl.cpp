@@ -20,6 +20,13 @@ void ScrollableControl::SetMinimumItemWidth(const int& weight) noexcept
 	m_MinimumItemWidth = weight;
 }
 
+// Size of a single character with the current font, used as the minimum item width and the item height.
+// The former GetTextExtentPoint32 calls passed a length of 2 for "A" (so the terminator was measured too)
+TextExtent ScrollableControl::MeasureItemSample() const
+{
+	return MeasureText("A");
+}
+
 ScrollableControl::ScrollableControl(Control* parent, const std::string& name, int width, int height, int x, int y)
 	:
 	Control(parent, name, width, height, x, y),
@@ -27,6 +27,7 @@ protected:
 	void SetMinimumItemWidth(const int& weight) noexcept;
 	LPRECT const GetDrawableArea() noexcept;
 	LPRECT const ResetDrawableArea() noexcept;
+	TextExtent MeasureItemSample() const;
 
 	ScrollableControl(Control* parent, const std::string& name, int width, int height, int x, int y);
 	virtual ~ScrollableControl();
@@ -0,0 +1,190 @@
+#include "SelectionModel.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+SelectionModel::SelectionModel() noexcept
+	:
+	m_Count(0)
+{
+
+}
+
+void SelectionModel::Add(size_t first, size_t last)
+{
+	if (first >= last) return;
+
+	// The range before the first one starting after the index can still cover or touch it
+	auto it = m_Ranges.upper_bound(first);
+
+	if (it != m_Ranges.begin() && std::prev(it)->second >= first)
+	{
+		--it;
+	}
+
+	// Every range overlapping or touching [first, last) is merged into a single one
+	while (it != m_Ranges.end() && it->first <= last)
+	{
+		first = (std::min)(first, it->first);
+		last = (std::max)(last, it->second);
+		m_Count -= it->second - it->first;
+		it = m_Ranges.erase(it);
+	}
+
+	m_Ranges.emplace_hint(it, first, last);
+	m_Count += last - first;
+}
+
+void SelectionModel::Remove(size_t first, size_t last)
+{
+	if (first >= last) return;
+
+	auto it = m_Ranges.upper_bound(first);
+
+	if (it != m_Ranges.begin() && std::prev(it)->second > first)
+	{
+		--it;
+	}
+
+	// Ranges crossing the bounds keep the part outside [first, last)
+	while (it != m_Ranges.end() && it->first < last)
+	{
+		const size_t start = it->first;
+		const size_t end = it->second;
+
+		m_Count -= end - start;
+		it = m_Ranges.erase(it);
+
+		if (start < first)
+		{
+			m_Ranges.emplace_hint(it, start, first);
+			m_Count += first - start;
+		}
+
+		if (end > last)
+		{
+			m_Ranges.emplace_hint(it, last, end);
+			m_Count += end - last;
+			break;
+		}
+	}
+}
+
+void SelectionModel::Shift(std::map<size_t, size_t>::iterator from, size_t count, bool isForward)
+{
+	// The order of the moved ranges doesn't change, so the nodes are reinserted at the end without allocating
+	std::vector<std::map<size_t, size_t>::node_type> nodes;
+
+	while (from != m_Ranges.end())
+	{
+		nodes.push_back(m_Ranges.extract(from++));
+	}
+
+	for (auto& node : nodes)
+	{
+		node.key() = isForward ? node.key() + count : node.key() - count;
+		node.mapped() = isForward ? node.mapped() + count : node.mapped() - count;
+		m_Ranges.insert(m_Ranges.end(), std::move(node));
+	}
+}
+
+bool SelectionModel::IsSelected(size_t index) const noexcept
+{
+	auto it = m_Ranges.upper_bound(index);
+
+	return it != m_Ranges.begin() && index < std::prev(it)->second;
+}
+
+size_t SelectionModel::GetCount() const noexcept
+{
+	return m_Count;
+}
+
+size_t SelectionModel::GetRangeCount() const noexcept
+{
+	return m_Ranges.size();
+}
+
+size_t SelectionModel::GetFirst() const noexcept
+{
+	return m_Ranges.empty() ? NotFound : m_Ranges.begin()->first;
+}
+
+size_t SelectionModel::GetLast() const noexcept
+{
+	return m_Ranges.empty() ? NotFound : m_Ranges.rbegin()->second - 1;
+}
+
+void SelectionModel::Select(size_t index, bool value)
+{
+	SelectRange(index, index + 1, value);
+}
+
+void SelectionModel::Toggle(size_t index)
+{
+	Select(index, !IsSelected(index));
+}
+
+void SelectionModel::SelectRange(size_t first, size_t last, bool value)
+{
+	if (value)
+	{
+		Add(first, last);
+	}
+	else
+	{
+		Remove(first, last);
+	}
+}
+
+void SelectionModel::SelectAll(size_t count)
+{
+	Clear();
+	Add(0, count);
+}
+
+void SelectionModel::Clear() noexcept
+{
+	m_Ranges.clear();
+	m_Count = 0;
+}
+
+void SelectionModel::Insert(size_t index, size_t count)
+{
+	if (count == 0) return;
+
+	auto it = m_Ranges.lower_bound(index);
+	size_t tail = 0;
+
+	// New items are unselected, so a range around the index is split in two
+	if (it != m_Ranges.begin() && std::prev(it)->second > index)
+	{
+		tail = std::exchange(std::prev(it)->second, index);
+	}
+
+	Shift(it, count, true);
+
+	if (tail != 0)
+	{
+		m_Ranges.emplace(index + count, tail + count);
+	}
+}
+
+void SelectionModel::Erase(size_t index, size_t count)
+{
+	if (count == 0) return;
+
+	Remove(index, index + count);
+	Shift(m_Ranges.lower_bound(index + count), count, false);
+
+	// Ranges on both sides of the removed items may touch now
+	const auto next = m_Ranges.find(index);
+
+	if (next != m_Ranges.end() && next != m_Ranges.begin() && std::prev(next)->second == index)
+	{
+		std::prev(next)->second = next->second;
+		m_Ranges.erase(next);
+	}
+}
\ No newline at end of file
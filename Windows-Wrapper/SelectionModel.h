@@ -0,0 +1,65 @@
+#pragma once
+
+#include <map>
+#include <cstddef>
+
+/*
+Selected indices of a list stored as a set of disjoint ranges.
+
+Each range [first, last) is keyed by its first index and touching ranges are merged, so a selection made of a few
+Shift+click spans stays a few entries whatever the number of items. Selecting, unselecting or toggling an index or a
+range costs O(log r) (r being the number of ranges) plus the ranges it swallows, and select all keeps a single range.
+The number of selected items is kept up to date, so it never walks the ranges.
+*/
+class SelectionModel
+{
+public:
+
+	static constexpr size_t NotFound = static_cast<size_t>(-1);
+
+private:
+
+	std::map<size_t, size_t> m_Ranges;	// First index -> last index (exclusive)
+	size_t m_Count;
+
+	void Add(size_t first, size_t last);
+	void Remove(size_t first, size_t last);
+	void Shift(std::map<size_t, size_t>::iterator from, size_t count, bool isForward);
+
+public:
+
+	SelectionModel() noexcept;
+
+	bool IsSelected(size_t index) const noexcept;
+
+	// Number of selected items and the ranges holding them
+	size_t GetCount() const noexcept;
+	size_t GetRangeCount() const noexcept;
+
+	// Lowest and highest selected index (NotFound when nothing is selected)
+	size_t GetFirst() const noexcept;
+	size_t GetLast() const noexcept;
+
+	void Select(size_t index, bool value);
+	void Toggle(size_t index);
+
+	// Items [first, last)
+	void SelectRange(size_t first, size_t last, bool value);
+	void SelectAll(size_t count);
+	void Clear() noexcept;
+
+	// Must be called when items are inserted (unselected) or removed from the list. Only the ranges after the
+	// index are moved
+	void Insert(size_t index, size_t count);
+	void Erase(size_t index, size_t count);
+
+	// Calls function(first, last) for each selected range [first, last), in order
+	template<typename F>
+	void ForEachRange(F&& function) const
+	{
+		for (const auto& [first, last] : m_Ranges)
+		{
+			function(first, last);
+		}
+	}
+};
\ No newline at end of file
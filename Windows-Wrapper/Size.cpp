@@ -1,7 +1,6 @@
 #include "Size.h"
 #include "Point.h"
 #include "SizeF.h"
-#include "Exceptions.h"
 
 Size::Size(Point p)
 	:
@@ -23,27 +22,4 @@ inline Size Size::RoundF(SizeF s) noexcept
 inline Size Size::Truncate(SizeF s) noexcept
 {
 	return Size(static_cast<int>(trunc(s.Width)), static_cast<int>(trunc(s.Height)));
-}
-
-int Size::GetHashCode() const noexcept
-{
-	return Width ^ Height;
-}
-
-bool Size::Equals(const Object* const s) const
-{
-	if (s == nullptr) return false;
-
-	if (const auto sz = dynamic_cast<const Size*>(s))
-	{
-		return *this == *sz;
-	}
-
-	throw ArgumentException("Arg_MustBeSize");
-}
-
-bool Size::Equals(const Size* const s) const
-{
-	if (s == nullptr) return false;
-	return *this == *s;
 }
\ No newline at end of file
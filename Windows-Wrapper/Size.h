@@ -1,11 +1,11 @@
 #pragma once
 
-#include "IEquatable.h"
+#include "ValueType.h"
 
 struct Point;
 struct SizeF;
 
-struct Size : public IEquatable<Size>
+struct Size
 {
 public:
 
@@ -32,9 +32,11 @@ public:
 	static constexpr Size Add(Size lhs, Size rhs) noexcept { return Size(lhs.Width + rhs.Width, lhs.Height + rhs.Height); }
 	static constexpr Size Subtract(Size lhs, Size rhs) noexcept { return Size(lhs.Width - rhs.Width, lhs.Height - rhs.Height); }
 	
-	int GetHashCode() const noexcept override;
-	inline bool Equals(const Object* const obj) const override;
-	inline bool Equals(const Size* const s) const override;
+	constexpr int GetHashCode() const noexcept { return Width ^ Height; }
+	constexpr bool Equals(const Size* const s) const noexcept { return s != nullptr && *this == *s; }
 
 	static constexpr Size Empty() { return Size(0, 0); }
-};
\ No newline at end of file
+};
+
+static_assert(EquatableValue<Size>);
+static_assert(sizeof(Size) == 2 * sizeof(int), "Size must stay a pair of integers");
\ No newline at end of file
@@ -0,0 +1,52 @@
+#include "SnapshotDataProvider.h"
+
+SnapshotDataProvider::SnapshotDataProvider() noexcept
+{
+
+}
+
+void SnapshotDataProvider::Publish(std::shared_ptr<const ItemSnapshot> snapshot) noexcept
+{
+	m_Published.store(std::move(snapshot));
+}
+
+bool SnapshotDataProvider::Publish(const std::shared_ptr<const ItemSnapshot>& expected, std::shared_ptr<const ItemSnapshot> snapshot) noexcept
+{
+	auto current = expected;
+
+	return m_Published.compare_exchange_strong(current, std::move(snapshot));
+}
+
+std::shared_ptr<const ItemSnapshot> SnapshotDataProvider::GetPublished() const noexcept
+{
+	return m_Published.load();
+}
+
+std::shared_ptr<const ItemSnapshot> SnapshotDataProvider::GetSnapshot() const noexcept
+{
+	return m_Current;
+}
+
+size_t SnapshotDataProvider::GetCount() const
+{
+	return m_Current != nullptr ? m_Current->GetCount() : 0;
+}
+
+void SnapshotDataProvider::GetText(size_t first, std::span<std::string> text) const
+{
+	for (size_t i = 0; i < text.size(); ++i)
+	{
+		text[i].assign(m_Current->GetValue(first + i));
+	}
+}
+
+bool SnapshotDataProvider::Refresh()
+{
+	auto published = m_Published.load();
+
+	if (published == m_Current) return false;
+
+	// The old snapshot is released here unless a producer still builds on it
+	m_Current = std::move(published);
+	return true;
+}
\ No newline at end of file
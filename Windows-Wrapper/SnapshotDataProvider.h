@@ -0,0 +1,42 @@
+#pragma once
+
+#include "IListDataProvider.h"
+#include "ItemSnapshot.h"
+#include <atomic>
+#include <memory>
+
+/*
+Data provider reading the items of a list from ItemSnapshots built on other threads.
+
+Producers publish a snapshot with an atomic pointer swap, from any thread, without locking the control. The control
+reads its own copy of the pointer (the current snapshot) and only takes the published one in Refresh, before its next
+paint, so the items never change while it draws. Nothing is copied: the rows drawn are read from the snapshot.
+*/
+class SnapshotDataProvider : public IListDataProvider
+{
+private:
+
+	std::atomic<std::shared_ptr<const ItemSnapshot>> m_Published;
+	std::shared_ptr<const ItemSnapshot> m_Current;		// Only used by the thread of the control
+
+public:
+
+	SnapshotDataProvider() noexcept;
+
+	// Any thread. The control is only told from a producer thread with InvalidateRect or PostMessage on its handle:
+	// Update and the other members of the control are only safe on its own thread
+	void Publish(std::shared_ptr<const ItemSnapshot> snapshot) noexcept;
+
+	// Publishes the snapshot only when expected is still the published one, for producers building on the latest
+	// snapshot (ex: appending to it). Returns false when another one was published in the meantime
+	bool Publish(const std::shared_ptr<const ItemSnapshot>& expected, std::shared_ptr<const ItemSnapshot> snapshot) noexcept;
+
+	std::shared_ptr<const ItemSnapshot> GetPublished() const noexcept;
+
+	// Snapshot read by the control
+	std::shared_ptr<const ItemSnapshot> GetSnapshot() const noexcept;
+
+	size_t GetCount() const override;
+	void GetText(size_t first, std::span<std::string> text) const override;
+	bool Refresh() override;
+};
\ No newline at end of file
@@ -0,0 +1,279 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+/*
+Uniform grid over axis aligned rectangles used to answer point and rectangle queries without walking every item.
+The plane is split in square cells of CellSize pixels and each item is referenced by every cell it overlaps, so a
+point query only looks at the items of a single cell. Only the non empty cells are allocated (hashed by their
+coordinates) so negative or huge coordinates are fine.
+Items covering too many cells (ex: a panel filling the whole window) are kept in a separate list instead to avoid
+inserting them in hundreds of cells. There are usually only a few of them.
+
+Every operation is incremental: Update and Remove only touch the cells of the old and new bounds of the item.
+*/
+template<typename T>
+class SpatialGrid
+{
+private:
+
+	static constexpr size_t MaximumCellsPerItem = 64;
+
+	struct Entry
+	{
+		T Key;
+		int X;
+		int Y;
+		int Width;
+		int Height;
+		bool IsLarge;
+		uint32_t QueryStamp;	// Avoids reporting twice an item found in more than one cell during the same query
+	};
+
+	int m_CellSize;
+	uint32_t m_QueryStamp;
+	std::vector<Entry> m_Entries;
+	std::vector<size_t> m_FreeSlots;
+	std::vector<size_t> m_Large;
+	std::unordered_map<T, size_t> m_Slots;
+	std::unordered_map<uint64_t, std::vector<size_t>> m_Cells;
+
+	static constexpr uint64_t CellKey(int cx, int cy) noexcept
+	{
+		return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+	}
+
+	// Floor division so negative coordinates fall in the right cell
+	constexpr int CellOf(int v) const noexcept
+	{
+		return v >= 0 ? v / m_CellSize : -((-v + m_CellSize - 1) / m_CellSize);
+	}
+
+	static constexpr bool Intersects(const Entry& e, int x, int y, int width, int height) noexcept
+	{
+		return e.X < x + width && x < e.X + e.Width && e.Y < y + height && y < e.Y + e.Height;
+	}
+
+	static constexpr bool Contains(const Entry& e, int x, int y) noexcept
+	{
+		return e.X <= x && x < e.X + e.Width && e.Y <= y && y < e.Y + e.Height;
+	}
+
+	template<typename F>
+	void ForEachCell(const Entry& e, F&& function) const
+	{
+		const int left = CellOf(e.X);
+		const int top = CellOf(e.Y);
+		const int right = CellOf(e.X + e.Width - 1);
+		const int bottom = CellOf(e.Y + e.Height - 1);
+
+		for (int cy = top; cy <= bottom; ++cy)
+		{
+			for (int cx = left; cx <= right; ++cx)
+			{
+				function(CellKey(cx, cy));
+			}
+		}
+	}
+
+	size_t CountCells(const Entry& e) const noexcept
+	{
+		const auto columns = static_cast<size_t>(static_cast<int64_t>(CellOf(e.X + e.Width - 1)) - CellOf(e.X) + 1);
+		const auto rows = static_cast<size_t>(static_cast<int64_t>(CellOf(e.Y + e.Height - 1)) - CellOf(e.Y) + 1);
+		return columns * rows;
+	}
+
+	void Link(size_t slot)
+	{
+		auto& e = m_Entries[slot];
+
+		// Empty rectangles can never be hit so they are only tracked by key
+		if (e.Width <= 0 || e.Height <= 0) return;
+
+		e.IsLarge = CountCells(e) > MaximumCellsPerItem;
+
+		if (e.IsLarge)
+		{
+			m_Large.push_back(slot);
+			return;
+		}
+
+		ForEachCell(e, [&](uint64_t key) { m_Cells[key].push_back(slot); });
+	}
+
+	void Unlink(size_t slot)
+	{
+		const auto& e = m_Entries[slot];
+
+		if (e.Width <= 0 || e.Height <= 0) return;
+
+		if (e.IsLarge)
+		{
+			m_Large.erase(std::find(m_Large.begin(), m_Large.end(), slot));
+			return;
+		}
+
+		ForEachCell(e, [&](uint64_t key)
+			{
+				auto it = m_Cells.find(key);
+				auto& cell = it->second;
+
+				// Order inside the cell doesn't matter so swap with the last one
+				*std::find(cell.begin(), cell.end(), slot) = cell.back();
+				cell.pop_back();
+
+				if (cell.empty()) m_Cells.erase(it);
+			});
+	}
+
+public:
+
+	explicit SpatialGrid(int cellSize = 64)
+		:
+		m_CellSize(cellSize > 0 ? cellSize : 64),
+		m_QueryStamp(0)
+	{
+
+	}
+
+	size_t GetCount() const noexcept { return m_Slots.size(); }
+	bool Contains(const T& key) const noexcept { return m_Slots.contains(key); }
+
+	// Inserts the item or moves it to the new bounds if it's already indexed
+	void Update(const T& key, int x, int y, int width, int height)
+	{
+		size_t slot;
+
+		if (auto it = m_Slots.find(key); it != m_Slots.end())
+		{
+			slot = it->second;
+			auto& e = m_Entries[slot];
+
+			if (e.X == x && e.Y == y && e.Width == width && e.Height == height) return;
+
+			Unlink(slot);
+		}
+		else
+		{
+			if (m_FreeSlots.empty())
+			{
+				slot = m_Entries.size();
+				m_Entries.emplace_back();
+			}
+			else
+			{
+				slot = m_FreeSlots.back();
+				m_FreeSlots.pop_back();
+			}
+
+			m_Slots.emplace(key, slot);
+		}
+
+		m_Entries[slot] = Entry{ key, x, y, width, height, false, 0 };
+		Link(slot);
+	}
+
+	void Remove(const T& key)
+	{
+		auto it = m_Slots.find(key);
+
+		if (it == m_Slots.end()) return;
+
+		Unlink(it->second);
+		m_FreeSlots.push_back(it->second);
+		m_Slots.erase(it);
+	}
+
+	void Clear() noexcept
+	{
+		m_Entries.clear();
+		m_FreeSlots.clear();
+		m_Large.clear();
+		m_Slots.clear();
+		m_Cells.clear();
+	}
+
+	// Calls function(key) for every item containing the point
+	template<typename F>
+	void QueryPoint(int x, int y, F&& function) const
+	{
+		if (auto it = m_Cells.find(CellKey(CellOf(x), CellOf(y))); it != m_Cells.end())
+		{
+			for (const auto slot : it->second)
+			{
+				if (Contains(m_Entries[slot], x, y)) function(m_Entries[slot].Key);
+			}
+		}
+
+		for (const auto slot : m_Large)
+		{
+			if (Contains(m_Entries[slot], x, y)) function(m_Entries[slot].Key);
+		}
+	}
+
+	// Calls function(key) once for every item intersecting the rectangle
+	template<typename F>
+	void QueryRectangle(int x, int y, int width, int height, F&& function)
+	{
+		if (width <= 0 || height <= 0) return;
+
+		const uint32_t stamp = ++m_QueryStamp;
+
+		// Stamp wrapped around, reset the old ones so no item is skipped by mistake
+		if (stamp == 0)
+		{
+			for (auto& e : m_Entries) e.QueryStamp = 0;
+			return QueryRectangle(x, y, width, height, function);
+		}
+
+		const int left = CellOf(x);
+		const int top = CellOf(y);
+		const int right = CellOf(x + width - 1);
+		const int bottom = CellOf(y + height - 1);
+		const auto cells = static_cast<size_t>(static_cast<int64_t>(right) - left + 1) * static_cast<size_t>(static_cast<int64_t>(bottom) - top + 1);
+
+		auto visit = [&](size_t slot)
+		{
+			auto& e = m_Entries[slot];
+
+			if (e.QueryStamp == stamp) return;
+
+			e.QueryStamp = stamp;
+
+			if (Intersects(e, x, y, width, height)) function(e.Key);
+		};
+
+		// Huge query rectangles are cheaper to answer by walking the allocated cells than every covered cell
+		if (cells > m_Cells.size())
+		{
+			for (const auto& [key, cell] : m_Cells)
+			{
+				const int cx = static_cast<int>(static_cast<uint32_t>(key >> 32));
+				const int cy = static_cast<int>(static_cast<uint32_t>(key));
+
+				if (cx < left || cx > right || cy < top || cy > bottom) continue;
+
+				for (const auto slot : cell) visit(slot);
+			}
+		}
+		else
+		{
+			for (int cy = top; cy <= bottom; ++cy)
+			{
+				for (int cx = left; cx <= right; ++cx)
+				{
+					if (auto it = m_Cells.find(CellKey(cx, cy)); it != m_Cells.end())
+					{
+						for (const auto slot : it->second) visit(slot);
+					}
+				}
+			}
+		}
+
+		for (const auto slot : m_Large) visit(slot);
+	}
+};
\ No newline at end of file
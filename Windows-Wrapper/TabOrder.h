@@ -0,0 +1,167 @@
+#pragma once
+
+#include <map>
+#include <iterator>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+/*
+Tab order of the controls of a window.
+
+Only the tab stops of the window are registered (labels, scroll bars and so on never are), with their tab index. The
+enabled ones are linked in the chain, sorted by tab index then by registration order for equal indexes. Each control
+keeps its position in the chain so the next and previous ones are found in constant time, without skipping the disabled
+controls that can't be focused.
+
+Conditions which don't belong to the control itself (ex: a disabled container) are checked by the predicate given to
+GetNext and GetPrevious while walking the chain.
+*/
+template<typename T>
+class TabOrder
+{
+private:
+
+	struct Key
+	{
+		int TabIndex;
+		uint64_t Sequence;
+
+		bool operator<(const Key& other) const noexcept
+		{
+			return TabIndex != other.TabIndex ? TabIndex < other.TabIndex : Sequence < other.Sequence;
+		}
+	};
+
+	using Chain = std::map<Key, T>;
+
+	struct Slot
+	{
+		Key Order;
+		typename Chain::iterator Position;	// Only valid while linked
+		bool IsLinked;
+	};
+
+	Chain m_Chain;
+	std::unordered_map<T, Slot> m_Slots;
+	uint64_t m_Sequence;
+	int m_NextIndex;
+
+	// First item to look at when going forward, one past the first one when going backward
+	typename Chain::const_iterator Find(const T& item, bool isForward) const
+	{
+		const auto it = m_Slots.find(item);
+
+		if (it == m_Slots.end()) return isForward ? m_Chain.begin() : m_Chain.end();
+		if (it->second.IsLinked) return isForward ? std::next(typename Chain::const_iterator(it->second.Position)) : it->second.Position;
+
+		// The key of an unlinked item isn't in the chain so this is the first item after it either way
+		return m_Chain.lower_bound(it->second.Order);
+	}
+
+public:
+
+	TabOrder() noexcept
+		:
+		m_Sequence(0),
+		m_NextIndex(0)
+	{
+
+	}
+
+	size_t GetCount() const noexcept { return m_Slots.size(); }
+	size_t GetLinkedCount() const noexcept { return m_Chain.size(); }
+	bool Contains(const T& item) const noexcept { return m_Slots.contains(item); }
+
+	// Tab index given to the next control created in the window
+	int GetNextIndex() const noexcept { return m_NextIndex; }
+
+	// Registers the item or moves it to its new tab index, linking it in the chain only when it can be focused
+	void Update(const T& item, int tabIndex, bool isLinked)
+	{
+		auto [it, isNew] = m_Slots.try_emplace(item);
+		auto& slot = it->second;
+
+		if (isNew)
+		{
+			slot.Order = Key{ tabIndex, m_Sequence++ };
+			slot.IsLinked = false;
+		}
+		else if (slot.Order.TabIndex != tabIndex)
+		{
+			if (slot.IsLinked)
+			{
+				// Moves the node itself, nothing is allocated
+				auto node = m_Chain.extract(slot.Position);
+				node.key().TabIndex = tabIndex;
+				slot.Position = m_Chain.insert(std::move(node)).position;
+			}
+
+			slot.Order.TabIndex = tabIndex;
+		}
+
+		if (isLinked && !slot.IsLinked)
+		{
+			slot.Position = m_Chain.emplace(slot.Order, item).first;
+		}
+		else if (!isLinked && slot.IsLinked)
+		{
+			m_Chain.erase(slot.Position);
+		}
+
+		slot.IsLinked = isLinked;
+
+		if (tabIndex >= m_NextIndex) m_NextIndex = tabIndex + 1;
+	}
+
+	void Remove(const T& item)
+	{
+		auto it = m_Slots.find(item);
+
+		if (it == m_Slots.end()) return;
+
+		if (it->second.IsLinked) m_Chain.erase(it->second.Position);
+		m_Slots.erase(it);
+	}
+
+	void Clear() noexcept
+	{
+		m_Chain.clear();
+		m_Slots.clear();
+		m_Sequence = 0;
+		m_NextIndex = 0;
+	}
+
+	// Next linked item after this one (the first one when it's not registered) accepted by the predicate, going back to
+	// the beginning after the last one. Returns T{} when there's no other item to go to
+	template<typename Predicate>
+	T GetNext(const T& item, Predicate&& predicate) const
+	{
+		auto it = Find(item, true);
+
+		for (size_t i = 0; i < m_Chain.size(); ++i, ++it)
+		{
+			if (it == m_Chain.end()) it = m_Chain.begin();
+			if (it->second == item) break;
+			if (predicate(it->second)) return it->second;
+		}
+
+		return T{};
+	}
+
+	template<typename Predicate>
+	T GetPrevious(const T& item, Predicate&& predicate) const
+	{
+		auto it = Find(item, false);
+
+		for (size_t i = 0; i < m_Chain.size(); ++i)
+		{
+			if (it == m_Chain.begin()) it = m_Chain.end();
+			--it;
+			if (it->second == item) break;
+			if (predicate(it->second)) return it->second;
+		}
+
+		return T{};
+	}
+};
\ No newline at end of file
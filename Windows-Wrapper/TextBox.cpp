@@ -1,4 +1,6 @@
 ﻿#include "TextBox.h"
+#include "Application.h"
+#include "ClipboardTextSource.h"
 
 void TextBox::PreDraw(Graphics* const graphics)
 {
@@ -19,9 +21,9 @@ void TextBox::Draw(Graphics* const graphics, Drawing::Rectangle rectangle)
 	HBITMAP hbmMem = CreateCompatibleBitmap(hdc, m_Size.Width, m_Size.Height);
 	HBITMAP hbmOld = (HBITMAP)SelectObject(hdcMem, hbmMem);
 
-	// Select current font
-	//auto hFont = Fonts->find(m_Font.ToString());
-	//SelectObject(hdcMem, hFont->second);
+	// Select current font so the drawn characters are the same measured for the caret
+	auto hFont = static_cast<HFONT>(graphics->CreateFontObject(GetFont()).ToPointer());
+	HGDIOBJ hFontOld = hFont != nullptr ? SelectObject(hdcMem, hFont) : nullptr;
 
 	RECT r, cr;
 	GetClientRect(hwnd, &cr);
@@ -127,8 +129,11 @@ void TextBox::Draw(Graphics* const graphics, Drawing::Rectangle rectangle)
 	cr.bottom -= m_Margin.Bottom;
 
 	// Adjust text in center based on default TextBox size with font size as 1
-	int spacingForAlignment = cr.bottom - m_Font.GetSizeInPixels();
-	cr.top += (spacingForAlignment / 2) - 4;	// 4 Pixels extra for small TextBox and underline characteres
+	if (!m_IsMultiline)
+	{
+		int spacingForAlignment = cr.bottom - m_Font.GetSizeInPixels();
+		cr.top += (spacingForAlignment / 2) - 4;	// 4 Pixels extra for small TextBox and underline characteres
+	}
 
 	// BOTTOM ALIGNMENT
 	//cr.top += (cr.top + Font.GetSizeInPixels()) / 2;
@@ -136,20 +141,42 @@ void TextBox::Draw(Graphics* const graphics, Drawing::Rectangle rectangle)
 	CopyRect(&r, &cr);
 
 	// Recalculate Caret position for each character
-	CalculateCaret(hwnd, hdcMem);
+	CalculateCaret();
 
-	// Draw for when control is selected and cursor index is the same as select index
-	if (!m_IsTabSelected || m_CursorIndex == m_SelectIndex)
+	int caretY = cr.top;
+	m_TextTop = cr.top;
+
+	// Matches are painted under the text, the selection is still painted over them
+	if (!m_IsMultiline && m_IsHighlightingMatches)
 	{
-		SetBkMode(hdcMem, TRANSPARENT);
-		SetTextColor(hdcMem, RGB(m_ForeColor.GetR(), m_ForeColor.GetG(), m_ForeColor.GetB()));
-		DrawText(hdcMem, Text.c_str(), -1, &r, DT_LEFT | DT_VCENTER);
-		DrawText(hdcMem, Text.c_str(), static_cast<int>(m_CursorIndex), &r, DT_LEFT | DT_VCENTER | DT_CALCRECT);
+		PaintMatches(hdcMem, cr, r.top, Application::GetTextMeasurer().GetFontMetrics(m_CaretFont).Height, 0, m_CaretPosition.FindIndex(cr.right - cr.left),
+			[&](size_t index) { return m_CaretPosition.GetPosition(index); });
+	}
+
+	if (m_IsMultiline)
+	{
+		m_View.SetViewportHeight(cr.bottom - cr.top);
 
-		if (m_CursorIndex == 0)
+		if (m_IsScrollToCaretPending)
 		{
-			r.right = cr.left;
+			m_View.EnsureVisible(m_Document.GetLineFromOffset(m_SelectIndex));
+			m_IsScrollToCaretPending = false;
 		}
+
+		DrawLines(hdcMem, cr);
+
+		int x, y;
+		m_View.GetPointFromOffset(m_CursorIndex, x, y);
+		r.right = cr.left + x;
+		caretY = cr.top + y;
+	}
+	// Draw for when control is selected and cursor index is the same as select index
+	else if (!m_IsTabSelected || m_CursorIndex == m_SelectIndex)
+	{
+		SetBkMode(hdcMem, TRANSPARENT);
+		SetTextColor(hdcMem, RGB(m_ForeColor.GetR(), m_ForeColor.GetG(), m_ForeColor.GetB()));
+		DrawTextRange(hdcMem, r.left, r.top, 0, m_CaretPosition.FindIndex(cr.right - cr.left));
+		r.right = cr.left + m_CaretPosition.GetPosition(m_CursorIndex);
 	}
 	else
 	{
@@ -162,17 +189,18 @@ void TextBox::Draw(Graphics* const graphics, Drawing::Rectangle rectangle)
 	{
 		std::ostringstream oss;
 
-		if (m_CursorIndex == m_SelectIndex)
+		// Caret is hidden while its line is scrolled out of the client area
+		if (m_CursorIndex == m_SelectIndex && caretY >= cr.top && caretY < cr.bottom)
 		{
 			if (r.right > cr.right)
 			{
-				oss << "Caret X: " << cr.right << " | " << "Caret Y: " << cr.top << std::endl;
-				SetCaretPos(cr.right, cr.top);
+				oss << "Caret X: " << cr.right << " | " << "Caret Y: " << caretY << std::endl;
+				SetCaretPos(cr.right, caretY);
 			}
 			else
 			{
-				oss << "Caret X: " << r.right << " | " << "Caret Y: " << cr.top << std::endl;
-				SetCaretPos(r.right, cr.top);
+				oss << "Caret X: " << r.right << " | " << "Caret Y: " << caretY << std::endl;
+				SetCaretPos(r.right, caretY);
 			}
 
 			EnableCaret();
@@ -187,6 +215,7 @@ void TextBox::Draw(Graphics* const graphics, Drawing::Rectangle rectangle)
 	// with the current image to avoid flickering
 	BitBlt(hdc, 0, 0, m_Size.Width, m_Size.Height, hdcMem, 0, 0, SRCCOPY);
 
+	if (hFontOld != nullptr) SelectObject(hdcMem, hFontOld);
 	SelectObject(hdcMem, hbmOld);
 	DeleteObject(hbmOld);
 	SelectObject(hdcMem, hbmOld);
@@ -251,14 +280,38 @@ void TextBox::OnKeyDown_Impl(HWND hwnd, unsigned int vk, int cRepeat, unsigned i
 
 	/**************************************************************************************************/
 
+	// Moving the caret ends the current typing sequence so it's undone on its own
+	if (vk == VK_LEFT || vk == VK_RIGHT || vk == VK_UP || vk == VK_DOWN || vk == VK_PRIOR || vk == VK_NEXT || vk == VK_HOME || vk == VK_END)
+	{
+		m_Journal.BreakMerge();
+	}
+
 	switch (vk)
 	{
+	case 'Z':		// Gives the TextBox the CTRL+Z feature to undo the last edit
+	{
+		if (0x8000 & GetKeyState(VK_CONTROL))
+		{
+			Undo();
+		}
+
+		break;
+	}
+	case 'Y':		// Gives the TextBox the CTRL+Y feature to redo the last undone edit
+	{
+		if (0x8000 & GetKeyState(VK_CONTROL))
+		{
+			Redo();
+		}
+
+		break;
+	}
 	case 'A':		// Gives the TextBox the CTRL+A feature to select all text from the control
 	{
 		if (0x8000 & GetKeyState(VK_CONTROL))
 		{
 			m_SelectIndex = 0;
-			m_CursorIndex = Text.length();
+			m_CursorIndex = m_Document.GetLength();
 		}
 
 		InputRedraw();
@@ -289,7 +342,9 @@ void TextBox::OnKeyDown_Impl(HWND hwnd, unsigned int vk, int cRepeat, unsigned i
 		if (0x8000 & GetKeyState(VK_CONTROL))
 		{
 			CopyToClipboard();
+			m_Journal.BreakMerge();
 			InputDelete(DeleteInputType::CutAndPaste);
+			m_Journal.BreakMerge();
 		}
 
 		InputRedraw();
@@ -322,10 +377,7 @@ void TextBox::OnKeyDown_Impl(HWND hwnd, unsigned int vk, int cRepeat, unsigned i
 		// Shift Press
 		if ((GetKeyState(VK_SHIFT) & 0x8000))
 		{
-			if (m_SelectIndex > 0)
-			{
-				--m_SelectIndex;
-			}
+			m_SelectIndex = m_Clusters.GetPreviousStop(m_SelectIndex);
 
 			InputRedraw();
 			break;
@@ -334,12 +386,12 @@ void TextBox::OnKeyDown_Impl(HWND hwnd, unsigned int vk, int cRepeat, unsigned i
 		// No Modifier Pressed
 		if (m_CursorIndex == m_SelectIndex)
 		{
-			--m_CursorIndex;
+			m_CursorIndex = m_Clusters.GetPreviousStop(m_CursorIndex);
 			m_SelectIndex = m_CursorIndex;
 		}
 		else
 		{
-			if (m_SelectIndex == Text.length() || m_SelectIndex > m_CursorIndex)
+			if (m_SelectIndex == m_Document.GetLength() || m_SelectIndex > m_CursorIndex)
 			{
 				m_SelectIndex = m_CursorIndex;
 			}
@@ -355,7 +407,7 @@ void TextBox::OnKeyDown_Impl(HWND hwnd, unsigned int vk, int cRepeat, unsigned i
 	case VK_RIGHT:	// Gives the TextBox the Navigation to Right feature by using the Right Arrow
 	{
 		// Doesn't let user get out of string if it's already at the end
-		if (m_CursorIndex == Text.length() && m_SelectIndex == Text.length())
+		if (m_CursorIndex == m_Document.GetLength() && m_SelectIndex == m_Document.GetLength())
 		{
 			break;
 		}
@@ -363,7 +415,7 @@ void TextBox::OnKeyDown_Impl(HWND hwnd, unsigned int vk, int cRepeat, unsigned i
 		// SHIFT + CONTROL Press
 		if ((GetKeyState(VK_CONTROL) & 0x8000) && (GetKeyState(VK_SHIFT) & 0x8000))
 		{
-			m_SelectIndex = Text.length();
+			m_SelectIndex = m_Document.GetLength();
 			InputRedraw();
 			break;
 		}
@@ -371,7 +423,7 @@ void TextBox::OnKeyDown_Impl(HWND hwnd, unsigned int vk, int cRepeat, unsigned i
 		// CONTROL Press
 		if ((GetKeyState(VK_CONTROL) & 0x8000))
 		{
-			m_SelectIndex = m_CursorIndex = Text.length();
+			m_SelectIndex = m_CursorIndex = m_Document.GetLength();
 			InputRedraw();
 			break;
 		}
@@ -379,10 +431,7 @@ void TextBox::OnKeyDown_Impl(HWND hwnd, unsigned int vk, int cRepeat, unsigned i
 		// SHIFT Press
 		if ((GetKeyState(VK_SHIFT) & 0x8000))
 		{
-			if (m_SelectIndex < Text.length())
-			{
-				++m_SelectIndex;
-			}
+			m_SelectIndex = m_Clusters.GetNextStop(m_SelectIndex);
 
 			InputRedraw();
 			break;
@@ -391,7 +440,7 @@ void TextBox::OnKeyDown_Impl(HWND hwnd, unsigned int vk, int cRepeat, unsigned i
 		// No Modifier Pressed
 		if (m_CursorIndex == m_SelectIndex)
 		{
-			++m_CursorIndex;
+			m_CursorIndex = m_Clusters.GetNextStop(m_CursorIndex);
 			m_SelectIndex = m_CursorIndex;
 		}
 		else
@@ -427,13 +476,30 @@ void TextBox::OnKeyDown_Impl(HWND hwnd, unsigned int vk, int cRepeat, unsigned i
 	{
 		if ((GetKeyState(VK_SHIFT) & 0x8000))
 		{
-			m_SelectIndex = Text.length();
+			m_SelectIndex = m_Document.GetLength();
 		}
 		else
 		{
-			m_CursorIndex = m_SelectIndex = Text.length();
+			m_CursorIndex = m_SelectIndex = m_Document.GetLength();
+		}
+
+		InputRedraw();
+		break;
+	}
+	case VK_UP:		// Moves the caret between the lines of a multiline TextBox with the arrows and Page Up/Down
+	case VK_DOWN:
+	case VK_PRIOR:
+	case VK_NEXT:
+	{
+		if (!m_IsMultiline)
+		{
+			break;
 		}
 
+		const auto page = (std::max)(1ll, static_cast<long long>(m_View.GetVisibleLineCount()) - 1);
+		const auto lines = vk == VK_UP ? -1ll : vk == VK_DOWN ? 1ll : vk == VK_PRIOR ? -page : page;
+
+		MoveCaretByLines(lines, (GetKeyState(VK_SHIFT) & 0x8000) != 0);
 		InputRedraw();
 		break;
 	}
@@ -449,7 +515,7 @@ void TextBox::OnKeyDown_Impl(HWND hwnd, unsigned int vk, int cRepeat, unsigned i
 		if (0x8000 & GetKeyState(VK_CONTROL))
 		{
 			m_SelectIndex = 0;
-			m_CursorIndex = Text.length();
+			m_CursorIndex = m_Document.GetLength();
 		}
 
 		InputDelete(DeleteInputType::Backspace);
@@ -469,6 +535,12 @@ void TextBox::OnKeyPressed_Impl(HWND hwnd, char c, int cRepeat) noexcept
 		return;
 	}
 
+	// Lines are always separated by '\n' inside the document
+	if (c == '\r')
+	{
+		c = '\n';
+	}
+
 	// Skip key input if TAB (Switch tabbing) or Backspace (Remove last character) is pressed
 	if (c == VK_TAB || c == VK_BACK || c == VK_ESCAPE)
 	{
@@ -489,19 +561,19 @@ void TextBox::OnKeyPressed_Impl(HWND hwnd, char c, int cRepeat) noexcept
 		return;
 	}
 
-	if (Text.length() < m_MaximumLenght)
+	if (m_Document.GetLength() < m_MaximumLenght)
 	{
 		if (m_CursorIndex == m_SelectIndex)
 		{
-			Text.insert(m_CursorIndex, 1, c);
+			InsertText(m_CursorIndex, std::string_view(&c, 1));
 			++m_CursorIndex;
 		}
 		else
 		{
 			size_t start = (std::min)(m_CursorIndex, m_SelectIndex);
 			size_t end = (std::max)(m_CursorIndex, m_SelectIndex);
-			Text.erase(start, end - start);
-			Text.insert(start, 1, c);
+			EraseText(start, end - start);
+			InsertText(start, std::string_view(&c, 1));
 			m_CursorIndex = start + 1;
 		}
 
@@ -518,25 +590,13 @@ void TextBox::OnKeyPressed_Impl(HWND hwnd, char c, int cRepeat) noexcept
 
 void TextBox::OnMouseLeftDown_Impl(HWND hwnd, int x, int y, unsigned int keyFlags) noexcept
 {
-	if (Text.length() == 0)
+	if (m_Document.GetLength() == 0)
 	{
 		return;
 	}
 
-	if (x > m_CaretPosition.back())
-	{
-		m_CursorIndex = Text.length();
-	}
-	else if (x < m_CaretPosition.front())
-	{
-		m_CursorIndex = 0;
-	}
-	else
-	{
-		const auto idx = std::lower_bound(m_CaretPosition.begin(), m_CaretPosition.end(), x);
-		m_CursorIndex = idx - m_CaretPosition.begin();
-	}
-
+	m_Journal.BreakMerge();
+	m_CursorIndex = GetIndexFromPoint(x, y);
 	m_SelectIndex = m_CursorIndex;
 
 	Control::OnMouseLeftDown_Impl(hwnd, x, y, keyFlags);
@@ -548,19 +608,7 @@ void TextBox::OnMouseMove_Impl(HWND hwnd, int x, int y, unsigned int keyFlags) n
 	{
 		if (keyFlags & MK_LBUTTON)
 		{
-			if (x > m_CaretPosition.back())
-			{
-				m_SelectIndex = Text.length();
-			}
-			else if (x < m_CaretPosition.front())
-			{
-				m_SelectIndex = 0;
-			}
-			else
-			{
-				const auto idx = std::lower_bound(m_CaretPosition.begin(), m_CaretPosition.end(), x);
-				m_SelectIndex = idx - m_CaretPosition.begin();
-			}
+			m_SelectIndex = GetIndexFromPoint(x, y);
 		}
 
 		Update();
@@ -570,10 +618,22 @@ void TextBox::OnMouseMove_Impl(HWND hwnd, int x, int y, unsigned int keyFlags) n
 	Control::OnMouseMove_Impl(hwnd, x, y, keyFlags);
 }
 
+void TextBox::OnMouseWheel_Impl(HWND hwnd, int x, int y, int delta, unsigned int fwKeys) noexcept
+{
+	if (m_IsMultiline)
+	{
+		// Three lines per notch like the system default
+		m_View.ScrollBy(-static_cast<long long>(delta) * 3 / WHEEL_DELTA);
+		Update();
+	}
+
+	Control::OnMouseWheel_Impl(hwnd, x, y, delta, fwKeys);
+}
+
 void TextBox::OnFocusEnter_Impl(HWND hwnd, HWND hwndOldFocus) noexcept
 {
 	// Create a solid black caret. 
-	CreateCaret(hwnd, (HBITMAP)NULL, 2, m_Font.GetSizeInPixels());
+	CreateCaret(hwnd, (HBITMAP)NULL, 2, GetFont().GetSizeInPixels());
 	EnableCaret();
 	InputRedraw();
 
@@ -589,38 +649,210 @@ void TextBox::OnFocusLeave_Impl(HWND hwnd, HWND hwndNewFocus) noexcept
 	Control::OnFocusLeave_Impl(hwnd, hwndNewFocus);
 }
 
-void TextBox::CalculateCaret(HWND hwnd, const HDC& hdc) noexcept
+void TextBox::CalculateCaret() noexcept
 {
-	if (Text.length() == 0)
+	switch (BorderStyle)
 	{
-		return;
+	case BorderStyle::None: m_CaretOffset = m_Margin.Left; break;
+	case BorderStyle::FixedSingle: m_CaretOffset = m_Margin.Left + 1; break;
+	case BorderStyle::Fixed3D: m_CaretOffset = m_Margin.Left + 2; break;
 	}
 
-	// Not the best solution for now.
-	// At least it calculates using the right values
-	m_CaretPosition.clear();
+	auto font = GetFont().GetDescriptor();
 
-	if (m_CaretPosition.size() < Text.length() + 1)
+	// Multiline TextBoxes only measure the visible lines through the view
+	if (m_IsMultiline)
 	{
-		m_CaretPosition.resize(Text.length() + 1, 0ul);
+		m_View.SetFont(Application::GetTextMeasurer(), font);
+		m_CaretFont = std::move(font);
+		m_IsCaretValid = false;
+		return;
 	}
 
-	for (int i = 0; i <= static_cast<int>(Text.length()); ++i)
+	if (m_IsCaretValid && font == m_CaretFont)
 	{
-		if (i > 0)
+		return;
+	}
+
+	m_CaretFont = std::move(font);
+
+	std::vector<int> advances(m_Document.GetLength());
+	auto advance = advances.data();
+
+	m_Document.ForEachChunk(0, m_Document.GetLength(), [&](std::string_view chunk)
 		{
-			SIZE s;
-			GetTextExtentPoint32(hdc, Text.substr(0, i).c_str(), i, &s);
-			m_CaretPosition[i] = s.cx;
-		}
+			Application::GetTextMeasurer().GetAdvances(m_CaretFont, chunk, advance);
+			advance += chunk.length();
+		});
+
+	m_CaretPosition.Assign(advances.data(), advances.size());
+	m_IsCaretValid = true;
+}
+
+size_t TextBox::GetIndexFromPoint(int x, int y) noexcept
+{
+	if (m_IsMultiline)
+	{
+		return m_Clusters.Snap(m_View.GetOffsetFromPoint(x - m_CaretOffset, y - m_TextTop));
+	}
+
+	return m_Clusters.Snap(m_CaretPosition.FindIndex(x - m_CaretOffset));
+}
+
+void TextBox::MoveCaretByLines(long long lines, bool isSelecting) noexcept
+{
+	// Keeps the caret x on the destination line
+	int x, y;
+	m_View.GetPointFromOffset(isSelecting ? m_SelectIndex : m_CursorIndex, x, y);
+
+	const size_t index = m_Clusters.Snap(m_View.GetOffsetFromPoint(x, y + static_cast<int>(lines * m_View.GetLineHeight())));
+
+	if (isSelecting)
+	{
+		m_SelectIndex = index;
+	}
+	else
+	{
+		m_CursorIndex = m_SelectIndex = index;
+	}
+}
+
+void TextBox::InsertText(size_t index, std::string_view text) noexcept
+{
+	if (!m_IsApplyingJournal)
+	{
+		m_Journal.Record(index, {}, text);
+	}
+
+	if (m_IsMultiline)
+	{
+		m_View.OnEdit(m_Document.GetLineFromOffset(index), 0, static_cast<size_t>(std::count(text.begin(), text.end(), '\n')));
+	}
+
+	m_Document.Insert(index, text);
+	m_IsDocumentTextValid = false;
+	m_Clusters.OnInsert(index, text.length());
+	m_Search.OnEdit(m_Document, index, 0, text.length());
+
+	// Not measured yet, CalculateCaret measures the whole text on the next draw
+	if (!m_IsCaretValid)
+	{
+		return;
+	}
 
-		switch (BorderStyle)
+	std::vector<int> advances(text.length());
+	Application::GetTextMeasurer().GetAdvances(m_CaretFont, text, advances.data());
+	m_CaretPosition.Insert(index, advances.data(), advances.size());
+}
+
+void TextBox::EraseText(size_t index, size_t count) noexcept
+{
+	if (!m_IsApplyingJournal)
+	{
+		m_Journal.Record(index, m_Document.GetText(index, count), {});
+	}
+
+	if (m_IsMultiline)
+	{
+		const size_t line = m_Document.GetLineFromOffset(index);
+		m_View.OnEdit(line, m_Document.GetLineFromOffset(index + count) - line, 0);
+	}
+
+	m_Document.Erase(index, count);
+	m_IsDocumentTextValid = false;
+	m_Clusters.OnErase(index, count);
+	m_Search.OnEdit(m_Document, index, count, 0);
+
+	if (m_IsCaretValid)
+	{
+		m_CaretPosition.Erase(index, count);
+	}
+}
+
+void TextBox::DrawTextRange(HDC hdc, int x, int y, size_t start, size_t end) const noexcept
+{
+	if (start >= end)
+	{
+		return;
+	}
+
+	// Each chunk is drawn straight from the document buffers at its caret position
+	size_t offset = start;
+
+	m_Document.ForEachChunk(start, end - start, [&](std::string_view chunk)
 		{
-		case BorderStyle::None: m_CaretPosition[i] += m_Margin.Left; break;
-		case BorderStyle::FixedSingle: m_CaretPosition[i] += m_Margin.Left + 1; break;
-		case BorderStyle::Fixed3D: m_CaretPosition[i] += m_Margin.Left + 2; break;
-		}
+			TextOut(hdc, x + m_CaretPosition.GetPosition(offset), y, chunk.data(), static_cast<int>(chunk.length()));
+			offset += chunk.length();
+		});
+}
+
+template<typename F>
+void TextBox::PaintMatches(HDC hdc, const RECT& r, int top, int height, size_t start, size_t end, F&& getPosition) noexcept
+{
+	const auto& matches = m_Search.FindAll(m_Document);
+	const size_t length = m_Search.GetPattern().length();
+
+	if (matches.empty())
+	{
+		return;
 	}
+
+	HBRUSH brush = CreateSolidBrush(RGB(255, 235, 0));
+
+	// Matches starting before the range can still end inside it
+	for (auto it = std::lower_bound(matches.begin(), matches.end(), start >= length ? start - length + 1 : 0); it != matches.end() && *it < end; ++it)
+	{
+		RECT rc;
+		rc.left = r.left + getPosition((std::max)(*it, start));
+		rc.top = top;
+		rc.right = r.left + getPosition((std::min)(*it + length, end));
+		rc.bottom = top + height;
+		IntersectRect(&rc, &rc, &r);
+		FillRect(hdc, &rc, brush);
+	}
+
+	DeleteObject(brush);
+}
+
+void TextBox::DrawLines(HDC hdc, const RECT& r) noexcept
+{
+	const size_t start = (std::min)(m_CursorIndex, m_SelectIndex);
+	const size_t end = (std::max)(m_CursorIndex, m_SelectIndex);
+	const int lineHeight = m_View.GetLineHeight();
+	HBRUSH selection = CreateSolidBrush(RGB(0, 120, 215));
+
+	SetBkMode(hdc, TRANSPARENT);
+
+	m_View.ForEachVisibleLine([&](size_t line, size_t offset, int y, const TextView::LineLayout& layout)
+		{
+			if (m_IsHighlightingMatches)
+			{
+				PaintMatches(hdc, r, r.top + y, lineHeight, offset, offset + layout.Text.length(), [&](size_t index) { return layout.Positions[index - offset]; });
+			}
+
+			SetTextColor(hdc, RGB(m_ForeColor.GetR(), m_ForeColor.GetG(), m_ForeColor.GetB()));
+			ExtTextOut(hdc, r.left, r.top + y, ETO_CLIPPED, &r, layout.Text.data(), static_cast<UINT>(layout.Text.length()), nullptr);
+
+			// Selected part of the line is drawn again over the highlight
+			if (m_IsTabSelected && start < end && start < offset + layout.Length && end > offset)
+			{
+				const size_t first = (std::min)(start > offset ? start - offset : 0, layout.Text.length());
+				const size_t last = (std::min)(end - offset, layout.Text.length());
+
+				RECT rc;
+				rc.left = r.left + layout.Positions[first];
+				rc.top = r.top + y;
+				rc.right = r.left + layout.Positions[last];
+				rc.bottom = rc.top + lineHeight;
+				IntersectRect(&rc, &rc, &r);
+				FillRect(hdc, &rc, selection);
+
+				SetTextColor(hdc, RGB(255, 255, 255));
+				ExtTextOut(hdc, r.left + layout.Positions[first], r.top + y, ETO_CLIPPED, &rc, layout.Text.data() + first, static_cast<UINT>(last - first), nullptr);
+			}
+		});
+
+	DeleteObject(selection);
 }
 
 void TextBox::CopyToClipboard() const noexcept
@@ -650,7 +882,7 @@ void TextBox::CopyToClipboard() const noexcept
 			buffer = reinterpret_cast<char*>(GlobalLock(clipbuffer));
 			if (buffer != NULL)
 			{
-				strcpy_s(buffer, end - start + 1, Text.substr(start, end - start).c_str());
+				strcpy_s(buffer, end - start + 1, m_Document.GetText(start, end - start).c_str());
 			}
 			GlobalUnlock(clipbuffer);
 			SetClipboardData(CF_TEXT, clipbuffer);
@@ -661,25 +893,8 @@ void TextBox::CopyToClipboard() const noexcept
 
 void TextBox::PasteFromClipboard() noexcept
 {
-	OpenClipboard(NULL);
-	HANDLE h = GetClipboardData(CF_TEXT);
-
-	InputDelete(DeleteInputType::CutAndPaste);
-
-	// Paste data from clipboard
-	std::ostringstream cb;
-	cb << reinterpret_cast<char*>(GlobalLock(h));
-
-	if (cb)
-	{
-		Text.insert(m_CursorIndex, cb.str());
-
-		m_CursorIndex += cb.str().length();
-		m_SelectIndex = m_CursorIndex;
-	}
-
-	GlobalUnlock(h);
-	CloseClipboard();
+	ClipboardTextSource source(static_cast<HWND>(Handle.ToPointer()));
+	Paste(source);
 }
 
 void TextBox::EnableCaret() noexcept
@@ -710,7 +925,8 @@ void TextBox::PrintDebug() const noexcept
 	for (int i = 0; i < static_cast<int>(m_SelectIndex); ++i) oss << "   ";
 	oss << " | " << std::endl;
 	oss << "  Text: ";
-	for (int i = 0; i < static_cast<int>(Text.size()); ++i) oss << " " << Text[i] << " ";
+	const auto& text = GetText();
+	for (int i = 0; i < static_cast<int>(text.size()); ++i) oss << " " << text[i] << " ";
 	oss << "\\0" << std::endl;
 	printf_s(oss.str().c_str());
 }
@@ -731,23 +947,20 @@ void TextBox::InputDelete(DeleteInputType deleteType) noexcept
 
 		if (m_SelectIndex < m_CursorIndex)
 		{
-			Text.erase(m_SelectIndex, GetSelectionLenght());
+			EraseText(m_SelectIndex, GetSelectionLenght());
 			m_CursorIndex = m_SelectIndex;
 		}
 		else if (m_SelectIndex > m_CursorIndex)
 		{
-			Text.erase(m_CursorIndex, GetSelectionLenght());
+			EraseText(m_CursorIndex, GetSelectionLenght());
 			m_SelectIndex = m_CursorIndex;
 		}
 		else
 		{
-			Text.erase(m_CursorIndex - 1, 1);
-
-			if (m_SelectIndex > 0)
-			{
-				--m_SelectIndex;
-				--m_CursorIndex;
-			}
+			// The whole cluster before the caret is removed (ex: a letter and its accent)
+			const size_t previous = m_Clusters.GetPreviousStop(m_CursorIndex);
+			EraseText(previous, m_CursorIndex - previous);
+			m_CursorIndex = m_SelectIndex = previous;
 		}
 
 		break;
@@ -755,25 +968,25 @@ void TextBox::InputDelete(DeleteInputType deleteType) noexcept
 	case DeleteInputType::Delete:
 	{
 		// Does nothing if delete is pressed on the end of the string
-		if (m_SelectIndex == Text.size() && m_CursorIndex == Text.size())
+		if (m_SelectIndex == m_Document.GetLength() && m_CursorIndex == m_Document.GetLength())
 		{
 			return;
 		}
 
 		if (m_SelectIndex < m_CursorIndex)
 		{
-			Text.erase(m_SelectIndex, GetSelectionLenght());
+			EraseText(m_SelectIndex, GetSelectionLenght());
 			m_CursorIndex = m_SelectIndex;
 		}
 		else if (m_SelectIndex > m_CursorIndex)
 		{
-			Text.erase(m_CursorIndex, GetSelectionLenght());
+			EraseText(m_CursorIndex, GetSelectionLenght());
 			m_SelectIndex = m_CursorIndex;
 		}
 		else
 		{
 			// Delete doesn't move cursor when used
-			Text.erase(m_CursorIndex, 1);
+			EraseText(m_CursorIndex, m_Clusters.GetNextStop(m_CursorIndex) - m_CursorIndex);
 		}
 
 		break;
@@ -787,12 +1000,12 @@ void TextBox::InputDelete(DeleteInputType deleteType) noexcept
 
 		if (m_SelectIndex < m_CursorIndex)
 		{
-			Text.erase(m_SelectIndex, GetSelectionLenght());
+			EraseText(m_SelectIndex, GetSelectionLenght());
 			m_CursorIndex = m_SelectIndex;
 		}
 		else if (m_SelectIndex > m_CursorIndex)
 		{
-			Text.erase(m_CursorIndex, GetSelectionLenght());
+			EraseText(m_CursorIndex, GetSelectionLenght());
 			m_SelectIndex = m_CursorIndex;
 		}
 		break;
@@ -802,6 +1015,7 @@ void TextBox::InputDelete(DeleteInputType deleteType) noexcept
 
 void TextBox::InputRedraw() noexcept
 {
+	m_IsScrollToCaretPending = true;
 	Update();
 }
 
@@ -820,36 +1034,33 @@ void TextBox::PaintSelection(HDC& hdc, RECT& r, size_t start, size_t end) const
 
 	As everything is working fine except the scrolling, I'll delay this feature to the future.
 	/**************************************************************************************************/
-	int currentX = 0;
+	const int startX = m_CaretPosition.GetPosition(start);
+	const int endX = m_CaretPosition.GetPosition(end);
 
-	// Draw text prior to selection
-	SIZE s;
+	// Characters after the client area are never drawn (there's no horizontal scrolling yet)
+	const size_t last = m_CaretPosition.FindIndex(r.right - r.left);
 
+	// Draw text prior to selection
 	if (start != 0)
 	{
-		GetTextExtentPoint32(hdc, Text.substr(0, start).c_str(), static_cast<int>(start), &s);
 		SetBkMode(hdc, TRANSPARENT);
 		SetBkColor(hdc, RGB(m_BackgroundColor.GetR(), m_BackgroundColor.GetG(), m_BackgroundColor.GetB()));
 		SetTextColor(hdc, RGB(m_ForeColor.GetR(), m_ForeColor.GetG(), m_ForeColor.GetB()));
-		TextOut(hdc, r.left, r.top, Text.substr(0, start).c_str(), static_cast<int>(start));
-		currentX += s.cx;
+		DrawTextRange(hdc, r.left, r.top, 0, (std::min)(start, last));
 	}
 
-	GetTextExtentPoint32(hdc, Text.substr(start, end - start).c_str(), static_cast<int>(end - start), &s);
 	SetBkMode(hdc, OPAQUE);
 	SetBkColor(hdc, RGB(0, 120, 215));
 	SetTextColor(hdc, RGB(255, 255, 255));
-	TextOut(hdc, r.left + currentX, r.top, Text.substr(start, end - start).c_str(), static_cast<int>(end - start));
-	currentX += s.cx;
-	r.right = currentX;
+	DrawTextRange(hdc, r.left, r.top, start, (std::min)(end, last));
+	r.right = endX;
 
-	if (end != Text.length())
+	if (end != m_Document.GetLength())
 	{
-		GetTextExtentPoint32(hdc, Text.substr(end, Text.length() - end).c_str(), static_cast<int>(Text.length() - end), &s);
 		SetBkMode(hdc, TRANSPARENT);
 		SetBkColor(hdc, RGB(m_BackgroundColor.GetR(), m_BackgroundColor.GetG(), m_BackgroundColor.GetB()));
 		SetTextColor(hdc, RGB(m_ForeColor.GetR(), m_ForeColor.GetG(), m_ForeColor.GetB()));
-		TextOut(hdc, r.left + currentX, r.top, Text.substr(end, Text.length() - end).c_str(), static_cast<int>(Text.length() - end));
+		DrawTextRange(hdc, r.left, r.top, end, last);
 	}
 }
 
@@ -863,19 +1074,30 @@ TextBox::TextBox(Control* parent, int width, int x, int y)
 TextBox::TextBox(Control* parent, const std::string& name, int width, int x, int y)
 	:
 	Control(parent, name, width, 0, x, y),	// Default control size without font is 9
-	m_SelectIndex(Text.length()),
-	m_CursorIndex(Text.length()),
+	m_Document(name),
+	m_IsDocumentTextValid(false),
+	m_Clusters(m_Document),
+	m_IsApplyingJournal(false),
+	m_View(m_Document),
+	m_TextTop(0),
+	m_IsScrollToCaretPending(false),
+	m_IsHighlightingMatches(false),
+	m_SelectIndex(m_Document.GetLength()),
+	m_CursorIndex(m_Document.GetLength()),
 	m_IsCaretVisible(false),
 	m_IsMultiline(false),
 	m_MaximumLenght(32767),
-	BorderStyle(BorderStyle::Fixed3D)
+	m_CaretOffset(0),
+	m_IsCaretValid(false),
+	BorderStyle(BorderStyle::Fixed3D),
+	OnPasteProgress(nullptr)
 {
 	Initialize();
 }
 
 TextBox::~TextBox()
 {
-
+	if (OnPasteProgress != nullptr) { delete OnPasteProgress; OnPasteProgress = nullptr; }
 }
 
 void TextBox::Initialize()
@@ -904,6 +1126,33 @@ void TextBox::Initialize()
 	m_Size = CalculateSizeByFont();
 }
 
+const std::string& TextBox::GetText() const noexcept
+{
+	if (!m_IsDocumentTextValid)
+	{
+		m_DocumentText = m_Document.GetText();
+		m_IsDocumentTextValid = true;
+	}
+
+	return m_DocumentText;
+}
+
+void TextBox::SetText(const std::string& text) noexcept
+{
+	Control::SetText(text);
+
+	m_Document.Assign(text);
+	m_IsDocumentTextValid = false;
+	m_Clusters.Invalidate();
+	m_Journal.Clear();
+	m_Search.Invalidate();
+	m_View.Invalidate();
+	m_View.ScrollTo(0);
+	m_IsCaretValid = false;
+	m_CursorIndex = (std::min)(m_CursorIndex, m_Document.GetLength());
+	m_SelectIndex = (std::min)(m_SelectIndex, m_Document.GetLength());
+}
+
 size_t TextBox::GetSelectionLenght() const noexcept
 {
 	if (m_CursorIndex < m_SelectIndex)
@@ -920,12 +1169,30 @@ std::string TextBox::GetSelectedText() const noexcept
 {
 	if (m_CursorIndex < m_SelectIndex)
 	{
-		return Text.substr(m_CursorIndex, GetSelectionLenght());
+		return m_Document.GetText(m_CursorIndex, GetSelectionLenght());
 	}
 	else
 	{
-		return Text.substr(m_SelectIndex, GetSelectionLenght());
+		return m_Document.GetText(m_SelectIndex, GetSelectionLenght());
+	}
+}
+
+bool TextBox::IsMultiline() const noexcept
+{
+	return m_IsMultiline;
+}
+
+void TextBox::SetMultiline(bool isMultiline) noexcept
+{
+	if (m_IsMultiline == isMultiline)
+	{
+		return;
 	}
+
+	m_IsMultiline = isMultiline;
+	m_IsCaretValid = false;
+	m_View.Invalidate();
+	Update();
 }
 
 unsigned int TextBox::GetMaximumLength() const noexcept
@@ -940,4 +1207,213 @@ void TextBox::SetMaximumLength(unsigned int maximumLength) noexcept
 	{
 		m_MaximumLenght = maximumLength;
 	}
+}
+
+bool TextBox::CanUndo() const noexcept
+{
+	return m_Journal.CanUndo();
+}
+
+bool TextBox::CanRedo() const noexcept
+{
+	return m_Journal.CanRedo();
+}
+
+void TextBox::Undo() noexcept
+{
+	const auto edit = m_Journal.Undo();
+
+	if (edit == nullptr)
+	{
+		return;
+	}
+
+	m_IsApplyingJournal = true;
+	EraseText(edit->Offset, edit->Inserted.length());
+	InsertText(edit->Offset, edit->Removed);
+	m_IsApplyingJournal = false;
+
+	m_CursorIndex = m_SelectIndex = edit->Offset + edit->Removed.length();
+	InputRedraw();
+}
+
+void TextBox::Redo() noexcept
+{
+	const auto edit = m_Journal.Redo();
+
+	if (edit == nullptr)
+	{
+		return;
+	}
+
+	m_IsApplyingJournal = true;
+	EraseText(edit->Offset, edit->Removed.length());
+	InsertText(edit->Offset, edit->Inserted);
+	m_IsApplyingJournal = false;
+
+	m_CursorIndex = m_SelectIndex = edit->Offset + edit->Inserted.length();
+	InputRedraw();
+}
+
+void TextBox::ClearUndo() noexcept
+{
+	m_Journal.Clear();
+}
+
+size_t TextBox::GetUndoMemoryBudget() const noexcept
+{
+	return m_Journal.GetMemoryBudget();
+}
+
+void TextBox::SetUndoMemoryBudget(size_t bytes) noexcept
+{
+	m_Journal.SetMemoryBudget(bytes);
+}
+
+size_t TextBox::Find(const std::string& text, size_t start, bool isCaseSensitive) noexcept
+{
+	m_Search.SetPattern(text, isCaseSensitive);
+
+	const size_t index = m_Search.FindNext(m_Document, start);
+
+	if (index == TextSearch::NotFound)
+	{
+		return index;
+	}
+
+	m_Journal.BreakMerge();
+	m_CursorIndex = index;
+	m_SelectIndex = index + text.length();
+	InputRedraw();
+	return index;
+}
+
+size_t TextBox::FindNext() noexcept
+{
+	if (m_Search.GetPattern().empty())
+	{
+		return TextSearch::NotFound;
+	}
+
+	// Starts right after the beginning of the current match so overlapping ones are found too
+	const size_t start = (std::min)(m_CursorIndex, m_SelectIndex) + (m_CursorIndex != m_SelectIndex ? 1 : 0);
+
+	return Find(m_Search.GetPattern(), start, m_Search.IsCaseSensitive());
+}
+
+size_t TextBox::GetMatchCount() noexcept
+{
+	return m_Search.FindAll(m_Document).size();
+}
+
+void TextBox::HighlightMatches(const std::string& text, bool isCaseSensitive) noexcept
+{
+	m_Search.SetPattern(text, isCaseSensitive);
+	m_IsHighlightingMatches = true;
+	Update();
+}
+
+void TextBox::ClearHighlight() noexcept
+{
+	if (m_IsHighlightingMatches)
+	{
+		m_IsHighlightingMatches = false;
+		Update();
+	}
+}
+
+size_t TextBox::ReplaceAll(const std::string& text, const std::string& replacement, bool isCaseSensitive) noexcept
+{
+	m_Search.SetPattern(text, isCaseSensitive);
+
+	const auto result = m_Search.ReplaceAll(m_Document, replacement);
+
+	if (result.Count == 0 || m_Document.GetLength() - result.Length + result.Text.length() > m_MaximumLenght)
+	{
+		return 0;
+	}
+
+	// Only the span between the first and the last match is replaced, as a single journal entry. Like a paste, a
+	// replacement that doesn't fit the undo budget can't be undone, and neither can anything before it
+	m_Journal.BreakMerge();
+
+	if (result.Length + result.Text.length() <= m_Journal.GetMemoryBudget())
+	{
+		m_Journal.Record(result.Offset, m_Document.GetText(result.Offset, result.Length), result.Text);
+	}
+	else
+	{
+		m_Journal.Clear();
+	}
+
+	m_Journal.BreakMerge();
+
+	m_IsApplyingJournal = true;
+	EraseText(result.Offset, result.Length);
+	InsertText(result.Offset, result.Text);
+	m_IsApplyingJournal = false;
+
+	m_CursorIndex = m_SelectIndex = result.Offset + result.Text.length();
+	InputRedraw();
+	return result.Count;
+}
+
+void TextBox::Paste(IClipboardSource& source) noexcept
+{
+	const size_t start = (std::min)(m_CursorIndex, m_SelectIndex);
+	const size_t selected = GetSelectionLenght();
+	const size_t remaining = m_Document.GetLength() - selected;
+
+	// Maximum length is enforced before reading anything, so the characters that don't fit are never copied
+	ChunkedPaste paste(source, m_MaximumLenght > remaining ? m_MaximumLenght - remaining : 0);
+
+	if (paste.GetLength() == 0)
+	{
+		return;
+	}
+
+	// The replaced selection and the pasted text are undone in a single step. A paste that doesn't fit the undo budget
+	// can't be undone, and neither can anything before it
+	const bool isRecorded = selected + paste.GetLength() <= m_Journal.GetMemoryBudget();
+	const std::string removed = isRecorded ? m_Document.GetText(start, selected) : std::string();
+
+	m_Journal.BreakMerge();
+	m_IsApplyingJournal = true;
+	EraseText(start, selected);
+	m_Document.Reserve(paste.GetLength());
+
+	// Chunks only update the document and its indexes. Multiline TextBoxes lay out the visible lines on the next draw
+	for (auto chunk = paste.Next(); !chunk.empty(); chunk = paste.Next())
+	{
+		InsertText(start + paste.GetPosition() - chunk.length(), chunk);
+
+		PasteProgressEventArgs args(paste.GetPosition(), paste.GetLength());
+		Dispatch("OnPasteProgress", &args);
+
+		if (args.Cancel)
+		{
+			break;
+		}
+	}
+
+	m_IsApplyingJournal = false;
+
+	if (isRecorded)
+	{
+		m_Journal.Record(start, removed, m_Document.GetText(start, paste.GetPosition()));
+	}
+	else
+	{
+		m_Journal.Clear();
+	}
+
+	m_Journal.BreakMerge();
+	m_CursorIndex = m_SelectIndex = start + paste.GetPosition();
+	InputRedraw();
+}
+
+void TextBox::OnPasteProgressSet(const std::function<void(Object*, PasteProgressEventArgs*)>& callback) noexcept
+{
+	OnPasteProgress = new PasteProgressEventHandler("OnPasteProgress", callback);
+	Events.Register(OnPasteProgress);
 }
\ No newline at end of file
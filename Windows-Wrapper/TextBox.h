@@ -1,6 +1,14 @@
 #pragma once
 
 #include "Control.h"
+#include "AdvanceIndex.h"
+#include "PieceTable.h"
+#include "GraphemeIndex.h"
+#include "UndoJournal.h"
+#include "TextView.h"
+#include "TextSearch.h"
+#include "ChunkedPaste.h"
+#include "PasteProgressEventHandler.h"
 
 class TextBox final: public Control
 {
@@ -8,6 +16,28 @@ class TextBox final: public Control
 
 private:
 
+	// Content of the TextBox. Control::Text only keeps the initial (or last set) text and GetText builds a copy of the
+	// document when it's requested after an edit
+	PieceTable m_Document;
+	mutable std::string m_DocumentText;
+	mutable bool m_IsDocumentTextValid;
+
+	// Caret stops of the UTF-8 content, so the caret never lands inside a multibyte character or a cluster
+	GraphemeIndex m_Clusters;
+
+	// Edits made by the user. Undo and Redo apply them through InsertText/EraseText without recording them again
+	UndoJournal m_Journal;
+	bool m_IsApplyingJournal;
+
+	// Lines of the multiline TextBox. Only the ones inside the client area are laid out and drawn
+	TextView m_View;
+	int m_TextTop;
+	bool m_IsScrollToCaretPending;
+
+	// Matches of the last search. Kept up to date by InsertText/EraseText and painted while highlighting is enabled
+	TextSearch m_Search;
+	bool m_IsHighlightingMatches;
+
 	// Used to track Caret positioning for input
 	size_t m_SelectIndex;
 	size_t m_CursorIndex;
@@ -23,7 +53,13 @@ private:
 	bool m_IsCaretVisible;
 	bool m_IsMultiline;
 	unsigned int m_MaximumLenght;
-	std::vector<int> m_CaretPosition;
+
+	// Advance of each character of the document, so placing the caret or finding the character under the mouse doesn't measure
+	// every prefix again. Kept in sync by InsertText/EraseText and measured again only when the font changes
+	AdvanceIndex m_CaretPosition;
+	FontDescriptor m_CaretFont;
+	int m_CaretOffset;
+	bool m_IsCaretValid;
 
 	enum class DeleteInputType
 	{
@@ -40,10 +76,18 @@ private:
 	void OnKeyPressed_Impl(HWND hwnd, char c, int cRepeat) noexcept override;
 	void OnMouseLeftDown_Impl(HWND hwnd, int x, int y, unsigned int keyFlags) noexcept override;
 	void OnMouseMove_Impl(HWND hwnd, int x, int y, unsigned int keyFlags) noexcept override;
+	void OnMouseWheel_Impl(HWND hwnd, int x, int y, int delta, unsigned int fwKeys) noexcept override;
 	void OnFocusEnter_Impl(HWND hwnd, HWND hwndOldFocus) noexcept override;
 	void OnFocusLeave_Impl(HWND hwnd, HWND hwndNewFocus) noexcept override;
 
-	void CalculateCaret(HWND hwnd, const HDC& hdc) noexcept;
+	void CalculateCaret() noexcept;
+	size_t GetIndexFromPoint(int x, int y) noexcept;
+	void MoveCaretByLines(long long lines, bool isSelecting) noexcept;
+	void InsertText(size_t index, std::string_view text) noexcept;
+	void EraseText(size_t index, size_t count) noexcept;
+	void DrawTextRange(HDC hdc, int x, int y, size_t start, size_t end) const noexcept;
+	void DrawLines(HDC hdc, const RECT& r) noexcept;
+	template<typename F> void PaintMatches(HDC hdc, const RECT& r, int top, int height, size_t start, size_t end, F&& getPosition) noexcept;
 	void CopyToClipboard() const noexcept;
 	void PasteFromClipboard() noexcept;
 	void EnableCaret() noexcept;
@@ -59,13 +103,41 @@ private:
 public:
 
 	BorderStyle BorderStyle;
+	PasteProgressEventHandler* OnPasteProgress;
 
 	virtual ~TextBox();
 
 	size_t GetSelectionLenght() const noexcept;
 	std::string GetSelectedText() const noexcept;
 	void Initialize() override;
+	const std::string& GetText() const noexcept override;
+	void SetText(const std::string& text) noexcept override;
 
+	bool IsMultiline() const noexcept;
+	void SetMultiline(bool isMultiline) noexcept;
 	unsigned int GetMaximumLength() const noexcept;
 	void SetMaximumLength(unsigned int maximumLength) noexcept;
+
+	bool CanUndo() const noexcept;
+	bool CanRedo() const noexcept;
+	void Undo() noexcept;
+	void Redo() noexcept;
+	void ClearUndo() noexcept;
+	size_t GetUndoMemoryBudget() const noexcept;
+	void SetUndoMemoryBudget(size_t bytes) noexcept;
+
+	// Replaces the selection by the text of the source, inserted in chunks. OnPasteProgress is raised after each chunk
+	// and can cancel the rest of the paste
+	void Paste(IClipboardSource& source) noexcept;
+	void OnPasteProgressSet(const std::function<void(Object*, PasteProgressEventArgs*)>& callback) noexcept;
+
+	// Selects the first match at or after start and returns its index (TextSearch::NotFound when there's none)
+	size_t Find(const std::string& text, size_t start = 0, bool isCaseSensitive = true) noexcept;
+	size_t FindNext() noexcept;
+	size_t GetMatchCount() noexcept;
+	void HighlightMatches(const std::string& text, bool isCaseSensitive = true) noexcept;
+	void ClearHighlight() noexcept;
+
+	// Returns the number of replaced matches. Undone in a single step
+	size_t ReplaceAll(const std::string& text, const std::string& replacement, bool isCaseSensitive = true) noexcept;
 };
\ No newline at end of file
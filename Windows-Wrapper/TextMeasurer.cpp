@@ -0,0 +1,113 @@
+#include "TextMeasurer.h"
+
+TextMeasurer::TextMeasurer(std::unique_ptr<ITextMetrics> backend, size_t capacity)
+	:
+	m_Backend(std::move(backend)),
+	m_Capacity(capacity > 0 ? capacity : 1),
+	m_Hits(0),
+	m_Misses(0)
+{
+
+}
+
+const TextMeasurer::FontEntry& TextMeasurer::GetFontEntry(const FontDescriptor& font)
+{
+	if (auto it = m_Fonts.find(font); it != m_Fonts.end())
+	{
+		return it->second;
+	}
+
+	FontEntry entry;
+	entry.Id = m_Fonts.size();
+	entry.Metrics = m_Backend->GetFontMetrics(font);
+	entry.HasKerning = m_Backend->HasKerning(font);
+	m_Backend->GetAdvances(font, entry.Advances);
+
+	return m_Fonts.emplace(font, entry).first->second;
+}
+
+const FontMetrics& TextMeasurer::GetFontMetrics(const FontDescriptor& font)
+{
+	return GetFontEntry(font).Metrics;
+}
+
+int TextMeasurer::GetAdvance(const FontDescriptor& font, char c)
+{
+	return GetFontEntry(font).Advances[static_cast<unsigned char>(c)];
+}
+
+void TextMeasurer::GetAdvances(const FontDescriptor& font, std::string_view text, int* advances)
+{
+	const auto& f = GetFontEntry(font);
+
+	for (const auto c : text)
+	{
+		*advances++ = f.Advances[static_cast<unsigned char>(c)];
+	}
+}
+
+int TextMeasurer::MeasureWidth(const FontDescriptor& font, std::string_view text)
+{
+	const auto& f = GetFontEntry(font);
+
+	// Fast path: without kerning the width is the sum of the advances
+	if (!f.HasKerning)
+	{
+		int ret = 0;
+
+		for (const auto c : text)
+		{
+			ret += f.Advances[static_cast<unsigned char>(c)];
+		}
+
+		return ret;
+	}
+
+	ExtentKey key{ f.Id, std::string(text) };
+
+	if (auto it = m_ExtentIndex.find(key); it != m_ExtentIndex.end())
+	{
+		++m_Hits;
+
+		// Move to the front as the most recently used
+		m_Extents.splice(m_Extents.begin(), m_Extents, it->second);
+		return it->second->second;
+	}
+
+	++m_Misses;
+
+	const int width = m_Backend->MeasureWidth(font, text);
+
+	if (m_Extents.size() >= m_Capacity)
+	{
+		m_ExtentIndex.erase(m_Extents.back().first);
+		m_Extents.pop_back();
+	}
+
+	m_Extents.emplace_front(std::move(key), width);
+	m_ExtentIndex.emplace(m_Extents.front().first, m_Extents.begin());
+
+	return width;
+}
+
+TextExtent TextMeasurer::Measure(const FontDescriptor& font, std::string_view text)
+{
+	return TextExtent{ MeasureWidth(font, text), GetFontEntry(font).Metrics.Height };
+}
+
+void TextMeasurer::Clear() noexcept
+{
+	m_Fonts.clear();
+	m_Extents.clear();
+	m_ExtentIndex.clear();
+}
+
+size_t TextMeasurer::GetCacheHits() const noexcept
+{
+	return m_Hits;
+}
+
+size_t TextMeasurer::GetCacheMisses() const noexcept
+{
+	return m_Misses;
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "ITextMetrics.h"
+
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+/*
+Text measurement service shared by every control.
+
+Each font gets an entry with its metrics and the advance of all single byte characters, loaded from the backend with
+one call the first time the font is used. When the font has no kerning (GDI never applies it on GetTextExtentPoint32)
+the width of a string is just the sum of the advances, so no backend call is needed at all.
+Fonts with kerning go through the backend, and the results are kept in a LRU of whole string extents.
+*/
+class TextMeasurer
+{
+private:
+
+	struct FontEntry
+	{
+		size_t Id;
+		FontMetrics Metrics;
+		bool HasKerning;
+		int Advances[256];
+	};
+
+	struct ExtentKey
+	{
+		size_t FontId;
+		std::string Text;
+
+		bool operator==(const ExtentKey& k) const noexcept = default;
+	};
+
+	struct ExtentKeyHash
+	{
+		size_t operator()(const ExtentKey& k) const noexcept
+		{
+			return std::hash<std::string>()(k.Text) ^ (k.FontId * 0x9E3779B97F4A7C15ull);
+		}
+	};
+
+	using LruList = std::list<std::pair<ExtentKey, int>>;
+
+	std::unique_ptr<ITextMetrics> m_Backend;
+	std::unordered_map<FontDescriptor, FontEntry, FontDescriptorHash> m_Fonts;
+	LruList m_Extents;
+	std::unordered_map<ExtentKey, LruList::iterator, ExtentKeyHash> m_ExtentIndex;
+	size_t m_Capacity;
+	size_t m_Hits;
+	size_t m_Misses;
+
+	const FontEntry& GetFontEntry(const FontDescriptor& font);
+
+public:
+
+	explicit TextMeasurer(std::unique_ptr<ITextMetrics> backend, size_t capacity = 1024);
+
+	const FontMetrics& GetFontMetrics(const FontDescriptor& font);
+	int GetAdvance(const FontDescriptor& font, char c);
+
+	// Writes the advance of each character of the text into advances (must hold text.length() entries)
+	void GetAdvances(const FontDescriptor& font, std::string_view text, int* advances);
+	int MeasureWidth(const FontDescriptor& font, std::string_view text);
+	TextExtent Measure(const FontDescriptor& font, std::string_view text);
+
+	// Drops every cached font and extent (ex: after a DPI change)
+	void Clear() noexcept;
+	size_t GetCacheHits() const noexcept;
+	size_t GetCacheMisses() const noexcept;
+};
\ No newline at end of file
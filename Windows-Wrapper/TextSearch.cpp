@@ -0,0 +1,337 @@
+#include "TextSearch.h"
+
+#include <bit>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define TEXTSEARCH_SSE2
+#endif
+
+TextSearch::TextSearch()
+	:
+	m_IsCaseSensitive(true),
+	m_IsCacheValid(false),
+	m_IsRefinePending(false)
+{
+	SetPattern({}, true);
+}
+
+bool TextSearch::IsMatch(const char* text) const noexcept
+{
+	if (m_IsCaseSensitive) return std::memcmp(text, m_Pattern.data(), m_Pattern.length()) == 0;
+
+	for (size_t i = 0; i < m_Pattern.length(); ++i)
+	{
+		if (m_Fold[static_cast<unsigned char>(text[i])] != static_cast<unsigned char>(m_Pattern[i])) return false;
+	}
+
+	return true;
+}
+
+bool TextSearch::IsMatch(const PieceTable& document, size_t offset) const
+{
+	if (offset + m_Pattern.length() > document.GetLength()) return false;
+
+	size_t i = 0;
+	bool isMatch = true;
+
+	// Matches spanning pieces are compared chunk by chunk without copying them
+	document.ForEachChunk(offset, m_Pattern.length(), [&](std::string_view chunk)
+		{
+			for (size_t j = 0; isMatch && j < chunk.length(); ++j, ++i)
+			{
+				isMatch = m_Fold[static_cast<unsigned char>(chunk[j])] == static_cast<unsigned char>(m_Pattern[i]);
+			}
+		});
+
+	return isMatch;
+}
+
+size_t TextSearch::FindFirstCharacter(std::string_view text, size_t start) const noexcept
+{
+	const char* data = text.data();
+	const size_t length = m_Pattern.length();
+	const size_t last = text.length() - length;
+	const auto first = static_cast<unsigned char>(m_Pattern.front());
+	const auto tail = static_cast<unsigned char>(m_Pattern.back());
+
+	// Pattern is folded to lowercase, so the uppercase letter is the other candidate
+	auto other = [&](unsigned char c) -> unsigned char { return !m_IsCaseSensitive && c >= 'a' && c <= 'z' ? c - 'a' + 'A' : c; };
+
+	size_t i = start;
+
+#ifdef TEXTSEARCH_SSE2
+	// The last character is checked too (from the block ending the candidates), so common first characters
+	// don't send every occurrence to the verification
+	const __m128i a = _mm_set1_epi8(static_cast<char>(first));
+	const __m128i b = _mm_set1_epi8(static_cast<char>(other(first)));
+	const __m128i c = _mm_set1_epi8(static_cast<char>(tail));
+	const __m128i d = _mm_set1_epi8(static_cast<char>(other(tail)));
+
+	for (; i + 15 <= last; i += 16)
+	{
+		const __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+		const __m128i end = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + length - 1));
+		const __m128i heads = _mm_or_si128(_mm_cmpeq_epi8(head, a), _mm_cmpeq_epi8(head, b));
+		const __m128i ends = _mm_or_si128(_mm_cmpeq_epi8(end, c), _mm_cmpeq_epi8(end, d));
+		auto mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_and_si128(heads, ends)));
+
+		while (mask != 0)
+		{
+			const size_t candidate = i + std::countr_zero(mask);
+
+			if (IsMatch(data + candidate)) return candidate;
+
+			mask &= mask - 1;
+		}
+	}
+#endif
+
+	const unsigned char second = other(first);
+
+	for (; i <= last; ++i)
+	{
+		const auto ch = static_cast<unsigned char>(data[i]);
+
+		if ((ch == first || ch == second) && IsMatch(data + i)) return i;
+	}
+
+	return NotFound;
+}
+
+size_t TextSearch::FindHorspool(std::string_view text, size_t start) const noexcept
+{
+	const auto data = reinterpret_cast<const unsigned char*>(text.data());
+	const size_t length = m_Pattern.length();
+	const size_t last = text.length() - length;
+	const auto tail = static_cast<unsigned char>(m_Pattern.back());
+
+	for (size_t i = start; i <= last;)
+	{
+		const unsigned char c = m_Fold[data[i + length - 1]];
+
+		if (c == tail && IsMatch(text.data() + i)) return i;
+
+		i += m_Skip[c];
+	}
+
+	return NotFound;
+}
+
+void TextSearch::FindAll(std::string_view text, size_t offset, std::vector<size_t>& matches) const
+{
+	for (size_t i = Find(text); i != NotFound; i = Find(text, i + 1))
+	{
+		matches.push_back(offset + i);
+	}
+}
+
+void TextSearch::Scan(const PieceTable& document)
+{
+	m_Matches.clear();
+
+	const size_t overlap = m_Pattern.length() - 1;
+	std::string carry;	// Last characters of the previous chunks, for the matches spanning two pieces
+	std::string joint;
+	size_t offset = 0;
+
+	document.ForEachChunk(0, document.GetLength(), [&](std::string_view chunk)
+		{
+			if (!carry.empty())
+			{
+				joint.assign(carry);
+				joint.append(chunk.substr(0, overlap));
+
+				for (size_t i = Find(joint); i != NotFound && i < carry.length(); i = Find(joint, i + 1))
+				{
+					m_Matches.push_back(offset - carry.length() + i);
+				}
+			}
+
+			FindAll(chunk, offset, m_Matches);
+			offset += chunk.length();
+
+			if (chunk.length() >= overlap)
+			{
+				carry.assign(chunk.substr(chunk.length() - overlap));
+			}
+			else
+			{
+				carry.append(chunk);
+				carry.erase(0, carry.length() > overlap ? carry.length() - overlap : 0);
+			}
+		});
+
+	m_IsCacheValid = true;
+	m_IsRefinePending = false;
+}
+
+void TextSearch::Refine(const PieceTable& document)
+{
+	// Every match of the longer pattern is also a match of its prefix
+	std::erase_if(m_Matches, [&](size_t offset) { return !IsMatch(document, offset); });
+	m_IsRefinePending = false;
+}
+
+void TextSearch::SetPattern(std::string_view pattern, bool isCaseSensitive)
+{
+	for (int i = 0; i < 256; ++i)
+	{
+		m_Fold[i] = !isCaseSensitive && i >= 'A' && i <= 'Z' ? static_cast<unsigned char>(i - 'A' + 'a') : static_cast<unsigned char>(i);
+	}
+
+	std::string folded(pattern);
+
+	for (auto& c : folded)
+	{
+		c = static_cast<char>(m_Fold[static_cast<unsigned char>(c)]);
+	}
+
+	if (folded == m_Pattern && isCaseSensitive == m_IsCaseSensitive) return;
+
+	const bool isExtension = m_IsCacheValid && !m_Pattern.empty() && isCaseSensitive == m_IsCaseSensitive && folded.starts_with(m_Pattern);
+
+	m_Pattern = std::move(folded);
+	m_IsCaseSensitive = isCaseSensitive;
+	m_IsCacheValid = isExtension;
+	m_IsRefinePending = m_IsRefinePending || isExtension;
+
+	if (!isExtension)
+	{
+		m_Matches.clear();
+	}
+
+	const size_t length = m_Pattern.length();
+
+	// Indexed by the folded character so both cases of a letter skip the same distance
+	std::fill(std::begin(m_Skip), std::end(m_Skip), length);
+
+	for (size_t i = 0; i + 1 < length; ++i)
+	{
+		m_Skip[static_cast<unsigned char>(m_Pattern[i])] = length - 1 - i;
+	}
+}
+
+const std::string& TextSearch::GetPattern() const noexcept
+{
+	return m_Pattern;
+}
+
+bool TextSearch::IsCaseSensitive() const noexcept
+{
+	return m_IsCaseSensitive;
+}
+
+size_t TextSearch::Find(std::string_view text, size_t start) const noexcept
+{
+	if (m_Pattern.empty() || start > text.length() || text.length() - start < m_Pattern.length()) return NotFound;
+
+	if (m_Pattern.length() >= HorspoolMinimumLength) return FindHorspool(text, start);
+
+	return FindFirstCharacter(text, start);
+}
+
+const std::vector<size_t>& TextSearch::FindAll(const PieceTable& document)
+{
+	if (m_Pattern.empty())
+	{
+		m_Matches.clear();
+	}
+	else if (!m_IsCacheValid)
+	{
+		Scan(document);
+	}
+	else if (m_IsRefinePending)
+	{
+		// Verifying each match walks the pieces again, scanning is cheaper when the prefix matched almost everywhere
+		if (m_Matches.size() * RefineMaximumDensity > document.GetLength())
+		{
+			Scan(document);
+		}
+		else
+		{
+			Refine(document);
+		}
+	}
+
+	return m_Matches;
+}
+
+size_t TextSearch::FindNext(const PieceTable& document, size_t offset)
+{
+	const auto& matches = FindAll(document);
+
+	if (matches.empty()) return NotFound;
+
+	const auto it = std::lower_bound(matches.begin(), matches.end(), offset);
+
+	return it != matches.end() ? *it : matches.front();
+}
+
+TextSearch::Replacement TextSearch::ReplaceAll(const PieceTable& document, std::string_view replacement)
+{
+	const auto& matches = FindAll(document);
+
+	Replacement ret{ 0, 0, {}, 0 };
+
+	if (matches.empty()) return ret;
+
+	const size_t length = m_Pattern.length();
+	size_t position = matches.front();
+
+	ret.Offset = position;
+
+	for (const auto offset : matches)
+	{
+		// Overlapping matches are skipped, the first one wins
+		if (offset < position) continue;
+
+		document.ForEachChunk(position, offset - position, [&](std::string_view chunk) { ret.Text.append(chunk); });
+		ret.Text.append(replacement);
+		position = offset + length;
+		++ret.Count;
+	}
+
+	ret.Length = position - ret.Offset;
+	return ret;
+}
+
+void TextSearch::OnEdit(const PieceTable& document, size_t offset, size_t removed, size_t inserted)
+{
+	if (!m_IsCacheValid || (removed == 0 && inserted == 0)) return;
+
+	// Cached matches still belong to the shorter pattern, so they can't be updated with the current one
+	if (m_IsRefinePending)
+	{
+		Invalidate();
+		return;
+	}
+
+	const size_t overlap = m_Pattern.length() - 1;
+
+	// Matches ending inside (or crossing) the edited range are gone and the ones after it are moved
+	const auto first = std::lower_bound(m_Matches.begin(), m_Matches.end(), offset > overlap ? offset - overlap : 0);
+	const auto last = std::lower_bound(first, m_Matches.end(), offset + removed);
+	const auto position = m_Matches.erase(first, last);
+
+	for (auto it = position; it != m_Matches.end(); ++it)
+	{
+		*it = *it - removed + inserted;
+	}
+
+	// Only the characters around the edit can hold new matches
+	const size_t start = offset > overlap ? offset - overlap : 0;
+	const size_t end = (std::min)(offset + inserted + overlap, document.GetLength());
+
+	std::vector<size_t> found;
+	FindAll(document.GetText(start, end - start), start, found);
+	m_Matches.insert(position, found.begin(), found.end());
+}
+
+void TextSearch::Invalidate() noexcept
+{
+	m_Matches.clear();
+	m_IsCacheValid = false;
+	m_IsRefinePending = false;
+}
\ No newline at end of file
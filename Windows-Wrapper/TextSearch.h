@@ -0,0 +1,75 @@
+#pragma once
+
+#include "PieceTable.h"
+
+/*
+Find and replace engine over a PieceTable.
+
+Short patterns are found by scanning 16 characters at a time (SSE2) for the first character of the pattern and
+verifying each candidate. Patterns of HorspoolMinimumLength characters or more use Boyer-Moore-Horspool instead, which
+skips up to the whole pattern length on each mismatch. Case insensitive matching only folds the ASCII letters.
+
+FindAll positions are cached for the current pattern and edits don't drop them: OnEdit removes the matches touching
+the edited range, shifts the following ones and only searches again the few characters around the edit. Extending the
+pattern (incremental search while typing it) only verifies the cached matches instead of scanning the document.
+*/
+class TextSearch
+{
+public:
+
+	static constexpr size_t NotFound = std::string_view::npos;
+
+	// Span of the document to replace by Text, covering every replaced match
+	struct Replacement
+	{
+		size_t Offset;
+		size_t Length;
+		std::string Text;
+		size_t Count;
+	};
+
+private:
+
+	static constexpr size_t HorspoolMinimumLength = 16;
+	static constexpr size_t RefineMaximumDensity = 256;
+
+	std::string m_Pattern;			// Already folded when matching case insensitive
+	bool m_IsCaseSensitive;
+	unsigned char m_Fold[256];
+	size_t m_Skip[256];
+	std::vector<size_t> m_Matches;
+	bool m_IsCacheValid;
+	bool m_IsRefinePending;			// Cached matches belong to a prefix of the pattern
+
+	bool IsMatch(const char* text) const noexcept;
+	bool IsMatch(const PieceTable& document, size_t offset) const;
+	size_t FindFirstCharacter(std::string_view text, size_t start) const noexcept;
+	size_t FindHorspool(std::string_view text, size_t start) const noexcept;
+	void FindAll(std::string_view text, size_t offset, std::vector<size_t>& matches) const;
+	void Scan(const PieceTable& document);
+	void Refine(const PieceTable& document);
+
+public:
+
+	TextSearch();
+
+	void SetPattern(std::string_view pattern, bool isCaseSensitive = true);
+	const std::string& GetPattern() const noexcept;
+	bool IsCaseSensitive() const noexcept;
+
+	// First match starting at or after start (NotFound when there's none)
+	size_t Find(std::string_view text, size_t start = 0) const noexcept;
+
+	// Sorted positions of every match of the document, including overlapping ones
+	const std::vector<size_t>& FindAll(const PieceTable& document);
+
+	// First match at or after the offset, wrapping around to the first one (NotFound when there's none)
+	size_t FindNext(const PieceTable& document, size_t offset);
+
+	// Replaces every non overlapping match, from left to right, building the new text in a single pass
+	Replacement ReplaceAll(const PieceTable& document, std::string_view replacement);
+
+	// Must be called after each edit of the document, with the removed and inserted lengths at the offset
+	void OnEdit(const PieceTable& document, size_t offset, size_t removed, size_t inserted);
+	void Invalidate() noexcept;
+};
\ No newline at end of file
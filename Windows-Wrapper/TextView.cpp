@@ -0,0 +1,199 @@
+#include "TextView.h"
+
+TextView::TextView(const PieceTable& document, size_t capacity)
+	:
+	m_Document(document),
+	m_Measurer(nullptr),
+	m_LineHeight(1),
+	m_ViewportHeight(0),
+	m_FirstLine(0),
+	m_Capacity(capacity > 0 ? capacity : 1),
+	m_Hits(0),
+	m_Misses(0)
+{
+
+}
+
+TextView::LineLayout TextView::CreateLayout(size_t line) const
+{
+	LineLayout ret;
+
+	const size_t start = m_Document.GetLineStart(line);
+	const size_t end = line + 1 < m_Document.GetLineCount() ? m_Document.GetLineStart(line + 1) : m_Document.GetLength();
+
+	ret.Length = end - start;
+	ret.Text = m_Document.GetText(start, ret.Length);
+
+	while (!ret.Text.empty() && (ret.Text.back() == '\n' || ret.Text.back() == '\r'))
+	{
+		ret.Text.pop_back();
+	}
+
+	ret.Positions.resize(ret.Text.length() + 1, 0);
+
+	// Without a font yet (never drawn) every character has no width
+	if (m_Measurer != nullptr) m_Measurer->GetAdvances(m_Font, ret.Text, ret.Positions.data() + 1);
+
+	for (size_t i = 1; i < ret.Positions.size(); ++i)
+	{
+		ret.Positions[i] += ret.Positions[i - 1];
+	}
+
+	return ret;
+}
+
+void TextView::SetFont(TextMeasurer& measurer, const FontDescriptor& font)
+{
+	if (m_Measurer == &measurer && m_Font == font) return;
+
+	m_Measurer = &measurer;
+	m_Font = font;
+	m_LineHeight = (std::max)(1, measurer.GetFontMetrics(font).Height);
+	Invalidate();
+}
+
+int TextView::GetLineHeight() const noexcept
+{
+	return m_LineHeight;
+}
+
+void TextView::SetViewportHeight(int height) noexcept
+{
+	m_ViewportHeight = (std::max)(0, height);
+}
+
+size_t TextView::GetFirstVisibleLine() const noexcept
+{
+	return m_FirstLine;
+}
+
+size_t TextView::GetVisibleLineCount() const noexcept
+{
+	// A partially visible line at the bottom is also drawn
+	return static_cast<size_t>((m_ViewportHeight + m_LineHeight - 1) / m_LineHeight);
+}
+
+void TextView::ScrollTo(size_t line) noexcept
+{
+	m_FirstLine = (std::min)(line, m_Document.GetLineCount() - 1);
+}
+
+void TextView::ScrollBy(long long lines) noexcept
+{
+	if (lines < 0 && static_cast<size_t>(-lines) > m_FirstLine)
+	{
+		m_FirstLine = 0;
+		return;
+	}
+
+	ScrollTo(static_cast<size_t>(static_cast<long long>(m_FirstLine) + lines));
+}
+
+void TextView::EnsureVisible(size_t line) noexcept
+{
+	// Only lines completely inside the viewport count as visible here
+	const size_t count = (std::max)(static_cast<size_t>(m_ViewportHeight / m_LineHeight), static_cast<size_t>(1));
+
+	if (line < m_FirstLine)
+	{
+		ScrollTo(line);
+	}
+	else if (line >= m_FirstLine + count)
+	{
+		ScrollTo(line - count + 1);
+	}
+}
+
+const TextView::LineLayout& TextView::GetLineLayout(size_t line)
+{
+	if (auto it = m_LayoutIndex.find(line); it != m_LayoutIndex.end())
+	{
+		++m_Hits;
+		m_Layouts.splice(m_Layouts.begin(), m_Layouts, it->second);
+		return it->second->second;
+	}
+
+	++m_Misses;
+
+	if (m_Layouts.size() >= m_Capacity)
+	{
+		m_LayoutIndex.erase(m_Layouts.back().first);
+		m_Layouts.pop_back();
+	}
+
+	m_Layouts.emplace_front(line, CreateLayout(line));
+	m_LayoutIndex.emplace(line, m_Layouts.begin());
+
+	return m_Layouts.front().second;
+}
+
+size_t TextView::GetOffsetFromPoint(int x, int y)
+{
+	const size_t lines = m_Document.GetLineCount();
+	size_t line = m_FirstLine;
+
+	if (y < 0)
+	{
+		const size_t above = static_cast<size_t>((-y + m_LineHeight - 1) / m_LineHeight);
+		line = above > line ? 0 : line - above;
+	}
+	else
+	{
+		line = (std::min)(line + static_cast<size_t>(y / m_LineHeight), lines - 1);
+	}
+
+	const auto& layout = GetLineLayout(line);
+	const auto it = std::lower_bound(layout.Positions.begin(), layout.Positions.end(), x);
+	const size_t column = (std::min)(static_cast<size_t>(it - layout.Positions.begin()), layout.Text.length());
+
+	return m_Document.GetLineStart(line) + column;
+}
+
+void TextView::GetPointFromOffset(size_t offset, int& x, int& y)
+{
+	const size_t line = m_Document.GetLineFromOffset(offset);
+	const auto& layout = GetLineLayout(line);
+	const size_t column = (std::min)(offset - m_Document.GetLineStart(line), layout.Text.length());
+
+	x = layout.Positions[column];
+	y = static_cast<int>(static_cast<long long>(line) - static_cast<long long>(m_FirstLine)) * m_LineHeight;
+}
+
+void TextView::OnEdit(size_t line, size_t removedLineBreaks, size_t insertedLineBreaks)
+{
+	// Cache is small (a few viewports) so renumbering every layout is cheap
+	m_LayoutIndex.clear();
+
+	for (auto it = m_Layouts.begin(); it != m_Layouts.end();)
+	{
+		if (it->first >= line && it->first <= line + removedLineBreaks)
+		{
+			it = m_Layouts.erase(it);
+			continue;
+		}
+
+		if (it->first > line) it->first = it->first - removedLineBreaks + insertedLineBreaks;
+
+		m_LayoutIndex.emplace(it->first, it);
+		++it;
+	}
+
+	const size_t lines = m_Document.GetLineCount() - removedLineBreaks + insertedLineBreaks;
+	m_FirstLine = (std::min)(m_FirstLine, lines - 1);
+}
+
+void TextView::Invalidate() noexcept
+{
+	m_Layouts.clear();
+	m_LayoutIndex.clear();
+}
+
+size_t TextView::GetCacheHits() const noexcept
+{
+	return m_Hits;
+}
+
+size_t TextView::GetCacheMisses() const noexcept
+{
+	return m_Misses;
+}
\ No newline at end of file
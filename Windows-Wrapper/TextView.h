@@ -0,0 +1,92 @@
+#pragma once
+
+#include "PieceTable.h"
+#include "TextMeasurer.h"
+
+#include <list>
+#include <unordered_map>
+
+/*
+Virtualized view over the lines of a PieceTable.
+
+Only the lines inside the viewport are ever laid out. Each layout (the line text and the caret x before each character)
+is built from the document line index in O(log n + line length) and kept in a LRU, so scrolling or redrawing reuses the
+layouts of the lines already seen and the cost of a frame only depends on the viewport size.
+Edits only drop the layouts of the edited lines and renumber the following ones.
+*/
+class TextView
+{
+public:
+
+	struct LineLayout
+	{
+		std::string Text;				// Without the line break
+		std::vector<int> Positions;		// Caret x before each character, plus the end of the line
+		size_t Length;					// Characters in the document, including the line break
+	};
+
+private:
+
+	using LruList = std::list<std::pair<size_t, LineLayout>>;
+
+	const PieceTable& m_Document;
+	TextMeasurer* m_Measurer;
+	FontDescriptor m_Font;
+	int m_LineHeight;
+	int m_ViewportHeight;
+	size_t m_FirstLine;
+	LruList m_Layouts;
+	std::unordered_map<size_t, LruList::iterator> m_LayoutIndex;
+	size_t m_Capacity;
+	size_t m_Hits;
+	size_t m_Misses;
+
+	LineLayout CreateLayout(size_t line) const;
+
+public:
+
+	explicit TextView(const PieceTable& document, size_t capacity = 512);
+
+	// Layouts are dropped only when the measurer or the font actually changes
+	void SetFont(TextMeasurer& measurer, const FontDescriptor& font);
+	int GetLineHeight() const noexcept;
+	void SetViewportHeight(int height) noexcept;
+
+	size_t GetFirstVisibleLine() const noexcept;
+	size_t GetVisibleLineCount() const noexcept;
+	void ScrollTo(size_t line) noexcept;
+	void ScrollBy(long long lines) noexcept;
+	void EnsureVisible(size_t line) noexcept;
+
+	const LineLayout& GetLineLayout(size_t line);
+
+	// Calls function(line, offset, y, layout) for every line inside the viewport, y relative to the viewport top
+	template<typename F>
+	void ForEachVisibleLine(F&& function)
+	{
+		if (m_Measurer == nullptr) return;
+
+		const size_t last = (std::min)(m_FirstLine + GetVisibleLineCount(), m_Document.GetLineCount());
+		size_t offset = m_Document.GetLineStart(m_FirstLine);
+
+		for (size_t line = m_FirstLine; line < last; ++line)
+		{
+			const auto& layout = GetLineLayout(line);
+			function(line, offset, static_cast<int>(line - m_FirstLine) * m_LineHeight, layout);
+			offset += layout.Length;
+		}
+	}
+
+	// Document offset of the caret closest to the point (relative to the viewport)
+	size_t GetOffsetFromPoint(int x, int y);
+
+	// Position of the caret placed at the offset (relative to the viewport, outside of it when the line isn't visible)
+	void GetPointFromOffset(size_t offset, int& x, int& y);
+
+	// Must be called before the document changes: the edit starts at line and removes/inserts the given line breaks
+	void OnEdit(size_t line, size_t removedLineBreaks, size_t insertedLineBreaks);
+	void Invalidate() noexcept;
+
+	size_t GetCacheHits() const noexcept;
+	size_t GetCacheMisses() const noexcept;
+};
\ No newline at end of file
@@ -23,7 +23,6 @@ ToolStrip::ToolStrip(Control* parent)
 		0,	// Height is calculated base on Font size
 		parent->GetMargin().Left,
 		parent->m_MinSize + parent->GetMargin().Top),
-	m_DockStyle(DockStyle::Top),
 	m_GripStyle(ToolStripGripStyle::Visible)
 {
 	Initialize();
@@ -51,19 +50,8 @@ void ToolStrip::Initialize()
 		throw CTL_LAST_EXCEPT();
 	}
 
-	// Set default TextBox margin to 3 pixels
-	m_Margin = 3;
-}
-
-DockStyle ToolStrip::GetDockStyle() const noexcept
-{
-	return m_DockStyle;
-}
-
-void ToolStrip::SetDockStyle(DockStyle style) noexcept
-{
-	m_DockStyle = style;
-	Update();
+	// Set default TextBox margin to 3 pixels (through SetMargin so the layout node gets it too)
+	SetMargin(3);
 }
 
 ToolStripGripStyle ToolStrip::GetGripStyle() const noexcept
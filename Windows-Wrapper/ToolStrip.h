@@ -12,7 +12,6 @@ class ToolStrip: public Control
 
 private:
 
-	DockStyle m_DockStyle;
 	ToolStripGripStyle m_GripStyle;
 	ToolStripRenderMode m_Renderer;
 
@@ -28,8 +27,6 @@ public:
 
 	void Initialize() override;
 
-	DockStyle GetDockStyle() const noexcept;
-	void SetDockStyle(DockStyle style) noexcept;
 	ToolStripGripStyle GetGripStyle() const noexcept;
 	void SetGripStyle(ToolStripGripStyle style) noexcept;
 	ToolStripRenderMode GetRenderMode() const noexcept;
@@ -0,0 +1,155 @@
+#include "UndoJournal.h"
+
+UndoJournal::UndoJournal(size_t memoryBudget)
+	:
+	m_Position(0),
+	m_MemoryUsage(0),
+	m_MemoryBudget(memoryBudget),
+	m_CanMerge(false)
+{
+
+}
+
+size_t UndoJournal::GetMemoryUsage(const Edit& e) noexcept
+{
+	return sizeof(Edit) + e.Removed.capacity() + e.Inserted.capacity();
+}
+
+bool UndoJournal::TryMerge(size_t offset, std::string_view removed, std::string_view inserted)
+{
+	if (!m_CanMerge || m_Position == 0 || m_Position != m_Edits.size()) return false;
+
+	auto& last = m_Edits.back();
+
+	if (last.Removed.length() + last.Inserted.length() + removed.length() + inserted.length() > MaximumMergedLength) return false;
+
+	const size_t before = GetMemoryUsage(last);
+
+	if (removed.empty())
+	{
+		// Typing after the last inserted text, or right where the last removal happened
+		if (offset != last.Offset + last.Inserted.length()) return false;
+
+		last.Inserted.append(inserted);
+	}
+	else if (inserted.empty() && last.Inserted.empty())
+	{
+		if (offset + removed.length() == last.Offset)
+		{
+			// Backspace
+			last.Removed.insert(0, removed);
+			last.Offset = offset;
+		}
+		else if (offset == last.Offset)
+		{
+			// Delete
+			last.Removed.append(removed);
+		}
+		else
+		{
+			return false;
+		}
+	}
+	else
+	{
+		return false;
+	}
+
+	m_MemoryUsage += GetMemoryUsage(last) - before;
+	return true;
+}
+
+void UndoJournal::Trim()
+{
+	while (m_MemoryUsage > m_MemoryBudget && !m_Edits.empty())
+	{
+		m_MemoryUsage -= GetMemoryUsage(m_Edits.front());
+		m_Edits.pop_front();
+
+		if (m_Position > 0) --m_Position;
+	}
+}
+
+void UndoJournal::Record(size_t offset, std::string_view removed, std::string_view inserted)
+{
+	if (removed.empty() && inserted.empty()) return;
+
+	// A new edit makes the undone entries unreachable
+	while (m_Edits.size() > m_Position)
+	{
+		m_MemoryUsage -= GetMemoryUsage(m_Edits.back());
+		m_Edits.pop_back();
+	}
+
+	if (!TryMerge(offset, removed, inserted))
+	{
+		m_Edits.push_back(Edit{ offset, std::string(removed), std::string(inserted) });
+		m_MemoryUsage += GetMemoryUsage(m_Edits.back());
+		m_Position = m_Edits.size();
+	}
+
+	m_CanMerge = true;
+	Trim();
+}
+
+void UndoJournal::BreakMerge() noexcept
+{
+	m_CanMerge = false;
+}
+
+const UndoJournal::Edit* UndoJournal::Undo() noexcept
+{
+	m_CanMerge = false;
+
+	if (m_Position == 0) return nullptr;
+
+	return &m_Edits[--m_Position];
+}
+
+const UndoJournal::Edit* UndoJournal::Redo() noexcept
+{
+	m_CanMerge = false;
+
+	if (m_Position == m_Edits.size()) return nullptr;
+
+	return &m_Edits[m_Position++];
+}
+
+bool UndoJournal::CanUndo() const noexcept
+{
+	return m_Position > 0;
+}
+
+bool UndoJournal::CanRedo() const noexcept
+{
+	return m_Position < m_Edits.size();
+}
+
+void UndoJournal::Clear() noexcept
+{
+	m_Edits.clear();
+	m_Position = 0;
+	m_MemoryUsage = 0;
+	m_CanMerge = false;
+}
+
+size_t UndoJournal::GetCount() const noexcept
+{
+	return m_Edits.size();
+}
+
+size_t UndoJournal::GetMemoryUsage() const noexcept
+{
+	return m_MemoryUsage;
+}
+
+size_t UndoJournal::GetMemoryBudget() const noexcept
+{
+	return m_MemoryBudget;
+}
+
+void UndoJournal::SetMemoryBudget(size_t bytes)
+{
+	m_MemoryBudget = bytes;
+	Trim();
+}
\ No newline at end of file
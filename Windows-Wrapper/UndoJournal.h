@@ -0,0 +1,67 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <deque>
+#include <cstddef>
+
+/*
+Undo/redo history storing only the edited spans: each entry keeps the offset, the removed text and the inserted text,
+so undoing replaces Inserted by Removed and redoing does the opposite. Nothing is proportional to the document.
+
+Consecutive typing (and consecutive Backspace or Delete presses) is merged in the last entry until the caller breaks
+the sequence (ex: the caret is moved). Typing right after removing text at the same offset turns the entry into a
+replacement, so overwriting a selection is undone in a single step.
+
+When the memory used by the entries goes over the budget the oldest ones are dropped from the front.
+*/
+class UndoJournal
+{
+public:
+
+	struct Edit
+	{
+		size_t Offset;
+		std::string Removed;
+		std::string Inserted;
+	};
+
+private:
+
+	// Merged entries are limited so prepending Backspace removals never becomes expensive
+	static constexpr size_t MaximumMergedLength = 1024;
+
+	std::deque<Edit> m_Edits;
+	size_t m_Position;			// Entries before it can be undone, the ones after it can be redone
+	size_t m_MemoryUsage;
+	size_t m_MemoryBudget;
+	bool m_CanMerge;
+
+	static size_t GetMemoryUsage(const Edit& e) noexcept;
+	bool TryMerge(size_t offset, std::string_view removed, std::string_view inserted);
+	void Trim();
+
+public:
+
+	explicit UndoJournal(size_t memoryBudget = 4 * 1024 * 1024);
+
+	void Record(size_t offset, std::string_view removed, std::string_view inserted);
+
+	// Next record starts a new entry
+	void BreakMerge() noexcept;
+
+	// Returns the edit to revert (nullptr when there's nothing to undo). Valid until the next Record
+	const Edit* Undo() noexcept;
+
+	// Returns the edit to apply again (nullptr when there's nothing to redo). Valid until the next Record
+	const Edit* Redo() noexcept;
+
+	bool CanUndo() const noexcept;
+	bool CanRedo() const noexcept;
+	void Clear() noexcept;
+
+	size_t GetCount() const noexcept;
+	size_t GetMemoryUsage() const noexcept;
+	size_t GetMemoryBudget() const noexcept;
+	void SetMemoryBudget(size_t bytes);
+};
\ No newline at end of file
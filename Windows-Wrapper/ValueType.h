@@ -0,0 +1,37 @@
+#pragma once
+
+#include <concepts>
+#include <type_traits>
+#include <cstdint>
+#include <cstddef>
+
+/*
+Small drawing types like Color, Point, Size, Drawing::Rectangle and IntPtr are copied around by value everywhere
+(control geometry, brushes cache, row positions, etc...). Deriving them from Object would add a vtable pointer to
+each instance (a 4 bytes Color becomes 16 bytes) and block memcpy/vectorization over arrays of them.
+So they are plain structures and the interfaces are checked at compile time through the concepts below, which only
+need the standard library.
+*/
+template<typename T>
+concept EquatableValue = std::is_trivially_copyable_v<T> && std::is_standard_layout_v<T> && requires(const T& a, const T& b)
+{
+	{ a == b } -> std::convertible_to<bool>;
+	{ a.Equals(&b) } -> std::convertible_to<bool>;
+	{ a.GetHashCode() } -> std::convertible_to<int>;
+};
+
+template<typename T>
+concept ComparableValue = EquatableValue<T> && requires(const T& a, const T& b)
+{
+	{ a.CompareTo(&b) } -> std::convertible_to<int>;
+};
+
+// Hash functor to use the value types as keys of unordered containers
+template<EquatableValue T>
+struct ValueHash
+{
+	constexpr size_t operator()(const T& value) const noexcept
+	{
+		return static_cast<size_t>(static_cast<uint32_t>(value.GetHashCode()));
+	}
+};
\ No newline at end of file
@@ -43,7 +43,7 @@ void VerticalScrollBar::OnVerticalScrolling_Impl(HWND hwnd, HWND hwndCtl, unsign
 	case SB_LINEDOWN:       nPos = si.nPos + 1; break;
 	case SB_PAGEUP:         nPos = si.nPos - Owner->GetVerticalPage(); break;
 	case SB_PAGEDOWN:       nPos = si.nPos + Owner->GetVerticalPage(); break;
-	case SB_THUMBTRACK:     nPos = pos; break;
+	case SB_THUMBTRACK:     nPos = si.nTrackPos; break;	// pos only has 16 bits
 	default:
 	case SB_THUMBPOSITION:  nPos = si.nPos; break;
 	}
@@ -36,6 +36,40 @@ void WinAPI::PostDraw(Graphics* const graphics)
 
 }
 
+void WinAPI::OnBoundsChanged()
+{
+
+}
+
+const WinAPI* WinAPI::GetAmbientParent() const noexcept
+{
+	return nullptr;
+}
+
+void WinAPI::ResolveAmbientProperties() const
+{
+	if (m_AmbientVersion == AmbientVersion::GetCurrent()) return;
+
+	auto parent = [](const WinAPI* c) { return c->GetAmbientParent(); };
+
+	// Versions are unique so the same font is never copied (and recreated on PreDraw) again
+	if (AmbientProperty<Font>::Find(this, &WinAPI::m_LocalFont, parent).CopyTo(m_Font, m_FontVersion))
+	{
+		m_HasFontChanged = true;
+	}
+
+	AmbientProperty<Color>::Find(this, &WinAPI::m_LocalForeColor, parent).CopyTo(m_ForeColor, m_ForeColorVersion);
+	AmbientProperty<Color>::Find(this, &WinAPI::m_LocalBackgroundColor, parent).CopyTo(m_BackgroundColor, m_BackgroundColorVersion);
+	m_AmbientVersion = AmbientVersion::GetCurrent();
+}
+
+// Invalidates the control and all its children with a single call, used when an ambient property changes
+void WinAPI::UpdateTree() const
+{
+	m_DamagedRegion.MakeEmpty();
+	RedrawWindow(static_cast<HWND>(Handle.ToPointer()), nullptr, nullptr, RDW_INVALIDATE | RDW_ERASE | RDW_ALLCHILDREN);
+}
+
 void WinAPI::OnActivate_Impl(HWND hwnd, unsigned int state, HWND hwndActDeact, bool minimized)
 {
 	/**************************************************************************************************/
@@ -104,6 +138,26 @@ void WinAPI::OnClosed_Impl(HWND hwnd)
 	Dispatch("OnClosed", &ArgsOnClosed);
 }
 
+void WinAPI::OnHandleCreated(HWND hwnd)
+{
+
+}
+
+void WinAPI::OnHandleDestroyed(HWND hwnd)
+{
+
+}
+
+void WinAPI::OnEnabledChanged()
+{
+
+}
+
+WinAPI* WinAPI::GetMouseWheelTarget(int x, int y) noexcept
+{
+	return this;
+}
+
 void WinAPI::OnCreate_Impl(HWND hwnd, LPCREATESTRUCT lpCreateStruct)
 {
 	Dispatch("OnCreate", &ArgsDefault);
@@ -312,6 +366,29 @@ void WinAPI::OnPaint_Impl(HWND hwnd)
 	{
 		Drawing::Rectangle rect = Drawing::Rectangle(0, 0, m_Size.Width, m_Size.Height);
 
+		ResolveAmbientProperties();
+
+		// Partial damage is only valid when nothing else (other windows, RedrawWindow, etc...) invalidated the control.
+		// The whole update region is compared, its bounding box would cover the gaps between the damaged rectangles
+		if (!m_DamagedRegion.IsEmpty())
+		{
+			HRGN update = CreateRectRgn(0, 0, 0, 0);
+
+			if (update != nullptr && GetUpdateRgn(hwnd, update, false) != ERROR)
+			{
+				auto system = Graphics::GetRegion(update);
+				system.Subtract(m_DamagedRegion);
+
+				if (!system.IsEmpty()) m_DamagedRegion.MakeEmpty();
+			}
+			else
+			{
+				m_DamagedRegion.MakeEmpty();
+			}
+
+			if (update != nullptr) DeleteObject(update);
+		}
+
 		if (m_Graphics == nullptr)
 		{
 			m_Graphics = Graphics::Create(Handle, m_Size);
@@ -319,6 +396,10 @@ void WinAPI::OnPaint_Impl(HWND hwnd)
 
 		PaintEventArgs pArgs = PaintEventArgs(m_Graphics, rect);
 
+		// Hand the partial damage to the renderer so only those rectangles are presented
+		m_Graphics->UpdateRegion = std::move(m_DamagedRegion);
+		m_DamagedRegion.MakeEmpty();
+
 		m_Graphics->BeginDraw();
 		PreDraw(m_Graphics);
 		Draw(m_Graphics, rect);
@@ -367,6 +448,8 @@ void WinAPI::OnSize_Impl(HWND hwnd, unsigned int state, int cx, int cy)
 
 	if(m_Graphics) m_Graphics->UpdateSize(m_Size);
 
+	OnBoundsChanged();
+
 	Dispatch("OnResize", &ArgsDefault);
 }
 
@@ -403,6 +486,7 @@ WinAPI::WinAPI(int width, int height, int x, int y)
 	ArgsOnMouseDoubleClick(MouseButtons::None, 0, 0, 0, 0),
 	ArgsOnMouseWheel(MouseButtons::None, 0, 0, 0, 0),
 	m_Font("Segoe", 9, false, false, false, false, GraphicsUnit::Point),		// Default application font for controls
+	m_LocalFont(m_Font),
 	m_Enabled(true),
 	m_Id(m_CurrentIndex++),
 	m_IsMouseOver(false),
@@ -410,6 +494,12 @@ WinAPI::WinAPI(int width, int height, int x, int y)
 	m_IsVisible(true),
 	m_BackgroundColor(Color::ControlBackground_Win11()),
 	m_ForeColor(Color::Foreground()),
+	m_LocalBackgroundColor(m_BackgroundColor),
+	m_LocalForeColor(m_ForeColor),
+	m_AmbientVersion(0),
+	m_FontVersion(0),
+	m_ForeColorVersion(0),
+	m_BackgroundColorVersion(0),
 	m_HorizontalScrolling(0),
 	m_VerticalScrolling(0),
 	m_VerticalScrollingUnit(0),
@@ -447,6 +537,8 @@ LRESULT WINAPI WinAPI::HandleMessageSetup(HWND hWnd, UINT msg, WPARAM wParam, LP
 		// Set message function to normal (non-setup) handler now that setup is finished
 		SetWindowLongPtr(hWnd, GWLP_WNDPROC, reinterpret_cast<LONG_PTR>(&WinAPI::HandleMessageForwarder));
 
+		pWnd->OnHandleCreated(hWnd);
+
 		// Forward message to window class member function
 		return pWnd->HandleMessage(hWnd, msg, wParam, lParam);
 	}
@@ -500,6 +592,7 @@ LRESULT WINAPI WinAPI::HandleMessage(HWND hWnd, UINT msg, WPARAM wParam, LPARAM
 		}
 		case WM_NCDESTROY:
 		{
+			OnHandleDestroyed(hWnd);
 			OnClosed_Impl(hWnd);
 			break;
 		}
@@ -591,6 +684,12 @@ LRESULT WINAPI WinAPI::HandleMessage(HWND hWnd, UINT msg, WPARAM wParam, LPARAM
 		}
 		case WM_MOUSEWHEEL:
 		{
+			// Wheel messages are sent to the focused control
+			if (auto target = GetMouseWheelTarget((int)(short)LOWORD(lParam), (int)(short)HIWORD(lParam)); target != this)
+			{
+				return target->HandleMessage(static_cast<HWND>(target->Handle.ToPointer()), msg, wParam, lParam);
+			}
+
 			OnMouseWheel_Impl(hWnd, (int)(short)LOWORD(lParam), (int)(short)HIWORD(lParam), (int)(short)HIWORD(wParam), (UINT)(short)LOWORD(wParam));
 			break;
 		}
@@ -665,12 +764,14 @@ void WinAPI::SetLocation(Point p) noexcept
 {
 	m_Location = p;
 	SetWindowPos(static_cast<HWND>(Handle.ToPointer()), nullptr, m_Location.X, m_Location.Y, m_Size.Width, m_Size.Height, SWP_NOZORDER);
+	OnBoundsChanged();
 }
 
 void WinAPI::SetLocation(int x, int y) noexcept
 {
 	m_Location = Point(x, y);
 	SetWindowPos(static_cast<HWND>(Handle.ToPointer()), nullptr, m_Location.X, m_Location.Y, m_Size.Width, m_Size.Height, SWP_NOZORDER);
+	OnBoundsChanged();
 }
 
 Size WinAPI::GetSize() const noexcept
@@ -682,12 +783,14 @@ void WinAPI::Resize(Size s) noexcept
 {
 	m_Size = s;
 	SetWindowPos(static_cast<HWND>(Handle.ToPointer()), nullptr, m_Location.X, m_Location.Y, m_Size.Width, m_Size.Height, SWP_NOZORDER);
+	OnBoundsChanged();
 }
 
 void WinAPI::Resize(int width, int height) noexcept
 {
 	m_Size = Size(width, height);
 	SetWindowPos(static_cast<HWND>(Handle.ToPointer()), nullptr, m_Location.X, m_Location.Y, m_Size.Width, m_Size.Height, SWP_NOZORDER);
+	OnBoundsChanged();
 }
 
 bool WinAPI::IsMouseOver() const noexcept
@@ -709,19 +812,47 @@ void WinAPI::Enable()
 {
 	m_Enabled = true;
 	EnableWindow(static_cast<HWND>(Handle.ToPointer()), true);
+	OnEnabledChanged();
 }
 
 void WinAPI::Disable()
 {
 	m_Enabled = false;
 	EnableWindow(static_cast<HWND>(Handle.ToPointer()), false);
+	OnEnabledChanged();
 }
 
 void WinAPI::Update() const
 {
+	// The whole control is going to be repainted so there's no need to keep the partial damage
+	m_DamagedRegion.MakeEmpty();
 	InvalidateRect(static_cast<HWND>(Handle.ToPointer()), nullptr, true);
 }
 
+void WinAPI::Invalidate(const Drawing::Rectangle& rectangle) const
+{
+	Drawing::Region damage(rectangle);
+	damage.Intersect(Drawing::Rectangle(0, 0, m_Size.Width, m_Size.Height));
+
+	if (damage.IsEmpty()) return;
+
+	// Nothing new to repaint if the area was already invalidated
+	if (Drawing::Region::Subtract(damage, m_DamagedRegion).IsEmpty()) return;
+
+	m_DamagedRegion.Union(damage);
+	m_DamagedRegion.Simplify(MaximumDamagedRectangles);
+
+	const auto bounds = damage.GetBounds<Drawing::Rectangle>();
+
+	RECT rc;
+	rc.left = bounds.X;
+	rc.top = bounds.Y;
+	rc.right = bounds.X + bounds.Width;
+	rc.bottom = bounds.Y + bounds.Height;
+
+	InvalidateRect(static_cast<HWND>(Handle.ToPointer()), &rc, true);
+}
+
 const Graphics* WinAPI::CreateGraphics() const noexcept
 {
 	return m_Graphics;
@@ -738,6 +869,7 @@ void WinAPI::Hide()
 	{
 		m_IsVisible = false;
 		ShowWindow(static_cast<HWND>(Handle.ToPointer()), SW_HIDE);
+		OnBoundsChanged();
 	}
 }
 
@@ -747,24 +879,37 @@ void WinAPI::Show()
 	{
 		m_IsVisible = true;
 		ShowWindow(static_cast<HWND>(Handle.ToPointer()), SW_SHOWDEFAULT);
+		OnBoundsChanged();
 	}
 }
 
 Font WinAPI::GetFont() const noexcept
 {
+	ResolveAmbientProperties();
 	return m_Font;
 }
 
-void WinAPI::SetFont(Font font) noexcept
+unsigned long long WinAPI::GetFontVersion() const noexcept
 {
-	m_Font = font;
+	ResolveAmbientProperties();
+	return m_FontVersion;
+}
 
-	m_HasFontChanged = true;
-	Update();
+TextExtent WinAPI::MeasureText(std::string_view text) const
+{
+	return Application::GetTextMeasurer().Measure(GetFont().GetDescriptor(), text);
+}
+
+void WinAPI::SetFont(Font font) noexcept
+{
+	m_LocalFont.Set(font);
+	UpdateTree();
 }
 
 Color WinAPI::GetBackgroundColor() const noexcept
 {
+	ResolveAmbientProperties();
+
 	if ((m_BackgroundColor ==Color::ControlBackground_Win11() || m_BackgroundColor == Color::ControlBackground_Win10()) && !IsEnabled())
 	{
 		return Color::DisabledControlBackground();
@@ -775,18 +920,20 @@ Color WinAPI::GetBackgroundColor() const noexcept
 
 void WinAPI::SetBackgroundColor(const Color& color) noexcept
 {
-	m_BackgroundColor = color;
-	Update();
+	m_LocalBackgroundColor.Set(color);
+	UpdateTree();
 }
 
 Color WinAPI::GetForeColor() const noexcept
 {
+	ResolveAmbientProperties();
+
 	if (!IsEnabled()) return Color::DisabledForeground();
 	return m_ForeColor;
 }
 
 void WinAPI::SetForeColor(const Color& color) noexcept
 {
-	m_ForeColor = color;
-	Update();
+	m_LocalForeColor.Set(color);
+	UpdateTree();
 }
\ No newline at end of file
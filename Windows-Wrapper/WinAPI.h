@@ -15,6 +15,8 @@
 #include "KeyPressEventArgs.h"
 #include "MessageMapper.h"
 #include "Rectangle.h"
+#include "Region.h"
+#include "AmbientProperty.h"
 
 class Graphics;
 class Window;
@@ -37,6 +39,7 @@ class WinAPI : public Component, public IHandle
 	friend class ListControl;
 	friend class ComboBox;
 	friend class ListBox;
+	friend class ScrollableControl;
 	friend class ScrollBar;
 	friend class HorizontalScrollBar;
 	friend class VerticalScrollBar;
@@ -49,9 +52,13 @@ private:
 	bool m_IsMouseOver;
 	bool m_IsClicking;
 	bool m_Enabled;
-	bool m_HasFontChanged;
+	mutable bool m_HasFontChanged;
 	static IntPtr m_OpenedControl;
 
+	// Partial invalidations accumulated since the last WM_PAINT
+	mutable Drawing::Region m_DamagedRegion;
+	static constexpr size_t MaximumDamagedRectangles = 16;
+
 	// Scrolling
 	int m_HorizontalScrolling;
 	int m_VerticalScrolling;
@@ -61,9 +68,23 @@ private:
 	Size m_Size;
 	Point m_Location;
 	Graphics* m_Graphics;
-	Font m_Font;
-	Color m_ForeColor;
-	Color m_BackgroundColor;
+	// Resolved (ambient) values used to draw the control. A value not explicitly set on the control is inherited
+	// from the nearest ancestor which set it, otherwise the control keeps its own default (local value)
+	mutable Font m_Font;
+	mutable Color m_ForeColor;
+	mutable Color m_BackgroundColor;
+	AmbientProperty<Font> m_LocalFont;
+	AmbientProperty<Color> m_LocalForeColor;
+	AmbientProperty<Color> m_LocalBackgroundColor;
+
+	// AmbientVersion when the values were last resolved and the version of each resolved value
+	mutable unsigned long long m_AmbientVersion;
+	mutable unsigned long long m_FontVersion;
+	mutable unsigned long long m_ForeColorVersion;
+	mutable unsigned long long m_BackgroundColorVersion;
+
+	void ResolveAmbientProperties() const;
+	void UpdateTree() const;
 
 	bool m_IsVisible;
 
@@ -91,6 +112,28 @@ private:
 	// Perform the PostDraw to clear drawing objects
 	virtual void PostDraw(Graphics* const graphics);
 
+	// Called when the location, size or visibility changes so the owner window can keep its hit testing index in sync
+	virtual void OnBoundsChanged();
+
+	// Called on WM_NCCREATE, before CreateWindow returns the handle
+	virtual void OnHandleCreated(HWND hwnd);
+
+	// Called on WM_NCDESTROY, the system may give the handle to another window after it
+	virtual void OnHandleDestroyed(HWND hwnd);
+
+	// Called by Enable and Disable
+	virtual void OnEnabledChanged();
+
+	// Control receiving a wheel message at the screen point, the wheel scrolls what is under the cursor instead of the
+	// focused control
+	virtual WinAPI* GetMouseWheelTarget(int x, int y) noexcept;
+
+	// Control from which the ambient properties are inherited
+	virtual const WinAPI* GetAmbientParent() const noexcept;
+
+	// Size of a single line of text with the current font, through the application text measurement cache
+	TextExtent MeasureText(std::string_view text) const;
+
 	/***** Global events declaration *****/
 	/* All are virtual to be overritten on the derived classes. Not all should be, but events like OnPaint(), OnMouseOver(),
 	OnKeyPressed() have different behaviors on each type of Control. So they are all virtual to decouple each kind of
@@ -168,12 +211,15 @@ public:
 	void Enable();
 	void Disable();
 	virtual void Update() const;
+	void Invalidate(const Drawing::Rectangle& rectangle) const;
 	const Graphics* CreateGraphics() const noexcept;
 	bool IsShown() const noexcept;
 	virtual void Hide();
 	virtual void Show();
 	Font GetFont() const noexcept;
 	virtual void SetFont(Font font) noexcept;
+	// Changes whenever the resolved font changes, to key what was drawn with it
+	unsigned long long GetFontVersion() const noexcept;
 	Color GetBackgroundColor() const noexcept;
 	void SetBackgroundColor(const Color& color) noexcept;
 	Color GetForeColor() const noexcept;
@@ -80,7 +80,7 @@ void Window::Initialize()
 	//SetParent(static_cast<HWND>(Handle.ToPointer()), static_cast<HWND>(Parent->Handle.ToPointer()));
 
 	// Force window redraw to set Background color
-	m_BackgroundColor = Color::WindowBackground();
+	m_LocalBackgroundColor.SetDefault(Color::WindowBackground());
 
 	// Add window the the application windows container
 	Application::AddWindow(this);
@@ -266,4 +266,80 @@ Mouse& Window::GetMouse() const
 	}
 
 	return *m_Mouse;
+}
+
+void Window::UpdateControlIndex(Control* control)
+{
+	// Accumulate the offset of the ancestors because each control location is relative to its parent
+	int x = 0;
+	int y = 0;
+	bool isVisible = true;
+
+	for (auto p = control->Parent; p != nullptr && p != this; p = p->Parent)
+	{
+		x += p->m_Location.X;
+		y += p->m_Location.Y;
+		isVisible = isVisible && p->m_IsVisible;
+	}
+
+	UpdateControlIndex(control, x, y, isVisible);
+}
+
+void Window::UpdateControlIndex(Control* control, int x, int y, bool isVisible)
+{
+	// Moving or hiding a container also moves or hides all its children
+	isVisible = isVisible && control->m_IsVisible;
+	x += control->m_Location.X;
+	y += control->m_Location.Y;
+
+	if (isVisible)
+	{
+		m_ControlIndex.Update(control, x, y, control->m_Size.Width, control->m_Size.Height);
+	}
+	else
+	{
+		m_ControlIndex.Remove(control);
+	}
+
+	for (const auto& c : control->Controls)
+	{
+		UpdateControlIndex(c, x, y, isVisible);
+	}
+}
+
+Control* Window::GetControlAtPoint(Point p) const
+{
+	// Every control under the point is kept, a deep hierarchy or many overlapping siblings can't drop the one on top
+	std::vector<Control*> hits;
+	m_ControlIndex.QueryPoint(p.X, p.Y, [&](Control* c) { hits.push_back(c); });
+
+	// Goes down from the window, picking the hit child on top at each level. Controls are created on top of their
+	// siblings so the most recent one (the highest id) wins, and a child outside its parent is clipped like in Win32
+	const Control* parent = this;
+	Control* ret = nullptr;
+
+	while (true)
+	{
+		Control* top = nullptr;
+
+		for (Control* c : hits)
+		{
+			if (c->Parent == parent && (top == nullptr || c->GetId() > top->GetId()))
+			{
+				top = c;
+			}
+		}
+
+		if (top == nullptr) return ret;
+
+		ret = top;
+		parent = top;
+	}
+}
+
+std::vector<Control*> Window::GetControlsInRectangle(const Drawing::Rectangle& rectangle)
+{
+	std::vector<Control*> ret;
+	m_ControlIndex.QueryRectangle(rectangle.X, rectangle.Y, rectangle.Width, rectangle.Height, [&](Control* c) { ret.push_back(c); });
+	return ret;
 }
\ No newline at end of file
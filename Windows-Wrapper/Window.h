@@ -12,11 +12,14 @@
 #include "OnClosingEventArgs.h"
 #include "Keyboard.h"
 #include "Mouse.h"
+#include "SpatialGrid.h"
+#include "TabOrder.h"
 
 class Window final : public Control
 {
 	friend class Menu;
 	friend class WinAPI;
+	friend class Control;
 
 private:
 
@@ -26,6 +29,15 @@ private:
 	std::unique_ptr<Mouse> m_Mouse;
 	std::vector<BYTE> m_RawBuffer;
 
+	// Bounds of every visible child control in window client coordinates for hit testing
+	SpatialGrid<Control*> m_ControlIndex;
+
+	// Tab indexes are given per window, the chain is used to move the focus with Tab
+	TabOrder<Control*> m_TabOrder;
+
+	void UpdateControlIndex(Control* control);
+	void UpdateControlIndex(Control* control, int x, int y, bool isVisible);
+
 	void EncloseCursor() const noexcept;
 	static void FreeCursor() noexcept;
 	static void HideCursor() noexcept;
@@ -68,4 +80,9 @@ public:
 	bool IsCursorEnabled() const noexcept;
 	Keyboard& GetKeyboard() const;
 	Mouse& GetMouse() const;
+
+	// Visible control on top under the point (window client coordinates), like WindowFromPoint: overlapping siblings
+	// are resolved by z-order and children are only hit inside their parent. Returns nullptr when there's none
+	Control* GetControlAtPoint(Point p) const;
+	std::vector<Control*> GetControlsInRectangle(const Drawing::Rectangle& rectangle);
 };
\ No newline at end of file